@@ -0,0 +1,184 @@
+/**************************************************************************/
+/*  frame_tracer.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_tracer.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+SafeFlag FrameTracer::tracing;
+uint64_t FrameTracer::trace_begin_usec = 0;
+Mutex FrameTracer::mutex;
+LocalVector<FrameTracer::ThreadData *> FrameTracer::threads;
+LocalVector<FrameTracer::GPUEvent> FrameTracer::gpu_events;
+SafeNumeric<uint32_t> FrameTracer::generation;
+thread_local FrameTracer::ThreadData *FrameTracer::thread_data = nullptr;
+thread_local uint32_t FrameTracer::thread_data_generation = 0;
+
+FrameTracer::ThreadData *FrameTracer::_get_thread_data() {
+	// finalize() can only clear the pointer of the calling thread, the others notice the generation changed.
+	if (unlikely(thread_data == nullptr || thread_data_generation != generation.get())) {
+		ThreadData *td = memnew(ThreadData);
+		td->id = Thread::get_caller_id();
+		td->name = td->id == Thread::get_main_id() ? String("Main Thread") : vformat("Thread %d", td->id);
+
+		MutexLock lock(mutex);
+		threads.push_back(td);
+		thread_data = td;
+		thread_data_generation = generation.get();
+	}
+	return thread_data;
+}
+
+const char *FrameTracer::_get_dynamic_name(const String &p_name) {
+	if (p_name.is_empty()) {
+		return "Unnamed Zone";
+	}
+
+	// Only accessed by the owning thread, and never cleared while the engine runs.
+	ThreadData *td = _get_thread_data();
+	HashMap<String, CharString>::Iterator E = td->dynamic_names.find(p_name);
+	if (!E) {
+		E = td->dynamic_names.insert(p_name, p_name.utf8());
+	}
+	return E->value.get_data();
+}
+
+uint64_t FrameTracer::get_ticks_usec() {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+void FrameTracer::start() {
+	clear();
+	trace_begin_usec = get_ticks_usec();
+	tracing.set();
+}
+
+void FrameTracer::stop() {
+	tracing.clear();
+}
+
+void FrameTracer::clear() {
+	MutexLock lock(mutex);
+	for (ThreadData *td : threads) {
+		td->lock.lock();
+		td->events.clear();
+		td->lock.unlock();
+	}
+	gpu_events.clear();
+}
+
+void FrameTracer::set_thread_name(const String &p_name) {
+	ThreadData *td = _get_thread_data();
+	MutexLock lock(mutex);
+	td->name = p_name;
+}
+
+void FrameTracer::add_zone(const char *p_name, uint64_t p_begin_usec, uint64_t p_end_usec) {
+	if (!tracing.is_set()) {
+		return;
+	}
+	ThreadData *td = _get_thread_data();
+	Event event;
+	event.name = p_name;
+	event.begin_usec = p_begin_usec;
+	event.end_usec = p_end_usec;
+	td->lock.lock();
+	td->events.push_back(event);
+	td->lock.unlock();
+}
+
+void FrameTracer::add_gpu_zone(const String &p_name, uint64_t p_begin_usec, uint64_t p_end_usec) {
+	if (!tracing.is_set()) {
+		return;
+	}
+	GPUEvent event;
+	event.name = p_name;
+	event.begin_usec = p_begin_usec;
+	event.end_usec = p_end_usec;
+	MutexLock lock(mutex);
+	gpu_events.push_back(event);
+}
+
+static void _store_trace_event(Ref<FileAccess> p_file, bool &r_first, const String &p_name, int p_pid, uint64_t p_tid, int64_t p_ts, uint64_t p_duration) {
+	p_file->store_string(vformat("%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%d,\"dur\":%d}", r_first ? "" : ",", p_name.json_escape(), p_pid, p_tid, p_ts, p_duration));
+	r_first = false;
+}
+
+static void _store_trace_metadata(Ref<FileAccess> p_file, bool &r_first, const String &p_what, int p_pid, uint64_t p_tid, const String &p_name) {
+	p_file->store_string(vformat("%s\n{\"name\":\"%s\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", r_first ? "" : ",", p_what, p_pid, p_tid, p_name.json_escape()));
+	r_first = false;
+}
+
+Error FrameTracer::save(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Can't open trace file for writing: " + p_path);
+
+	// CPU zones go in the first process (one track per thread), GPU passes in the second one.
+	const int cpu_pid = 1;
+	const int gpu_pid = 2;
+	const int64_t base = trace_begin_usec;
+
+	f->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	bool first = true;
+	_store_trace_metadata(f, first, "process_name", cpu_pid, 0, "CPU");
+	_store_trace_metadata(f, first, "process_name", gpu_pid, 0, "GPU");
+	_store_trace_metadata(f, first, "thread_name", gpu_pid, 0, "RenderingDevice");
+
+	MutexLock lock(mutex);
+	for (ThreadData *td : threads) {
+		_store_trace_metadata(f, first, "thread_name", cpu_pid, td->id, td->name);
+		td->lock.lock();
+		for (const Event &E : td->events) {
+			_store_trace_event(f, first, E.name, cpu_pid, td->id, int64_t(E.begin_usec) - base, E.end_usec - E.begin_usec);
+		}
+		td->lock.unlock();
+	}
+	for (const GPUEvent &E : gpu_events) {
+		_store_trace_event(f, first, E.name, gpu_pid, 0, int64_t(E.begin_usec) - base, E.end_usec - E.begin_usec);
+	}
+
+	f->store_string("\n]}\n");
+	return OK;
+}
+
+void FrameTracer::finalize() {
+	tracing.clear();
+	MutexLock lock(mutex);
+	for (ThreadData *td : threads) {
+		memdelete(td);
+	}
+	threads.clear();
+	gpu_events.clear();
+	generation.increment();
+	thread_data = nullptr;
+}
@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  frame_tracer.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_TRACER_H
+#define FRAME_TRACER_H
+
+#include "core/os/mutex.h"
+#include "core/os/spin_lock.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Records a timeline of named CPU zones (per thread) and GPU passes, which can be exported
+// in the Chrome trace event JSON format (readable by chrome://tracing and the Perfetto UI).
+// When not tracing, a zone costs a single flag check.
+class FrameTracer {
+	struct Event {
+		const char *name = nullptr;
+		uint64_t begin_usec = 0;
+		uint64_t end_usec = 0;
+	};
+
+	struct ThreadData {
+		uint64_t id = 0;
+		String name;
+		SpinLock lock;
+		LocalVector<Event> events;
+		// Owns the names of zones created from a String, so events can keep pointing to them.
+		HashMap<String, CharString> dynamic_names;
+	};
+
+	struct GPUEvent {
+		String name;
+		uint64_t begin_usec = 0;
+		uint64_t end_usec = 0;
+	};
+
+	static SafeFlag tracing;
+	static uint64_t trace_begin_usec;
+	static Mutex mutex;
+	static LocalVector<ThreadData *> threads;
+	static LocalVector<GPUEvent> gpu_events;
+	static SafeNumeric<uint32_t> generation; // Incremented when finalize() frees the thread data.
+	static thread_local ThreadData *thread_data;
+	static thread_local uint32_t thread_data_generation;
+
+	static ThreadData *_get_thread_data();
+	static const char *_get_dynamic_name(const String &p_name);
+
+public:
+	class Zone {
+		const char *name = nullptr;
+		uint64_t begin_usec = 0;
+
+	public:
+		_FORCE_INLINE_ Zone(const char *p_name) {
+			if (unlikely(tracing.is_set())) {
+				name = p_name;
+				begin_usec = get_ticks_usec();
+			}
+		}
+		_FORCE_INLINE_ Zone(const String &p_name) {
+			if (unlikely(tracing.is_set())) {
+				name = _get_dynamic_name(p_name);
+				begin_usec = get_ticks_usec();
+			}
+		}
+		_FORCE_INLINE_ ~Zone() {
+			if (unlikely(begin_usec != 0)) {
+				add_zone(name, begin_usec, get_ticks_usec());
+			}
+		}
+	};
+
+	_FORCE_INLINE_ static bool is_tracing() { return tracing.is_set(); }
+	static uint64_t get_ticks_usec();
+
+	static void start();
+	static void stop();
+	static Error save(const String &p_path);
+	static void clear();
+
+	// Names the calling thread in the exported trace.
+	static void set_thread_name(const String &p_name);
+
+	// The name must outlive the trace (i.e. a string literal).
+	static void add_zone(const char *p_name, uint64_t p_begin_usec, uint64_t p_end_usec);
+	// GPU times must already be converted to the CPU clock (see OS::get_ticks_usec()).
+	static void add_gpu_zone(const String &p_name, uint64_t p_begin_usec, uint64_t p_end_usec);
+
+	static void finalize();
+};
+
+#define _TRACE_ZONE_CONCAT_IMPL(m_a, m_b) m_a##m_b
+#define _TRACE_ZONE_CONCAT(m_a, m_b) _TRACE_ZONE_CONCAT_IMPL(m_a, m_b)
+
+// Records the time spent from this point until the end of the enclosing scope.
+#define TRACE_ZONE(m_name) FrameTracer::Zone _TRACE_ZONE_CONCAT(_trace_zone_, __LINE__)(m_name)
+
+#endif // FRAME_TRACER_H
@@ -55,6 +55,8 @@
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
+#define BVH_SEGMENT_PACKET_MAX 32
+
 #define BVH_LOCKED_FUNCTION BVHLockedFunction _lock_guard(&_mutex, BVH_THREAD_SAFE &&_thread_safe);
 
 template <class T, int NUM_TREES = 1, bool USE_PAIRS = false, int MAX_ITEMS = 32, class USER_PAIR_TEST_FUNCTION = BVH_DummyPairTestFunction<T>, class USER_CULL_TEST_FUNCTION = BVH_DummyCullTestFunction<T>, class BOUNDS = AABB, class POINT = Vector3, bool BVH_THREAD_SAFE = true>
@@ -312,6 +314,64 @@ public:
 		_check_for_collisions();
 	}
 
+	// Same as update(), split so the pairing queries of the changed items (the most expensive part when many items
+	// move) can run on several threads. pairing_begin() returns the amount of changed items, then pairing_query()
+	// must be called once for each of them (from any thread), and pairing_end() sends the pair callbacks, in the
+	// same order as update(). No other function may be called before pairing_end().
+	uint32_t pairing_begin() {
+		BVH_LOCKED_FUNCTION
+		tree.update();
+
+		if (_pairing_hits.size() < changed_items.size()) {
+			_pairing_hits.resize(changed_items.size());
+		}
+		return changed_items.size();
+	}
+
+	void pairing_query(uint32_t p_index) {
+		BVHHandle h = changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		params.hits = &_pairing_hits[p_index];
+
+		tree.item_fill_cullparams(h, params);
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+		tree.cull_aabb(params, false);
+	}
+
+	void pairing_end() {
+		BVH_LOCKED_FUNCTION
+		if (changed_items.size()) {
+			for (uint32_t n = 0; n < changed_items.size(); n++) {
+				BVHHandle h = changed_items[n];
+				BVHABB_CLASS abb;
+				abb.from(tree._pairs[h.id()].expanded_aabb);
+
+				_find_leavers(h, abb, false);
+
+				for (const uint32_t ref_id : _pairing_hits[n]) {
+					// don't collide against ourself
+					if (ref_id == h.id()) {
+						continue;
+					}
+
+					BVHHandle h_collidee;
+					h_collidee.set_id(ref_id);
+					_collide(h, h_collidee);
+				}
+			}
+			_reset();
+		}
+
+#ifdef BVH_INTEGRITY_CHECKS
+		tree._integrity_check_all();
+#endif
+	}
+
 	// prefer calling this directly as type safe
 	void set_tree(const BVHHandle &p_handle, uint32_t p_tree_id, uint32_t p_tree_collision_mask, bool p_force_collision_check = true) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -381,6 +441,34 @@ public:
 		return params.result_count_overall;
 	}
 
+	// Same as cull_segment() for a packet of up to BVH_SEGMENT_PACKET_MAX segments, in a single traversal of the tree:
+	// each node is only tested against the segments intersecting its parent, so coherent segments share most of the work.
+	// Results of segment n are written from p_result_array[n * p_result_max], and their amount to r_result_counts[n].
+	void cull_segments(const POINT *p_from, const POINT *p_to, int p_count, T **p_result_array, int *r_result_counts, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
+		ERR_FAIL_COND(p_count > BVH_SEGMENT_PACKET_MAX);
+		BVH_LOCKED_FUNCTION
+		typename BVHTREE_CLASS::CullParams params[BVH_SEGMENT_PACKET_MAX];
+
+		for (int n = 0; n < p_count; n++) {
+			params[n].result_count_overall = 0;
+			params[n].result_max = p_result_max;
+			params[n].result_array = p_result_array + n * p_result_max;
+			params[n].subindex_array = p_subindex_array ? p_subindex_array + n * p_result_max : nullptr;
+			params[n].tester = p_tester;
+			params[n].tree_collision_mask = p_tree_collision_mask;
+			params[n].hits = &_cull_segments_hits[n];
+
+			params[n].segment.from = p_from[n];
+			params[n].segment.to = p_to[n];
+		}
+
+		tree.cull_segments(params, p_count);
+
+		for (int n = 0; n < p_count; n++) {
+			r_result_counts[n] = params[n].result_count_overall;
+		}
+	}
+
 	int cull_point(const POINT &p_point, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
 		BVH_LOCKED_FUNCTION
 		typename BVHTREE_CLASS::CullParams params;
@@ -773,6 +861,12 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// Hits of each changed item, written by pairing_query().
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> _pairing_hits;
+
+	// Hits of each segment of the packet in cull_segments().
+	LocalVector<uint32_t, uint32_t, true> _cull_segments_hits[BVH_SEGMENT_PACKET_MAX];
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
@@ -30,6 +30,7 @@
 
 #include "worker_thread_pool.h"
 
+#include "core/debugger/frame_tracer.h"
 #include "core/os/os.h"
 #include "core/os/thread_safe.h"
 
@@ -51,6 +52,8 @@ void WorkerThreadPool::_process_task_queue() {
 }
 
 void WorkerThreadPool::_process_task(Task *p_task) {
+	TRACE_ZONE(p_task->description);
+
 	bool low_priority = p_task->low_priority;
 	int pool_thread_index = -1;
 	Task *prev_low_prio_task = nullptr; // In case this is recursively called.
@@ -185,6 +188,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
+	FrameTracer::set_thread_name("WorkerThreadPool");
 	while (true) {
 		singleton->task_available_semaphore.wait();
 		if (singleton->exit_threads) {
@@ -580,6 +584,8 @@ void WorkerThreadPool::finish() {
 	}
 
 	threads.clear();
+	thread_ids.clear();
+	exit_threads = false; // Can be initialized again, i.e. with another amount of threads.
 }
 
 void WorkerThreadPool::_bind_methods() {
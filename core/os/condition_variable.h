@@ -31,6 +31,8 @@
 #ifndef CONDITION_VARIABLE_H
 #define CONDITION_VARIABLE_H
 
+#include "core/os/mutex.h"
+
 #include <condition_variable>
 
 // An object one or multiple threads can wait on a be notified by some other.
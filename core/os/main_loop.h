@@ -65,6 +65,7 @@ public:
 	};
 
 	virtual void initialize();
+	virtual void iteration_prepare() {} // Called before each physics tick, before the physics servers sync.
 	virtual bool physics_process(double p_time);
 	virtual bool process(double p_time);
 	virtual void finalize();
@@ -58,6 +58,11 @@ MeshStorage::~MeshStorage() {
 
 /* MESH API */
 
+bool MeshStorage::can_create_resources_async() const {
+	// The GL context is only current on the render thread.
+	return false;
+}
+
 RID MeshStorage::mesh_allocate() {
 	return mesh_owner.allocate_rid();
 }
@@ -1154,6 +1154,10 @@ void TextureStorage::texture_set_detect_roughness_callback(RID p_texture, RS::Te
 	texture->detect_roughness_callback_ud = p_userdata;
 }
 
+void TextureStorage::texture_set_streaming_callback(RID p_texture, RS::TextureStreamingCallback p_callback, void *p_userdata) {
+	// Texture streaming is not supported by the Compatibility renderer, textures are always fully loaded.
+}
+
 void TextureStorage::texture_debug_usage(List<RS::TextureInfo> *r_info) {
 	List<RID> textures;
 	texture_owner.get_owned_list(&textures);
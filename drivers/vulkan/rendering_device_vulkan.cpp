@@ -6399,8 +6399,26 @@ RID RenderingDeviceVulkan::render_pipeline_create(RID p_shader, FramebufferForma
 	graphics_pipeline_create_info.basePipelineIndex = 0;
 
 	RenderPipeline pipeline;
+
+	// Pipeline creation is slow, don't hold the lock while it happens so pipelines can be compiled
+	// in the background without stalling the render thread. The pipeline cache is internally synchronized.
+	// The create info only references framebuffer and vertex formats, which are never freed, and the shader
+	// modules and layouts, which _free_pending_resources() keeps alive while pipelines_compiling is not zero.
+	String shader_name = shader->name;
+	pipelines_compiling++;
+	_thread_safe_.unlock();
 	VkResult err = vkCreateGraphicsPipelines(device, pipelines_cache.cache_object, 1, &graphics_pipeline_create_info, nullptr, &pipeline.pipeline);
-	ERR_FAIL_COND_V_MSG(err, RID(), "vkCreateGraphicsPipelines failed with error " + itos(err) + " for shader '" + shader->name + "'.");
+	_thread_safe_.lock();
+	pipelines_compiling--;
+	ERR_FAIL_COND_V_MSG(err, RID(), "vkCreateGraphicsPipelines failed with error " + itos(err) + " for shader '" + shader_name + "'.");
+
+	// Everything looked up before unlocking may have changed, look it up again.
+	shader = shader_owner.get_or_null(p_shader);
+	if (!shader || !framebuffer_formats.has(p_framebuffer_format) || (p_vertex_format != INVALID_ID && !vertex_formats.has(p_vertex_format))) {
+		// Freed while the pipeline was being created.
+		vkDestroyPipeline(device, pipeline.pipeline, nullptr);
+		ERR_FAIL_V_MSG(RID(), "Shader or formats were freed while creating a render pipeline for them.");
+	}
 
 	if (pipelines_cache.cache_object != VK_NULL_HANDLE) {
 		_update_pipeline_cache();
@@ -8687,8 +8705,9 @@ void RenderingDeviceVulkan::_free_pending_resources(int p_frame) {
 		frames[p_frame].buffer_views_to_dispose_of.pop_front();
 	}
 
-	// Shaders.
-	while (frames[p_frame].shaders_to_dispose_of.front()) {
+	// Shaders, unless a pipeline is being created without the lock held, as it may be using them.
+	// They are freed the next time this frame is cycled instead.
+	while (pipelines_compiling == 0 && frames[p_frame].shaders_to_dispose_of.front()) {
 		Shader *shader = &frames[p_frame].shaders_to_dispose_of.front()->get();
 
 		// Descriptor set layout for each set.
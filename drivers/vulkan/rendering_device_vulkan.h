@@ -1044,6 +1044,9 @@ class RenderingDeviceVulkan : public RenderingDevice {
 
 	void _free_pending_resources(int p_frame);
 
+	// Render pipelines being created with the lock released, see render_pipeline_create().
+	uint32_t pipelines_compiling = 0;
+
 	VmaAllocator allocator = nullptr;
 	HashMap<uint32_t, VmaPool> small_allocs_pools;
 	VmaPool _find_or_create_small_allocs_pool(uint32_t p_mem_type_index);
@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  hlod_3d_editor_plugin.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "hlod_3d_editor_plugin.h"
+
+#include "editor/editor_node.h"
+#include "editor/editor_undo_redo_manager.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/gui/button.h"
+
+void HLOD3DEditorPlugin::_get_visibility_parents(Node *p_node, HashMap<Node3D *, NodePath> &r_parents) {
+	Node3D *node = Object::cast_to<Node3D>(p_node);
+	if (node && !node->get_visibility_parent().is_empty()) {
+		r_parents[node] = node->get_visibility_parent();
+	}
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_get_visibility_parents(p_node->get_child(i), r_parents);
+	}
+}
+
+void HLOD3DEditorPlugin::_bake() {
+	if (!hlod) {
+		return;
+	}
+
+	Node *from_node = hlod->get_parent();
+	if (get_tree()->get_edited_scene_root() && get_tree()->get_edited_scene_root() == hlod) {
+		from_node = hlod;
+	}
+
+	// The bake frees the previous proxies, copies of them are restored on undo.
+	HashMap<Node3D *, NodePath> old_visibility_parents;
+	_get_visibility_parents(from_node, old_visibility_parents);
+	LocalVector<MeshInstance3D *> old_proxies;
+	hlod->get_proxies(old_proxies);
+	LocalVector<Node *> old_proxy_copies;
+	for (MeshInstance3D *proxy : old_proxies) {
+		old_proxy_copies.push_back(proxy->duplicate());
+	}
+
+	HLOD3D::BakeError err = hlod->bake(from_node);
+
+	HashMap<Node3D *, NodePath> new_visibility_parents;
+	_get_visibility_parents(from_node, new_visibility_parents);
+	LocalVector<MeshInstance3D *> new_proxies;
+	hlod->get_proxies(new_proxies);
+
+	// Nothing changed when there were no proxies before nor after.
+	if (!old_proxy_copies.is_empty() || !new_proxies.is_empty()) {
+		// The bake is already done, the action only records it.
+		Node *owner = hlod->get_owner() ? hlod->get_owner() : hlod;
+		EditorUndoRedoManager *ur = EditorUndoRedoManager::get_singleton();
+		ur->create_action(TTR("Bake HLOD"));
+
+		// The proxies of both bakes share names, the ones in the tree are removed before adding the others.
+		for (MeshInstance3D *proxy : new_proxies) {
+			ur->add_undo_method(hlod, "remove_child", proxy);
+		}
+		for (Node *copy : old_proxy_copies) {
+			ur->add_do_method(hlod, "remove_child", copy);
+			ur->add_undo_method(hlod, "add_child", copy, true);
+			ur->add_undo_method(copy, "set_owner", owner);
+			ur->add_undo_reference(copy);
+		}
+		for (MeshInstance3D *proxy : new_proxies) {
+			ur->add_do_method(hlod, "add_child", proxy, true);
+			ur->add_do_method(proxy, "set_owner", owner);
+			ur->add_do_reference(proxy);
+		}
+
+		for (const KeyValue<Node3D *, NodePath> &E : new_visibility_parents) {
+			ur->add_do_method(E.key, "set_visibility_parent", E.value);
+			const NodePath *old_parent = old_visibility_parents.getptr(E.key);
+			ur->add_undo_method(E.key, "set_visibility_parent", old_parent ? *old_parent : NodePath());
+		}
+		for (const KeyValue<Node3D *, NodePath> &E : old_visibility_parents) {
+			if (!new_visibility_parents.has(E.key)) {
+				ur->add_do_method(E.key, "set_visibility_parent", NodePath());
+				ur->add_undo_method(E.key, "set_visibility_parent", E.value);
+			}
+		}
+
+		ur->commit_action(false);
+	}
+
+	if (err == HLOD3D::BAKE_ERROR_NO_MESHES) {
+		EditorNode::get_singleton()->show_warning(TTR("No meshes to bake.\nMake sure there are at least two static MeshInstance3D nodes within the same cluster whose visual layers are part of the HLOD3D's Bake Mask property."));
+	}
+}
+
+void HLOD3DEditorPlugin::edit(Object *p_object) {
+	HLOD3D *s = Object::cast_to<HLOD3D>(p_object);
+	if (!s) {
+		return;
+	}
+
+	hlod = s;
+}
+
+bool HLOD3DEditorPlugin::handles(Object *p_object) const {
+	return p_object->is_class("HLOD3D");
+}
+
+void HLOD3DEditorPlugin::make_visible(bool p_visible) {
+	if (p_visible) {
+		bake->show();
+	} else {
+		bake->hide();
+	}
+}
+
+HLOD3DEditorPlugin::HLOD3DEditorPlugin() {
+	bake = memnew(Button);
+	bake->set_flat(true);
+	bake->set_icon(EditorNode::get_singleton()->get_gui_base()->get_theme_icon(SNAME("Bake"), SNAME("EditorIcons")));
+	bake->set_text(TTR("Bake HLOD"));
+	bake->hide();
+	bake->connect("pressed", callable_mp(this, &HLOD3DEditorPlugin::_bake));
+	add_control_to_container(CONTAINER_SPATIAL_EDITOR_MENU, bake);
+}
@@ -0,0 +1,64 @@
+/**************************************************************************/
+/*  shader_cache_export_plugin.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "shader_cache_export_plugin.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+
+void ShaderCacheExportPlugin::_add_cache_dir(const String &p_source_dir, const String &p_export_dir) {
+	for (const String &file : DirAccess::get_files_at(p_source_dir)) {
+		if (file.get_extension() != "cache") {
+			continue;
+		}
+		add_file(p_export_dir.path_join(file), FileAccess::get_file_as_bytes(p_source_dir.path_join(file)), false);
+	}
+	for (const String &dir : DirAccess::get_directories_at(p_source_dir)) {
+		_add_cache_dir(p_source_dir.path_join(dir), p_export_dir.path_join(dir));
+	}
+}
+
+void ShaderCacheExportPlugin::_export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) {
+	if (!GLOBAL_GET("rendering/shader_compiler/shader_cache/include_in_export")) {
+		return;
+	}
+
+	const String cache_dir = Engine::get_singleton()->get_shader_cache_path().path_join("shader_cache");
+	if (!DirAccess::dir_exists_absolute(cache_dir)) {
+		WARN_PRINT("Shader cache folder not found, no shaders will be included in the export: " + cache_dir);
+		return;
+	}
+
+	// Entries are addressed by the hash of their source and defines, so shaders that don't match the exported
+	// project are simply never looked up.
+	_add_cache_dir(cache_dir, "res://.godot/shader_cache");
+}
@@ -35,6 +35,7 @@
 #include "core/core_string_names.h"
 #include "core/crypto/crypto.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/frame_tracer.h"
 #include "core/extension/extension_api_dump.h"
 #include "core/extension/gdextension_interface_dump.gen.h"
 #include "core/extension/gdextension_manager.h"
@@ -212,10 +213,12 @@ static bool debug_avoidance = false;
 #endif
 static int frame_delay = 0;
 static bool disable_render_loop = false;
+static bool pipelined_render_frames = false;
 static int fixed_fps = -1;
 static MovieWriter *movie_writer = nullptr;
 static bool disable_vsync = false;
 static bool print_fps = false;
+static String trace_file;
 #ifdef TOOLS_ENABLED
 static bool dump_gdextension_interface = false;
 static bool dump_extension_api = false;
@@ -470,6 +473,7 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --fixed-fps <fps>                 Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	OS::get_singleton()->print("  --delta-smoothing <enable>        Enable or disable frame delta smoothing ['enable', 'disable'].\n");
 	OS::get_singleton()->print("  --print-fps                       Print the frames per second to the stdout.\n");
+	OS::get_singleton()->print("  --trace-file <path>               Record a timeline of the main loop, render thread, physics, navigation, worker threads and GPU passes, and save it to the given file in the Chrome trace JSON format when quitting (can be opened in Perfetto).\n");
 	OS::get_singleton()->print("\n");
 
 	OS::get_singleton()->print("Standalone tools:\n");
@@ -1419,6 +1423,15 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			disable_vsync = true;
 		} else if (I->get() == "--print-fps") {
 			print_fps = true;
+		} else if (I->get() == "--trace-file") {
+			if (I->next()) {
+				trace_file = I->next()->get();
+				FrameTracer::start();
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing <path> argument for --trace-file <path>.\n");
+				goto error;
+			}
 		} else if (I->get() == "--profile-gpu") {
 			profile_gpu = true;
 		} else if (I->get() == "--disable-crash-handler") {
@@ -1899,6 +1912,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		OS::get_singleton()->_render_thread_mode = OS::RenderThreadMode(rtm);
 	}
 
+	pipelined_render_frames = GLOBAL_DEF_RST("rendering/driver/threads/pipelined_frames", false);
+
 	/* Determine audio and video drivers */
 
 	// Display driver, e.g. X11, Wayland.
@@ -2287,7 +2302,7 @@ Error Main::setup2() {
 
 	/* Initialize Rendering Server */
 
-	rendering_server = memnew(RenderingServerDefault(OS::get_singleton()->get_render_thread_mode() == OS::RENDER_SEPARATE_THREAD));
+	rendering_server = memnew(RenderingServerDefault(OS::get_singleton()->get_render_thread_mode() == OS::RENDER_SEPARATE_THREAD, pipelined_render_frames));
 
 	rendering_server->init();
 	//rendering_server->call_set_use_vsync(OS::get_singleton()->_use_vsync);
@@ -3343,6 +3358,8 @@ static uint64_t process_max = 0;
 static uint64_t navigation_process_max = 0;
 
 bool Main::iteration() {
+	TRACE_ZONE("Main::iteration");
+
 	//for now do not error on this
 	//ERR_FAIL_COND_V(iterating, false);
 
@@ -3391,17 +3408,26 @@ bool Main::iteration() {
 			Input::get_singleton()->flush_buffered_events();
 		}
 
+		TRACE_ZONE("Physics Frame");
+
 		Engine::get_singleton()->_in_physics = true;
 
 		uint64_t physics_begin = OS::get_singleton()->get_ticks_usec();
 
+		OS::get_singleton()->get_main_loop()->iteration_prepare();
+
 		PhysicsServer3D::get_singleton()->sync();
 		PhysicsServer3D::get_singleton()->flush_queries();
 
 		PhysicsServer2D::get_singleton()->sync();
 		PhysicsServer2D::get_singleton()->flush_queries();
 
-		if (OS::get_singleton()->get_main_loop()->physics_process(physics_step * time_scale)) {
+		bool physics_exit = false;
+		{
+			TRACE_ZONE("MainLoop::physics_process");
+			physics_exit = OS::get_singleton()->get_main_loop()->physics_process(physics_step * time_scale);
+		}
+		if (physics_exit) {
 			PhysicsServer3D::get_singleton()->end_sync();
 			PhysicsServer2D::get_singleton()->end_sync();
 
@@ -3439,12 +3465,17 @@ bool Main::iteration() {
 
 	uint64_t process_begin = OS::get_singleton()->get_ticks_usec();
 
-	if (OS::get_singleton()->get_main_loop()->process(process_step * time_scale)) {
-		exit = true;
+	{
+		TRACE_ZONE("MainLoop::process");
+		if (OS::get_singleton()->get_main_loop()->process(process_step * time_scale)) {
+			exit = true;
+		}
+		message_queue->flush();
 	}
-	message_queue->flush();
 
-	RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
+	if (!RenderingServer::get_singleton()->is_draw_pipelined()) {
+		RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
+	}
 
 	if (DisplayServer::get_singleton()->can_any_window_draw() &&
 			RenderingServer::get_singleton()->is_render_loop_enabled()) {
@@ -3560,6 +3591,12 @@ void Main::cleanup(bool p_force) {
 		ERR_FAIL_COND(!_start_success);
 	}
 
+	if (!trace_file.is_empty()) {
+		FrameTracer::stop();
+		FrameTracer::save(trace_file);
+		trace_file = String();
+	}
+
 	for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
 		TextServerManager::get_singleton()->get_interface(i)->cleanup();
 	}
@@ -3696,6 +3733,8 @@ void Main::cleanup(bool p_force) {
 	uninitialize_modules(MODULE_INITIALIZATION_LEVEL_CORE);
 	unregister_core_types();
 
+	FrameTracer::finalize();
+
 	OS::get_singleton()->benchmark_end_measure("Main::cleanup");
 	OS::get_singleton()->benchmark_dump();
 
@@ -30,6 +30,7 @@
 
 #include "performance.h"
 
+#include "core/debugger/frame_tracer.h"
 #include "core/object/message_queue.h"
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
@@ -51,6 +52,10 @@ void Performance::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_custom_monitor", "id"), &Performance::get_custom_monitor);
 	ClassDB::bind_method(D_METHOD("get_monitor_modification_time"), &Performance::get_monitor_modification_time);
 	ClassDB::bind_method(D_METHOD("get_custom_monitor_names"), &Performance::get_custom_monitor_names);
+	ClassDB::bind_method(D_METHOD("start_trace"), &Performance::start_trace);
+	ClassDB::bind_method(D_METHOD("stop_trace"), &Performance::stop_trace);
+	ClassDB::bind_method(D_METHOD("is_tracing"), &Performance::is_tracing);
+	ClassDB::bind_method(D_METHOD("save_trace", "path"), &Performance::save_trace);
 
 	BIND_ENUM_CONSTANT(TIME_FPS);
 	BIND_ENUM_CONSTANT(TIME_PROCESS);
@@ -313,6 +318,22 @@ uint64_t Performance::get_monitor_modification_time() {
 	return _monitor_modification_time;
 }
 
+void Performance::start_trace() {
+	FrameTracer::start();
+}
+
+void Performance::stop_trace() {
+	FrameTracer::stop();
+}
+
+bool Performance::is_tracing() const {
+	return FrameTracer::is_tracing();
+}
+
+Error Performance::save_trace(const String &p_path) {
+	return FrameTracer::save(p_path);
+}
+
 Performance::Performance() {
 	_process_time = 0;
 	_physics_process_time = 0;
@@ -126,6 +126,11 @@ public:
 
 	uint64_t get_monitor_modification_time();
 
+	void start_trace();
+	void stop_trace();
+	bool is_tracing() const;
+	Error save_trace(const String &p_path);
+
 	static Performance *get_singleton() { return singleton; }
 
 	Performance();
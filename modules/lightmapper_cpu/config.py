@@ -0,0 +1,18 @@
+def can_build(env, platform):
+    # The raycaster (Embree) is only available in editor builds.
+    env.module_add_dependencies("lightmapper_cpu", ["raycast"])
+    return env.editor_build
+
+
+def configure(env):
+    pass
+
+
+def get_doc_classes():
+    return [
+        "LightmapperCPU",
+    ]
+
+
+def get_doc_path():
+    return "doc_classes"
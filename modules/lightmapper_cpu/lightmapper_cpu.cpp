@@ -0,0 +1,1388 @@
+/**************************************************************************/
+/*  lightmapper_cpu.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "lightmapper_cpu.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/math/geometry_2d.h"
+#include "core/object/worker_thread_pool.h"
+
+static const uint32_t CHECKPOINT_VERSION = 1;
+
+// Same random number generation as lm_compute.glsl, so both lightmappers trace the same rays.
+// https://www.reedbeta.com/blog/hash-functions-for-gpu-rendering/
+static _FORCE_INLINE_ uint32_t _lm_hash(uint32_t p_value) {
+	uint32_t state = p_value * 747796405u + 2891336453u;
+	uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+	return (word >> 22u) ^ word;
+}
+
+static _FORCE_INLINE_ uint32_t _lm_random_seed(uint32_t p_x, uint32_t p_y, uint32_t p_z) {
+	return _lm_hash(p_x ^ _lm_hash(p_y ^ _lm_hash(p_z)));
+}
+
+// Generates a random value in range [0.0, 1.0).
+static _FORCE_INLINE_ float _lm_randomize(uint32_t &r_value) {
+	r_value = _lm_hash(r_value);
+	return float(double(r_value) / 4294967296.0);
+}
+
+static _FORCE_INLINE_ Vector3 _lm_hemisphere_uniform_direction(uint32_t &r_noise) {
+	float noise1 = _lm_randomize(r_noise);
+	float noise2 = _lm_randomize(r_noise) * 2.0 * Math_PI;
+
+	float factor = Math::sqrt(1.0 - (noise1 * noise1));
+	return Vector3(factor * Math::cos(noise2), factor * Math::sin(noise2), noise1);
+}
+
+static _FORCE_INLINE_ Vector3 _lm_hemisphere_cosine_weighted_direction(uint32_t &r_noise) {
+	float noise1 = _lm_randomize(r_noise);
+	float noise2 = _lm_randomize(r_noise) * 2.0 * Math_PI;
+
+	return Vector3(Math::sqrt(noise1) * Math::cos(noise2), Math::sqrt(noise1) * Math::sin(noise2), Math::sqrt(1.0 - noise1));
+}
+
+static _FORCE_INLINE_ float _lm_omni_attenuation(float p_distance, float p_inv_range, float p_decay) {
+	float nd = p_distance * p_inv_range;
+	nd *= nd;
+	nd *= nd; // nd^4
+	nd = MAX(1.0 - nd, 0.0);
+	nd *= nd; // nd^2
+	return nd * Math::pow(MAX(p_distance, 0.0001f), -p_decay);
+}
+
+static _FORCE_INLINE_ void _lm_tangents(const Vector3 &p_normal, Vector3 &r_tangent, Vector3 &r_bitangent) {
+	Vector3 v0 = Math::abs(p_normal.z) < 0.999 ? Vector3(0.0, 0.0, 1.0) : Vector3(0.0, 1.0, 0.0);
+	r_tangent = v0.cross(p_normal).normalized();
+	r_bitangent = r_tangent.cross(p_normal).normalized();
+}
+
+static _FORCE_INLINE_ Color _lm_light(const Vector3 &p_light) {
+	return Color(p_light.x, p_light.y, p_light.z, 0.0);
+}
+
+void LightmapperCPU::add_mesh(const MeshData &p_mesh) {
+	ERR_FAIL_COND(p_mesh.albedo_on_uv2.is_null() || p_mesh.albedo_on_uv2->is_empty());
+	ERR_FAIL_COND(p_mesh.emission_on_uv2.is_null() || p_mesh.emission_on_uv2->is_empty());
+	ERR_FAIL_COND(p_mesh.albedo_on_uv2->get_width() != p_mesh.emission_on_uv2->get_width());
+	ERR_FAIL_COND(p_mesh.albedo_on_uv2->get_height() != p_mesh.emission_on_uv2->get_height());
+	ERR_FAIL_COND(p_mesh.points.size() == 0);
+	ERR_FAIL_COND(p_mesh.uv2.size() != p_mesh.points.size() || p_mesh.normal.size() != p_mesh.points.size());
+	MeshInstance mi;
+	mi.data = p_mesh;
+	mi.size = p_mesh.albedo_on_uv2->get_size();
+	mesh_instances.push_back(mi);
+}
+
+void LightmapperCPU::add_directional_light(bool p_static, const Vector3 &p_direction, const Color &p_color, float p_energy, float p_angular_distance, float p_shadow_blur) {
+	Light l;
+	l.type = LIGHT_TYPE_DIRECTIONAL;
+	l.direction = p_direction;
+	l.color = Vector3(p_color.r, p_color.g, p_color.b);
+	l.energy = p_energy;
+	l.static_bake = p_static;
+	l.size = Math::tan(Math::deg_to_rad(p_angular_distance));
+	l.shadow_blur = p_shadow_blur;
+	lights.push_back(l);
+}
+
+void LightmapperCPU::add_omni_light(bool p_static, const Vector3 &p_position, const Color &p_color, float p_energy, float p_range, float p_attenuation, float p_size, float p_shadow_blur) {
+	Light l;
+	l.type = LIGHT_TYPE_OMNI;
+	l.position = p_position;
+	l.range = p_range;
+	l.attenuation = p_attenuation;
+	l.color = Vector3(p_color.r, p_color.g, p_color.b);
+	l.energy = p_energy;
+	l.static_bake = p_static;
+	l.size = p_size;
+	l.shadow_blur = p_shadow_blur;
+	lights.push_back(l);
+}
+
+void LightmapperCPU::add_spot_light(bool p_static, const Vector3 &p_position, const Vector3 p_direction, const Color &p_color, float p_energy, float p_range, float p_attenuation, float p_spot_angle, float p_spot_attenuation, float p_size, float p_shadow_blur) {
+	Light l;
+	l.type = LIGHT_TYPE_SPOT;
+	l.position = p_position;
+	l.direction = p_direction;
+	l.range = p_range;
+	l.attenuation = p_attenuation;
+	l.cos_spot_angle = Math::cos(Math::deg_to_rad(p_spot_angle));
+	l.inv_spot_attenuation = 1.0f / p_spot_attenuation;
+	l.color = Vector3(p_color.r, p_color.g, p_color.b);
+	l.energy = p_energy;
+	l.static_bake = p_static;
+	l.size = p_size;
+	l.shadow_blur = p_shadow_blur;
+	lights.push_back(l);
+}
+
+void LightmapperCPU::add_probe(const Vector3 &p_position) {
+	probe_positions.push_back(p_position);
+}
+
+Lightmapper::BakeError LightmapperCPU::_blit_meshes_into_atlas(int p_max_texture_size, BakeStepFunc p_step_function, void *p_bake_userdata) {
+	// Same packing as LightmapperRD, so both produce the same atlas layout.
+	Vector<Size2i> sizes;
+	atlas_size = Size2i();
+
+	for (int m_i = 0; m_i < mesh_instances.size(); m_i++) {
+		const Size2i &s = mesh_instances[m_i].size;
+		sizes.push_back(s);
+		atlas_size.width = MAX(atlas_size.width, s.width + 2);
+		atlas_size.height = MAX(atlas_size.height, s.height + 2);
+	}
+
+	int max = nearest_power_of_2_templated(atlas_size.width);
+	max = MAX(max, nearest_power_of_2_templated(atlas_size.height));
+
+	if (max > p_max_texture_size) {
+		return BAKE_ERROR_LIGHTMAP_TOO_SMALL;
+	}
+
+	if (p_step_function) {
+		p_step_function(0.1, RTR("Determining optimal atlas size"), p_bake_userdata, true);
+	}
+
+	atlas_size = Size2i(max, max);
+
+	Size2i best_atlas_size;
+	int best_atlas_slices = 0;
+	int best_atlas_memory = 0x7FFFFFFF;
+	Vector<Vector3i> best_atlas_offsets;
+
+	// Determine best texture array atlas size by bruteforce fitting.
+	while (atlas_size.x <= p_max_texture_size && atlas_size.y <= p_max_texture_size) {
+		Vector<Vector2i> source_sizes;
+		Vector<int> source_indices;
+		source_sizes.resize(sizes.size());
+		source_indices.resize(sizes.size());
+		for (int i = 0; i < source_indices.size(); i++) {
+			source_sizes.write[i] = sizes[i] + Vector2i(2, 2); // Add padding between lightmaps.
+			source_indices.write[i] = i;
+		}
+		Vector<Vector3i> atlas_offsets;
+		atlas_offsets.resize(source_sizes.size());
+
+		int slices = 0;
+
+		while (source_sizes.size() > 0) {
+			Vector<Vector3i> offsets = Geometry2D::partial_pack_rects(source_sizes, atlas_size);
+			Vector<int> new_indices;
+			Vector<Vector2i> new_sources;
+			for (int i = 0; i < offsets.size(); i++) {
+				Vector3i ofs = offsets[i];
+				int sidx = source_indices[i];
+				if (ofs.z > 0) {
+					ofs.z = slices;
+					atlas_offsets.write[sidx] = ofs + Vector3i(1, 1, 0); // Center lightmap in the reserved oversized region.
+				} else {
+					new_indices.push_back(sidx);
+					new_sources.push_back(source_sizes[i]);
+				}
+			}
+
+			source_sizes = new_sources;
+			source_indices = new_indices;
+			slices++;
+		}
+
+		int mem_used = atlas_size.x * atlas_size.y * slices;
+		if (mem_used < best_atlas_memory) {
+			best_atlas_size = atlas_size;
+			best_atlas_offsets = atlas_offsets;
+			best_atlas_slices = slices;
+			best_atlas_memory = mem_used;
+		}
+
+		if (atlas_size.width == atlas_size.height) {
+			atlas_size.width *= 2;
+		} else {
+			atlas_size.height *= 2;
+		}
+	}
+	atlas_size = best_atlas_size;
+	atlas_slices = best_atlas_slices;
+
+	for (int m_i = 0; m_i < mesh_instances.size(); m_i++) {
+		MeshInstance &mi = mesh_instances.write[m_i];
+		mi.offset.x = best_atlas_offsets[m_i].x;
+		mi.offset.y = best_atlas_offsets[m_i].y;
+		mi.slice = best_atlas_offsets[m_i].z;
+	}
+
+	return BAKE_OK;
+}
+
+void LightmapperCPU::_create_seams() {
+	struct EdgeUV2 {
+		Vector2 a;
+		Vector2 b;
+		bool seam_found = false;
+	};
+
+	seams.clear();
+
+	for (int m_i = 0; m_i < mesh_instances.size(); m_i++) {
+		const MeshInstance &mi = mesh_instances[m_i];
+		const Vector3 *points = mi.data.points.ptr();
+		const Vector3 *normals = mi.data.normal.ptr();
+		const Vector2 *uvs = mi.data.uv2.ptr();
+		const Vector2 uv_scale = Vector2(mi.size);
+		const Vector2 uv_offset = Vector2(mi.offset) - Vector2(0.5, 0.5);
+
+		HashMap<EdgeKey, EdgeUV2, EdgeKey> edges;
+
+		for (int i = 0; i < mi.data.points.size(); i += 3) {
+			for (int k = 0; k < 3; k++) {
+				int a = i + k;
+				int b = i + (k + 1) % 3;
+
+				EdgeKey edge = { points[a], points[b], normals[a], normals[b] };
+				EdgeUV2 uv2 = { uvs[a] * uv_scale + uv_offset, uvs[b] * uv_scale + uv_offset };
+
+				if (edge.b == edge.a) {
+					continue; // Degenerate.
+				}
+				if (edge.b < edge.a) {
+					SWAP(edge.a, edge.b);
+					SWAP(edge.na, edge.nb);
+					SWAP(uv2.a, uv2.b);
+				}
+
+				EdgeUV2 *euv2 = edges.getptr(edge);
+				if (!euv2) {
+					edges.insert(edge, uv2);
+					continue;
+				}
+				if ((euv2->a == uv2.a && euv2->b == uv2.b) || euv2->seam_found) {
+					continue; // Shared UV space (no need to blend), or bad geometry.
+				}
+
+				Seam seam;
+				seam.a[0] = uv2.a;
+				seam.a[1] = uv2.b;
+				seam.b[0] = euv2->a;
+				seam.b[1] = euv2->b;
+				seam.slice = mi.slice;
+				seams.push_back(seam);
+				euv2->seam_found = true;
+			}
+		}
+	}
+}
+
+uint32_t LightmapperCPU::_compute_bake_hash() const {
+	uint32_t h = hash_murmur3_one_32(CHECKPOINT_VERSION);
+
+	for (int m_i = 0; m_i < mesh_instances.size(); m_i++) {
+		const MeshInstance &mi = mesh_instances[m_i];
+		h = hash_murmur3_buffer(mi.data.points.ptr(), mi.data.points.size() * sizeof(Vector3), h);
+		h = hash_murmur3_buffer(mi.data.normal.ptr(), mi.data.normal.size() * sizeof(Vector3), h);
+		h = hash_murmur3_buffer(mi.data.uv2.ptr(), mi.data.uv2.size() * sizeof(Vector2), h);
+		Vector<uint8_t> data = mi.data.albedo_on_uv2->get_data();
+		h = hash_murmur3_buffer(data.ptr(), data.size(), h);
+		data = mi.data.emission_on_uv2->get_data();
+		h = hash_murmur3_buffer(data.ptr(), data.size(), h);
+		h = hash_murmur3_one_32(mi.slice, h);
+		h = hash_murmur3_one_32(mi.offset.x, h);
+		h = hash_murmur3_one_32(mi.offset.y, h);
+	}
+
+	for (int i = 0; i < lights.size(); i++) {
+		const Light &l = lights[i];
+		h = hash_murmur3_one_32(l.type, h);
+		h = hash_murmur3_one_32(l.static_bake, h);
+		const float values[] = { (float)l.position.x, (float)l.position.y, (float)l.position.z, (float)l.direction.x, (float)l.direction.y, (float)l.direction.z, (float)l.color.x, (float)l.color.y, (float)l.color.z, l.energy, l.size, l.range, l.attenuation, l.cos_spot_angle, l.inv_spot_attenuation, l.shadow_blur };
+		for (const float value : values) {
+			h = hash_murmur3_one_float(value, h);
+		}
+	}
+
+	h = hash_murmur3_one_32(atlas_size.width, h);
+	h = hash_murmur3_one_32(atlas_size.height, h);
+	h = hash_murmur3_one_32(atlas_slices, h);
+	h = hash_murmur3_one_32(bake_sh, h);
+	h = hash_murmur3_one_32(ray_count, h);
+	h = hash_murmur3_one_float(bias, h);
+	h = hash_murmur3_one_float(exposure_normalization, h);
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			h = hash_murmur3_one_real(environment_transform.rows[i][j], h);
+		}
+	}
+	h = hash_murmur3_buffer(environment.ptr(), environment.size() * sizeof(Color), h);
+
+	return hash_fmix32(h);
+}
+
+void LightmapperCPU::_raster_texel(Texel &r_texel, const Vector3 *p_points, const Vector3 *p_normals, const Vector3 &p_face_normal, float p_texel_size, bool p_smooth, const Vector3 &p_barycentric) {
+	Vector3 vertex_pos = p_points[0] * p_barycentric.x + p_points[1] * p_barycentric.y + p_points[2] * p_barycentric.z;
+
+	if (p_smooth) {
+		// Smooth out vertex position by interpolating its projection in the 3 normal planes (normal plane is created by vertex pos and normal),
+		// because we don't want to interpolate inwards, normals found pointing inwards are pushed out.
+		Vector3 center = (p_points[0] + p_points[1] + p_points[2]) * 0.3333333;
+		Vector3 smooth_position;
+		for (int k = 0; k < 3; k++) {
+			Vector3 norm = p_normals[k];
+			Vector3 dir = (p_points[k] - center).normalized();
+			float d = dir.dot(norm);
+			if (d < 0) {
+				norm = (norm - dir * d).normalized(); // Pointing inwards.
+			}
+			float plane_d = norm.dot(p_points[k]);
+			smooth_position += (vertex_pos - norm * (norm.dot(vertex_pos) - plane_d)) * p_barycentric[k];
+		}
+
+		if (p_face_normal.dot(smooth_position) > p_face_normal.dot(vertex_pos)) { // Only project outwards.
+			vertex_pos = smooth_position;
+		}
+	}
+
+	r_texel.position = vertex_pos;
+	r_texel.normal = (p_normals[0] * p_barycentric.x + p_normals[1] * p_barycentric.y + p_normals[2] * p_barycentric.z).normalized();
+	r_texel.face_normal = p_face_normal;
+	r_texel.texel_size = p_texel_size;
+	r_texel.valid = true;
+}
+
+void LightmapperCPU::_raster_mesh(uint32_t p_mesh, void *p_userdata) {
+	const MeshInstance &mi = mesh_instances[p_mesh];
+
+	// Copy albedo and emission into the atlas. Meshes never overlap, so this is safe to do in parallel.
+	for (int y = 0; y < mi.size.height; y++) {
+		for (int x = 0; x < mi.size.width; x++) {
+			uint32_t ofs = _get_texel_index(mi.slice, mi.offset.x + x, mi.offset.y + y);
+			albedo[ofs] = mi.data.albedo_on_uv2->get_pixel(x, y);
+			emission[ofs] = mi.data.emission_on_uv2->get_pixel(x, y);
+		}
+	}
+
+	const Vector3 *points = mi.data.points.ptr();
+	const Vector3 *normals = mi.data.normal.ptr();
+	const Vector2 *uvs = mi.data.uv2.ptr();
+	const Vector2 uv_scale = Vector2(mi.size);
+	// Half pixel offset (same as LightmapperRD), so face edges aren't directly aligned into texel centers.
+	// See <https://github.com/godotengine/godot/issues/69126>.
+	const Vector2 uv_offset = Vector2(mi.offset) - Vector2(0.5, 0.5);
+
+	// The first pass fills the texels whose center lies inside a triangle, the second one walks the triangle
+	// edges to also cover texels touched by triangles which are too thin to contain any texel center.
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 0; i < mi.data.points.size(); i += 3) {
+			const Vector3 *p = &points[i];
+			const Vector3 *n = &normals[i];
+			const Vector2 s[3] = { uvs[i] * uv_scale + uv_offset, uvs[i + 1] * uv_scale + uv_offset, uvs[i + 2] * uv_scale + uv_offset };
+
+			const Vector2 e1 = s[1] - s[0];
+			const Vector2 e2 = s[2] - s[0];
+			const real_t det = e1.cross(e2);
+			if (Math::is_zero_approx(det)) {
+				continue; // Degenerate in UV space.
+			}
+			const real_t inv_det = 1.0 / det;
+
+			Vector3 face_normal = -(p[0] - p[1]).cross(p[0] - p[2]).normalized();
+
+			// Unocclusion technique based on:
+			// https://ndotl.wordpress.com/2018/08/29/baking-artifact-free-lightmaps/
+			Vector3 dp_dx = (p[1] - p[0]) * (e2.y * inv_det) - (p[2] - p[0]) * (e1.y * inv_det);
+			Vector3 dp_dy = (p[2] - p[0]) * (e1.x * inv_det) - (p[1] - p[0]) * (e2.x * inv_det);
+			Vector3 delta = Vector3(MAX(Math::abs(dp_dx.x), Math::abs(dp_dy.x)), MAX(Math::abs(dp_dx.y), Math::abs(dp_dy.y)), MAX(Math::abs(dp_dx.z), Math::abs(dp_dy.z)));
+			float texel_size = MAX(delta.x, MAX(delta.y, delta.z)) * Math_SQRT2; // Expand to unit box edge length (worst case).
+
+			const float FLAT_THRESHOLD = 0.99;
+			bool smooth = n[0].dot(n[1]) < FLAT_THRESHOLD || n[0].dot(n[2]) < FLAT_THRESHOLD || n[1].dot(n[2]) < FLAT_THRESHOLD;
+
+			if (pass == 0) {
+				Rect2 rect(s[0], Vector2());
+				rect.expand_to(s[1]);
+				rect.expand_to(s[2]);
+				int from_x = MAX(0, int(Math::ceil(rect.position.x - 0.5)));
+				int from_y = MAX(0, int(Math::ceil(rect.position.y - 0.5)));
+				int to_x = MIN(atlas_size.width - 1, int(Math::floor(rect.position.x + rect.size.x - 0.5)));
+				int to_y = MIN(atlas_size.height - 1, int(Math::floor(rect.position.y + rect.size.y - 0.5)));
+
+				for (int y = from_y; y <= to_y; y++) {
+					for (int x = from_x; x <= to_x; x++) {
+						Texel &texel = texels[_get_texel_index(mi.slice, x, y)];
+						if (texel.valid) {
+							continue; // The first triangle rasterized wins.
+						}
+						Vector2 d = Vector2(x + 0.5, y + 0.5) - s[0];
+						real_t b1 = d.cross(e2) * inv_det;
+						real_t b2 = e1.cross(d) * inv_det;
+						real_t b0 = 1.0 - b1 - b2;
+						if (b0 < 0.0 || b1 < 0.0 || b2 < 0.0) {
+							continue;
+						}
+						_raster_texel(texel, p, n, face_normal, texel_size, smooth, Vector3(b0, b1, b2));
+					}
+				}
+			} else {
+				for (int k = 0; k < 3; k++) {
+					int next = (k + 1) % 3;
+					int steps = MAX(1, int(Math::ceil(s[k].distance_to(s[next]) * 2.0)));
+					for (int j = 0; j <= steps; j++) {
+						real_t t = real_t(j) / steps;
+						Vector2 pos = s[k].lerp(s[next], t);
+						int x = int(Math::floor(pos.x));
+						int y = int(Math::floor(pos.y));
+						if (x < 0 || y < 0 || x >= atlas_size.width || y >= atlas_size.height) {
+							continue;
+						}
+						Texel &texel = texels[_get_texel_index(mi.slice, x, y)];
+						if (texel.valid) {
+							continue;
+						}
+						Vector3 barycentric;
+						barycentric[k] = 1.0 - t;
+						barycentric[next] = t;
+						_raster_texel(texel, p, n, face_normal, texel_size, smooth, barycentric);
+					}
+				}
+			}
+		}
+	}
+}
+
+void LightmapperCPU::_get_tile(uint32_t p_tile, int &r_layer, Rect2i &r_rect) const {
+	int tiles_per_layer = tiles_x * tiles_y;
+	r_layer = p_tile / tiles_per_layer;
+	int tile = p_tile % tiles_per_layer;
+	r_rect.position = Vector2i(tile % tiles_x, tile / tiles_x) * TILE_SIZE;
+	r_rect.size = Vector2i(MIN(TILE_SIZE, atlas_size.width - r_rect.position.x), MIN(TILE_SIZE, atlas_size.height - r_rect.position.y));
+}
+
+LightmapperCPU::RayResult LightmapperCPU::_trace_ray(const Vector3 &p_from, const Vector3 &p_to, uint32_t *r_mesh, Vector2 *r_uv, float *r_distance, Vector3 *r_normal) {
+	Vector3 rel = p_to - p_from;
+	float rel_len = rel.length();
+	if (rel_len <= bias) {
+		return RAY_MISS;
+	}
+	Vector3 dir = rel / rel_len;
+
+	LightmapRaycaster::Ray ray(p_from, dir, bias, rel_len);
+	if (!raycaster->intersect(ray)) {
+		return RAY_MISS;
+	}
+
+	// The raycaster interpolates the vertex normals, but backfaces are detected with the face normal (like the GPU tracer).
+	const Vector3 *points = &mesh_instances[ray.geomID].data.points[ray.primID * 3];
+	Vector3 normal = -(points[0] - points[1]).cross(points[0] - points[2]).normalized();
+
+	if (r_mesh) {
+		*r_mesh = ray.geomID;
+	}
+	if (r_uv) {
+		*r_uv = Vector2(ray.u, ray.v);
+	}
+	if (r_distance) {
+		*r_distance = ray.tfar;
+	}
+	if (r_normal) {
+		*r_normal = normal;
+	}
+
+	return normal.dot(dir) >= 0.0 ? RAY_BACK : RAY_FRONT;
+}
+
+Color LightmapperCPU::_sample_light(const LocalVector<Color> &p_light, uint32_t p_mesh, const Vector2 &p_uv) const {
+	// Bilinear sampling, like the linear sampler used by the GPU tracer.
+	const MeshInstance &mi = mesh_instances[p_mesh];
+	Vector2 pos = p_uv * Vector2(mi.size) + Vector2(mi.offset) - Vector2(0.5, 0.5);
+	int x = int(Math::floor(pos.x));
+	int y = int(Math::floor(pos.y));
+	float fx = pos.x - x;
+	float fy = pos.y - y;
+
+	int x0 = CLAMP(x, 0, atlas_size.width - 1);
+	int x1 = CLAMP(x + 1, 0, atlas_size.width - 1);
+	int y0 = CLAMP(y, 0, atlas_size.height - 1);
+	int y1 = CLAMP(y + 1, 0, atlas_size.height - 1);
+
+	Color top = p_light[_get_texel_index(mi.slice, x0, y0)].lerp(p_light[_get_texel_index(mi.slice, x1, y0)], fx);
+	Color bottom = p_light[_get_texel_index(mi.slice, x0, y1)].lerp(p_light[_get_texel_index(mi.slice, x1, y1)], fx);
+	return top.lerp(bottom, fy);
+}
+
+Color LightmapperCPU::_sample_environment(const Vector3 &p_dir) const {
+	if (environment.is_empty()) {
+		return Color();
+	}
+
+	Vector3 sky_dir = environment_transform.xform(p_dir).normalized();
+	Vector2 st = Vector2(Math::atan2(sky_dir.x, sky_dir.z), Math::acos(CLAMP(sky_dir.y, -1.0, 1.0)));
+	if (st.x < 0.0) {
+		st.x += Math_TAU;
+	}
+	st /= Vector2(Math_TAU, Math_PI);
+
+	Vector2 pos = st * Vector2(environment_size) - Vector2(0.5, 0.5);
+	int x = int(Math::floor(pos.x));
+	int y = int(Math::floor(pos.y));
+	float fx = pos.x - x;
+	float fy = pos.y - y;
+
+	int x0 = Math::posmod(x, environment_size.width);
+	int x1 = Math::posmod(x + 1, environment_size.width);
+	int y0 = CLAMP(y, 0, environment_size.height - 1);
+	int y1 = CLAMP(y + 1, 0, environment_size.height - 1);
+
+	Color top = environment[y0 * environment_size.width + x0].lerp(environment[y0 * environment_size.width + x1], fx);
+	Color bottom = environment[y1 * environment_size.width + x0].lerp(environment[y1 * environment_size.width + x1], fx);
+	return top.lerp(bottom, fy);
+}
+
+void LightmapperCPU::_unocclude_tile(uint32_t p_tile, void *p_userdata) {
+	int slice;
+	Rect2i rect;
+	_get_tile(p_tile, slice, rect);
+
+	for (int y = rect.position.y; y < rect.position.y + rect.size.y; y++) {
+		for (int x = rect.position.x; x < rect.position.x + rect.size.x; x++) {
+			Texel &texel = texels[_get_texel_index(slice, x, y)];
+			if (!texel.valid) {
+				continue;
+			}
+
+			Vector3 tangent;
+			Vector3 bitangent;
+			_lm_tangents(texel.face_normal, tangent, bitangent);
+			Vector3 base_pos = texel.position + texel.face_normal * bias; // Raise a bit.
+			Vector3 vertex_pos = texel.position;
+
+			const Vector3 rays[4] = { tangent, bitangent, -tangent, -bitangent };
+			float min_d = 1e20;
+			for (int i = 0; i < 4; i++) {
+				float d;
+				Vector3 norm;
+				if (_trace_ray(base_pos, base_pos + rays[i] * texel.texel_size, nullptr, nullptr, &d, &norm) == RAY_BACK) {
+					if (d < min_d) {
+						// This bias needs to be greater than the regular bias, because otherwise later, rays will go the other side when pointing back.
+						vertex_pos = base_pos + rays[i] * d + norm * bias * 10.0;
+						min_d = d;
+					}
+				}
+			}
+
+			texel.position = vertex_pos;
+		}
+	}
+}
+
+void LightmapperCPU::_direct_light_tile(uint32_t p_tile, void *p_userdata) {
+	int slice;
+	Rect2i rect;
+	_get_tile(p_tile, slice, rect);
+
+	for (int y = rect.position.y; y < rect.position.y + rect.size.y; y++) {
+		for (int x = rect.position.x; x < rect.position.x + rect.size.x; x++) {
+			uint32_t ofs = _get_texel_index(slice, x, y);
+			const Texel &texel = texels[ofs];
+			if (!texel.valid) {
+				continue;
+			}
+			const Vector3 &position = texel.position;
+			const Vector3 &normal = texel.normal;
+
+			Vector3 static_light;
+			Vector3 dynamic_light;
+			Vector3 sh_accum[4];
+
+			for (int i = 0; i < lights.size(); i++) {
+				const Light &light = lights[i];
+				Vector3 light_pos;
+				float dist;
+				float attenuation;
+				float soft_shadowing_disk_size;
+				if (light.type == LIGHT_TYPE_DIRECTIONAL) {
+					light_pos = position - light.direction * world_size;
+					dist = world_size;
+					attenuation = 1.0;
+					soft_shadowing_disk_size = light.size;
+				} else {
+					light_pos = light.position;
+					dist = position.distance_to(light_pos);
+					if (dist > light.range) {
+						continue;
+					}
+					soft_shadowing_disk_size = light.size / dist;
+
+					attenuation = _lm_omni_attenuation(dist, 1.0 / light.range, light.attenuation);
+
+					if (light.type == LIGHT_TYPE_SPOT) {
+						Vector3 rel = (position - light_pos).normalized();
+						float cos_angle = rel.dot(light.direction);
+						if (cos_angle < light.cos_spot_angle) {
+							continue; // Invisible, don't try.
+						}
+
+						float scos = MAX(cos_angle, light.cos_spot_angle);
+						float spot_rim = MAX(0.0001f, (1.0f - scos) / (1.0f - light.cos_spot_angle));
+						attenuation *= 1.0 - Math::pow(spot_rim, light.inv_spot_attenuation);
+					}
+				}
+
+				Vector3 light_dir = (light_pos - position).normalized();
+				attenuation *= MAX(0.0f, (float)normal.dot(light_dir));
+
+				if (attenuation <= 0.0001) {
+					continue; // No need to do anything.
+				}
+
+				float penumbra = 0.0;
+				if (light.size > 0.0) {
+					Vector3 light_to_point = -light_dir;
+					Vector3 aux = light_to_point.y < 0.777 ? Vector3(0.0, 1.0, 0.0) : Vector3(1.0, 0.0, 0.0);
+					Vector3 light_to_point_tan = light_to_point.cross(aux).normalized();
+					Vector3 light_to_point_bitan = light_to_point.cross(light_to_point_tan).normalized();
+
+					const uint32_t shadowing_rays_check_penumbra_denom = 2;
+					uint32_t shadowing_ray_count = ray_count;
+
+					uint32_t hits = 0;
+					uint32_t noise = _lm_random_seed(x, y, 43573547 /* some prime */);
+					for (uint32_t j = 0; j < shadowing_ray_count; j++) {
+						// Once already traced an important proportion of rays, if all are hits or misses,
+						// assume we're not in the penumbra so we can infer the rest would have the same result.
+						if (j == shadowing_ray_count / shadowing_rays_check_penumbra_denom) {
+							if (hits == j) {
+								hits = shadowing_ray_count; // Assume totally lit.
+								break;
+							} else if (hits == 0) {
+								break; // Assume totally dark.
+							}
+						}
+
+						float r = _lm_randomize(noise);
+						float a = _lm_randomize(noise) * 2.0 * Math_PI;
+						Vector2 disk_sample = Vector2(Math::cos(a), Math::sin(a)) * r * soft_shadowing_disk_size * light.shadow_blur;
+						Vector3 light_disk_to_point = (light_to_point + disk_sample.x * light_to_point_tan + disk_sample.y * light_to_point_bitan).normalized();
+
+						if (_trace_ray(position - light_disk_to_point * bias, position - light_disk_to_point * dist) == RAY_MISS) {
+							hits++;
+						}
+					}
+					penumbra = float(hits) / float(shadowing_ray_count);
+				} else {
+					if (_trace_ray(position + light_dir * bias, light_pos) == RAY_MISS) {
+						penumbra = 1.0;
+					}
+				}
+
+				Vector3 light_color = light.color * light.energy * attenuation * penumbra;
+				if (light.static_bake) {
+					static_light += light_color;
+					if (bake_sh) {
+						const float c[4] = {
+							0.282095f, // l0
+							0.488603f * (float)light_dir.y, // l1n1
+							0.488603f * (float)light_dir.z, // l1n0
+							0.488603f * (float)light_dir.x // l1p1
+						};
+						for (int j = 0; j < 4; j++) {
+							sh_accum[j] += light_color * c[j] * (1.0 / 3.0);
+						}
+					}
+				} else {
+					dynamic_light += light_color;
+				}
+			}
+
+			const Vector3 texel_albedo = Vector3(albedo[ofs].r, albedo[ofs].g, albedo[ofs].b);
+			const Vector3 texel_emission = Vector3(emission[ofs].r, emission[ofs].g, emission[ofs].b);
+
+			dynamic_light *= texel_albedo; // If it will bounce, must multiply by albedo.
+			dynamic_light += texel_emission;
+
+			// Keep for lightprobes.
+			light_primary_dynamic[ofs] = _lm_light(dynamic_light);
+			light_primary_dynamic[ofs].a = 1.0;
+
+			dynamic_light += static_light * texel_albedo; // Send for bounces.
+			dynamic_light *= exposure_normalization;
+			light_source[ofs] = _lm_light(dynamic_light);
+			light_source[ofs].a = 1.0;
+
+			if (bake_sh) {
+				// Keep for adding at the end.
+				for (int j = 0; j < 4; j++) {
+					Color &accum = light_accum[_get_texel_index(slice * 4 + j, x, y)];
+					accum = _lm_light(sh_accum[j]);
+					accum.a = 1.0;
+				}
+			} else {
+				static_light *= exposure_normalization;
+				light_accum[ofs] = _lm_light(static_light);
+				light_accum[ofs].a = 1.0;
+			}
+		}
+	}
+}
+
+void LightmapperCPU::_bounce_light_tile(uint32_t p_tile, const BouncePass *p_pass) {
+	int slice;
+	Rect2i rect;
+	_get_tile(p_tile, slice, rect);
+
+	for (int y = rect.position.y; y < rect.position.y + rect.size.y; y++) {
+		for (int x = rect.position.x; x < rect.position.x + rect.size.x; x++) {
+			uint32_t ofs = _get_texel_index(slice, x, y);
+			const Texel &texel = texels[ofs];
+			if (!texel.valid) {
+				continue;
+			}
+			const Vector3 &position = texel.position;
+			const Vector3 &normal = texel.normal;
+
+			Vector3 tangent;
+			Vector3 bitangent;
+			_lm_tangents(normal, tangent, bitangent);
+
+			Vector3 sh_accum[4];
+			Color light_average;
+			float active_rays = 0.0;
+			uint32_t noise = _lm_random_seed(p_pass->ray_from, x, y);
+			for (uint32_t i = p_pass->ray_from; i < p_pass->ray_to; i++) {
+				Vector3 d = _lm_hemisphere_cosine_weighted_direction(noise);
+				Vector3 ray_dir = tangent * d.x + bitangent * d.y + normal * d.z;
+
+				uint32_t mesh = 0;
+				Vector2 uv;
+				Color light;
+				RayResult trace_result = _trace_ray(position + ray_dir * bias, position + ray_dir * world_size, &mesh, &uv);
+				if (trace_result == RAY_FRONT) {
+					light = _sample_light(*p_pass->source_light, mesh, uv);
+					active_rays += 1.0;
+				} else if (trace_result == RAY_MISS) {
+					if (p_pass->use_environment) {
+						// Did not hit a triangle, reach out for the sky.
+						light = _sample_environment(ray_dir);
+					}
+					active_rays += 1.0;
+				}
+
+				light_average += Color(light.r, light.g, light.b, 0.0);
+
+				if (bake_sh) {
+					const float c[4] = {
+						0.282095f, // l0
+						0.488603f * (float)ray_dir.y, // l1n1
+						0.488603f * (float)ray_dir.z, // l1n0
+						0.488603f * (float)ray_dir.x // l1p1
+					};
+					for (int j = 0; j < 4; j++) {
+						sh_accum[j] += Vector3(light.r, light.g, light.b) * c[j] * (8.0 / float(ray_count));
+					}
+				}
+			}
+
+			Color light_total;
+			if (p_pass->ray_from > 0) {
+				light_total = Color(bounce_accum[ofs].r, bounce_accum[ofs].g, bounce_accum[ofs].b, 0.0);
+				active_rays += bounce_accum[ofs].a;
+			}
+
+			light_total += light_average;
+
+			if (bake_sh) {
+				for (int j = 0; j < 4; j++) {
+					light_accum[_get_texel_index(slice * 4 + j, x, y)] += _lm_light(sh_accum[j]);
+				}
+			}
+
+			if (p_pass->ray_to == ray_count) {
+				if (active_rays > 0) {
+					light_total /= active_rays;
+				}
+				light_total.a = 1.0;
+				(*p_pass->dest_light)[ofs] = light_total;
+				if (!bake_sh) {
+					light_accum[ofs] += Color(light_total.r, light_total.g, light_total.b, 0.0);
+				}
+			} else {
+				light_total.a = active_rays;
+				bounce_accum[ofs] = light_total;
+			}
+		}
+	}
+}
+
+void LightmapperCPU::_light_probe(uint32_t p_probe, const ProbePass *p_pass) {
+	const Vector3 &position = probe_positions[p_probe];
+	Color *probe_sh_accum = &probe_accum[p_probe * 9];
+
+	uint32_t noise = _lm_random_seed(p_pass->ray_from, p_probe, 49502741 /* some prime */);
+	for (uint32_t i = p_pass->ray_from; i < p_pass->ray_to; i++) {
+		Vector3 ray_dir = _lm_hemisphere_uniform_direction(noise);
+		if (i & 1) {
+			ray_dir.z *= -1.0; // Throw to both sides, so alternate them.
+		}
+
+		uint32_t mesh = 0;
+		Vector2 uv;
+		Color light;
+		RayResult trace_result = _trace_ray(position + ray_dir * bias, position + ray_dir * world_size, &mesh, &uv);
+		if (trace_result == RAY_FRONT) {
+			light = _sample_light(*p_pass->source_light, mesh, uv);
+			light += _sample_light(light_primary_dynamic, mesh, uv);
+		} else if (trace_result == RAY_MISS) {
+			light = _sample_environment(ray_dir); // Did not hit a triangle, reach out for the sky.
+		}
+		light.a = 0.0;
+
+		const float c[9] = {
+			0.282095f, // l0
+			0.488603f * (float)ray_dir.y, // l1n1
+			0.488603f * (float)ray_dir.z, // l1n0
+			0.488603f * (float)ray_dir.x, // l1p1
+			1.092548f * (float)(ray_dir.x * ray_dir.y), // l2n2
+			1.092548f * (float)(ray_dir.y * ray_dir.z), // l2n1
+			0.315392f * (float)(3.0 * ray_dir.z * ray_dir.z - 1.0), // l20
+			1.092548f * (float)(ray_dir.x * ray_dir.z), // l2p1
+			0.546274f * (float)(ray_dir.x * ray_dir.x - ray_dir.y * ray_dir.y) // l2p2
+		};
+
+		for (int j = 0; j < 9; j++) {
+			probe_sh_accum[j] += light * c[j];
+		}
+	}
+
+	if (p_pass->ray_to == p_pass->ray_count) {
+		for (int j = 0; j < 9; j++) {
+			probe_sh_accum[j] *= 4.0 / float(p_pass->ray_count);
+		}
+	}
+}
+
+void LightmapperCPU::_dilate_tile(uint32_t p_tile, const DilatePass *p_pass) {
+	// Sides first, as they are closer, then endpoints, far sides, far-mid endpoints and far endpoints.
+	static const Vector2i offsets[25] = {
+		Vector2i(0, 0),
+		Vector2i(-1, 0), Vector2i(0, 1), Vector2i(1, 0), Vector2i(0, -1),
+		Vector2i(-1, -1), Vector2i(-1, 1), Vector2i(1, -1), Vector2i(1, 1),
+		Vector2i(-2, 0), Vector2i(0, 2), Vector2i(2, 0), Vector2i(0, -2),
+		Vector2i(-2, -1), Vector2i(-2, 1), Vector2i(2, -1), Vector2i(2, 1),
+		Vector2i(-1, -2), Vector2i(-1, 2), Vector2i(1, -2), Vector2i(1, 2),
+		Vector2i(-2, -2), Vector2i(-2, 2), Vector2i(2, -2), Vector2i(2, 2)
+	};
+
+	int layer;
+	Rect2i rect;
+	_get_tile(p_tile, layer, rect);
+
+	const LocalVector<Color> &source = *p_pass->source;
+	LocalVector<Color> &dest = *p_pass->dest;
+
+	for (int y = rect.position.y; y < rect.position.y + rect.size.y; y++) {
+		for (int x = rect.position.x; x < rect.position.x + rect.size.x; x++) {
+			Color c = source[_get_texel_index(layer, x, y)];
+			for (int i = 1; i < 25 && c.a <= 0.5; i++) {
+				Vector2i pos = Vector2i(x, y) + offsets[i];
+				if (pos.x < 0 || pos.y < 0 || pos.x >= atlas_size.width || pos.y >= atlas_size.height) {
+					continue;
+				}
+				const Color &n = source[_get_texel_index(layer, pos.x, pos.y)];
+				if (n.a > 0.5) {
+					c = n;
+				}
+			}
+			dest[_get_texel_index(layer, x, y)] = c;
+		}
+	}
+}
+
+void LightmapperCPU::_dilate(LocalVector<Color> &r_light) {
+	LocalVector<Color> source = r_light;
+
+	DilatePass pass;
+	pass.source = &source;
+	pass.dest = &r_light;
+
+	int layers = r_light.size() / (atlas_size.width * atlas_size.height);
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &LightmapperCPU::_dilate_tile, &pass, tiles_x * tiles_y * layers, -1, true, SNAME("LightmapperCPUDilate"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void LightmapperCPU::_blend_seams(LocalVector<Color> &r_light) {
+	const int layers_per_slice = bake_sh ? 4 : 1;
+
+	for (const Seam &seam : seams) {
+		int steps = MAX(1, int(Math::ceil(MAX(seam.a[0].distance_to(seam.a[1]), seam.b[0].distance_to(seam.b[1])) * 2.0)));
+		for (int i = 0; i <= steps; i++) {
+			real_t t = real_t(i) / steps;
+			Vector2 pos_a = seam.a[0].lerp(seam.a[1], t);
+			Vector2 pos_b = seam.b[0].lerp(seam.b[1], t);
+			Vector2i texel_a = Vector2i(Math::floor(pos_a.x), Math::floor(pos_a.y));
+			Vector2i texel_b = Vector2i(Math::floor(pos_b.x), Math::floor(pos_b.y));
+			if (texel_a == texel_b || !Rect2i(Vector2i(), atlas_size).has_point(texel_a) || !Rect2i(Vector2i(), atlas_size).has_point(texel_b)) {
+				continue;
+			}
+			if (!texels[_get_texel_index(seam.slice, texel_a.x, texel_a.y)].valid || !texels[_get_texel_index(seam.slice, texel_b.x, texel_b.y)].valid) {
+				continue;
+			}
+
+			for (int j = 0; j < layers_per_slice; j++) {
+				int layer = seam.slice * layers_per_slice + j;
+				Color &a = r_light[_get_texel_index(layer, texel_a.x, texel_a.y)];
+				Color &b = r_light[_get_texel_index(layer, texel_b.x, texel_b.y)];
+				Color blend = (a + b) * 0.5;
+				a = Color(blend.r, blend.g, blend.b, a.a);
+				b = Color(blend.r, blend.g, blend.b, b.a);
+			}
+		}
+	}
+}
+
+void LightmapperCPU::_save_checkpoint(const String &p_path, uint32_t p_hash, int p_bounces_done, const LocalVector<Color> &p_bounce_light) const {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(f.is_null(), "Can't open lightmap checkpoint for writing: " + p_path);
+
+	f->store_buffer((const uint8_t *)"GDLC", 4);
+	f->store_32(CHECKPOINT_VERSION);
+	f->store_32(p_hash);
+	f->store_32(p_bounces_done);
+	f->store_32(light_accum.size());
+	f->store_32(p_bounce_light.size());
+	f->store_buffer((const uint8_t *)light_accum.ptr(), light_accum.size() * sizeof(Color));
+	f->store_buffer((const uint8_t *)p_bounce_light.ptr(), p_bounce_light.size() * sizeof(Color));
+}
+
+int LightmapperCPU::_load_checkpoint(const String &p_path, uint32_t p_hash, LocalVector<Color> &r_bounce_light) {
+	if (!FileAccess::exists(p_path)) {
+		return 0;
+	}
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return 0;
+	}
+
+	uint8_t magic[4] = {};
+	f->get_buffer(magic, 4);
+	if (memcmp(magic, "GDLC", 4) != 0 || f->get_32() != CHECKPOINT_VERSION || f->get_32() != p_hash) {
+		return 0; // Not a checkpoint, or one from a different scene or settings.
+	}
+
+	int bounces_done = f->get_32();
+	if (f->get_32() != light_accum.size() || f->get_32() != r_bounce_light.size()) {
+		return 0;
+	}
+
+	uint64_t accum_size = light_accum.size() * sizeof(Color);
+	uint64_t bounce_size = r_bounce_light.size() * sizeof(Color);
+	if (f->get_buffer((uint8_t *)light_accum.ptr(), accum_size) != accum_size || f->get_buffer((uint8_t *)r_bounce_light.ptr(), bounce_size) != bounce_size) {
+		ERR_PRINT("Lightmap checkpoint is truncated, ignoring it: " + p_path);
+		return -1;
+	}
+
+	return bounces_done;
+}
+
+LightmapperCPU::BakeError LightmapperCPU::bake(BakeQuality p_quality, bool p_use_denoiser, int p_bounces, float p_bias, int p_max_texture_size, bool p_bake_sh, GenerateProbes p_generate_probes, const Ref<Image> &p_environment_panorama, const Basis &p_environment_transform, BakeStepFunc p_step_function, void *p_bake_userdata, float p_exposure_normalization) {
+	if (p_step_function) {
+		p_step_function(0.0, RTR("Begin Bake"), p_bake_userdata, true);
+	}
+	bake_textures.clear();
+	probe_values.clear();
+
+	raycaster = LightmapRaycaster::create();
+	ERR_FAIL_COND_V_MSG(raycaster.is_null(), BAKE_ERROR_LIGHTMAP_CANT_PRE_BAKE_MESHES, "The CPU lightmapper requires a raycaster (the raycast module), which is not available.");
+
+	/* STEP 1: Compute the atlas layout */
+
+	BakeError bake_error = _blit_meshes_into_atlas(p_max_texture_size, p_step_function, p_bake_userdata);
+	if (bake_error != BAKE_OK) {
+		raycaster.unref();
+		return bake_error;
+	}
+
+	bake_sh = p_bake_sh;
+	bias = p_bias;
+	exposure_normalization = p_exposure_normalization;
+	environment_transform = p_environment_transform;
+
+	switch (p_quality) {
+		case BAKE_QUALITY_LOW: {
+			ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/low_quality_ray_count");
+		} break;
+		case BAKE_QUALITY_MEDIUM: {
+			ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/medium_quality_ray_count");
+		} break;
+		case BAKE_QUALITY_HIGH: {
+			ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/high_quality_ray_count");
+		} break;
+		case BAKE_QUALITY_ULTRA: {
+			ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/ultra_quality_ray_count");
+		} break;
+	}
+	ray_count = CLAMP(ray_count, 16u, 8192u);
+
+	environment.clear();
+	environment_size = Size2i();
+	if (p_environment_panorama.is_valid() && !p_environment_panorama->is_empty()) {
+		Ref<Image> panorama = p_environment_panorama->duplicate();
+		panorama->convert(Image::FORMAT_RGBAF);
+		environment_size = panorama->get_size();
+		environment.resize(environment_size.width * environment_size.height);
+		Vector<uint8_t> data = panorama->get_data();
+		memcpy(environment.ptr(), data.ptr(), environment.size() * sizeof(Color));
+	}
+
+	const uint32_t slice_texel_count = atlas_size.width * atlas_size.height;
+	const uint32_t texel_count = slice_texel_count * atlas_slices;
+	const uint32_t layer_count = atlas_slices * (bake_sh ? 4 : 1);
+	const uint32_t accum_texel_count = slice_texel_count * layer_count;
+	tiles_x = (atlas_size.width - 1) / TILE_SIZE + 1;
+	tiles_y = (atlas_size.height - 1) / TILE_SIZE + 1;
+	const uint32_t tile_count = tiles_x * tiles_y * atlas_slices;
+
+	albedo.resize(texel_count);
+	emission.resize(texel_count);
+	texels.resize(texel_count);
+	light_source.resize(texel_count);
+	light_dest.resize(texel_count);
+	light_primary_dynamic.resize(texel_count);
+	bounce_accum.resize(texel_count);
+	light_accum.resize(accum_texel_count);
+	for (uint32_t i = 0; i < texel_count; i++) {
+		albedo[i] = Color(0, 0, 0, 0);
+		emission[i] = Color(0, 0, 0, 0);
+		texels[i].valid = false;
+		light_source[i] = Color(0, 0, 0, 0);
+		light_dest[i] = Color(0, 0, 0, 0);
+		light_primary_dynamic[i] = Color(0, 0, 0, 0);
+		bounce_accum[i] = Color(0, 0, 0, 0);
+	}
+	for (uint32_t i = 0; i < accum_texel_count; i++) {
+		light_accum[i] = Color(0, 0, 0, 0);
+	}
+
+	/* STEP 2: Build the acceleration structure */
+
+	AABB bounds;
+	for (int m_i = 0; m_i < mesh_instances.size(); m_i++) {
+		if (p_step_function) {
+			float p = float(m_i + 1) / mesh_instances.size() * 0.1;
+			p_step_function(0.3 + p, vformat(RTR("Plotting mesh into acceleration structure %d/%d"), m_i + 1, mesh_instances.size()), p_bake_userdata, false);
+		}
+
+		const MeshInstance &mi = mesh_instances[m_i];
+		raycaster->add_mesh(mi.data.points, mi.data.normal, mi.data.uv2, m_i);
+
+		if (m_i == 0) {
+			bounds.position = mi.data.points[0];
+		}
+		for (int i = 0; i < mi.data.points.size(); i++) {
+			bounds.expand_to(mi.data.points[i]);
+		}
+	}
+	// Also consider probe positions for bounds.
+	for (int i = 0; i < probe_positions.size(); i++) {
+		bounds.expand_to(probe_positions[i]);
+	}
+	bounds.grow_by(0.1); // Grow a bit to avoid numerical error.
+	world_size = bounds.size.length();
+
+	if (p_step_function) {
+		p_step_function(0.4, RTR("Optimizing acceleration structure"), p_bake_userdata, true);
+	}
+	raycaster->commit();
+	_create_seams();
+
+	const String checkpoint_path = GLOBAL_GET("rendering/lightmapping/bake_performance/checkpoint_path");
+	const uint32_t bake_hash = checkpoint_path.is_empty() ? 0 : _compute_bake_hash();
+
+	/* STEP 3: Raster the geometry to UV2 coords in the atlas */
+
+	WorkerThreadPool *wtp = WorkerThreadPool::get_singleton();
+	WorkerThreadPool::GroupID group_task = wtp->add_template_group_task(this, &LightmapperCPU::_raster_mesh, (void *)nullptr, mesh_instances.size(), -1, true, SNAME("LightmapperCPURaster"));
+	wtp->wait_for_group_task_completion(group_task);
+
+	if (p_step_function) {
+		p_step_function(0.49, RTR("Un-occluding geometry"), p_bake_userdata, true);
+	}
+
+	group_task = wtp->add_template_group_task(this, &LightmapperCPU::_unocclude_tile, (void *)nullptr, tile_count, -1, true, SNAME("LightmapperCPUUnocclude"));
+	wtp->wait_for_group_task_completion(group_task);
+
+	/* PRIMARY (direct) LIGHT PASS */
+
+	if (p_step_function) {
+		p_step_function(0.5, RTR("Plot direct lighting"), p_bake_userdata, true);
+	}
+
+	group_task = wtp->add_template_group_task(this, &LightmapperCPU::_direct_light_tile, (void *)nullptr, tile_count, -1, true, SNAME("LightmapperCPUDirect"));
+	wtp->wait_for_group_task_completion(group_task);
+
+	/* SECONDARY (indirect) LIGHT PASS(ES) */
+
+	if (p_step_function) {
+		p_step_function(0.6, RTR("Integrate indirect lighting"), p_bake_userdata, true);
+	}
+
+	// The result of each bounce is the source of the next one, alternating between both buffers.
+	LocalVector<Color> *bounce_buffers[2] = { &light_source, &light_dest };
+
+	int first_bounce = 0;
+	if (!checkpoint_path.is_empty() && p_bounces > 0) {
+		LocalVector<Color> checkpoint_light;
+		checkpoint_light.resize(texel_count);
+		LocalVector<Color> direct_accum = light_accum;
+		first_bounce = _load_checkpoint(checkpoint_path, bake_hash, checkpoint_light);
+		if (first_bounce > 0) {
+			first_bounce = MIN(first_bounce, p_bounces);
+			*bounce_buffers[first_bounce % 2] = checkpoint_light;
+			print_line(vformat("Lightmap bake resumed from checkpoint after bounce %d: %s", first_bounce, checkpoint_path));
+		} else {
+			light_accum = direct_accum; // Discard a partially loaded checkpoint.
+			first_bounce = 0;
+		}
+	}
+
+	if (p_bounces > 0) {
+		int max_rays = GLOBAL_GET("rendering/lightmapping/bake_performance/max_rays_per_pass");
+		max_rays = MAX(max_rays, 1);
+		int ray_iterations = (ray_count - 1) / max_rays + 1;
+
+		for (int b = first_bounce; b < p_bounces; b++) {
+			BouncePass pass;
+			pass.source_light = bounce_buffers[b % 2];
+			pass.dest_light = bounce_buffers[(b + 1) % 2];
+			pass.use_environment = b == 0; // Only the first bounce reaches out for the sky.
+
+			// Progressive refinement: rays are traced in batches, reporting progress after each one.
+			for (int k = 0; k < ray_iterations; k++) {
+				pass.ray_from = k * max_rays;
+				pass.ray_to = MIN((k + 1) * max_rays, int32_t(ray_count));
+
+				group_task = wtp->add_template_group_task(this, &LightmapperCPU::_bounce_light_tile, (const BouncePass *)&pass, tile_count, -1, true, SNAME("LightmapperCPUBounce"));
+				wtp->wait_for_group_task_completion(group_task);
+
+				if (p_step_function) {
+					int percent = (k + 1) * 100 / ray_iterations;
+					float p = float(k + 1) / ray_iterations * 0.1;
+					p_step_function(0.6 + p, vformat(RTR("Bounce %d/%d: Integrate indirect lighting %d%%"), b + 1, p_bounces, percent), p_bake_userdata, false);
+				}
+			}
+
+			if (!checkpoint_path.is_empty() && b + 1 < p_bounces) {
+				_save_checkpoint(checkpoint_path, bake_hash, b + 1, *pass.dest_light);
+			}
+		}
+	}
+
+	/* LIGHTPROBES */
+
+	if (probe_positions.size()) {
+		if (p_step_function) {
+			p_step_function(0.7, RTR("Baking lightprobes"), p_bake_userdata, true);
+		}
+
+		ProbePass pass;
+		switch (p_quality) {
+			case BAKE_QUALITY_LOW: {
+				pass.ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/low_quality_probe_ray_count");
+			} break;
+			case BAKE_QUALITY_MEDIUM: {
+				pass.ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/medium_quality_probe_ray_count");
+			} break;
+			case BAKE_QUALITY_HIGH: {
+				pass.ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/high_quality_probe_ray_count");
+			} break;
+			case BAKE_QUALITY_ULTRA: {
+				pass.ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/ultra_quality_probe_ray_count");
+			} break;
+		}
+		pass.ray_count = CLAMP(pass.ray_count, 16u, 8192u);
+		// Without bounces the indirect light is empty; the light of the last bounce otherwise.
+		pass.source_light = p_bounces > 0 ? bounce_buffers[p_bounces % 2] : &bounce_accum;
+		if (p_bounces == 0) {
+			for (uint32_t i = 0; i < texel_count; i++) {
+				bounce_accum[i] = Color(0, 0, 0, 0);
+			}
+		}
+
+		probe_accum.resize(probe_positions.size() * 9);
+		for (uint32_t i = 0; i < probe_accum.size(); i++) {
+			probe_accum[i] = Color(0, 0, 0, 0);
+		}
+
+		int max_rays = GLOBAL_GET("rendering/lightmapping/bake_performance/max_rays_per_probe_pass");
+		max_rays = MAX(max_rays, 1);
+		int ray_iterations = (pass.ray_count - 1) / max_rays + 1;
+
+		for (int i = 0; i < ray_iterations; i++) {
+			pass.ray_from = i * max_rays;
+			pass.ray_to = MIN((i + 1) * max_rays, int32_t(pass.ray_count));
+
+			group_task = wtp->add_template_group_task(this, &LightmapperCPU::_light_probe, (const ProbePass *)&pass, probe_positions.size(), -1, true, SNAME("LightmapperCPUProbes"));
+			wtp->wait_for_group_task_completion(group_task);
+
+			if (p_step_function) {
+				int percent = i * 100 / ray_iterations;
+				float p = float(i) / ray_iterations * 0.1;
+				p_step_function(0.7 + p, vformat(RTR("Integrating light probes %d%%"), percent), p_bake_userdata, false);
+			}
+		}
+
+		probe_values.resize(probe_accum.size());
+		memcpy(probe_values.ptrw(), probe_accum.ptr(), probe_accum.size() * sizeof(Color));
+	}
+
+	_dilate(light_accum);
+
+	/* DENOISE */
+
+	if (p_use_denoiser) {
+		if (p_step_function) {
+			p_step_function(0.8, RTR("Denoising"), p_bake_userdata, true);
+		}
+
+		Ref<LightmapDenoiser> denoiser = LightmapDenoiser::create();
+		if (denoiser.is_valid()) {
+			for (uint32_t i = 0; i < layer_count; i++) {
+				Color *layer = &light_accum[i * slice_texel_count];
+
+				Vector<uint8_t> data;
+				data.resize(slice_texel_count * sizeof(Color));
+				memcpy(data.ptrw(), layer, data.size());
+				Ref<Image> img = Image::create_from_data(atlas_size.width, atlas_size.height, false, Image::FORMAT_RGBAF, data);
+
+				Ref<Image> denoised = denoiser->denoise_image(img);
+				if (denoised != img) {
+					denoised->convert(Image::FORMAT_RGBAF);
+					Vector<uint8_t> denoised_data = denoised->get_data();
+					const Color *src = (const Color *)denoised_data.ptr();
+					for (uint32_t j = 0; j < slice_texel_count; j++) {
+						// Restore alpha.
+						layer[j] = Color(src[j].r, src[j].g, src[j].b, layer[j].a);
+					}
+				}
+			}
+		}
+
+		_dilate(light_accum);
+	}
+
+	/* BLEND SEAMS */
+
+	_blend_seams(light_accum);
+
+	if (p_step_function) {
+		p_step_function(0.9, RTR("Retrieving textures"), p_bake_userdata, true);
+	}
+
+	for (uint32_t i = 0; i < layer_count; i++) {
+		Vector<uint8_t> data;
+		data.resize(slice_texel_count * sizeof(Color));
+		memcpy(data.ptrw(), &light_accum[i * slice_texel_count], data.size());
+		Ref<Image> img = Image::create_from_data(atlas_size.width, atlas_size.height, false, Image::FORMAT_RGBAF, data);
+		img->convert(Image::FORMAT_RGBH); // Remove alpha.
+		bake_textures.push_back(img);
+	}
+
+	if (!checkpoint_path.is_empty() && FileAccess::exists(checkpoint_path)) {
+		// The bake finished, so the checkpoint is no longer needed.
+		DirAccess::remove_absolute(checkpoint_path);
+	}
+
+	// Free the bake state.
+	raycaster.unref();
+	environment.clear();
+	albedo.clear();
+	emission.clear();
+	texels.clear();
+	seams.clear();
+	light_source.clear();
+	light_dest.clear();
+	light_primary_dynamic.clear();
+	light_accum.clear();
+	bounce_accum.clear();
+	probe_accum.clear();
+
+	return BAKE_OK;
+}
+
+int LightmapperCPU::get_bake_texture_count() const {
+	return bake_textures.size();
+}
+
+Ref<Image> LightmapperCPU::get_bake_texture(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, bake_textures.size(), Ref<Image>());
+	return bake_textures[p_index];
+}
+
+int LightmapperCPU::get_bake_mesh_count() const {
+	return mesh_instances.size();
+}
+
+Variant LightmapperCPU::get_bake_mesh_userdata(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, mesh_instances.size(), Variant());
+	return mesh_instances[p_index].data.userdata;
+}
+
+Rect2 LightmapperCPU::get_bake_mesh_uv_scale(int p_index) const {
+	ERR_FAIL_COND_V(bake_textures.size() == 0, Rect2());
+	ERR_FAIL_INDEX_V(p_index, mesh_instances.size(), Rect2());
+	Rect2 uv_ofs;
+	Vector2 atlas_size_f = Vector2(bake_textures[0]->get_width(), bake_textures[0]->get_height());
+	uv_ofs.position = Vector2(mesh_instances[p_index].offset) / atlas_size_f;
+	uv_ofs.size = Vector2(mesh_instances[p_index].size) / atlas_size_f;
+	return uv_ofs;
+}
+
+int LightmapperCPU::get_bake_mesh_texture_slice(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, mesh_instances.size(), 0);
+	return mesh_instances[p_index].slice;
+}
+
+int LightmapperCPU::get_bake_probe_count() const {
+	return probe_positions.size();
+}
+
+Vector3 LightmapperCPU::get_bake_probe_point(int p_probe) const {
+	ERR_FAIL_INDEX_V(p_probe, probe_positions.size(), Vector3());
+	return probe_positions[p_probe];
+}
+
+Vector<Color> LightmapperCPU::get_bake_probe_sh(int p_probe) const {
+	ERR_FAIL_INDEX_V(p_probe, probe_positions.size(), Vector<Color>());
+	Vector<Color> ret;
+	ret.resize(9);
+	memcpy(ret.ptrw(), &probe_values[p_probe * 9], sizeof(Color) * 9);
+	return ret;
+}
+
+LightmapperCPU::LightmapperCPU() {
+}
@@ -0,0 +1,209 @@
+/**************************************************************************/
+/*  lightmapper_cpu.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef LIGHTMAPPER_CPU_H
+#define LIGHTMAPPER_CPU_H
+
+#include "core/templates/local_vector.h"
+#include "scene/3d/lightmapper.h"
+
+// CPU implementation of the lightmapper, for machines without a RenderingDevice (such as headless bake servers).
+// It follows the same algorithm as LightmapperRD (see lm_compute.glsl), using LightmapRaycaster (Embree) for the ray
+// queries and WorkerThreadPool to process the atlas in tiles, so baked data is interchangeable between both.
+class LightmapperCPU : public Lightmapper {
+	GDCLASS(LightmapperCPU, Lightmapper)
+
+	struct MeshInstance {
+		MeshData data;
+		int slice = 0;
+		Vector2i offset;
+		Size2i size;
+	};
+
+	struct Light {
+		Vector3 position;
+		uint32_t type = LIGHT_TYPE_DIRECTIONAL;
+		Vector3 direction;
+		float energy = 0.0;
+		Vector3 color;
+		float size = 0.0;
+		float range = 0.0;
+		float attenuation = 0.0;
+		float cos_spot_angle = 0.0;
+		float inv_spot_attenuation = 0.0;
+		float shadow_blur = 0.0;
+		bool static_bake = false;
+	};
+
+	struct Texel {
+		Vector3 position;
+		Vector3 normal;
+		Vector3 face_normal;
+		float texel_size = 0.0;
+		bool valid = false;
+	};
+
+	struct Seam {
+		Vector2 a[2];
+		Vector2 b[2];
+		int slice = 0;
+	};
+
+	struct EdgeKey {
+		Vector3 a;
+		Vector3 b;
+		Vector3 na;
+		Vector3 nb;
+
+		bool operator==(const EdgeKey &p_edge) const {
+			return a == p_edge.a && b == p_edge.b && na == p_edge.na && nb == p_edge.nb;
+		}
+
+		static uint32_t hash(const EdgeKey &p_edge) {
+			uint32_t h = hash_murmur3_one_real(p_edge.a.x);
+			h = hash_murmur3_one_real(p_edge.a.y, h);
+			h = hash_murmur3_one_real(p_edge.a.z, h);
+			h = hash_murmur3_one_real(p_edge.b.x, h);
+			h = hash_murmur3_one_real(p_edge.b.y, h);
+			h = hash_murmur3_one_real(p_edge.b.z, h);
+			return hash_fmix32(h);
+		}
+	};
+
+	enum RayResult {
+		RAY_MISS,
+		RAY_FRONT,
+		RAY_BACK,
+	};
+
+	struct BouncePass {
+		uint32_t ray_from = 0;
+		uint32_t ray_to = 0;
+		bool use_environment = false;
+		const LocalVector<Color> *source_light = nullptr;
+		LocalVector<Color> *dest_light = nullptr;
+	};
+
+	struct ProbePass {
+		uint32_t ray_from = 0;
+		uint32_t ray_to = 0;
+		uint32_t ray_count = 0;
+		const LocalVector<Color> *source_light = nullptr;
+	};
+
+	struct DilatePass {
+		const LocalVector<Color> *source = nullptr;
+		LocalVector<Color> *dest = nullptr;
+	};
+
+	static const int TILE_SIZE = 32;
+
+	Vector<MeshInstance> mesh_instances;
+	Vector<Light> lights;
+	Vector<Vector3> probe_positions;
+
+	Vector<Ref<Image>> bake_textures;
+	Vector<Color> probe_values;
+
+	// Bake state, only valid while baking.
+	Ref<LightmapRaycaster> raycaster;
+	Size2i atlas_size;
+	int atlas_slices = 0;
+	int tiles_x = 0;
+	int tiles_y = 0;
+	bool bake_sh = false;
+	float bias = 0.0;
+	float world_size = 0.0;
+	uint32_t ray_count = 0;
+	float exposure_normalization = 1.0;
+	Basis environment_transform;
+	Size2i environment_size;
+	LocalVector<Color> environment;
+
+	LocalVector<Color> albedo;
+	LocalVector<Color> emission;
+	LocalVector<Texel> texels;
+	LocalVector<Seam> seams;
+	LocalVector<Color> light_source;
+	LocalVector<Color> light_dest;
+	LocalVector<Color> light_primary_dynamic;
+	LocalVector<Color> light_accum;
+	LocalVector<Color> bounce_accum;
+	LocalVector<Color> probe_accum;
+
+	_FORCE_INLINE_ uint32_t _get_texel_index(int p_slice, int p_x, int p_y) const {
+		return (uint32_t(p_slice) * atlas_size.height + p_y) * atlas_size.width + p_x;
+	}
+
+	BakeError _blit_meshes_into_atlas(int p_max_texture_size, BakeStepFunc p_step_function, void *p_bake_userdata);
+	void _create_seams();
+	uint32_t _compute_bake_hash() const;
+
+	static void _raster_texel(Texel &r_texel, const Vector3 *p_points, const Vector3 *p_normals, const Vector3 &p_face_normal, float p_texel_size, bool p_smooth, const Vector3 &p_barycentric);
+	void _raster_mesh(uint32_t p_mesh, void *p_userdata);
+	void _unocclude_tile(uint32_t p_tile, void *p_userdata);
+	void _direct_light_tile(uint32_t p_tile, void *p_userdata);
+	void _bounce_light_tile(uint32_t p_tile, const BouncePass *p_pass);
+	void _light_probe(uint32_t p_probe, const ProbePass *p_pass);
+	void _get_tile(uint32_t p_tile, int &r_layer, Rect2i &r_rect) const;
+	void _dilate_tile(uint32_t p_tile, const DilatePass *p_pass);
+	void _dilate(LocalVector<Color> &r_light);
+	void _blend_seams(LocalVector<Color> &r_light);
+
+	RayResult _trace_ray(const Vector3 &p_from, const Vector3 &p_to, uint32_t *r_mesh = nullptr, Vector2 *r_uv = nullptr, float *r_distance = nullptr, Vector3 *r_normal = nullptr);
+	Color _sample_light(const LocalVector<Color> &p_light, uint32_t p_mesh, const Vector2 &p_uv) const;
+	Color _sample_environment(const Vector3 &p_dir) const;
+
+	// Checkpoints store the light accumulated after each finished bounce, so an interrupted bake can resume from it.
+	void _save_checkpoint(const String &p_path, uint32_t p_hash, int p_bounces_done, const LocalVector<Color> &p_bounce_light) const;
+	int _load_checkpoint(const String &p_path, uint32_t p_hash, LocalVector<Color> &r_bounce_light);
+
+public:
+	virtual void add_mesh(const MeshData &p_mesh) override;
+	virtual void add_directional_light(bool p_static, const Vector3 &p_direction, const Color &p_color, float p_energy, float p_angular_distance, float p_shadow_blur) override;
+	virtual void add_omni_light(bool p_static, const Vector3 &p_position, const Color &p_color, float p_energy, float p_range, float p_attenuation, float p_size, float p_shadow_blur) override;
+	virtual void add_spot_light(bool p_static, const Vector3 &p_position, const Vector3 p_direction, const Color &p_color, float p_energy, float p_range, float p_attenuation, float p_spot_angle, float p_spot_attenuation, float p_size, float p_shadow_blur) override;
+	virtual void add_probe(const Vector3 &p_position) override;
+	virtual BakeError bake(BakeQuality p_quality, bool p_use_denoiser, int p_bounces, float p_bias, int p_max_texture_size, bool p_bake_sh, GenerateProbes p_generate_probes, const Ref<Image> &p_environment_panorama, const Basis &p_environment_transform, BakeStepFunc p_step_function = nullptr, void *p_bake_userdata = nullptr, float p_exposure_normalization = 1.0) override;
+
+	int get_bake_texture_count() const override;
+	Ref<Image> get_bake_texture(int p_index) const override;
+	int get_bake_mesh_count() const override;
+	Variant get_bake_mesh_userdata(int p_index) const override;
+	Rect2 get_bake_mesh_uv_scale(int p_index) const override;
+	int get_bake_mesh_texture_slice(int p_index) const override;
+	int get_bake_probe_count() const override;
+	Vector3 get_bake_probe_point(int p_probe) const override;
+	Vector<Color> get_bake_probe_sh(int p_probe) const override;
+
+	LightmapperCPU();
+};
+
+#endif // LIGHTMAPPER_CPU_H
@@ -37,6 +37,9 @@
 
 #ifndef _3D_DISABLED
 static Lightmapper *create_lightmapper_rd() {
+	if (!RenderingDevice::get_singleton()) {
+		return nullptr; // Not using a RenderingDevice based renderer (e.g. running headless), let the CPU lightmapper bake.
+	}
 	return memnew(LightmapperRD);
 }
 #endif
@@ -34,6 +34,7 @@
 #include "navigation_mesh_generator.h"
 #endif
 
+#include "core/debugger/frame_tracer.h"
 #include "core/os/mutex.h"
 
 using namespace NavigationUtilities;
@@ -1035,6 +1036,8 @@ void GodotNavigationServer::map_force_update(RID p_map) {
 }
 
 void GodotNavigationServer::process(real_t p_delta_time) {
+	TRACE_ZONE("NavigationServer3D::process");
+
 	flush_queries();
 
 	if (!active) {
@@ -31,10 +31,12 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_polygon_bvh.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
 #include "core/math/math_defs.h"
+#include "core/os/mutex.h"
 #include "core/object/worker_thread_pool.h"
 
 #include <KdTree2d.h>
@@ -76,6 +78,31 @@ class NavMap : public NavRid {
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
 
+	/// Spatial index of the map polygons, for the closest point queries.
+	NavPolygonBVH polygons_bvh;
+
+	/// Navigation polys of a path query, indexed by polygon id.
+	/// Kept between queries, so a query doesn't allocate and reset one for every map polygon.
+	struct PathQueryBuffer {
+		LocalVector<gd::NavigationPoly> navigation_polys;
+		uint32_t query_id = 0;
+
+		uint32_t next_query_id();
+	};
+
+	/// Takes a free path query buffer of the map, or a new one, and gives it back when destroyed.
+	/// Path queries can run on several threads at once, each one with its own buffer.
+	struct PathQueryBufferScope {
+		const NavMap *map = nullptr;
+		PathQueryBuffer *buffer = nullptr;
+
+		PathQueryBufferScope(const NavMap *p_map);
+		~PathQueryBufferScope();
+	};
+
+	mutable Mutex path_query_buffers_mutex;
+	mutable LocalVector<PathQueryBuffer *> path_query_buffers;
+
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
@@ -0,0 +1,285 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_polygon_bvh.h"
+
+#include "nav_base.h"
+
+#include "core/math/face3.h"
+#include "core/math/geometry_3d.h"
+#include "core/templates/sort_array.h"
+
+struct NavPolygonBVHItemCompare {
+	int axis = 0;
+
+	template <class T>
+	bool operator()(const T &p_a, const T &p_b) const {
+		return p_a.center[axis] < p_b.center[axis];
+	}
+};
+
+static real_t _get_point_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+	return p_point.clamp(p_aabb.position, p_aabb.position + p_aabb.size).distance_squared_to(p_point);
+}
+
+static real_t _get_aabb_distance_squared(const AABB &p_aabb_a, const AABB &p_aabb_b) {
+	real_t distance_squared = 0.0;
+	for (int i = 0; i < 3; i++) {
+		real_t gap = MAX(p_aabb_a.position[i] - (p_aabb_b.position[i] + p_aabb_b.size[i]), p_aabb_b.position[i] - (p_aabb_a.position[i] + p_aabb_a.size[i]));
+		if (gap > 0.0) {
+			distance_squared += gap * gap;
+		}
+	}
+	return distance_squared;
+}
+
+// Keeps the first polygon in map order on ties, as the linear searches did.
+static bool _is_closer(real_t p_distance, const gd::Polygon *p_polygon, real_t p_best_distance, const gd::Polygon *p_best_polygon) {
+	return p_distance < p_best_distance || (p_distance == p_best_distance && p_best_polygon && p_polygon->id < p_best_polygon->id);
+}
+
+void NavPolygonBVH::_build(LocalVector<Item> &p_items, uint32_t p_begin, uint32_t p_end, uint32_t p_depth) {
+	uint32_t node_index = nodes.size();
+	nodes.push_back(Node());
+
+	AABB aabb = p_items[p_begin].aabb;
+	AABB center_aabb(p_items[p_begin].center, Vector3());
+	for (uint32_t i = p_begin + 1; i < p_end; i++) {
+		aabb.merge_with(p_items[i].aabb);
+		center_aabb.expand_to(p_items[i].center);
+	}
+	nodes[node_index].aabb = aabb;
+
+	if (p_end - p_begin <= MAX_LEAF_POLYGONS || p_depth >= MAX_DEPTH - 1) {
+		nodes[node_index].index = polygons.size();
+		nodes[node_index].count = p_end - p_begin;
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			polygons.push_back(p_items[i].polygon);
+		}
+		return;
+	}
+
+	// Median split along the longest axis of the polygon centers.
+	uint32_t split = p_begin + (p_end - p_begin) / 2;
+	SortArray<Item, NavPolygonBVHItemCompare> sorter;
+	sorter.compare.axis = center_aabb.get_longest_axis_index();
+	sorter.nth_element(p_begin, p_end, split, p_items.ptr());
+
+	_build(p_items, p_begin, split, p_depth + 1);
+	nodes[node_index].index = nodes.size();
+	_build(p_items, split, p_end, p_depth + 1);
+}
+
+void NavPolygonBVH::build(const LocalVector<gd::Polygon> &p_polygons) {
+	clear();
+
+	LocalVector<Item> items;
+	items.reserve(p_polygons.size());
+	for (const gd::Polygon &polygon : p_polygons) {
+		if (polygon.points.size() < 3) {
+			continue; // Has no faces to be closest to.
+		}
+
+		Item item;
+		item.polygon = &polygon;
+		item.aabb.position = polygon.points[0].pos;
+		for (uint32_t i = 1; i < polygon.points.size(); i++) {
+			item.aabb.expand_to(polygon.points[i].pos);
+		}
+		item.center = item.aabb.get_center();
+		items.push_back(item);
+	}
+
+	if (items.is_empty()) {
+		return;
+	}
+
+	nodes.reserve(items.size() / MAX_LEAF_POLYGONS * 2 + 1);
+	polygons.reserve(items.size());
+	_build(items, 0, items.size(), 0);
+}
+
+void NavPolygonBVH::clear() {
+	nodes.clear();
+	polygons.clear();
+}
+
+const gd::Polygon *NavPolygonBVH::get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, real_t p_max_distance, Vector3 &r_point, Vector3 *r_normal) const {
+	if (nodes.is_empty()) {
+		return nullptr;
+	}
+
+	const gd::Polygon *closest_polygon = nullptr;
+	real_t closest_distance = MIN(p_max_distance * p_max_distance, (real_t)FLT_MAX);
+
+	uint32_t stack[MAX_DEPTH * 2];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		uint32_t node_index = stack[--stack_size];
+		const Node &node = nodes[node_index];
+		if (_get_point_distance_squared(node.aabb, p_point) > closest_distance) {
+			continue;
+		}
+
+		if (node.count == 0) {
+			// Visit the closest child first, so more of the other one can be skipped.
+			uint32_t left = node_index + 1;
+			uint32_t right = node.index;
+			if (_get_point_distance_squared(nodes[left].aabb, p_point) < _get_point_distance_squared(nodes[right].aabb, p_point)) {
+				SWAP(left, right);
+			}
+			stack[stack_size++] = left;
+			stack[stack_size++] = right;
+			continue;
+		}
+
+		for (uint32_t i = node.index; i < node.index + node.count; i++) {
+			const gd::Polygon *polygon = polygons[i];
+			if (p_navigation_layers != 0 && (p_navigation_layers & polygon->owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			for (uint32_t point_id = 2; point_id < polygon->points.size(); point_id++) {
+				const Face3 face(polygon->points[0].pos, polygon->points[point_id - 1].pos, polygon->points[point_id].pos);
+				const Vector3 point = face.get_closest_point_to(p_point);
+				const real_t distance = point.distance_squared_to(p_point);
+				if (_is_closer(distance, polygon, closest_distance, closest_polygon)) {
+					closest_distance = distance;
+					closest_polygon = polygon;
+					r_point = point;
+					if (r_normal) {
+						*r_normal = face.get_plane().normal;
+					}
+				}
+			}
+		}
+	}
+
+	return closest_polygon;
+}
+
+bool NavPolygonBVH::intersect_segment(const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_point) const {
+	if (nodes.is_empty()) {
+		return false;
+	}
+
+	AABB segment_aabb(p_from, Vector3());
+	segment_aabb.expand_to(p_to);
+
+	const gd::Polygon *closest_polygon = nullptr;
+	real_t closest_distance = FLT_MAX;
+
+	uint32_t stack[MAX_DEPTH * 2];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		uint32_t node_index = stack[--stack_size];
+		const Node &node = nodes[node_index];
+		if (!node.aabb.intersects_inclusive(segment_aabb) || _get_point_distance_squared(node.aabb, p_from) > closest_distance) {
+			continue;
+		}
+
+		if (node.count == 0) {
+			stack[stack_size++] = node.index;
+			stack[stack_size++] = node_index + 1;
+			continue;
+		}
+
+		for (uint32_t i = node.index; i < node.index + node.count; i++) {
+			const gd::Polygon *polygon = polygons[i];
+			for (uint32_t point_id = 2; point_id < polygon->points.size(); point_id++) {
+				const Face3 face(polygon->points[0].pos, polygon->points[point_id - 1].pos, polygon->points[point_id].pos);
+				Vector3 intersection;
+				if (face.intersects_segment(p_from, p_to, &intersection)) {
+					const real_t distance = p_from.distance_squared_to(intersection);
+					if (_is_closer(distance, polygon, closest_distance, closest_polygon)) {
+						closest_distance = distance;
+						closest_polygon = polygon;
+						r_point = intersection;
+					}
+				}
+			}
+		}
+	}
+
+	return closest_polygon != nullptr;
+}
+
+bool NavPolygonBVH::get_closest_edge_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_point) const {
+	if (nodes.is_empty()) {
+		return false;
+	}
+
+	AABB segment_aabb(p_from, Vector3());
+	segment_aabb.expand_to(p_to);
+
+	const gd::Polygon *closest_polygon = nullptr;
+	real_t closest_distance = FLT_MAX;
+
+	uint32_t stack[MAX_DEPTH * 2];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		uint32_t node_index = stack[--stack_size];
+		const Node &node = nodes[node_index];
+		// The segment is within its AABB, so the distance between both AABBs never exceeds the one to the segment.
+		if (_get_aabb_distance_squared(node.aabb, segment_aabb) > closest_distance) {
+			continue;
+		}
+
+		if (node.count == 0) {
+			stack[stack_size++] = node.index;
+			stack[stack_size++] = node_index + 1;
+			continue;
+		}
+
+		for (uint32_t i = node.index; i < node.index + node.count; i++) {
+			const gd::Polygon *polygon = polygons[i];
+			for (uint32_t point_id = 0; point_id < polygon->points.size(); point_id++) {
+				Vector3 a;
+				Vector3 b;
+				Geometry3D::get_closest_points_between_segments(p_from, p_to, polygon->points[point_id].pos, polygon->points[(point_id + 1) % polygon->points.size()].pos, a, b);
+
+				const real_t distance = a.distance_squared_to(b);
+				if (_is_closer(distance, polygon, closest_distance, closest_polygon)) {
+					closest_distance = distance;
+					closest_polygon = polygon;
+					r_point = b;
+				}
+			}
+		}
+	}
+
+	return closest_polygon != nullptr;
+}
@@ -0,0 +1,81 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_POLYGON_BVH_H
+#define NAV_POLYGON_BVH_H
+
+#include "nav_utils.h"
+
+#include "core/math/aabb.h"
+
+/// Static bounding volume hierarchy over the polygons of a map, rebuilt when the map polygons change.
+/// Answers the closest polygon queries of the map without going through all its polygons.
+/// When several polygons are equally close, the one with the lowest id is used, like a linear search would.
+class NavPolygonBVH {
+	enum {
+		MAX_LEAF_POLYGONS = 4,
+		MAX_DEPTH = 64,
+	};
+
+	struct Node {
+		AABB aabb;
+		/// First polygon of a leaf, or right child of an inner node, whose left child is the next node.
+		uint32_t index = 0;
+		/// Polygons in a leaf, 0 for inner nodes.
+		uint32_t count = 0;
+	};
+
+	struct Item {
+		AABB aabb;
+		Vector3 center;
+		const gd::Polygon *polygon = nullptr;
+	};
+
+	LocalVector<Node> nodes;
+	LocalVector<const gd::Polygon *> polygons;
+
+	void _build(LocalVector<Item> &p_items, uint32_t p_begin, uint32_t p_end, uint32_t p_depth);
+
+public:
+	void build(const LocalVector<gd::Polygon> &p_polygons);
+	void clear();
+
+	/// Returns the polygon closest to `p_point` that is closer than `p_max_distance`, or null.
+	/// Only polygons with an owner in `p_navigation_layers` are considered, all of them if it is 0.
+	const gd::Polygon *get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, real_t p_max_distance, Vector3 &r_point, Vector3 *r_normal = nullptr) const;
+
+	/// Returns the intersection of the segment with the polygons that is the closest to `p_from`.
+	bool intersect_segment(const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_point) const;
+
+	/// Returns the point of the polygon edges that is the closest to the segment.
+	bool get_closest_edge_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_point) const;
+};
+
+#endif // NAV_POLYGON_BVH_H
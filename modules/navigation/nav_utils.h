@@ -98,6 +98,9 @@ struct Edge {
 };
 
 struct Polygon {
+	/// Index of this polygon in the map, region polygons first and then link polygons.
+	uint32_t id = UINT32_MAX;
+
 	/// Navigation region or link that contains this polygon.
 	const NavBase *owner = nullptr;
 
@@ -115,10 +118,15 @@ struct Polygon {
 };
 
 struct NavigationPoly {
-	uint32_t self_id = 0;
 	/// This poly.
 	const Polygon *poly;
 
+	/// Id of the path query that reached this poly, the other fields are stale for any other query.
+	uint32_t query_id = 0;
+
+	/// Index of this poly in the heap of polys to visit, UINT32_MAX when not in it.
+	uint32_t traversable_poly_index = UINT32_MAX;
+
 	/// Those 4 variables are used to travel the path backwards.
 	int back_navigation_poly_id = -1;
 	int back_navigation_edge = -1;
@@ -127,8 +135,14 @@ struct NavigationPoly {
 
 	/// The entry position of this poly.
 	Vector3 entry;
-	/// The distance to the destination.
+	/// The distance traveled to reach this poly.
 	real_t traveled_distance = 0.0;
+	/// The estimated distance left to the destination.
+	real_t distance_to_destination = 0.0;
+
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
 
 	NavigationPoly() { poly = nullptr; }
 
@@ -144,6 +158,114 @@ struct NavigationPoly {
 	}
 };
 
+struct NavPolyTravelCostGreaterThan {
+	// Returns `true` if the travel cost of `a` is higher than that of `b`.
+	bool operator()(const NavigationPoly *p_poly_a, const NavigationPoly *p_poly_b) const {
+		return p_poly_a->total_travel_cost() > p_poly_b->total_travel_cost();
+	}
+};
+
+struct NavPolyHeapIndexer {
+	void operator()(NavigationPoly *p_poly, uint32_t p_heap_index) const {
+		p_poly->traversable_poly_index = p_heap_index;
+	}
+};
+
+/// Binary heap keeping the element that compares greatest with `Comparator` on top,
+/// and reporting the index of each element through `Indexer`, so it can be moved after its key changed.
+template <class T, class Comparator, class Indexer>
+class Heap {
+	LocalVector<T> buffer;
+	Comparator compare;
+	Indexer indexer;
+
+	void _shift_up(uint32_t p_index) {
+		T value = buffer[p_index];
+		while (p_index > 0) {
+			uint32_t parent = (p_index - 1) / 2;
+			if (!compare(buffer[parent], value)) {
+				break;
+			}
+			buffer[p_index] = buffer[parent];
+			indexer(buffer[p_index], p_index);
+			p_index = parent;
+		}
+		buffer[p_index] = value;
+		indexer(value, p_index);
+	}
+
+	void _shift_down(uint32_t p_index) {
+		T value = buffer[p_index];
+		uint32_t size = buffer.size();
+		while (true) {
+			uint32_t child = p_index * 2 + 1;
+			if (child >= size) {
+				break;
+			}
+			if (child + 1 < size && compare(buffer[child], buffer[child + 1])) {
+				child++;
+			}
+			if (!compare(value, buffer[child])) {
+				break;
+			}
+			buffer[p_index] = buffer[child];
+			indexer(buffer[p_index], p_index);
+			p_index = child;
+		}
+		buffer[p_index] = value;
+		indexer(value, p_index);
+	}
+
+public:
+	void reserve(uint32_t p_size) {
+		buffer.reserve(p_size);
+	}
+
+	uint32_t size() const {
+		return buffer.size();
+	}
+
+	bool is_empty() const {
+		return buffer.is_empty();
+	}
+
+	void push(const T &p_element) {
+		buffer.push_back(p_element);
+		_shift_up(buffer.size() - 1);
+	}
+
+	T pop() {
+		T top = buffer[0];
+		indexer(top, UINT32_MAX);
+
+		uint32_t last = buffer.size() - 1;
+		if (last > 0) {
+			buffer[0] = buffer[last];
+			buffer.resize(last);
+			_shift_down(0);
+		} else {
+			buffer.clear();
+		}
+		return top;
+	}
+
+	/// Moves the element at `p_index` to its place after its key changed.
+	void shift(uint32_t p_index) {
+		if (p_index > 0 && compare(buffer[(p_index - 1) / 2], buffer[p_index])) {
+			_shift_up(p_index);
+		} else {
+			_shift_down(p_index);
+		}
+	}
+
+	void clear() {
+		for (const T &element : buffer) {
+			indexer(element, UINT32_MAX);
+		}
+		buffer.clear();
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
@@ -31,6 +31,8 @@
 #include "cpu_particles_2d.h"
 
 #include "core/core_string_names.h"
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/2d/gpu_particles_2d.h"
 #include "scene/resources/particle_process_material.h"
 
@@ -554,6 +556,37 @@ static real_t rand_from_seed(uint32_t &seed) {
 	return (seed % uint32_t(65536)) / 65535.0;
 }
 
+// Merges the sorted runs of p_run_size elements left in p_order after sorting it in chunks.
+template <class C>
+static void _merge_sorted_runs(int *p_order, int *p_temp, int p_count, int p_run_size, const C &p_compare) {
+	int *src = p_order;
+	int *dst = p_temp;
+
+	for (int width = p_run_size; width < p_count; width *= 2) {
+		for (int lo = 0; lo < p_count; lo += width * 2) {
+			int mid = MIN(lo + width, p_count);
+			int hi = MIN(lo + width * 2, p_count);
+			int a = lo;
+			int b = mid;
+			int k = lo;
+			while (a < mid && b < hi) {
+				dst[k++] = p_compare(src[b], src[a]) ? src[b++] : src[a++];
+			}
+			while (a < mid) {
+				dst[k++] = src[a++];
+			}
+			while (b < hi) {
+				dst[k++] = src[b++];
+			}
+		}
+		SWAP(src, dst);
+	}
+
+	if (src != p_order) {
+		memcpy(p_order, src, sizeof(int) * p_count);
+	}
+}
+
 void CPUParticles2D::_update_internal() {
 	if (particles.size() == 0 || !is_visible_in_tree()) {
 		_set_do_redraw(false);
@@ -621,43 +654,26 @@ void CPUParticles2D::_update_internal() {
 	_update_particle_data_buffer();
 }
 
-void CPUParticles2D::_particles_process(double p_delta) {
-	p_delta *= speed_scale;
-
-	int pcount = particles.size();
-	Particle *w = particles.ptrw();
+void CPUParticles2D::_particles_process_chunk(uint32_t p_chunk, const ProcessFrame *p_frame) {
+	Particle *parray = p_frame->particles;
+	int pcount = p_frame->particle_count;
+	int from = p_chunk * PARALLEL_CHUNK_SIZE;
+	int to = MIN(from + PARALLEL_CHUNK_SIZE, pcount);
 
-	Particle *parray = w;
+	double delta = p_frame->delta;
+	double prev_time = p_frame->prev_time;
+	double system_phase = p_frame->system_phase;
+	const Transform2D &emission_xform = p_frame->emission_xform;
+	const Transform2D &velocity_xform = p_frame->velocity_xform;
 
-	double prev_time = time;
-	time += p_delta;
-	if (time > lifetime) {
-		time = Math::fmod(time, lifetime);
-		cycle++;
-		if (one_shot && cycle > 0) {
-			set_emitting(false);
-			notify_property_list_changed();
-		}
-	}
-
-	Transform2D emission_xform;
-	Transform2D velocity_xform;
-	if (!local_coords) {
-		emission_xform = get_global_transform();
-		velocity_xform = emission_xform;
-		velocity_xform[2] = Vector2();
-	}
-
-	double system_phase = time / lifetime;
-
-	for (int i = 0; i < pcount; i++) {
+	for (int i = from; i < to; i++) {
 		Particle &p = parray[i];
 
 		if (!emitting && !p.active) {
 			continue;
 		}
 
-		double local_delta = p_delta;
+		double local_delta = delta;
 
 		// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
 		// While we use time in tests later on, for randomness we use the phase as done in the
@@ -732,22 +748,25 @@ void CPUParticles2D::_particles_process(double p_delta) {
 				tex_anim_offset = curve_parameters[PARAM_ANGLE]->sample(tv);
 			}
 
-			p.seed = Math::rand();
+			// Spawn randomness is seeded per particle, so it doesn't depend on the chunks and threads.
+			RandomPCG rng(hash_murmur3_one_32(uint32_t(i), p_frame->seed));
 
-			p.angle_rand = Math::randf();
-			p.scale_rand = Math::randf();
-			p.hue_rot_rand = Math::randf();
-			p.anim_offset_rand = Math::randf();
+			p.seed = rng.rand();
+
+			p.angle_rand = rng.randf();
+			p.scale_rand = rng.randf();
+			p.hue_rot_rand = rng.randf();
+			p.anim_offset_rand = rng.randf();
 
 			if (color_initial_ramp.is_valid()) {
-				p.start_color_rand = color_initial_ramp->get_color_at_offset(Math::randf());
+				p.start_color_rand = color_initial_ramp->get_color_at_offset(rng.randf());
 			} else {
 				p.start_color_rand = Color(1, 1, 1, 1);
 			}
 
-			real_t angle1_rad = direction.angle() + Math::deg_to_rad((Math::randf() * 2.0 - 1.0) * spread);
+			real_t angle1_rad = direction.angle() + Math::deg_to_rad((rng.randf() * 2.0 - 1.0) * spread);
 			Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
-			p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)Math::randf());
+			p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)rng.randf());
 
 			real_t base_angle = tex_angle * Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
 			p.rotation = Math::deg_to_rad(base_angle);
@@ -758,7 +777,7 @@ void CPUParticles2D::_particles_process(double p_delta) {
 			p.custom[3] = 0.0;
 			p.transform = Transform2D();
 			p.time = 0;
-			p.lifetime = lifetime * (1.0 - Math::randf() * lifetime_randomness);
+			p.lifetime = lifetime * (1.0 - rng.randf() * lifetime_randomness);
 			p.base_color = Color(1, 1, 1, 1);
 
 			switch (emission_shape) {
@@ -766,17 +785,17 @@ void CPUParticles2D::_particles_process(double p_delta) {
 					//do none
 				} break;
 				case EMISSION_SHAPE_SPHERE: {
-					real_t t = Math_TAU * Math::randf();
-					real_t radius = emission_sphere_radius * Math::randf();
+					real_t t = Math_TAU * rng.randf();
+					real_t radius = emission_sphere_radius * rng.randf();
 					p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
 				} break;
 				case EMISSION_SHAPE_SPHERE_SURFACE: {
-					real_t s = Math::randf(), t = Math_TAU * Math::randf();
+					real_t s = rng.randf(), t = Math_TAU * rng.randf();
 					real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
 					p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
 				} break;
 				case EMISSION_SHAPE_RECTANGLE: {
-					p.transform[2] = Vector2(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_rect_extents;
+					p.transform[2] = Vector2(rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0) * emission_rect_extents;
 				} break;
 				case EMISSION_SHAPE_POINTS:
 				case EMISSION_SHAPE_DIRECTED_POINTS: {
@@ -785,7 +804,7 @@ void CPUParticles2D::_particles_process(double p_delta) {
 						break;
 					}
 
-					int random_idx = Math::rand() % pc;
+					int random_idx = rng.rand() % pc;
 
 					p.transform[2] = emission_points.get(random_idx);
 
@@ -997,33 +1016,69 @@ void CPUParticles2D::_particles_process(double p_delta) {
 	}
 }
 
-void CPUParticles2D::_update_particle_data_buffer() {
-	MutexLock lock(update_mutex);
+void CPUParticles2D::_particles_process(double p_delta) {
+	p_delta *= speed_scale;
 
-	int pc = particles.size();
+	ProcessFrame frame;
+	frame.particles = particles.ptrw();
+	frame.particle_count = particles.size();
+	frame.delta = p_delta;
+	frame.prev_time = time;
+
+	time += p_delta;
+	if (time > lifetime) {
+		time = Math::fmod(time, lifetime);
+		cycle++;
+		if (one_shot && cycle > 0) {
+			set_emitting(false);
+			notify_property_list_changed();
+		}
+	}
 
-	int *ow;
-	int *order = nullptr;
+	if (!local_coords) {
+		frame.emission_xform = get_global_transform();
+		frame.velocity_xform = frame.emission_xform;
+		frame.velocity_xform[2] = Vector2();
+	}
 
-	float *w = particle_data.ptrw();
-	const Particle *r = particles.ptr();
-	float *ptr = w;
+	frame.system_phase = time / lifetime;
+	// Drawn from the global generator, so seeding it still makes the simulation reproducible.
+	frame.seed = Math::rand();
 
-	if (draw_order != DRAW_ORDER_INDEX) {
-		ow = particle_order.ptrw();
-		order = ow;
+	// Gradients sort their points on first use, do it here rather than concurrently in the chunks.
+	if (color_ramp.is_valid()) {
+		color_ramp->update_sorting();
+	}
+	if (color_initial_ramp.is_valid()) {
+		color_initial_ramp->update_sorting();
+	}
 
-		for (int i = 0; i < pc; i++) {
-			order[i] = i;
-		}
-		if (draw_order == DRAW_ORDER_LIFETIME) {
-			SortArray<int, SortLifetime> sorter;
-			sorter.compare.particles = r;
-			sorter.sort(order, pc);
-		}
+	int chunk_count = (frame.particle_count + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+	if (chunk_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles2D::_particles_process_chunk, (const ProcessFrame *)&frame, chunk_count, -1, true, SNAME("CPUParticles2DProcess"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (chunk_count == 1) {
+		_particles_process_chunk(0, &frame);
 	}
+}
 
-	for (int i = 0; i < pc; i++) {
+void CPUParticles2D::_sort_particle_order_chunk(uint32_t p_chunk, const UpdateFrame *p_frame) {
+	int from = p_chunk * PARALLEL_CHUNK_SIZE;
+	int count = MIN(PARALLEL_CHUNK_SIZE, p_frame->particle_count - from);
+
+	SortArray<int, SortLifetime> sorter;
+	sorter.compare.particles = p_frame->particles;
+	sorter.sort(p_frame->order + from, count);
+}
+
+void CPUParticles2D::_update_particle_data_chunk(uint32_t p_chunk, const UpdateFrame *p_frame) {
+	const Particle *r = p_frame->particles;
+	const int *order = p_frame->order;
+	int from = p_chunk * PARALLEL_CHUNK_SIZE;
+	int to = MIN(from + PARALLEL_CHUNK_SIZE, p_frame->particle_count);
+	float *ptr = p_frame->data + from * 16;
+
+	for (int i = from; i < to; i++) {
 		int idx = order ? order[i] : i;
 
 		Transform2D t = r[idx].transform;
@@ -1062,6 +1117,50 @@ void CPUParticles2D::_update_particle_data_buffer() {
 	}
 }
 
+void CPUParticles2D::_update_particle_data_buffer() {
+	MutexLock lock(update_mutex);
+
+	UpdateFrame frame;
+	frame.particles = particles.ptr();
+	frame.particle_count = particles.size();
+	frame.data = particle_data.ptrw();
+
+	int chunk_count = (frame.particle_count + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+	if (chunk_count == 0) {
+		return;
+	}
+
+	if (draw_order != DRAW_ORDER_INDEX) {
+		frame.order = particle_order.ptrw();
+
+		for (int i = 0; i < frame.particle_count; i++) {
+			frame.order[i] = i;
+		}
+
+		bool sort = draw_order == DRAW_ORDER_LIFETIME;
+
+		if (sort && chunk_count > 1) {
+			// Sort the chunks in parallel, then merge them here.
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles2D::_sort_particle_order_chunk, (const UpdateFrame *)&frame, chunk_count, -1, true, SNAME("CPUParticles2DSort"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+			particle_order_merge.resize(frame.particle_count);
+			SortLifetime compare;
+			compare.particles = frame.particles;
+			_merge_sorted_runs(frame.order, particle_order_merge.ptr(), frame.particle_count, PARALLEL_CHUNK_SIZE, compare);
+		} else if (sort) {
+			_sort_particle_order_chunk(0, &frame);
+		}
+	}
+
+	if (chunk_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles2D::_update_particle_data_chunk, (const UpdateFrame *)&frame, chunk_count, -1, true, SNAME("CPUParticles2DUpdateBuffer"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_update_particle_data_chunk(0, &frame);
+	}
+}
+
 void CPUParticles2D::_set_do_redraw(bool p_do_redraw) {
 	if (do_redraw == p_do_redraw) {
 		return;
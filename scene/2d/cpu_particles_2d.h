@@ -31,6 +31,7 @@
 #ifndef CPU_PARTICLES_2D_H
 #define CPU_PARTICLES_2D_H
 
+#include "core/templates/local_vector.h"
 #include "scene/2d/node_2d.h"
 
 class CPUParticles2D : public Node2D {
@@ -176,8 +177,34 @@ private:
 
 	Vector2 gravity = Vector2(0, 980);
 
+	// Particles are processed, sorted and copied to the buffer in chunks of this size on the WorkerThreadPool.
+	static constexpr int PARALLEL_CHUNK_SIZE = 256;
+
+	struct ProcessFrame {
+		Particle *particles = nullptr;
+		int particle_count = 0;
+		double delta = 0.0;
+		double prev_time = 0.0;
+		double system_phase = 0.0;
+		Transform2D emission_xform;
+		Transform2D velocity_xform;
+		uint32_t seed = 0;
+	};
+
+	struct UpdateFrame {
+		const Particle *particles = nullptr;
+		int particle_count = 0;
+		int *order = nullptr;
+		float *data = nullptr;
+	};
+
+	LocalVector<int> particle_order_merge;
+
 	void _update_internal();
+	void _particles_process_chunk(uint32_t p_chunk, const ProcessFrame *p_frame);
 	void _particles_process(double p_delta);
+	void _sort_particle_order_chunk(uint32_t p_chunk, const UpdateFrame *p_frame);
+	void _update_particle_data_chunk(uint32_t p_chunk, const UpdateFrame *p_frame);
 	void _update_particle_data_buffer();
 
 	Mutex update_mutex;
@@ -423,6 +423,10 @@ Point2 Node2D::to_global(Point2 p_local) const {
 	return get_global_transform().xform(p_local);
 }
 
+void Node2D::_physics_interpolated_changed() {
+	RenderingServer::get_singleton()->canvas_item_set_interpolated(get_canvas_item(), is_physics_interpolated());
+}
+
 void Node2D::_notification(int p_notification) {
 	ERR_THREAD_GUARD;
 	switch (p_notification) {
@@ -430,6 +434,15 @@ void Node2D::_notification(int p_notification) {
 			if (get_viewport()) {
 				get_parent()->connect(SNAME("child_order_changed"), callable_mp(get_viewport(), &Viewport::gui_set_root_order_dirty), CONNECT_REFERENCE_COUNTED);
 			}
+
+			RenderingServer::get_singleton()->canvas_item_set_interpolated(get_canvas_item(), is_physics_interpolated());
+			if (is_physics_interpolated_and_enabled()) {
+				// Don't interpolate from transforms set before entering the tree.
+				RenderingServer::get_singleton()->canvas_item_reset_physics_interpolation(get_canvas_item());
+			}
+		} break;
+		case NOTIFICATION_RESET_PHYSICS_INTERPOLATION: {
+			RenderingServer::get_singleton()->canvas_item_reset_physics_interpolation(get_canvas_item());
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
 			if (get_viewport()) {
@@ -52,6 +52,8 @@ class Node2D : public CanvasItem {
 	void _update_xform_values() const;
 
 protected:
+	virtual void _physics_interpolated_changed() override;
+
 	void _notification(int p_notification);
 	static void _bind_methods();
 
@@ -30,6 +30,8 @@
 
 #include "cpu_particles_3d.h"
 
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/3d/camera_3d.h"
 #include "scene/3d/gpu_particles_3d.h"
 #include "scene/main/viewport.h"
@@ -568,6 +570,37 @@ static real_t rand_from_seed(uint32_t &seed) {
 	return (seed % uint32_t(65536)) / 65535.0;
 }
 
+// Merges the sorted runs of p_run_size elements left in p_order after sorting it in chunks.
+template <class C>
+static void _merge_sorted_runs(int *p_order, int *p_temp, int p_count, int p_run_size, const C &p_compare) {
+	int *src = p_order;
+	int *dst = p_temp;
+
+	for (int width = p_run_size; width < p_count; width *= 2) {
+		for (int lo = 0; lo < p_count; lo += width * 2) {
+			int mid = MIN(lo + width, p_count);
+			int hi = MIN(lo + width * 2, p_count);
+			int a = lo;
+			int b = mid;
+			int k = lo;
+			while (a < mid && b < hi) {
+				dst[k++] = p_compare(src[b], src[a]) ? src[b++] : src[a++];
+			}
+			while (a < mid) {
+				dst[k++] = src[a++];
+			}
+			while (b < hi) {
+				dst[k++] = src[b++];
+			}
+		}
+		SWAP(src, dst);
+	}
+
+	if (src != p_order) {
+		memcpy(p_order, src, sizeof(int) * p_count);
+	}
+}
+
 void CPUParticles3D::_update_internal() {
 	if (particles.size() == 0 || !is_visible_in_tree()) {
 		_set_redraw(false);
@@ -642,42 +675,26 @@ void CPUParticles3D::_update_internal() {
 	}
 }
 
-void CPUParticles3D::_particles_process(double p_delta) {
-	p_delta *= speed_scale;
-
-	int pcount = particles.size();
-	Particle *w = particles.ptrw();
-
-	Particle *parray = w;
-
-	double prev_time = time;
-	time += p_delta;
-	if (time > lifetime) {
-		time = Math::fmod(time, lifetime);
-		cycle++;
-		if (one_shot && cycle > 0) {
-			set_emitting(false);
-			notify_property_list_changed();
-		}
-	}
-
-	Transform3D emission_xform;
-	Basis velocity_xform;
-	if (!local_coords) {
-		emission_xform = get_global_transform();
-		velocity_xform = emission_xform.basis;
-	}
+void CPUParticles3D::_particles_process_chunk(uint32_t p_chunk, const ProcessFrame *p_frame) {
+	Particle *parray = p_frame->particles;
+	int pcount = p_frame->particle_count;
+	int from = p_chunk * PARALLEL_CHUNK_SIZE;
+	int to = MIN(from + PARALLEL_CHUNK_SIZE, pcount);
 
-	double system_phase = time / lifetime;
+	double delta = p_frame->delta;
+	double prev_time = p_frame->prev_time;
+	double system_phase = p_frame->system_phase;
+	const Transform3D &emission_xform = p_frame->emission_xform;
+	const Basis &velocity_xform = p_frame->velocity_xform;
 
-	for (int i = 0; i < pcount; i++) {
+	for (int i = from; i < to; i++) {
 		Particle &p = parray[i];
 
 		if (!emitting && !p.active) {
 			continue;
 		}
 
-		double local_delta = p_delta;
+		double local_delta = delta;
 
 		// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
 		// While we use time in tests later on, for randomness we use the phase as done in the
@@ -752,27 +769,30 @@ void CPUParticles3D::_particles_process(double p_delta) {
 				tex_anim_offset = curve_parameters[PARAM_ANGLE]->sample(tv);
 			}
 
-			p.seed = Math::rand();
+			// Spawn randomness is seeded per particle, so it doesn't depend on the chunks and threads.
+			RandomPCG rng(hash_murmur3_one_32(uint32_t(i), p_frame->seed));
 
-			p.angle_rand = Math::randf();
-			p.scale_rand = Math::randf();
-			p.hue_rot_rand = Math::randf();
-			p.anim_offset_rand = Math::randf();
+			p.seed = rng.rand();
+
+			p.angle_rand = rng.randf();
+			p.scale_rand = rng.randf();
+			p.hue_rot_rand = rng.randf();
+			p.anim_offset_rand = rng.randf();
 
 			if (color_initial_ramp.is_valid()) {
-				p.start_color_rand = color_initial_ramp->get_color_at_offset(Math::randf());
+				p.start_color_rand = color_initial_ramp->get_color_at_offset(rng.randf());
 			} else {
 				p.start_color_rand = Color(1, 1, 1, 1);
 			}
 
 			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-				real_t angle1_rad = Math::atan2(direction.y, direction.x) + Math::deg_to_rad((Math::randf() * 2.0 - 1.0) * spread);
+				real_t angle1_rad = Math::atan2(direction.y, direction.x) + Math::deg_to_rad((rng.randf() * 2.0 - 1.0) * spread);
 				Vector3 rot = Vector3(Math::cos(angle1_rad), Math::sin(angle1_rad), 0.0);
-				p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)Math::randf());
+				p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)rng.randf());
 			} else {
 				//initiate velocity spread in 3D
-				real_t angle1_rad = Math::deg_to_rad((Math::randf() * (real_t)2.0 - (real_t)1.0) * spread);
-				real_t angle2_rad = Math::deg_to_rad((Math::randf() * (real_t)2.0 - (real_t)1.0) * ((real_t)1.0 - flatness) * spread);
+				real_t angle1_rad = Math::deg_to_rad((rng.randf() * (real_t)2.0 - (real_t)1.0) * spread);
+				real_t angle2_rad = Math::deg_to_rad((rng.randf() * (real_t)2.0 - (real_t)1.0) * ((real_t)1.0 - flatness) * spread);
 
 				Vector3 direction_xz = Vector3(Math::sin(angle1_rad), 0, Math::cos(angle1_rad));
 				Vector3 direction_yz = Vector3(0, Math::sin(angle2_rad), Math::cos(angle2_rad));
@@ -792,7 +812,7 @@ void CPUParticles3D::_particles_process(double p_delta) {
 				binormal.normalize();
 				Vector3 normal = binormal.cross(direction_nrm);
 				spread_direction = binormal * spread_direction.x + normal * spread_direction.y + direction_nrm * spread_direction.z;
-				p.velocity = spread_direction * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)Math::randf());
+				p.velocity = spread_direction * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)rng.randf());
 			}
 
 			real_t base_angle = tex_angle * Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
@@ -801,7 +821,7 @@ void CPUParticles3D::_particles_process(double p_delta) {
 			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand); //animation offset (0-1)
 			p.transform = Transform3D();
 			p.time = 0;
-			p.lifetime = lifetime * (1.0 - Math::randf() * lifetime_randomness);
+			p.lifetime = lifetime * (1.0 - rng.randf() * lifetime_randomness);
 			p.base_color = Color(1, 1, 1, 1);
 
 			switch (emission_shape) {
@@ -809,20 +829,20 @@ void CPUParticles3D::_particles_process(double p_delta) {
 					//do none
 				} break;
 				case EMISSION_SHAPE_SPHERE: {
-					real_t s = 2.0 * Math::randf() - 1.0;
-					real_t t = Math_TAU * Math::randf();
-					real_t x = Math::randf();
+					real_t s = 2.0 * rng.randf() - 1.0;
+					real_t t = Math_TAU * rng.randf();
+					real_t x = rng.randf();
 					real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
 					p.transform.origin = Vector3(0, 0, 0).lerp(Vector3(radius * Math::cos(t), radius * Math::sin(t), emission_sphere_radius * s), x);
 				} break;
 				case EMISSION_SHAPE_SPHERE_SURFACE: {
-					real_t s = 2.0 * Math::randf() - 1.0;
-					real_t t = Math_TAU * Math::randf();
+					real_t s = 2.0 * rng.randf() - 1.0;
+					real_t t = Math_TAU * rng.randf();
 					real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
 					p.transform.origin = Vector3(radius * Math::cos(t), radius * Math::sin(t), emission_sphere_radius * s);
 				} break;
 				case EMISSION_SHAPE_BOX: {
-					p.transform.origin = Vector3(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_box_extents;
+					p.transform.origin = Vector3(rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0) * emission_box_extents;
 				} break;
 				case EMISSION_SHAPE_POINTS:
 				case EMISSION_SHAPE_DIRECTED_POINTS: {
@@ -831,7 +851,7 @@ void CPUParticles3D::_particles_process(double p_delta) {
 						break;
 					}
 
-					int random_idx = Math::rand() % pc;
+					int random_idx = rng.rand() % pc;
 
 					p.transform.origin = emission_points.get(random_idx);
 
@@ -864,8 +884,8 @@ void CPUParticles3D::_particles_process(double p_delta) {
 					}
 				} break;
 				case EMISSION_SHAPE_RING: {
-					real_t ring_random_angle = Math::randf() * Math_TAU;
-					real_t ring_random_radius = Math::randf() * (emission_ring_radius - emission_ring_inner_radius) + emission_ring_inner_radius;
+					real_t ring_random_angle = rng.randf() * Math_TAU;
+					real_t ring_random_radius = rng.randf() * (emission_ring_radius - emission_ring_inner_radius) + emission_ring_inner_radius;
 					Vector3 axis = emission_ring_axis.normalized();
 					Vector3 ortho_axis;
 					if (axis == Vector3(1.0, 0.0, 0.0)) {
@@ -876,7 +896,7 @@ void CPUParticles3D::_particles_process(double p_delta) {
 					ortho_axis = ortho_axis.normalized();
 					ortho_axis.rotate(axis, ring_random_angle);
 					ortho_axis = ortho_axis.normalized();
-					p.transform.origin = ortho_axis * ring_random_radius + (Math::randf() * emission_ring_height - emission_ring_height / 2.0) * axis;
+					p.transform.origin = ortho_axis * ring_random_radius + (rng.randf() * emission_ring_height - emission_ring_height / 2.0) * axis;
 				} break;
 				case EMISSION_SHAPE_MAX: { // Max value for validity check.
 					break;
@@ -1139,52 +1159,75 @@ void CPUParticles3D::_particles_process(double p_delta) {
 	}
 }
 
-void CPUParticles3D::_update_particle_data_buffer() {
-	MutexLock lock(update_mutex);
+void CPUParticles3D::_particles_process(double p_delta) {
+	p_delta *= speed_scale;
 
-	int pc = particles.size();
+	ProcessFrame frame;
+	frame.particles = particles.ptrw();
+	frame.particle_count = particles.size();
+	frame.delta = p_delta;
+	frame.prev_time = time;
 
-	int *ow;
-	int *order = nullptr;
+	time += p_delta;
+	if (time > lifetime) {
+		time = Math::fmod(time, lifetime);
+		cycle++;
+		if (one_shot && cycle > 0) {
+			set_emitting(false);
+			notify_property_list_changed();
+		}
+	}
 
-	float *w = particle_data.ptrw();
-	const Particle *r = particles.ptr();
-	float *ptr = w;
+	if (!local_coords) {
+		frame.emission_xform = get_global_transform();
+		frame.velocity_xform = frame.emission_xform.basis;
+	}
 
-	if (draw_order != DRAW_ORDER_INDEX) {
-		ow = particle_order.ptrw();
-		order = ow;
+	frame.system_phase = time / lifetime;
+	// Drawn from the global generator, so seeding it still makes the simulation reproducible.
+	frame.seed = Math::rand();
 
-		for (int i = 0; i < pc; i++) {
-			order[i] = i;
-		}
-		if (draw_order == DRAW_ORDER_LIFETIME) {
-			SortArray<int, SortLifetime> sorter;
-			sorter.compare.particles = r;
-			sorter.sort(order, pc);
-		} else if (draw_order == DRAW_ORDER_VIEW_DEPTH) {
-			ERR_FAIL_NULL(get_viewport());
-			Camera3D *c = get_viewport()->get_camera_3d();
-			if (c) {
-				Vector3 dir = c->get_global_transform().basis.get_column(2); //far away to close
+	// Gradients sort their points on first use, do it here rather than concurrently in the chunks.
+	if (color_ramp.is_valid()) {
+		color_ramp->update_sorting();
+	}
+	if (color_initial_ramp.is_valid()) {
+		color_initial_ramp->update_sorting();
+	}
 
-				if (local_coords) {
-					// will look different from Particles in editor as this is based on the camera in the scenetree
-					// and not the editor camera
-					dir = inv_emission_transform.xform(dir).normalized();
-				} else {
-					dir = dir.normalized();
-				}
+	int chunk_count = (frame.particle_count + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+	if (chunk_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles3D::_particles_process_chunk, (const ProcessFrame *)&frame, chunk_count, -1, true, SNAME("CPUParticles3DProcess"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (chunk_count == 1) {
+		_particles_process_chunk(0, &frame);
+	}
+}
 
-				SortArray<int, SortAxis> sorter;
-				sorter.compare.particles = r;
-				sorter.compare.axis = dir;
-				sorter.sort(order, pc);
-			}
-		}
+void CPUParticles3D::_sort_particle_order_chunk(uint32_t p_chunk, const UpdateFrame *p_frame) {
+	int from = p_chunk * PARALLEL_CHUNK_SIZE;
+	int count = MIN(PARALLEL_CHUNK_SIZE, p_frame->particle_count - from);
+
+	if (draw_order == DRAW_ORDER_LIFETIME) {
+		SortArray<int, SortLifetime> sorter;
+		sorter.compare.particles = p_frame->particles;
+		sorter.sort(p_frame->order + from, count);
+	} else {
+		SortArray<int, SortAxis> sorter;
+		sorter.compare.particles = p_frame->particles;
+		sorter.compare.axis = p_frame->sort_axis;
+		sorter.sort(p_frame->order + from, count);
 	}
+}
 
-	for (int i = 0; i < pc; i++) {
+void CPUParticles3D::_update_particle_data_chunk(uint32_t p_chunk, const UpdateFrame *p_frame) {
+	const Particle *r = p_frame->particles;
+	const int *order = p_frame->order;
+	int from = p_chunk * PARALLEL_CHUNK_SIZE;
+	int to = MIN(from + PARALLEL_CHUNK_SIZE, p_frame->particle_count);
+	float *ptr = p_frame->data + from * 20;
+
+	for (int i = from; i < to; i++) {
 		int idx = order ? order[i] : i;
 
 		Transform3D t = r[idx].transform;
@@ -1224,8 +1267,78 @@ void CPUParticles3D::_update_particle_data_buffer() {
 
 		ptr += 20;
 	}
+}
 
+void CPUParticles3D::_update_particle_data_buffer() {
+	MutexLock lock(update_mutex);
+
+	// Set on every path, the render thread only reads the buffer once the lock is released.
 	can_update.set();
+
+	UpdateFrame frame;
+	frame.particles = particles.ptr();
+	frame.particle_count = particles.size();
+	frame.data = particle_data.ptrw();
+
+	int chunk_count = (frame.particle_count + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+	if (chunk_count == 0) {
+		return;
+	}
+
+	if (draw_order != DRAW_ORDER_INDEX) {
+		frame.order = particle_order.ptrw();
+
+		for (int i = 0; i < frame.particle_count; i++) {
+			frame.order[i] = i;
+		}
+
+		bool sort = draw_order == DRAW_ORDER_LIFETIME;
+		if (draw_order == DRAW_ORDER_VIEW_DEPTH) {
+			ERR_FAIL_NULL(get_viewport());
+			Camera3D *c = get_viewport()->get_camera_3d();
+			if (c) {
+				Vector3 dir = c->get_global_transform().basis.get_column(2); //far away to close
+
+				if (local_coords) {
+					// will look different from Particles in editor as this is based on the camera in the scenetree
+					// and not the editor camera
+					dir = inv_emission_transform.xform(dir).normalized();
+				} else {
+					dir = dir.normalized();
+				}
+
+				frame.sort_axis = dir;
+				sort = true;
+			}
+		}
+
+		if (sort && chunk_count > 1) {
+			// Sort the chunks in parallel, then merge them here.
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles3D::_sort_particle_order_chunk, (const UpdateFrame *)&frame, chunk_count, -1, true, SNAME("CPUParticles3DSort"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+			particle_order_merge.resize(frame.particle_count);
+			if (draw_order == DRAW_ORDER_LIFETIME) {
+				SortLifetime compare;
+				compare.particles = frame.particles;
+				_merge_sorted_runs(frame.order, particle_order_merge.ptr(), frame.particle_count, PARALLEL_CHUNK_SIZE, compare);
+			} else {
+				SortAxis compare;
+				compare.particles = frame.particles;
+				compare.axis = frame.sort_axis;
+				_merge_sorted_runs(frame.order, particle_order_merge.ptr(), frame.particle_count, PARALLEL_CHUNK_SIZE, compare);
+			}
+		} else if (sort) {
+			_sort_particle_order_chunk(0, &frame);
+		}
+	}
+
+	if (chunk_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles3D::_update_particle_data_chunk, (const UpdateFrame *)&frame, chunk_count, -1, true, SNAME("CPUParticles3DUpdateBuffer"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_update_particle_data_chunk(0, &frame);
+	}
 }
 
 void CPUParticles3D::_set_redraw(bool p_redraw) {
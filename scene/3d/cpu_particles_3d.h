@@ -31,6 +31,7 @@
 #ifndef CPU_PARTICLES_3D_H
 #define CPU_PARTICLES_3D_H
 
+#include "core/templates/local_vector.h"
 #include "scene/3d/visual_instance_3d.h"
 
 class CPUParticles3D : public GeometryInstance3D {
@@ -185,8 +186,35 @@ private:
 
 	Vector3 gravity = Vector3(0, -9.8, 0);
 
+	// Particles are processed, sorted and copied to the buffer in chunks of this size on the WorkerThreadPool.
+	static constexpr int PARALLEL_CHUNK_SIZE = 256;
+
+	struct ProcessFrame {
+		Particle *particles = nullptr;
+		int particle_count = 0;
+		double delta = 0.0;
+		double prev_time = 0.0;
+		double system_phase = 0.0;
+		Transform3D emission_xform;
+		Basis velocity_xform;
+		uint32_t seed = 0;
+	};
+
+	struct UpdateFrame {
+		const Particle *particles = nullptr;
+		int particle_count = 0;
+		int *order = nullptr;
+		float *data = nullptr;
+		Vector3 sort_axis;
+	};
+
+	LocalVector<int> particle_order_merge;
+
 	void _update_internal();
+	void _particles_process_chunk(uint32_t p_chunk, const ProcessFrame *p_frame);
 	void _particles_process(double p_delta);
+	void _sort_particle_order_chunk(uint32_t p_chunk, const UpdateFrame *p_frame);
+	void _update_particle_data_chunk(uint32_t p_chunk, const UpdateFrame *p_frame);
 	void _update_particle_data_buffer();
 
 	Mutex update_mutex;
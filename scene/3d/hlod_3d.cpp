@@ -0,0 +1,465 @@
+/**************************************************************************/
+/*  hlod_3d.cpp                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "hlod_3d.h"
+
+#include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/3d/skeleton_3d.h"
+#include "scene/resources/material.h"
+#include "scene/resources/mesh.h"
+#include "scene/resources/surface_tool.h"
+#include "scene/resources/texture.h"
+
+void HLOD3D::set_bake_mask(uint32_t p_mask) {
+	bake_mask = p_mask;
+	update_configuration_warnings();
+}
+
+uint32_t HLOD3D::get_bake_mask() const {
+	return bake_mask;
+}
+
+void HLOD3D::set_bake_mask_value(int p_layer_number, bool p_value) {
+	ERR_FAIL_COND_MSG(p_layer_number < 1, "Render layer number must be between 1 and 20 inclusive.");
+	ERR_FAIL_COND_MSG(p_layer_number > 20, "Render layer number must be between 1 and 20 inclusive.");
+	uint32_t mask = get_bake_mask();
+	if (p_value) {
+		mask |= 1 << (p_layer_number - 1);
+	} else {
+		mask &= ~(1 << (p_layer_number - 1));
+	}
+	set_bake_mask(mask);
+}
+
+bool HLOD3D::get_bake_mask_value(int p_layer_number) const {
+	ERR_FAIL_COND_V_MSG(p_layer_number < 1, false, "Render layer number must be between 1 and 20 inclusive.");
+	ERR_FAIL_COND_V_MSG(p_layer_number > 20, false, "Render layer number must be between 1 and 20 inclusive.");
+	return bake_mask & (1 << (p_layer_number - 1));
+}
+
+void HLOD3D::set_bake_cluster_size(float p_size) {
+	ERR_FAIL_COND(p_size <= 0.0);
+	bake_cluster_size = p_size;
+}
+
+float HLOD3D::get_bake_cluster_size() const {
+	return bake_cluster_size;
+}
+
+void HLOD3D::set_bake_simplification_distance(float p_distance) {
+	bake_simplification_distance = MAX(p_distance, 0.0f);
+}
+
+float HLOD3D::get_bake_simplification_distance() const {
+	return bake_simplification_distance;
+}
+
+void HLOD3D::set_bake_atlas_size(int p_size) {
+	bake_atlas_size = CLAMP(p_size, 16, 16384);
+}
+
+int HLOD3D::get_bake_atlas_size() const {
+	return bake_atlas_size;
+}
+
+void HLOD3D::set_bake_visibility_range(float p_range) {
+	bake_visibility_range = MAX(p_range, 0.0f);
+}
+
+float HLOD3D::get_bake_visibility_range() const {
+	return bake_visibility_range;
+}
+
+bool HLOD3D::_is_proxy(Node *p_node) const {
+	return p_node->get_parent() == this && p_node->has_meta(SNAME("_hlod_proxy")) && Object::cast_to<MeshInstance3D>(p_node);
+}
+
+bool HLOD3D::_is_source_valid(MeshInstance3D *p_instance) const {
+	if (!p_instance->is_visible_in_tree() || (p_instance->get_layer_mask() & bake_mask) == 0) {
+		return false;
+	}
+	if (is_ancestor_of(p_instance)) {
+		return false; // Under this node, like the proxies.
+	}
+	if (!p_instance->get_visibility_parent().is_empty() || p_instance->get_visibility_range_end() > 0.0) {
+		return false; // Already part of a manual LOD setup.
+	}
+
+	Ref<Mesh> mesh = p_instance->get_mesh();
+	if (mesh.is_null() || p_instance->get_skin().is_valid()) {
+		return false;
+	}
+	for (int i = 0; i < mesh->get_surface_count(); i++) {
+		if (mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_BONES) {
+			return false; // Skinned, not static.
+		}
+	}
+	return true;
+}
+
+void HLOD3D::_gather_sources(Node *p_node, LocalVector<MeshInstance3D *> &r_instances) {
+	MeshInstance3D *mi = Object::cast_to<MeshInstance3D>(p_node);
+	if (mi && _is_source_valid(mi)) {
+		r_instances.push_back(mi);
+	}
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		Node *child = p_node->get_child(i);
+		if (!child->get_owner()) {
+			continue; // may be a helper
+		}
+
+		_gather_sources(child, r_instances);
+	}
+}
+
+void HLOD3D::_gather_surfaces(MeshInstance3D *p_instance, Cluster &r_cluster) {
+	Ref<Mesh> mesh = p_instance->get_mesh();
+	Transform3D xform = get_global_transform().affine_inverse() * p_instance->get_global_transform();
+
+	for (int i = 0; i < mesh->get_surface_count(); i++) {
+		if (mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
+			continue;
+		}
+
+		SourceSurface surface;
+		Ref<BaseMaterial3D> material = p_instance->get_active_material(i);
+		if (material.is_valid()) {
+			if (material->get_transparency() != BaseMaterial3D::TRANSPARENCY_DISABLED) {
+				continue; // The proxy material is opaque.
+			}
+			surface.albedo_color = material->get_albedo();
+			Ref<Texture2D> texture = material->get_texture(BaseMaterial3D::TEXTURE_ALBEDO);
+			if (texture.is_valid()) {
+				// Shared by the clusters, the bake threads work on copies.
+				surface.albedo_image = texture->get_image();
+			}
+		}
+
+		surface.transform = xform;
+		surface.arrays = mesh->surface_get_arrays(i);
+		if (PackedVector3Array(surface.arrays[Mesh::ARRAY_VERTEX]).is_empty()) {
+			continue;
+		}
+		r_cluster.surfaces.push_back(surface);
+	}
+}
+
+void HLOD3D::_bake_cluster(uint32_t p_index, void *p_userdata) {
+	Cluster &cluster = bake_clusters[p_index];
+
+	// Every surface gets a tile of the same size in the atlas.
+	const int grid = Math::ceil(Math::sqrt(float(cluster.surfaces.size())));
+	const int tile_size = MAX(bake_atlas_size / grid, 4);
+	const int padding = MIN(2, tile_size / 4);
+	const int inner_size = tile_size - padding * 2;
+	const int atlas_size = grid * tile_size;
+	cluster.atlas = Image::create_empty(atlas_size, atlas_size, false, Image::FORMAT_RGBA8);
+
+	for (uint32_t i = 0; i < cluster.surfaces.size(); i++) {
+		const SourceSurface &surface = cluster.surfaces[i];
+		const Point2i tile_pos = Point2i(i % grid, i / grid) * tile_size;
+
+		if (surface.albedo_image.is_valid() && !surface.albedo_image->is_empty()) {
+			Ref<Image> image = surface.albedo_image->duplicate();
+			if (image->is_compressed()) {
+				image->decompress();
+			}
+			image->clear_mipmaps();
+			image->convert(Image::FORMAT_RGBA8);
+			image->resize(inner_size, inner_size);
+
+			// Fill the padding with the edge texels, so filtering doesn't bleed between tiles.
+			for (int y = 0; y < tile_size; y++) {
+				for (int x = 0; x < tile_size; x++) {
+					Color color = image->get_pixel(CLAMP(x - padding, 0, inner_size - 1), CLAMP(y - padding, 0, inner_size - 1));
+					cluster.atlas->set_pixel(tile_pos.x + x, tile_pos.y + y, color * surface.albedo_color);
+				}
+			}
+		} else {
+			cluster.atlas->fill_rect(Rect2i(tile_pos, Size2i(tile_size, tile_size)), surface.albedo_color);
+		}
+	}
+	cluster.atlas->generate_mipmaps();
+
+	// Merge the surfaces, remapping their UVs to their tile. UVs outside of the 0-1 range (repeating textures) are clamped.
+	LocalVector<Vector3> vertices;
+	LocalVector<Vector3> normals;
+	LocalVector<Vector2> uvs;
+	LocalVector<int> indices;
+
+	for (uint32_t i = 0; i < cluster.surfaces.size(); i++) {
+		const SourceSurface &surface = cluster.surfaces[i];
+		const Vector2 uv_offset = Vector2(Point2i(i % grid, i / grid) * tile_size + Point2i(padding, padding)) / atlas_size;
+		const Vector2 uv_scale = Vector2(inner_size, inner_size) / atlas_size;
+		const Basis normal_basis = surface.transform.basis.inverse().transposed();
+
+		PackedVector3Array src_vertices = surface.arrays[Mesh::ARRAY_VERTEX];
+		PackedVector3Array src_normals = surface.arrays[Mesh::ARRAY_NORMAL];
+		PackedVector2Array src_uvs = surface.arrays[Mesh::ARRAY_TEX_UV];
+		PackedInt32Array src_indices = surface.arrays[Mesh::ARRAY_INDEX];
+
+		const int vertex_offset = vertices.size();
+		for (int j = 0; j < src_vertices.size(); j++) {
+			vertices.push_back(surface.transform.xform(src_vertices[j]));
+			normals.push_back(j < src_normals.size() ? normal_basis.xform(src_normals[j]).normalized() : Vector3(0, 1, 0));
+			Vector2 uv = j < src_uvs.size() ? src_uvs[j].clamp(Vector2(), Vector2(1, 1)) : Vector2(0.5, 0.5);
+			uvs.push_back(uv_offset + uv * uv_scale);
+		}
+
+		if (src_indices.is_empty()) {
+			for (int j = 0; j < src_vertices.size(); j++) {
+				indices.push_back(vertex_offset + j);
+			}
+		} else {
+			for (int j = 0; j < src_indices.size(); j++) {
+				indices.push_back(vertex_offset + src_indices[j]);
+			}
+		}
+	}
+
+	if (SurfaceTool::simplify_func && bake_simplification_distance > 0.0 && indices.size() > 3) {
+		Vector<float> vertices_f32 = vector3_to_float32_array(vertices.ptr(), vertices.size());
+
+		// The target is the error, not the index count.
+		float error_scale = SurfaceTool::simplify_scale_func(vertices_f32.ptr(), vertices.size(), sizeof(float) * 3);
+		float target_error = bake_simplification_distance / error_scale;
+		float error = -1.0f;
+
+		uint32_t index_count = SurfaceTool::simplify_func(
+				(unsigned int *)indices.ptr(),
+				(unsigned int *)indices.ptr(),
+				indices.size(),
+				vertices_f32.ptr(), vertices.size(), sizeof(float) * 3,
+				3, target_error, 0, &error);
+		indices.resize(index_count);
+	}
+
+	// Only keep the vertices still referenced after simplification.
+	LocalVector<int> remap;
+	remap.resize(vertices.size());
+	for (uint32_t i = 0; i < remap.size(); i++) {
+		remap[i] = -1;
+	}
+
+	cluster.indices.resize(indices.size());
+	int *indices_ptr = cluster.indices.ptrw();
+	for (uint32_t i = 0; i < indices.size(); i++) {
+		int &index = remap[indices[i]];
+		if (index == -1) {
+			index = cluster.vertices.size();
+			cluster.vertices.push_back(vertices[indices[i]]);
+			cluster.normals.push_back(normals[indices[i]]);
+			cluster.uvs.push_back(uvs[indices[i]]);
+		}
+		indices_ptr[i] = index;
+	}
+}
+
+float HLOD3D::_get_cluster_visibility_range(const Cluster &p_cluster) const {
+	if (bake_visibility_range > 0.0) {
+		return bake_visibility_range;
+	}
+
+	// Switch once the simplification error is around a pixel (at 1080p with a 75 degree FOV, a meter covers ~700 pixels
+	// at a distance of one meter), but never while the camera may be within the cluster.
+	return MAX(float(p_cluster.aabb.size.length()), bake_simplification_distance * 700.0f);
+}
+
+HLOD3D::BakeError HLOD3D::bake(Node *p_from_node) {
+	ERR_FAIL_NULL_V(p_from_node, BAKE_ERROR_NO_MESHES);
+	ERR_FAIL_COND_V(!is_inside_tree(), BAKE_ERROR_NO_MESHES);
+
+	clear(p_from_node);
+
+	LocalVector<MeshInstance3D *> instances;
+	_gather_sources(p_from_node, instances);
+
+	// Group the instances in a grid, based on the center of their bounds.
+	Transform3D to_local = get_global_transform().affine_inverse();
+	HashMap<Vector3i, uint32_t> cluster_map;
+	LocalVector<Cluster> clusters;
+	for (MeshInstance3D *mi : instances) {
+		AABB aabb = (to_local * mi->get_global_transform()).xform(mi->get_aabb());
+		Vector3 cell = (aabb.get_center() / bake_cluster_size).floor();
+		Vector3i key = Vector3i(cell.x, cell.y, cell.z);
+
+		HashMap<Vector3i, uint32_t>::Iterator E = cluster_map.find(key);
+		if (!E) {
+			E = cluster_map.insert(key, clusters.size());
+			clusters.push_back(Cluster());
+			clusters[E->value].aabb = aabb;
+		}
+		Cluster &cluster = clusters[E->value];
+		cluster.instances.push_back(mi);
+		cluster.aabb.merge_with(aabb);
+	}
+
+	// A cluster with a single instance would not save any draw call.
+	bake_clusters.clear();
+	for (Cluster &cluster : clusters) {
+		if (cluster.instances.size() < 2) {
+			continue;
+		}
+		for (MeshInstance3D *mi : cluster.instances) {
+			_gather_surfaces(mi, cluster);
+		}
+		if (!cluster.surfaces.is_empty()) {
+			bake_clusters.push_back(cluster);
+		}
+	}
+
+	if (bake_clusters.is_empty()) {
+		return BAKE_ERROR_NO_MESHES;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &HLOD3D::_bake_cluster, (void *)nullptr, bake_clusters.size(), -1, true, SNAME("HLOD3DBake"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	Node *owner = get_owner() ? get_owner() : this;
+	for (uint32_t i = 0; i < bake_clusters.size(); i++) {
+		Cluster &cluster = bake_clusters[i];
+		if (cluster.indices.size() < 3) {
+			continue;
+		}
+
+		Array arrays;
+		arrays.resize(Mesh::ARRAY_MAX);
+		arrays[Mesh::ARRAY_VERTEX] = cluster.vertices;
+		arrays[Mesh::ARRAY_NORMAL] = cluster.normals;
+		arrays[Mesh::ARRAY_TEX_UV] = cluster.uvs;
+		arrays[Mesh::ARRAY_INDEX] = cluster.indices;
+
+		Ref<StandardMaterial3D> material;
+		material.instantiate();
+		material->set_texture(BaseMaterial3D::TEXTURE_ALBEDO, ImageTexture::create_from_image(cluster.atlas));
+
+		Ref<ArrayMesh> mesh;
+		mesh.instantiate();
+		mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+		mesh->surface_set_material(0, material);
+
+		float range = _get_cluster_visibility_range(cluster);
+
+		MeshInstance3D *proxy = memnew(MeshInstance3D);
+		proxy->set_name(vformat("HLODCluster%d", i));
+		proxy->set_meta(SNAME("_hlod_proxy"), true);
+		proxy->set_mesh(mesh);
+		proxy->set_visibility_range_begin(range);
+		proxy->set_visibility_range_begin_margin(range * 0.05);
+		add_child(proxy, true);
+		proxy->set_owner(owner);
+
+		for (MeshInstance3D *mi : cluster.instances) {
+			mi->set_visibility_parent(mi->get_path_to(proxy));
+		}
+	}
+
+	bake_clusters.clear();
+	return BAKE_ERROR_OK;
+}
+
+void HLOD3D::_clear_sources(Node *p_node) {
+	Node3D *node = Object::cast_to<Node3D>(p_node);
+	if (node && !node->get_visibility_parent().is_empty()) {
+		Node *parent = node->get_node_or_null(node->get_visibility_parent());
+		if (parent && _is_proxy(parent)) {
+			node->set_visibility_parent(NodePath());
+		}
+	}
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_clear_sources(p_node->get_child(i));
+	}
+}
+
+void HLOD3D::clear(Node *p_from_node) {
+	ERR_FAIL_NULL(p_from_node);
+
+	_clear_sources(p_from_node);
+
+	LocalVector<MeshInstance3D *> proxies;
+	get_proxies(proxies);
+	for (MeshInstance3D *proxy : proxies) {
+		remove_child(proxy);
+		proxy->queue_free();
+	}
+}
+
+void HLOD3D::get_proxies(LocalVector<MeshInstance3D *> &r_proxies) const {
+	for (int i = 0; i < get_child_count(); i++) {
+		if (_is_proxy(get_child(i))) {
+			r_proxies.push_back(Object::cast_to<MeshInstance3D>(get_child(i)));
+		}
+	}
+}
+
+PackedStringArray HLOD3D::get_configuration_warnings() const {
+	PackedStringArray warnings = Node::get_configuration_warnings();
+
+	if (bake_mask == 0) {
+		warnings.push_back(RTR("The Bake Mask has no bits enabled, which means baking will not produce any HLOD proxies for this HLOD3D.\nTo resolve this, enable at least one bit in the Bake Mask property."));
+	}
+
+	return warnings;
+}
+
+void HLOD3D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_bake_mask", "mask"), &HLOD3D::set_bake_mask);
+	ClassDB::bind_method(D_METHOD("get_bake_mask"), &HLOD3D::get_bake_mask);
+	ClassDB::bind_method(D_METHOD("set_bake_mask_value", "layer_number", "value"), &HLOD3D::set_bake_mask_value);
+	ClassDB::bind_method(D_METHOD("get_bake_mask_value", "layer_number"), &HLOD3D::get_bake_mask_value);
+	ClassDB::bind_method(D_METHOD("set_bake_cluster_size", "size"), &HLOD3D::set_bake_cluster_size);
+	ClassDB::bind_method(D_METHOD("get_bake_cluster_size"), &HLOD3D::get_bake_cluster_size);
+	ClassDB::bind_method(D_METHOD("set_bake_simplification_distance", "distance"), &HLOD3D::set_bake_simplification_distance);
+	ClassDB::bind_method(D_METHOD("get_bake_simplification_distance"), &HLOD3D::get_bake_simplification_distance);
+	ClassDB::bind_method(D_METHOD("set_bake_atlas_size", "size"), &HLOD3D::set_bake_atlas_size);
+	ClassDB::bind_method(D_METHOD("get_bake_atlas_size"), &HLOD3D::get_bake_atlas_size);
+	ClassDB::bind_method(D_METHOD("set_bake_visibility_range", "range"), &HLOD3D::set_bake_visibility_range);
+	ClassDB::bind_method(D_METHOD("get_bake_visibility_range"), &HLOD3D::get_bake_visibility_range);
+
+	ClassDB::bind_method(D_METHOD("bake", "from_node"), &HLOD3D::bake);
+	ClassDB::bind_method(D_METHOD("clear", "from_node"), &HLOD3D::clear);
+
+	ADD_GROUP("Bake", "bake_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "bake_mask", PROPERTY_HINT_LAYERS_3D_RENDER), "set_bake_mask", "get_bake_mask");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bake_cluster_size", PROPERTY_HINT_RANGE, "1,1024,0.1,or_greater,suffix:m"), "set_bake_cluster_size", "get_bake_cluster_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bake_simplification_distance", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater,suffix:m"), "set_bake_simplification_distance", "get_bake_simplification_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "bake_atlas_size", PROPERTY_HINT_RANGE, "16,16384,1"), "set_bake_atlas_size", "get_bake_atlas_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bake_visibility_range", PROPERTY_HINT_RANGE, "0,4096,0.1,or_greater,suffix:m"), "set_bake_visibility_range", "get_bake_visibility_range");
+
+	BIND_ENUM_CONSTANT(BAKE_ERROR_OK);
+	BIND_ENUM_CONSTANT(BAKE_ERROR_NO_MESHES);
+}
+
+HLOD3D::HLOD3D() {
+}
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*  hlod_3d.h                                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef HLOD_3D_H
+#define HLOD_3D_H
+
+#include "core/templates/local_vector.h"
+#include "scene/3d/node_3d.h"
+
+class MeshInstance3D;
+
+// Bakes hierarchical LOD proxies for static geometry: the MeshInstance3Ds found under a node are grouped
+// in a grid of clusters, and each cluster is merged into a single simplified mesh using a single material
+// (with an albedo atlas). The proxies are added as children of this node, and the source instances use them
+// as visibility parent, so the existing visibility range culling swaps between both based on distance.
+class HLOD3D : public Node3D {
+	GDCLASS(HLOD3D, Node3D);
+
+public:
+	enum BakeError {
+		BAKE_ERROR_OK,
+		BAKE_ERROR_NO_MESHES,
+	};
+
+private:
+	struct SourceSurface {
+		Transform3D transform; // Relative to this node.
+		Array arrays;
+		Ref<Image> albedo_image;
+		Color albedo_color = Color(1, 1, 1);
+	};
+
+	struct Cluster {
+		LocalVector<MeshInstance3D *> instances;
+		LocalVector<SourceSurface> surfaces;
+		AABB aabb;
+
+		// Output of _bake_cluster().
+		Vector<Vector3> vertices;
+		Vector<Vector3> normals;
+		Vector<Vector2> uvs;
+		Vector<int> indices;
+		Ref<Image> atlas;
+	};
+
+	uint32_t bake_mask = 0xFFFFFFFF;
+	float bake_cluster_size = 64.0;
+	float bake_simplification_distance = 0.5;
+	int bake_atlas_size = 1024;
+	float bake_visibility_range = 0.0;
+
+	LocalVector<Cluster> bake_clusters;
+
+	bool _is_proxy(Node *p_node) const;
+	bool _is_source_valid(MeshInstance3D *p_instance) const;
+	void _gather_sources(Node *p_node, LocalVector<MeshInstance3D *> &r_instances);
+	void _gather_surfaces(MeshInstance3D *p_instance, Cluster &r_cluster);
+	void _bake_cluster(uint32_t p_index, void *p_userdata);
+	float _get_cluster_visibility_range(const Cluster &p_cluster) const;
+	void _clear_sources(Node *p_node);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_bake_mask(uint32_t p_mask);
+	uint32_t get_bake_mask() const;
+
+	void set_bake_mask_value(int p_layer_number, bool p_enable);
+	bool get_bake_mask_value(int p_layer_number) const;
+
+	void set_bake_cluster_size(float p_size);
+	float get_bake_cluster_size() const;
+
+	void set_bake_simplification_distance(float p_distance);
+	float get_bake_simplification_distance() const;
+
+	void set_bake_atlas_size(int p_size);
+	int get_bake_atlas_size() const;
+
+	void set_bake_visibility_range(float p_range);
+	float get_bake_visibility_range() const;
+
+	BakeError bake(Node *p_from_node);
+	void clear(Node *p_from_node);
+
+	// The proxies added by the last bake, other children are left alone.
+	void get_proxies(LocalVector<MeshInstance3D *> &r_proxies) const;
+
+	virtual PackedStringArray get_configuration_warnings() const override;
+
+	HLOD3D();
+};
+
+VARIANT_ENUM_CAST(HLOD3D::BakeError);
+
+#endif // HLOD_3D_H
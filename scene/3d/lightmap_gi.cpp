@@ -716,6 +716,58 @@ void LightmapGI::_gen_new_positions_from_octree(const GenProbesOctree *p_cell, f
 	}
 }
 
+// Used when the renderer can't render materials into UV2 space (such as the dummy renderer used when running headless).
+// Each mesh is approximated with the average albedo, metallic and emission of its surface materials.
+static TypedArray<Image> _bake_flat_material_uv2(const Ref<Mesh> &p_mesh, const Vector<Ref<Material>> &p_overrides, const Size2i &p_size) {
+	Color albedo(0, 0, 0);
+	Color emission(0, 0, 0);
+	float metallic = 0.0;
+	int surface_count = p_mesh->get_surface_count();
+
+	for (int i = 0; i < surface_count; i++) {
+		Ref<Material> material = i < p_overrides.size() && p_overrides[i].is_valid() ? p_overrides[i] : p_mesh->surface_get_material(i);
+		Ref<BaseMaterial3D> base_material = material;
+		if (base_material.is_null()) {
+			albedo += Color(1, 1, 1); // Not possible to know, assume white like the default material.
+			continue;
+		}
+		albedo += base_material->get_albedo().srgb_to_linear();
+		metallic += base_material->get_metallic();
+		if (base_material->get_feature(BaseMaterial3D::FEATURE_EMISSION)) {
+			emission += base_material->get_emission().srgb_to_linear() * base_material->get_emission_energy_multiplier();
+		}
+	}
+
+	if (surface_count > 0) {
+		albedo /= surface_count;
+		emission /= surface_count;
+		metallic /= surface_count;
+	} else {
+		albedo = Color(1, 1, 1);
+	}
+
+	TypedArray<Image> images;
+	images.resize(RS::BAKE_CHANNEL_EMISSION + 1);
+
+	Ref<Image> albedo_image = Image::create_empty(p_size.width, p_size.height, false, Image::FORMAT_RGBA8);
+	albedo_image->fill(Color(albedo.r, albedo.g, albedo.b, 1.0));
+	images[RS::BAKE_CHANNEL_ALBEDO_ALPHA] = albedo_image;
+
+	Ref<Image> normal_image = Image::create_empty(p_size.width, p_size.height, false, Image::FORMAT_RGBA8);
+	normal_image->fill(Color(0.5, 0.5, 1.0, 1.0));
+	images[RS::BAKE_CHANNEL_NORMAL] = normal_image;
+
+	Ref<Image> orm_image = Image::create_empty(p_size.width, p_size.height, false, Image::FORMAT_RGBA8);
+	orm_image->fill(Color(1.0, 1.0, metallic, 1.0));
+	images[RS::BAKE_CHANNEL_ORM] = orm_image;
+
+	Ref<Image> emission_image = Image::create_empty(p_size.width, p_size.height, false, Image::FORMAT_RGBAH);
+	emission_image->fill(Color(emission.r, emission.g, emission.b, 1.0));
+	images[RS::BAKE_CHANNEL_EMISSION] = emission_image;
+
+	return images;
+}
+
 LightmapGI::BakeError LightmapGI::bake(Node *p_from_node, String p_image_data_path, Lightmapper::BakeStepFunc p_bake_step, void *p_bake_userdata) {
 	if (p_image_data_path.is_empty()) {
 		if (get_light_data().is_null()) {
@@ -780,6 +832,10 @@ LightmapGI::BakeError LightmapGI::bake(Node *p_from_node, String p_image_data_pa
 				}
 			}
 			TypedArray<Image> images = RS::get_singleton()->bake_render_uv2(mf.mesh->get_rid(), overrides, lightmap_size);
+			if (images.is_empty()) {
+				WARN_PRINT_ONCE("The renderer can't render materials for lightmap baking (e.g. when running headless), using flat material colors instead.");
+				images = _bake_flat_material_uv2(mf.mesh, mf.overrides, lightmap_size);
+			}
 
 			ERR_FAIL_COND_V(images.is_empty(), BAKE_ERROR_CANT_CREATE_IMAGE);
 
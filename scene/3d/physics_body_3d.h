@@ -31,6 +31,8 @@
 #ifndef PHYSICS_BODY_3D_H
 #define PHYSICS_BODY_3D_H
 
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vset.h"
 #include "scene/3d/collision_object_3d.h"
 #include "scene/resources/physics_material.h"
@@ -426,13 +428,27 @@ private:
 	Vector3 last_motion;
 	Vector3 platform_velocity;
 	Vector3 platform_angular_velocity;
-	Vector3 platform_ceiling_velocity;
 	Vector3 previous_position;
 	Vector3 real_velocity;
 
 	Vector<PhysicsServer3D::MotionResult> motion_results;
 	Vector<Ref<KinematicCollision3D>> slide_colliders;
 
+	// Batched bodies are slid together by the physics server once all the nodes had their physics process.
+	bool batched_motion = false;
+	bool batched_motion_queued = false;
+	double batched_motion_delta = 0.0;
+
+	static Mutex batched_motion_mutex;
+	static LocalVector<ObjectID> batched_motion_queue;
+
+	static void _flush_batched_motions();
+	static bool _is_wall_platform(ObjectID p_collider_id);
+	Vector3 _get_current_platform_velocity();
+	void _get_slide_parameters(double p_delta, PhysicsServer3D::SlideParameters &r_parameters, PhysicsServer3D::SlideResult &r_state) const;
+	void _apply_slide_state(const PhysicsServer3D::SlideResult &p_state);
+	void _apply_slide_result(const PhysicsServer3D::SlideParameters &p_parameters, const PhysicsServer3D::SlideResult &p_result);
+
 	void set_safe_margin(real_t p_margin);
 	real_t get_safe_margin() const;
 
@@ -472,17 +488,13 @@ private:
 	void set_platform_on_leave(PlatformOnLeave p_on_leave_velocity);
 	PlatformOnLeave get_platform_on_leave() const;
 
-	void _move_and_slide_floating(double p_delta);
-	void _move_and_slide_grounded(double p_delta, bool p_was_on_floor);
+	void set_batched_motion_enabled(bool p_enabled);
+	bool is_batched_motion_enabled() const;
 
 	Ref<KinematicCollision3D> _get_slide_collision(int p_bounce);
 	Ref<KinematicCollision3D> _get_last_slide_collision();
 	const Vector3 &get_up_direction() const;
-	bool _on_floor_if_snapped(bool p_was_on_floor, bool p_vel_dir_facing_up);
 	void set_up_direction(const Vector3 &p_up_direction);
-	void _set_collision_direction(const PhysicsServer3D::MotionResult &p_result, CollisionState &r_state, CollisionState p_apply_state = CollisionState(true, true, true));
-	void _set_platform_data(const PhysicsServer3D::MotionCollision &p_collision);
-	void _snap_on_floor(bool p_was_on_floor, bool p_vel_dir_facing_up);
 
 protected:
 	void _notification(int p_what);
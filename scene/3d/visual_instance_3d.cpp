@@ -52,7 +52,14 @@ void VisualInstance3D::_notification(int p_what) {
 		case NOTIFICATION_ENTER_WORLD: {
 			ERR_FAIL_COND(get_world_3d().is_null());
 			RenderingServer::get_singleton()->instance_set_scenario(instance, get_world_3d()->get_scenario());
+			RenderingServer::get_singleton()->instance_set_interpolated(instance, is_physics_interpolated());
 			_update_visibility();
+
+			if (is_physics_interpolated_and_enabled()) {
+				// Don't interpolate from wherever the instance was before entering the tree.
+				RenderingServer::get_singleton()->instance_set_transform(instance, get_global_transform());
+				RenderingServer::get_singleton()->instance_reset_physics_interpolation(instance);
+			}
 		} break;
 
 		case NOTIFICATION_TRANSFORM_CHANGED: {
@@ -60,6 +67,12 @@ void VisualInstance3D::_notification(int p_what) {
 			RenderingServer::get_singleton()->instance_set_transform(instance, gt);
 		} break;
 
+		case NOTIFICATION_RESET_PHYSICS_INTERPOLATION: {
+			// The transform notification is deferred, so set the transform now to not reset to the previous one.
+			RenderingServer::get_singleton()->instance_set_transform(instance, get_global_transform());
+			RenderingServer::get_singleton()->instance_reset_physics_interpolation(instance);
+		} break;
+
 		case NOTIFICATION_EXIT_WORLD: {
 			RenderingServer::get_singleton()->instance_set_scenario(instance, RID());
 			RenderingServer::get_singleton()->instance_attach_skeleton(instance, RID());
@@ -71,6 +84,10 @@ void VisualInstance3D::_notification(int p_what) {
 	}
 }
 
+void VisualInstance3D::_physics_interpolated_changed() {
+	RenderingServer::get_singleton()->instance_set_interpolated(instance, is_physics_interpolated());
+}
+
 RID VisualInstance3D::get_instance() const {
 	return instance;
 }
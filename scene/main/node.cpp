@@ -77,6 +77,9 @@ void Node::_notification(int p_notification) {
 				data.process_owner = this;
 			}
 
+			// Update physics interpolation, inherited from the parent too.
+			_propagate_physics_interpolated(data.parent ? data.parent->data.physics_interpolated : true);
+
 			{ // Update threaded process mode.
 				if (data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
 					if (data.parent) {
@@ -1037,6 +1040,62 @@ Node::ProcessThreadGroup Node::get_process_thread_group() const {
 	return data.process_thread_group;
 }
 
+void Node::set_physics_interpolation_mode(PhysicsInterpolationMode p_mode) {
+	ERR_THREAD_GUARD
+	if (data.physics_interpolation_mode == p_mode) {
+		return;
+	}
+
+	data.physics_interpolation_mode = p_mode;
+
+	if (is_inside_tree()) {
+		bool interpolated = data.physics_interpolated;
+		_propagate_physics_interpolated(data.parent ? data.parent->data.physics_interpolated : true);
+
+		// Start from the current transforms rather than the ones of the last physics ticks.
+		if (interpolated != data.physics_interpolated) {
+			reset_physics_interpolation();
+		}
+	}
+}
+
+Node::PhysicsInterpolationMode Node::get_physics_interpolation_mode() const {
+	return data.physics_interpolation_mode;
+}
+
+void Node::_propagate_physics_interpolated(bool p_interpolated) {
+	if (data.physics_interpolation_mode == PHYSICS_INTERPOLATION_MODE_ON) {
+		p_interpolated = true;
+	} else if (data.physics_interpolation_mode == PHYSICS_INTERPOLATION_MODE_OFF) {
+		p_interpolated = false;
+	}
+
+	if (data.physics_interpolated != p_interpolated) {
+		data.physics_interpolated = p_interpolated;
+		_physics_interpolated_changed();
+	}
+
+	data.blocked++;
+	for (KeyValue<StringName, Node *> &K : data.children) {
+		// Children still entering the tree update themselves.
+		if (K.value->is_inside_tree()) {
+			K.value->_propagate_physics_interpolated(p_interpolated);
+		}
+	}
+	data.blocked--;
+}
+
+bool Node::is_physics_interpolated_and_enabled() const {
+	return is_inside_tree() && get_tree()->is_physics_interpolation_enabled() && data.physics_interpolated;
+}
+
+void Node::reset_physics_interpolation() {
+	ERR_THREAD_GUARD
+	if (is_inside_tree()) {
+		propagate_notification(NOTIFICATION_RESET_PHYSICS_INTERPOLATION);
+	}
+}
+
 void Node::set_process_thread_messages(BitField<ProcessThreadMessages> p_flags) {
 	ERR_THREAD_GUARD
 	if (data.process_thread_messages == p_flags) {
@@ -3298,6 +3357,12 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_process_thread_group", "mode"), &Node::set_process_thread_group);
 	ClassDB::bind_method(D_METHOD("get_process_thread_group"), &Node::get_process_thread_group);
 
+	ClassDB::bind_method(D_METHOD("set_physics_interpolation_mode", "mode"), &Node::set_physics_interpolation_mode);
+	ClassDB::bind_method(D_METHOD("get_physics_interpolation_mode"), &Node::get_physics_interpolation_mode);
+	ClassDB::bind_method(D_METHOD("is_physics_interpolated"), &Node::is_physics_interpolated);
+	ClassDB::bind_method(D_METHOD("is_physics_interpolated_and_enabled"), &Node::is_physics_interpolated_and_enabled);
+	ClassDB::bind_method(D_METHOD("reset_physics_interpolation"), &Node::reset_physics_interpolation);
+
 	ClassDB::bind_method(D_METHOD("set_process_thread_messages", "flags"), &Node::set_process_thread_messages);
 	ClassDB::bind_method(D_METHOD("get_process_thread_messages"), &Node::get_process_thread_messages);
 
@@ -3413,6 +3478,7 @@ void Node::_bind_methods() {
 	BIND_CONSTANT(NOTIFICATION_DISABLED);
 	BIND_CONSTANT(NOTIFICATION_ENABLED);
 	BIND_CONSTANT(NOTIFICATION_NODE_RECACHE_REQUESTED);
+	BIND_CONSTANT(NOTIFICATION_RESET_PHYSICS_INTERPOLATION);
 
 	BIND_CONSTANT(NOTIFICATION_EDITOR_PRE_SAVE);
 	BIND_CONSTANT(NOTIFICATION_EDITOR_POST_SAVE);
@@ -3444,6 +3510,10 @@ void Node::_bind_methods() {
 	BIND_ENUM_CONSTANT(PROCESS_MODE_ALWAYS);
 	BIND_ENUM_CONSTANT(PROCESS_MODE_DISABLED);
 
+	BIND_ENUM_CONSTANT(PHYSICS_INTERPOLATION_MODE_INHERIT);
+	BIND_ENUM_CONSTANT(PHYSICS_INTERPOLATION_MODE_ON);
+	BIND_ENUM_CONSTANT(PHYSICS_INTERPOLATION_MODE_OFF);
+
 	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_INHERIT);
 	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_MAIN_THREAD);
 	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_SUB_THREAD);
@@ -3487,6 +3557,9 @@ void Node::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group_order"), "set_process_thread_group_order", "get_process_thread_group_order");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_messages", PROPERTY_HINT_FLAGS, "Process,Physics Process"), "set_process_thread_messages", "get_process_thread_messages");
 
+	ADD_GROUP("Physics Interpolation", "physics_interpolation_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "physics_interpolation_mode", PROPERTY_HINT_ENUM, "Inherit,On,Off"), "set_physics_interpolation_mode", "get_physics_interpolation_mode");
+
 	ADD_GROUP("Editor Description", "editor_");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "editor_description", PROPERTY_HINT_MULTILINE_TEXT), "set_editor_description", "get_editor_description");
 
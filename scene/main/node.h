@@ -74,6 +74,12 @@ public:
 		PROCESS_MODE_DISABLED, // never process
 	};
 
+	enum PhysicsInterpolationMode {
+		PHYSICS_INTERPOLATION_MODE_INHERIT,
+		PHYSICS_INTERPOLATION_MODE_ON,
+		PHYSICS_INTERPOLATION_MODE_OFF,
+	};
+
 	enum ProcessThreadGroup {
 		PROCESS_THREAD_GROUP_INHERIT,
 		PROCESS_THREAD_GROUP_MAIN_THREAD,
@@ -186,6 +192,9 @@ private:
 		BitField<ProcessThreadMessages> process_thread_messages;
 		void *process_group = nullptr; // to avoid cyclic dependency
 
+		PhysicsInterpolationMode physics_interpolation_mode = PHYSICS_INTERPOLATION_MODE_INHERIT;
+		bool physics_interpolated = true; // Resolved from the mode and the parent.
+
 		int multiplayer_authority = 1; // Server by default.
 		Variant rpc_config;
 
@@ -234,6 +243,7 @@ private:
 	void _propagate_exit_tree();
 	void _propagate_after_exit_tree();
 	void _propagate_process_owner(Node *p_owner, int p_pause_notification, int p_enabled_notification);
+	void _propagate_physics_interpolated(bool p_interpolated);
 	void _propagate_groups_dirty();
 	Array _get_node_and_resource(const NodePath &p_path);
 
@@ -289,6 +299,7 @@ protected:
 	virtual void remove_child_notify(Node *p_child);
 	virtual void move_child_notify(Node *p_child);
 	virtual void owner_changed_notify();
+	virtual void _physics_interpolated_changed() {}
 
 	void _propagate_replace_owner(Node *p_owner, Node *p_by_owner);
 
@@ -351,6 +362,7 @@ public:
 		NOTIFICATION_DISABLED = 28,
 		NOTIFICATION_ENABLED = 29,
 		NOTIFICATION_NODE_RECACHE_REQUESTED = 30,
+		NOTIFICATION_RESET_PHYSICS_INTERPOLATION = 2001,
 		//keep these linked to node
 
 		NOTIFICATION_WM_MOUSE_ENTER = 1002,
@@ -605,6 +617,12 @@ public:
 	void set_process_thread_group(ProcessThreadGroup p_mode);
 	ProcessThreadGroup get_process_thread_group() const;
 
+	void set_physics_interpolation_mode(PhysicsInterpolationMode p_mode);
+	PhysicsInterpolationMode get_physics_interpolation_mode() const;
+	_FORCE_INLINE_ bool is_physics_interpolated() const { return data.physics_interpolated; }
+	bool is_physics_interpolated_and_enabled() const;
+	void reset_physics_interpolation();
+
 	static void print_orphan_nodes();
 
 #ifdef TOOLS_ENABLED
@@ -712,6 +730,7 @@ public:
 
 VARIANT_ENUM_CAST(Node::DuplicateFlags);
 VARIANT_ENUM_CAST(Node::ProcessMode);
+VARIANT_ENUM_CAST(Node::PhysicsInterpolationMode);
 VARIANT_ENUM_CAST(Node::ProcessThreadGroup);
 VARIANT_BITFIELD_CAST(Node::ProcessThreadMessages);
 VARIANT_ENUM_CAST(Node::InternalMode);
@@ -134,6 +134,7 @@ private:
 	bool debug_navigation_hint = false;
 #endif
 	bool paused = false;
+	bool physics_interpolation_enabled = false;
 	int root_lock = 0;
 
 	HashMap<StringName, Group> group_map;
@@ -312,6 +313,7 @@ public:
 
 	virtual void initialize() override;
 
+	virtual void iteration_prepare() override;
 	virtual bool physics_process(double p_time) override;
 	virtual bool process(double p_time) override;
 
@@ -337,6 +339,9 @@ public:
 	void set_pause(bool p_enabled);
 	bool is_paused() const;
 
+	void set_physics_interpolation_enabled(bool p_enabled);
+	bool is_physics_interpolation_enabled() const;
+
 #ifdef DEBUG_ENABLED
 	void set_debug_collisions_hint(bool p_enabled);
 	bool is_debugging_collisions_hint() const;
@@ -73,6 +73,11 @@ void ConcavePolygonShape3D::_update_shape() {
 	Dictionary d;
 	d["faces"] = faces;
 	d["backface_collision"] = backface_collision;
+	if (!bvh_data.is_empty()) {
+		// The server ignores it if it doesn't match the faces.
+		d["bvh"] = bvh_data;
+		bvh_data.clear();
+	}
 	PhysicsServer3D::get_singleton()->shape_set_data(get_shape(), d);
 
 	Shape3D::_update_shape();
@@ -101,6 +106,19 @@ bool ConcavePolygonShape3D::is_backface_collision_enabled() const {
 	return backface_collision;
 }
 
+void ConcavePolygonShape3D::set_bvh_data(const Vector<uint8_t> &p_data) {
+	bvh_data = p_data;
+}
+
+Vector<uint8_t> ConcavePolygonShape3D::get_bvh_data() const {
+	if (faces.is_empty()) {
+		return Vector<uint8_t>();
+	}
+	// Physics servers that don't build a BVH don't return one.
+	Dictionary d = PhysicsServer3D::get_singleton()->shape_get_data(get_shape());
+	return d.get("bvh", Vector<uint8_t>());
+}
+
 void ConcavePolygonShape3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_faces", "faces"), &ConcavePolygonShape3D::set_faces);
 	ClassDB::bind_method(D_METHOD("get_faces"), &ConcavePolygonShape3D::get_faces);
@@ -108,6 +126,11 @@ void ConcavePolygonShape3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_backface_collision_enabled", "enabled"), &ConcavePolygonShape3D::set_backface_collision_enabled);
 	ClassDB::bind_method(D_METHOD("is_backface_collision_enabled"), &ConcavePolygonShape3D::is_backface_collision_enabled);
 
+	ClassDB::bind_method(D_METHOD("_set_bvh_data", "data"), &ConcavePolygonShape3D::set_bvh_data);
+	ClassDB::bind_method(D_METHOD("_get_bvh_data"), &ConcavePolygonShape3D::get_bvh_data);
+
+	// Before the faces, so it's loaded by the time they update the shape.
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_BYTE_ARRAY, "_bvh_data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL), "_set_bvh_data", "_get_bvh_data");
 	ADD_PROPERTY(PropertyInfo(Variant::PACKED_VECTOR3_ARRAY, "data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL), "set_faces", "get_faces");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "backface_collision"), "set_backface_collision_enabled", "is_backface_collision_enabled");
 }
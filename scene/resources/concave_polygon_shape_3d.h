@@ -38,6 +38,7 @@ class ConcavePolygonShape3D : public Shape3D {
 
 	Vector<Vector3> faces;
 	bool backface_collision = false;
+	Vector<uint8_t> bvh_data; // Loaded BVH, only kept until it's passed to the physics server.
 
 	struct DrawEdge {
 		Vector3 a;
@@ -71,6 +72,9 @@ public:
 	void set_backface_collision_enabled(bool p_enabled);
 	bool is_backface_collision_enabled() const;
 
+	void set_bvh_data(const Vector<uint8_t> &p_data);
+	Vector<uint8_t> get_bvh_data() const;
+
 	virtual Vector<Vector3> get_debug_mesh_lines() const override;
 	virtual real_t get_enclosing_radius() const override;
 
@@ -151,6 +151,11 @@ public:
 	void set_interpolation_color_space(Gradient::ColorSpace p_color_space);
 	ColorSpace get_interpolation_color_space();
 
+	// Points are sorted lazily on the first lookup, this does it ahead of concurrent lookups.
+	_FORCE_INLINE_ void update_sorting() {
+		_update_sorting();
+	}
+
 	_FORCE_INLINE_ Color get_color_at_offset(float p_offset) {
 		if (points.is_empty()) {
 			return Color(0, 0, 0, 1);
@@ -54,6 +54,8 @@ public:
 	void set_map_data(Vector<real_t> p_new);
 	Vector<real_t> get_map_data() const;
 
+	void update_map_data_region(const Rect2i &p_region, const Vector<real_t> &p_data);
+
 	virtual Vector<Vector3> get_debug_mesh_lines() const override;
 	virtual real_t get_enclosing_radius() const override;
 
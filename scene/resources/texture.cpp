@@ -37,6 +37,7 @@
 #include "core/os/os.h"
 #include "scene/resources/bit_map.h"
 #include "scene/resources/mesh.h"
+#include "scene/resources/texture_streaming.h"
 #include "servers/camera/camera_feed.h"
 
 int Texture2D::get_width() const {
@@ -669,7 +670,7 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			uint32_t size = f->get_32();
 
-			if (p_size_limit > 0 && i < (mipmaps - 1) && (sw > p_size_limit || sh > p_size_limit)) {
+			if (p_size_limit > 0 && i < mipmaps && (sw > p_size_limit || sh > p_size_limit)) {
 				//can't load this due to size limit
 				sw = MAX(sw >> 1, 1);
 				sh = MAX(sh >> 1, 1);
@@ -740,21 +741,13 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				}
 			}
 
-			image->set_data(w, h, true, mipmap_images[0]->get_format(), img_data);
+			image->set_data(mipmap_images[0]->get_width(), mipmap_images[0]->get_height(), true, mipmap_images[0]->get_format(), img_data);
 			return image;
 		}
 
 	} else if (data_format == DATA_FORMAT_BASIS_UNIVERSAL) {
-		int sw = w;
-		int sh = h;
+		// Basis Universal mipmaps are transcoded together, so the size limit can't be honored.
 		uint32_t size = f->get_32();
-		if (p_size_limit > 0 && (sw > p_size_limit || sh > p_size_limit)) {
-			//can't load this due to size limit
-			sw = MAX(sw >> 1, 1);
-			sh = MAX(sh >> 1, 1);
-			f->seek(f->get_position() + size);
-			return Ref<Image>();
-		}
 		Vector<uint8_t> pv;
 		pv.resize(size);
 		{
@@ -766,24 +759,23 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 		if (img.is_null() || img->is_empty()) {
 			ERR_FAIL_COND_V(img.is_null() || img->is_empty(), Ref<Image>());
 		}
-		format = img->get_format();
-		sw = MAX(sw >> 1, 1);
-		sh = MAX(sh >> 1, 1);
 		return img;
 	} else if (data_format == DATA_FORMAT_IMAGE) {
 		int size = Image::get_image_data_size(w, h, format, mipmaps ? true : false);
+		uint64_t data_begin = f->get_position();
 
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			int tw, th;
 			int ofs = Image::get_image_mipmap_offset_and_dimensions(w, h, format, i, tw, th);
 
-			if (p_size_limit > 0 && i < mipmaps && (p_size_limit > tw || p_size_limit > th)) {
-				if (ofs) {
-					f->seek(f->get_position() + ofs);
-				}
+			if (p_size_limit > 0 && i < mipmaps && (tw > p_size_limit || th > p_size_limit)) {
 				continue; //oops, size limit enforced, go to next
 			}
 
+			if (ofs) {
+				f->seek(data_begin + ofs);
+			}
+
 			Vector<uint8_t> data;
 			data.resize(size - ofs);
 
@@ -838,7 +830,7 @@ Image::Format CompressedTexture2D::get_format() const {
 	return format;
 }
 
-Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit) {
+Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, uint64_t &r_stream_data_offset, int p_size_limit) {
 	alpha_cache.unref();
 
 	ERR_FAIL_COND_V(image.is_null(), ERR_INVALID_PARAMETER);
@@ -884,6 +876,7 @@ Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r
 	if (!(df & FORMAT_BIT_STREAM)) {
 		p_size_limit = 0;
 	}
+	r_stream_data_offset = p_size_limit > 0 ? f->get_position() : 0;
 
 	image = load_image_from_file(f, p_size_limit);
 
@@ -903,8 +896,9 @@ Error CompressedTexture2D::load(const String &p_path) {
 	bool request_normal;
 	bool request_roughness;
 	int mipmap_limit;
+	uint64_t stream_data_offset;
 
-	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit, stream_data_offset, TextureStreaming::get_resident_size());
 	if (err) {
 		return err;
 	}
@@ -919,6 +913,13 @@ Error CompressedTexture2D::load(const String &p_path) {
 		RS::get_singleton()->texture_set_size_override(texture, lw, lh);
 	}
 
+	if (stream_data_offset && MAX(image->get_width(), image->get_height()) < MAX(lw, lh)) {
+		// Only the smaller mipmaps were loaded, the larger ones are streamed in once needed.
+		TextureStreaming::register_texture(texture, p_path, stream_data_offset, Size2i(lw, lh), image);
+	} else {
+		TextureStreaming::unregister_texture(texture);
+	}
+
 	w = lw;
 	h = lh;
 	path_to_file = p_path;
@@ -1077,6 +1078,7 @@ CompressedTexture2D::CompressedTexture2D() {}
 CompressedTexture2D::~CompressedTexture2D() {
 	if (texture.is_valid()) {
 		ERR_FAIL_NULL(RenderingServer::get_singleton());
+		TextureStreaming::unregister_texture(texture);
 		RS::get_singleton()->free(texture);
 	}
 }
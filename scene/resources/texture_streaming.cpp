@@ -0,0 +1,229 @@
+/**************************************************************************/
+/*  texture_streaming.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "texture_streaming.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "scene/resources/texture.h"
+#include "servers/rendering_server.h"
+
+bool TextureStreaming::enabled = false;
+int TextureStreaming::resident_size = 0;
+uint64_t TextureStreaming::memory_budget = 0;
+
+Mutex TextureStreaming::mutex;
+HashMap<RID, TextureStreaming::Texture> TextureStreaming::textures;
+uint64_t TextureStreaming::memory_used = 0;
+
+Mutex TextureStreaming::requests_mutex;
+HashMap<RID, int> TextureStreaming::requests;
+
+Thread TextureStreaming::thread;
+Semaphore TextureStreaming::semaphore;
+SafeFlag TextureStreaming::exit_thread;
+
+void TextureStreaming::_streaming_callback(void *p_userdata, RID p_texture, int p_size) {
+	{
+		MutexLock lock(requests_mutex);
+		requests[p_texture] = p_size;
+	}
+	semaphore.post();
+}
+
+void TextureStreaming::_thread_func(void *p_userdata) {
+	while (true) {
+		semaphore.wait();
+		if (exit_thread.is_set()) {
+			break;
+		}
+
+		HashMap<RID, int> pending;
+		{
+			MutexLock lock(requests_mutex);
+			SWAP(pending, requests);
+		}
+
+		for (const KeyValue<RID, int> &E : pending) {
+			if (exit_thread.is_set()) {
+				break;
+			}
+			_process_request(E.key, E.value);
+		}
+	}
+}
+
+Ref<Image> TextureStreaming::_load_image(const String &p_path, uint64_t p_data_offset, int p_size_limit) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(f.is_null(), Ref<Image>(), vformat("Unable to open file: %s.", p_path));
+
+	// The header was already validated when the texture was loaded.
+	f->seek(p_data_offset);
+	return CompressedTexture2D::load_image_from_file(f, p_size_limit);
+}
+
+void TextureStreaming::_process_request(RID p_texture, int p_size) {
+	String path;
+	uint64_t data_offset = 0;
+	int limit = 0;
+
+	{
+		MutexLock lock(mutex);
+		Texture *t = textures.getptr(p_texture);
+		if (!t) {
+			return; // Freed meanwhile.
+		}
+
+		// Mipmap sizes are requested in powers of two, and never go below the resident mipmaps.
+		limit = MAX(int(next_power_of_2(MAX(p_size, 1))), resident_size);
+		if (t->max_size > 0) {
+			limit = MIN(limit, int(next_power_of_2(t->max_size)));
+		}
+
+		if (limit > t->loaded_size && memory_budget > 0) {
+			// Only loading larger mipmaps is limited by the budget, dropping them always goes through.
+			while (limit > t->loaded_size) {
+				uint64_t estimate = t->memory * (uint64_t(limit) * limit) / (uint64_t(t->loaded_size) * t->loaded_size);
+				if (memory_used - t->memory + estimate <= memory_budget) {
+					break;
+				}
+				limit >>= 1;
+			}
+		}
+
+		if (limit == t->loaded_size) {
+			return;
+		}
+
+		path = t->path;
+		data_offset = t->data_offset;
+	}
+
+	Ref<Image> image = _load_image(path, data_offset, limit);
+	ERR_FAIL_COND_MSG(image.is_null() || image->is_empty(), vformat("Failed to stream mipmaps of texture: %s.", path));
+
+	RID new_texture = RS::get_singleton()->texture_2d_create(image);
+
+	MutexLock lock(mutex);
+	Texture *t = textures.getptr(p_texture);
+	if (!t || t->path != path) {
+		// Freed or reloaded from another file while loading.
+		RS::get_singleton()->free(new_texture);
+		return;
+	}
+
+	// Both calls are queued to the rendering thread, under the lock so they can't be reordered with a free.
+	RS::get_singleton()->texture_replace(p_texture, new_texture);
+	RS::get_singleton()->texture_set_size_override(p_texture, t->size.width, t->size.height);
+
+	int image_size = MAX(image->get_width(), image->get_height());
+	if (image_size < limit) {
+		t->max_size = image_size; // Got all the mipmaps in the file.
+	}
+	t->loaded_size = limit;
+	memory_used -= t->memory;
+	t->memory = image->get_data().size();
+	memory_used += t->memory;
+}
+
+void TextureStreaming::initialize() {
+	if (Engine::get_singleton()->is_editor_hint() || !GLOBAL_GET("rendering/textures/streaming/enabled")) {
+		return;
+	}
+	if (!RS::get_singleton()->get_rendering_device()) {
+		// The Compatibility renderer does not report the sizes textures are needed at.
+		return;
+	}
+
+	resident_size = next_power_of_2(MAX(int(GLOBAL_GET("rendering/textures/streaming/resident_size")), 1));
+	memory_budget = uint64_t(int(GLOBAL_GET("rendering/textures/streaming/memory_budget_mb"))) * 1024 * 1024;
+	enabled = true;
+
+	exit_thread.clear();
+	thread.start(_thread_func, nullptr);
+}
+
+void TextureStreaming::finish() {
+	if (!enabled) {
+		return;
+	}
+
+	exit_thread.set();
+	semaphore.post();
+	thread.wait_to_finish();
+
+	textures.clear();
+	requests.clear();
+	memory_used = 0;
+	enabled = false;
+}
+
+void TextureStreaming::register_texture(RID p_texture, const String &p_path, uint64_t p_data_offset, const Size2i &p_size, const Ref<Image> &p_image) {
+	ERR_FAIL_COND(!enabled);
+
+	{
+		MutexLock lock(mutex);
+		Texture *t = textures.getptr(p_texture);
+		if (t) {
+			memory_used -= t->memory; // Reloaded.
+		} else {
+			t = &textures.insert(p_texture, Texture())->value;
+		}
+
+		t->path = p_path;
+		t->data_offset = p_data_offset;
+		t->size = p_size;
+		t->max_size = 0;
+		t->loaded_size = resident_size;
+		t->memory = p_image->get_data().size();
+		memory_used += t->memory;
+	}
+
+	RS::get_singleton()->texture_set_streaming_callback(p_texture, _streaming_callback, nullptr);
+}
+
+void TextureStreaming::unregister_texture(RID p_texture) {
+	if (!enabled) {
+		return;
+	}
+
+	{
+		MutexLock lock(mutex);
+		Texture *t = textures.getptr(p_texture);
+		if (!t) {
+			return;
+		}
+		memory_used -= t->memory;
+		textures.erase(p_texture);
+	}
+
+	RS::get_singleton()->texture_set_streaming_callback(p_texture, nullptr, nullptr);
+}
@@ -0,0 +1,88 @@
+/**************************************************************************/
+/*  texture_streaming.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEXTURE_STREAMING_H
+#define TEXTURE_STREAMING_H
+
+#include "core/io/image.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/rid.h"
+#include "core/templates/safe_refcount.h"
+
+// Loads the larger mipmaps of streamable CompressedTexture2Ds on demand. Textures are loaded with their
+// smaller mipmaps only (the resident size), and the renderer reports the size each one is needed at.
+// The larger mipmaps are read from the .ctex file in a background thread, within a memory budget, and
+// swapped in with RenderingServer::texture_replace(). Until then, the texture renders with the mipmaps it has.
+class TextureStreaming {
+	struct Texture {
+		String path;
+		uint64_t data_offset = 0;
+		Size2i size; // Size reported by the texture, used as size override.
+		int max_size = 0; // Largest mipmap available in the file.
+		int loaded_size = 0;
+		uint64_t memory = 0;
+	};
+
+	static bool enabled;
+	static int resident_size;
+	static uint64_t memory_budget;
+
+	static Mutex mutex; // Protects textures and memory_used.
+	static HashMap<RID, Texture> textures;
+	static uint64_t memory_used;
+
+	// Requests come from the rendering thread, they are kept apart so it never has to wait for a load.
+	static Mutex requests_mutex;
+	static HashMap<RID, int> requests;
+
+	static Thread thread;
+	static Semaphore semaphore;
+	static SafeFlag exit_thread;
+
+	static void _streaming_callback(void *p_userdata, RID p_texture, int p_size);
+	static void _thread_func(void *p_userdata);
+	static void _process_request(RID p_texture, int p_size);
+	static Ref<Image> _load_image(const String &p_path, uint64_t p_data_offset, int p_size_limit);
+
+public:
+	static void initialize();
+	static void finish();
+
+	// Returns the size limit streamable textures must be loaded with, or 0 if streaming is disabled.
+	static int get_resident_size() { return enabled ? resident_size : 0; }
+
+	static void register_texture(RID p_texture, const String &p_path, uint64_t p_data_offset, const Size2i &p_size, const Ref<Image> &p_image);
+	static void unregister_texture(RID p_texture);
+};
+
+#endif // TEXTURE_STREAMING_H
@@ -237,6 +237,9 @@ public:
 	EXBIND3(space_set_param, RID, SpaceParameter, real_t)
 	EXBIND2RC(real_t, space_get_param, RID, SpaceParameter)
 
+	EXBIND1RC(Vector<uint8_t>, space_save_state, RID)
+	EXBIND2R(bool, space_restore_state, RID, const Vector<uint8_t> &)
+
 	EXBIND1R(PhysicsDirectSpaceState3D *, space_get_direct_state, RID)
 
 	EXBIND2(space_set_debug_contacts, RID, int)
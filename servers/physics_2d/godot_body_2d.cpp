@@ -148,6 +148,56 @@ void GodotBody2D::set_active(bool p_active) {
 	}
 }
 
+void GodotBody2D::save_state(State &r_state) const {
+	r_state.transform = get_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.constant_force = constant_force;
+	r_state.constant_torque = constant_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void GodotBody2D::restore_state(const State &p_state) {
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.transform.affine_inverse());
+	_update_transform_dependent();
+	new_transform = p_state.new_transform;
+
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	constant_force = p_state.constant_force;
+	constant_torque = p_state.constant_torque;
+	still_time = p_state.still_time;
+	set_active(p_state.active);
+}
+
+void GodotBody2D::set_constraint_order(const LocalVector<GodotConstraint2D *> &p_order) {
+	List<Pair<GodotConstraint2D *, int>> ordered_list;
+	for (GodotConstraint2D *constraint : p_order) {
+		for (List<Pair<GodotConstraint2D *, int>>::Element *E = constraint_list.front(); E; E = E->next()) {
+			if (E->get().first == constraint) {
+				ordered_list.push_back(E->get());
+				E->erase();
+				break;
+			}
+		}
+	}
+	for (const Pair<GodotConstraint2D *, int> &E : constraint_list) {
+		ordered_list.push_back(E);
+	}
+	constraint_list = ordered_list;
+}
+
 void GodotBody2D::set_param(PhysicsServer2D::BodyParameter p_param, const Variant &p_value) {
 	switch (p_param) {
 		case PhysicsServer2D::BODY_PARAM_BOUNCE: {
@@ -604,7 +654,8 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector2();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_update_shapes_with_motion(motion, false);
+		broadphase_update_pending = true;
 	}
 
 	contact_count = 0;
@@ -616,14 +667,14 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	}
 
 	if (fi_callback_data || body_state_callback.get_object()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		state_query_pending = true;
 	}
 
 	if (mode == PhysicsServer2D::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.size() == 0 && linear_velocity == Vector2() && angular_velocity == 0) {
-			set_active(false); //stopped moving, deactivate
+			deactivate_pending = true; //stopped moving, deactivate
 		}
 		return;
 	}
@@ -640,8 +691,12 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 		pos += center_of_mass - center_of_mass.rotated(angle_delta);
 	}
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	_set_transform(Transform2D(angle, pos), false);
 	_set_inv_transform(get_transform().inverse());
+	if (continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED) {
+		_update_shapes(false);
+		broadphase_update_pending = true;
+	}
 
 	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
 		new_transform = get_transform();
@@ -650,6 +705,23 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	_update_transform_dependent();
 }
 
+void GodotBody2D::commit_integration() {
+	if (broadphase_update_pending) {
+		broadphase_update_pending = false;
+		_update_shapes_broadphase();
+	}
+
+	if (state_query_pending) {
+		state_query_pending = false;
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (deactivate_pending) {
+		deactivate_pending = false;
+		set_active(false);
+	}
+}
+
 void GodotBody2D::wakeup_neighbours() {
 	for (const Pair<GodotConstraint2D *, int> &E : constraint_list) {
 		const GodotConstraint2D *c = E.first;
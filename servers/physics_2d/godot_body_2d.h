@@ -100,6 +100,11 @@ class GodotBody2D : public GodotCollisionObject2D {
 	PhysicsServer2D::CCDMode continuous_cd_mode = PhysicsServer2D::CCD_MODE_DISABLED;
 	bool omit_force_integration = false;
 	bool active = true;
+
+	// Changes integrate_forces() and integrate_velocities() can't do from several threads, see commit_integration().
+	bool broadphase_update_pending = false;
+	bool state_query_pending = false;
+	bool deactivate_pending = false;
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
 	void _mass_properties_changed();
@@ -291,6 +296,27 @@ public:
 		set_active(true);
 	}
 
+	// Simulation state stored by GodotSpace2D::save_state(), copied as plain data.
+	struct State {
+		Transform2D transform;
+		Transform2D new_transform;
+		Vector2 linear_velocity;
+		real_t angular_velocity = 0.0;
+		Vector2 prev_linear_velocity;
+		real_t prev_angular_velocity = 0.0;
+		Vector2 applied_force;
+		real_t applied_torque = 0.0;
+		Vector2 constant_force;
+		real_t constant_torque = 0.0;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void save_state(State &r_state) const;
+	void restore_state(const State &p_state);
+	// Constraints are solved in the order they were added, the ones missing from the order are kept after it.
+	void set_constraint_order(const LocalVector<GodotConstraint2D *> &p_order);
+
 	void set_param(PhysicsServer2D::BodyParameter p_param, const Variant &p_value);
 	Variant get_param(PhysicsServer2D::BodyParameter p_param) const;
 
@@ -315,8 +341,11 @@ public:
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
+	// Can run on several threads (for different bodies), as long as commit_integration() is called
+	// afterwards from a single thread, to update the broadphase and the space lists.
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void commit_integration();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
@@ -591,6 +591,28 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair2D::save_state(State &r_state) const {
+	for (int i = 0; i < contact_count; i++) {
+		r_state.contacts[i] = contacts[i];
+	}
+	r_state.contact_count = contact_count;
+	r_state.sep_axis = sep_axis;
+	r_state.collided = collided;
+	r_state.oneway_disabled = oneway_disabled;
+}
+
+void GodotBodyPair2D::restore_state(const State &p_state) {
+	ERR_FAIL_INDEX(p_state.contact_count, MAX_CONTACTS + 1);
+
+	for (int i = 0; i < p_state.contact_count; i++) {
+		contacts[i] = p_state.contacts[i];
+	}
+	contact_count = p_state.contact_count;
+	sep_axis = p_state.sep_axis;
+	collided = p_state.collided;
+	oneway_disabled = p_state.oneway_disabled;
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
 		GodotConstraint2D(_arr, 2) {
 	A = p_A;
@@ -94,6 +94,25 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual GodotBodyPair2D *get_body_pair() override { return this; }
+
+	_FORCE_INLINE_ GodotBody2D *get_body_a() const { return A; }
+	_FORCE_INLINE_ GodotBody2D *get_body_b() const { return B; }
+	_FORCE_INLINE_ int get_shape_a() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_b() const { return shape_B; }
+
+	// Contact cache stored by GodotSpace2D::save_state(), so restored pairs are warm started the same way.
+	struct State {
+		Contact contacts[MAX_CONTACTS];
+		int contact_count = 0;
+		Vector2 sep_axis;
+		bool collided = false;
+		bool oneway_disabled = false;
+	};
+
+	void save_state(State &r_state) const;
+	void restore_state(const State &p_state);
+
 	GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B);
 	~GodotBodyPair2D();
 };
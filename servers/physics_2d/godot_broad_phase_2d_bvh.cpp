@@ -31,6 +31,8 @@
 #include "godot_broad_phase_2d_bvh.h"
 #include "godot_collision_object_2d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 GodotBroadPhase2D::ID GodotBroadPhase2DBVH::create(GodotCollisionObject2D *p_object, int p_subindex, const Rect2 &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
 	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
@@ -81,6 +83,10 @@ int GodotBroadPhase2DBVH::cull_aabb(const Rect2 &p_aabb, GodotCollisionObject2D
 	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
 }
 
+void GodotBroadPhase2DBVH::cull_segments(const Vector2 *p_from, const Vector2 *p_to, int p_count, GodotCollisionObject2D **p_results, int *r_result_counts, int p_max_results, int *p_result_indices) {
+	bvh.cull_segments(p_from, p_to, p_count, p_results, r_result_counts, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
+}
+
 void *GodotBroadPhase2DBVH::_pair_callback(void *self, uint32_t p_A, GodotCollisionObject2D *p_object_A, int subindex_A, uint32_t p_B, GodotCollisionObject2D *p_object_B, int subindex_B) {
 	GodotBroadPhase2DBVH *bpo = static_cast<GodotBroadPhase2DBVH *>(self);
 	if (!bpo->pair_callback) {
@@ -109,8 +115,23 @@ void GodotBroadPhase2DBVH::set_unpair_callback(UnpairCallback p_unpair_callback,
 	unpair_userdata = p_userdata;
 }
 
+void GodotBroadPhase2DBVH::_pairing_query(uint32_t p_index, void *p_userdata) {
+	bvh.pairing_query(p_index);
+}
+
 void GodotBroadPhase2DBVH::update() {
-	bvh.update();
+	// Finding the shapes overlapping the moved ones doesn't modify the BVH, so it's done in parallel.
+	// Pairs are then created and removed from this thread, as the callbacks modify the space and the objects.
+	uint32_t changed_count = bvh.pairing_begin();
+	if (changed_count >= PAIRING_THREADED_MIN_ITEMS) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotBroadPhase2DBVH::_pairing_query, nullptr, changed_count, -1, true, SNAME("Physics2DBroadPhasePairing"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < changed_count; i++) {
+			bvh.pairing_query(i);
+		}
+	}
+	bvh.pairing_end();
 }
 
 GodotBroadPhase2D *GodotBroadPhase2DBVH::_create() {
@@ -70,6 +70,11 @@ class GodotBroadPhase2DBVH : public GodotBroadPhase2D {
 	static void *_pair_callback(void *, uint32_t, GodotCollisionObject2D *, int, uint32_t, GodotCollisionObject2D *, int);
 	static void _unpair_callback(void *, uint32_t, GodotCollisionObject2D *, int, uint32_t, GodotCollisionObject2D *, int, void *);
 
+	// With fewer moved shapes, the pairing queries are done on the calling thread.
+	static constexpr uint32_t PAIRING_THREADED_MIN_ITEMS = 256;
+
+	void _pairing_query(uint32_t p_index, void *p_userdata = nullptr);
+
 	PairCallback pair_callback = nullptr;
 	void *pair_userdata = nullptr;
 	UnpairCallback unpair_callback = nullptr;
@@ -88,6 +93,7 @@ public:
 
 	virtual int cull_segment(const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
 	virtual int cull_aabb(const Rect2 &p_aabb, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+	virtual void cull_segments(const Vector2 *p_from, const Vector2 *p_to, int p_count, GodotCollisionObject2D **p_results, int *r_result_counts, int p_max_results, int *p_result_indices = nullptr) override;
 
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) override;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) override;
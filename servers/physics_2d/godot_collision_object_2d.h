@@ -75,10 +75,12 @@ private:
 
 	SelfList<GodotCollisionObject2D> pending_shape_update_list;
 
-	void _update_shapes();
-
 protected:
-	void _update_shapes_with_motion(const Vector2 &p_motion);
+	// When p_update_broadphase is false, only the cached shape AABBs are updated, so it can be done from several
+	// threads (for different objects). _update_shapes_broadphase() must then be called from a single thread.
+	void _update_shapes(bool p_update_broadphase = true);
+	void _update_shapes_with_motion(const Vector2 &p_motion, bool p_update_broadphase = true);
+	void _update_shapes_broadphase();
 	void _unregister_shapes();
 
 	_FORCE_INLINE_ void _set_transform(const Transform2D &p_transform, bool p_update_shapes = true) {
@@ -36,6 +36,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/frame_tracer.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -258,6 +259,22 @@ real_t GodotPhysicsServer2D::space_get_param(RID p_space, SpaceParameter p_param
 	return space->get_param(p_param);
 }
 
+Vector<uint8_t> GodotPhysicsServer2D::space_save_state(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(using_threads && !doing_sync, Vector<uint8_t>(), "Space state can't be saved while the space is being stepped, wait for iteration or physics process notification.");
+
+	return space->save_state();
+}
+
+bool GodotPhysicsServer2D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, false);
+	ERR_FAIL_COND_V_MSG(using_threads && !doing_sync, false, "Space state can't be restored while the space is being stepped, wait for iteration or physics process notification.");
+
+	return space->restore_state(p_state);
+}
+
 void GodotPhysicsServer2D::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 	GodotSpace2D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_COND(!space);
@@ -1270,6 +1287,8 @@ void GodotPhysicsServer2D::init() {
 }
 
 void GodotPhysicsServer2D::step(real_t p_step) {
+	TRACE_ZONE("PhysicsServer2D::step");
+
 	if (!active) {
 		return;
 	}
@@ -1279,11 +1298,17 @@ void GodotPhysicsServer2D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
+		elapsed_time[i] = 0;
+	}
 	for (const GodotSpace2D *E : active_spaces) {
 		stepper->step(const_cast<GodotSpace2D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
+			elapsed_time[i] += E->get_elapsed_time(GodotSpace2D::ElapsedTime(i));
+		}
 	}
 }
 
@@ -1311,6 +1336,7 @@ void GodotPhysicsServer2D::flush_queries() {
 		uint64_t total_time[GodotSpace2D::ELAPSED_TIME_MAX];
 		static const char *time_name[GodotSpace2D::ELAPSED_TIME_MAX] = {
 			"integrate_forces",
+			"broadphase",
 			"generate_islands",
 			"setup_constraints",
 			"solve_constraints",
@@ -1367,6 +1393,24 @@ int GodotPhysicsServer2D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_INTEGRATE_FORCES_TIME: {
+			return elapsed_time[GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES];
+		} break;
+		case INFO_BROADPHASE_TIME: {
+			return elapsed_time[GodotSpace2D::ELAPSED_TIME_BROADPHASE];
+		} break;
+		case INFO_GENERATE_ISLANDS_TIME: {
+			return elapsed_time[GodotSpace2D::ELAPSED_TIME_GENERATE_ISLANDS];
+		} break;
+		case INFO_SETUP_CONSTRAINTS_TIME: {
+			return elapsed_time[GodotSpace2D::ELAPSED_TIME_SETUP_CONSTRAINTS];
+		} break;
+		case INFO_SOLVE_CONSTRAINTS_TIME: {
+			return elapsed_time[GodotSpace2D::ELAPSED_TIME_SOLVE_CONSTRAINTS];
+		} break;
+		case INFO_INTEGRATE_VELOCITIES_TIME: {
+			return elapsed_time[GodotSpace2D::ELAPSED_TIME_INTEGRATE_VELOCITIES];
+		} break;
 	}
 
 	return 0;
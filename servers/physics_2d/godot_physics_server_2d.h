@@ -43,6 +43,7 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 	GDCLASS(GodotPhysicsServer2D, PhysicsServer2D);
 
 	friend class GodotPhysicsDirectSpaceState2D;
+	friend class GodotSpace2D;
 	friend class GodotPhysicsDirectBodyState2D;
 	bool active = true;
 	bool doing_sync = false;
@@ -50,6 +51,7 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	uint64_t elapsed_time[GodotSpace2D::ELAPSED_TIME_MAX] = {}; // Of all the active spaces, in microseconds.
 
 	bool using_threads = false;
 
@@ -112,6 +114,9 @@ public:
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) override;
 	virtual real_t space_get_param(RID p_space, SpaceParameter p_param) const override;
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) const override;
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override;
+
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) override;
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
@@ -45,6 +45,38 @@
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
+	enum {
+		RAY_BATCH_PACKET_SIZE = 16, // Rays culled together in the broadphase.
+	};
+
+	// Batches are split in one contiguous range of queries per thread, each using its own result buffers.
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector2 *from = nullptr;
+		const Vector2 *to = nullptr;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+		uint32_t count = 0;
+		uint32_t task_count = 1;
+		SafeNumeric<uint32_t> hit_count;
+	};
+
+	struct MotionBatch {
+		GodotShape2D *shape = nullptr;
+		const ShapeParameters *parameters = nullptr;
+		const Vector2 *origins = nullptr;
+		const Vector2 *motions = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+		uint32_t count = 0;
+		uint32_t task_count = 1;
+	};
+
+	bool _intersect_ray_results(const RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D *const *p_results, const int *p_subindex_results, int p_amount, RayResult &r_result);
+	bool _cast_motion(GodotShape2D *p_shape, const ShapeParameters &p_parameters, const Transform2D &p_transform, const Vector2 &p_motion, GodotCollisionObject2D **r_results, int *r_subindex_results, real_t &p_closest_safe, real_t &p_closest_unsafe);
+	void _intersect_ray_batch_task(uint32_t p_index, RayBatch *p_batch);
+	void _cast_motion_batch_task(uint32_t p_index, MotionBatch *p_batch);
+
 public:
 	GodotSpace2D *space = nullptr;
 
@@ -52,6 +84,8 @@ public:
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) override;
+	virtual int intersect_ray_batch(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) override;
+	virtual bool cast_motion_batch(const ShapeParameters &p_parameters, const Vector2 *p_origins, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 
@@ -62,6 +96,7 @@ class GodotSpace2D {
 public:
 	enum ElapsedTime {
 		ELAPSED_TIME_INTEGRATE_FORCES,
+		ELAPSED_TIME_BROADPHASE,
 		ELAPSED_TIME_GENERATE_ISLANDS,
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
@@ -158,6 +193,9 @@ public:
 	void remove_object(GodotCollisionObject2D *p_object);
 	const HashSet<GodotCollisionObject2D *> &get_objects() const;
 
+	Vector<uint8_t> save_state() const;
+	bool restore_state(const Vector<uint8_t> &p_state);
+
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
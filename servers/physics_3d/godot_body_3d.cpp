@@ -189,6 +189,55 @@ void GodotBody3D::set_active(bool p_active) {
 	}
 }
 
+void GodotBody3D::save_state(State &r_state) const {
+	r_state.transform = get_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.constant_force = constant_force;
+	r_state.constant_torque = constant_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void GodotBody3D::restore_state(const State &p_state) {
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.transform.affine_inverse());
+	_update_transform_dependent();
+	new_transform = p_state.new_transform;
+
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	constant_force = p_state.constant_force;
+	constant_torque = p_state.constant_torque;
+	still_time = p_state.still_time;
+	set_active(p_state.active);
+}
+
+void GodotBody3D::set_constraint_order(const LocalVector<GodotConstraint3D *> &p_order) {
+	HashMap<GodotConstraint3D *, int> ordered_map;
+	for (GodotConstraint3D *constraint : p_order) {
+		HashMap<GodotConstraint3D *, int>::ConstIterator E = constraint_map.find(constraint);
+		if (E) {
+			ordered_map.insert(E->key, E->value);
+		}
+	}
+	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
+		if (!ordered_map.has(E.key)) {
+			ordered_map.insert(E.key, E.value);
+		}
+	}
+	constraint_map = ordered_map;
+}
+
 void GodotBody3D::set_param(PhysicsServer3D::BodyParameter p_param, const Variant &p_value) {
 	switch (p_param) {
 		case PhysicsServer3D::BODY_PARAM_BOUNCE: {
@@ -663,7 +712,8 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector3();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_update_shapes_with_motion(motion, false);
+		broadphase_update_pending = true;
 	}
 
 	contact_count = 0;
@@ -675,7 +725,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	}
 
 	if (fi_callback_data || body_state_callback.get_object()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		state_query_pending = true;
 	}
 
 	//apply axis lock linear
@@ -698,7 +748,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
+			deactivate_pending = true; //stopped moving, deactivate
 		}
 
 		return;
@@ -727,12 +777,31 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, false);
 	_set_inv_transform(get_transform().inverse());
+	_update_shapes(false);
+	broadphase_update_pending = true;
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::commit_integration() {
+	if (broadphase_update_pending) {
+		broadphase_update_pending = false;
+		_update_shapes_broadphase();
+	}
+
+	if (state_query_pending) {
+		state_query_pending = false;
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (deactivate_pending) {
+		deactivate_pending = false;
+		set_active(false);
+	}
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
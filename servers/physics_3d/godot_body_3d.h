@@ -104,6 +104,11 @@ class GodotBody3D : public GodotCollisionObject3D {
 	bool omit_force_integration = false;
 	bool active = true;
 
+	// Changes integrate_forces() and integrate_velocities() can't do from several threads, see commit_integration().
+	bool broadphase_update_pending = false;
+	bool state_query_pending = false;
+	bool deactivate_pending = false;
+
 	bool continuous_cd = false;
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
@@ -145,6 +150,7 @@ class GodotBody3D : public GodotCollisionObject3D {
 	GodotPhysicsDirectBodyState3D *direct_state = nullptr;
 
 	uint64_t island_step = 0;
+	uint64_t solver_colors = 0; // Constraint colors using this body in the island being colored, see GodotStep3D.
 
 	void _update_transform_dependent();
 
@@ -195,6 +201,9 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	_FORCE_INLINE_ uint64_t get_solver_colors() const { return solver_colors; }
+	_FORCE_INLINE_ void set_solver_colors(uint64_t p_colors) { solver_colors = p_colors; }
+
 	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
 	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraint_map.erase(p_constraint); }
 	const HashMap<GodotConstraint3D *, int> &get_constraint_map() const { return constraint_map; }
@@ -217,7 +226,10 @@ public:
 	_FORCE_INLINE_ Vector3 get_prev_linear_velocity() const { return prev_linear_velocity; }
 	_FORCE_INLINE_ Vector3 get_prev_angular_velocity() const { return prev_angular_velocity; }
 
+	_FORCE_INLINE_ void set_biased_linear_velocity(const Vector3 &p_velocity) { biased_linear_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_linear_velocity() const { return biased_linear_velocity; }
+
+	_FORCE_INLINE_ void set_biased_angular_velocity(const Vector3 &p_velocity) { biased_angular_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_angular_velocity() const { return biased_angular_velocity; }
 
 	_FORCE_INLINE_ void apply_central_impulse(const Vector3 &p_impulse) {
@@ -290,6 +302,27 @@ public:
 		set_active(true);
 	}
 
+	// Simulation state stored by GodotSpace3D::save_state(), copied as plain data.
+	struct State {
+		Transform3D transform;
+		Transform3D new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 prev_linear_velocity;
+		Vector3 prev_angular_velocity;
+		Vector3 applied_force;
+		Vector3 applied_torque;
+		Vector3 constant_force;
+		Vector3 constant_torque;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void save_state(State &r_state) const;
+	void restore_state(const State &p_state);
+	// Constraints are solved in the order they were added, the ones missing from the order are kept after it.
+	void set_constraint_order(const LocalVector<GodotConstraint3D *> &p_order);
+
 	void set_param(PhysicsServer3D::BodyParameter p_param, const Variant &p_value);
 	Variant get_param(PhysicsServer3D::BodyParameter p_param) const;
 
@@ -316,8 +349,11 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// Can run on several threads (for different bodies), as long as commit_integration() is called
+	// afterwards from a single thread, to update the broadphase and the space lists.
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void commit_integration();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
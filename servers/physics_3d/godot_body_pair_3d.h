@@ -71,6 +71,8 @@ protected:
 };
 
 class GodotBodyPair3D : public GodotBodyContact3D {
+	friend class GodotContactSolver3D;
+
 	enum {
 		MAX_CONTACTS = 4
 	};
@@ -109,6 +111,24 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual GodotBodyPair3D *get_body_pair() override { return this; }
+
+	_FORCE_INLINE_ GodotBody3D *get_body_a() const { return A; }
+	_FORCE_INLINE_ GodotBody3D *get_body_b() const { return B; }
+	_FORCE_INLINE_ int get_shape_a() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_b() const { return shape_B; }
+
+	// Contact cache stored by GodotSpace3D::save_state(), so restored pairs are warm started the same way.
+	struct State {
+		Contact contacts[MAX_CONTACTS];
+		int contact_count = 0;
+		Vector3 sep_axis;
+		bool collided = false;
+	};
+
+	void save_state(State &r_state) const;
+	void restore_state(const State &p_state);
+
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
 };
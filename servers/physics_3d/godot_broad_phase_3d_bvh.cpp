@@ -32,6 +32,8 @@
 
 #include "godot_collision_object_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
 	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
@@ -86,6 +88,10 @@ int GodotBroadPhase3DBVH::cull_aabb(const AABB &p_aabb, GodotCollisionObject3D *
 	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
 }
 
+void GodotBroadPhase3DBVH::cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_count, GodotCollisionObject3D **p_results, int *r_result_counts, int p_max_results, int *p_result_indices) {
+	bvh.cull_segments(p_from, p_to, p_count, p_results, r_result_counts, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
+}
+
 void *GodotBroadPhase3DBVH::_pair_callback(void *self, uint32_t p_A, GodotCollisionObject3D *p_object_A, int subindex_A, uint32_t p_B, GodotCollisionObject3D *p_object_B, int subindex_B) {
 	GodotBroadPhase3DBVH *bpo = static_cast<GodotBroadPhase3DBVH *>(self);
 	if (!bpo->pair_callback) {
@@ -114,8 +120,23 @@ void GodotBroadPhase3DBVH::set_unpair_callback(UnpairCallback p_unpair_callback,
 	unpair_userdata = p_userdata;
 }
 
+void GodotBroadPhase3DBVH::_pairing_query(uint32_t p_index, void *p_userdata) {
+	bvh.pairing_query(p_index);
+}
+
 void GodotBroadPhase3DBVH::update() {
-	bvh.update();
+	// Finding the shapes overlapping the moved ones doesn't modify the BVH, so it's done in parallel.
+	// Pairs are then created and removed from this thread, as the callbacks modify the space and the objects.
+	uint32_t changed_count = bvh.pairing_begin();
+	if (changed_count >= PAIRING_THREADED_MIN_ITEMS) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotBroadPhase3DBVH::_pairing_query, nullptr, changed_count, -1, true, SNAME("Physics3DBroadPhasePairing"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < changed_count; i++) {
+			bvh.pairing_query(i);
+		}
+	}
+	bvh.pairing_end();
 }
 
 GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
@@ -68,6 +68,11 @@ class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 	static void *_pair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int);
 	static void _unpair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int, void *);
 
+	// With fewer moved shapes, the pairing queries are done on the calling thread.
+	static constexpr uint32_t PAIRING_THREADED_MIN_ITEMS = 256;
+
+	void _pairing_query(uint32_t p_index, void *p_userdata = nullptr);
+
 	PairCallback pair_callback = nullptr;
 	void *pair_userdata = nullptr;
 	UnpairCallback unpair_callback = nullptr;
@@ -87,6 +92,7 @@ public:
 	virtual int cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+	virtual void cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_count, GodotCollisionObject3D **p_results, int *r_result_counts, int p_max_results, int *p_result_indices = nullptr) override;
 
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) override;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) override;
@@ -152,7 +152,29 @@ void GodotCollisionObject3D::_unregister_shapes() {
 	}
 }
 
-void GodotCollisionObject3D::_update_shapes() {
+void GodotCollisionObject3D::_update_shape_cache(Shape &r_shape) {
+	//not quite correct, should compute the next matrix..
+	AABB shape_aabb = r_shape.shape->get_aabb();
+	Transform3D xform = transform * r_shape.xform;
+	shape_aabb = xform.xform(shape_aabb);
+	shape_aabb.grow_by((r_shape.aabb_cache.size.x + r_shape.aabb_cache.size.y) * 0.5 * 0.05);
+	r_shape.aabb_cache = shape_aabb;
+
+	Vector3 scale = xform.get_basis().get_scale();
+	r_shape.area_cache = r_shape.shape->get_volume() * scale.x * scale.y * scale.z;
+}
+
+void GodotCollisionObject3D::_update_shape_broadphase(int p_index) {
+	Shape &s = shapes.write[p_index];
+	if (s.bpid == 0) {
+		s.bpid = space->get_broadphase()->create(this, p_index, s.aabb_cache, _static);
+		space->get_broadphase()->set_static(s.bpid, _static);
+	}
+
+	space->get_broadphase()->move(s.bpid, s.aabb_cache);
+}
+
+void GodotCollisionObject3D::_update_shapes(bool p_update_broadphase) {
 	if (!space) {
 		return;
 	}
@@ -163,26 +185,15 @@ void GodotCollisionObject3D::_update_shapes() {
 			continue;
 		}
 
-		//not quite correct, should compute the next matrix..
-		AABB shape_aabb = s.shape->get_aabb();
-		Transform3D xform = transform * s.xform;
-		shape_aabb = xform.xform(shape_aabb);
-		shape_aabb.grow_by((s.aabb_cache.size.x + s.aabb_cache.size.y) * 0.5 * 0.05);
-		s.aabb_cache = shape_aabb;
-
-		Vector3 scale = xform.get_basis().get_scale();
-		s.area_cache = s.shape->get_volume() * scale.x * scale.y * scale.z;
-
-		if (s.bpid == 0) {
-			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
-			space->get_broadphase()->set_static(s.bpid, _static);
-		}
+		_update_shape_cache(s);
+	}
 
-		space->get_broadphase()->move(s.bpid, shape_aabb);
+	if (p_update_broadphase) {
+		_update_shapes_broadphase();
 	}
 }
 
-void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion) {
+void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion, bool p_update_broadphase) {
 	if (!space) {
 		return;
 	}
@@ -199,13 +210,24 @@ void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion)
 		shape_aabb = xform.xform(shape_aabb);
 		shape_aabb.merge_with(AABB(shape_aabb.position + p_motion, shape_aabb.size)); //use motion
 		s.aabb_cache = shape_aabb;
+	}
 
-		if (s.bpid == 0) {
-			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
-			space->get_broadphase()->set_static(s.bpid, _static);
+	if (p_update_broadphase) {
+		_update_shapes_broadphase();
+	}
+}
+
+void GodotCollisionObject3D::_update_shapes_broadphase() {
+	if (!space) {
+		return;
+	}
+
+	for (int i = 0; i < shapes.size(); i++) {
+		if (shapes[i].disabled) {
+			continue;
 		}
 
-		space->get_broadphase()->move(s.bpid, shape_aabb);
+		_update_shape_broadphase(i);
 	}
 }
 
@@ -235,6 +257,24 @@ void GodotCollisionObject3D::_shape_changed() {
 	_shapes_changed();
 }
 
+void GodotCollisionObject3D::_shape_data_changed(const GodotShape3D *p_shape) {
+	// Only the entries of this shape are updated, so objects made of many shapes (like terrain tiles)
+	// don't move all their broadphase entries when a single one changes.
+	if (space) {
+		for (int i = 0; i < shapes.size(); i++) {
+			Shape &s = shapes.write[i];
+			if (s.shape != p_shape || s.disabled) {
+				continue;
+			}
+
+			_update_shape_cache(s);
+			_update_shape_broadphase(i);
+		}
+	}
+
+	_shapes_changed();
+}
+
 GodotCollisionObject3D::GodotCollisionObject3D(Type p_type) :
 		pending_shape_update_list(this) {
 	type = p_type;
@@ -79,10 +79,15 @@ private:
 
 	SelfList<GodotCollisionObject3D> pending_shape_update_list;
 
-	void _update_shapes();
+	void _update_shape_cache(Shape &r_shape);
+	void _update_shape_broadphase(int p_index);
 
 protected:
-	void _update_shapes_with_motion(const Vector3 &p_motion);
+	// When p_update_broadphase is false, only the cached shape AABBs are updated, so it can be done from several
+	// threads (for different objects). _update_shapes_broadphase() must then be called from a single thread.
+	void _update_shapes(bool p_update_broadphase = true);
+	void _update_shapes_with_motion(const Vector3 &p_motion, bool p_update_broadphase = true);
+	void _update_shapes_broadphase();
 	void _unregister_shapes();
 
 	_FORCE_INLINE_ void _set_transform(const Transform3D &p_transform, bool p_update_shapes = true) {
@@ -113,7 +118,8 @@ public:
 	_FORCE_INLINE_ void set_instance_id(const ObjectID &p_instance_id) { instance_id = p_instance_id; }
 	_FORCE_INLINE_ ObjectID get_instance_id() const { return instance_id; }
 
-	void _shape_changed() override;
+	void _shape_changed();
+	void _shape_data_changed(const GodotShape3D *p_shape) override;
 
 	_FORCE_INLINE_ Type get_type() const { return type; }
 	void add_shape(GodotShape3D *p_shape, const Transform3D &p_transform = Transform3D(), bool p_disabled = false);
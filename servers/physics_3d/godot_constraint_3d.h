@@ -32,6 +32,7 @@
 #define GODOT_CONSTRAINT_3D_H
 
 class GodotBody3D;
+class GodotBodyPair3D;
 class GodotSoftBody3D;
 
 class GodotConstraint3D {
@@ -65,6 +66,8 @@ public:
 	virtual GodotSoftBody3D *get_soft_body_ptr(int p_index) const { return nullptr; }
 	virtual int get_soft_body_count() const { return 0; }
 
+	virtual GodotBodyPair3D *get_body_pair() { return nullptr; }
+
 	_FORCE_INLINE_ void set_priority(int p_priority) { priority = p_priority; }
 	_FORCE_INLINE_ int get_priority() const { return priority; }
 
@@ -0,0 +1,509 @@
+/**************************************************************************/
+/*  godot_contact_solver_3d.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_contact_solver_3d.h"
+
+// Same as GodotBodyPair3D.
+#define MIN_VELOCITY 0.0001
+#define MAX_BIAS_ROTATION (Math_PI / 8)
+
+void GodotContactSolver3D::setup(const LocalVector<GodotConstraint3D *> &p_constraints) {
+	packet_count = 0;
+	constraints.clear();
+
+	for (GodotConstraint3D *constraint : p_constraints) {
+		GodotBodyPair3D *pair = constraint->get_body_pair();
+		if (!pair) {
+			constraints.push_back(constraint);
+			continue;
+		}
+		if (!pair->collided) {
+			continue; // Nothing to solve.
+		}
+
+		if (packet_count == 0 || packets[packet_count - 1].pair_count == LANES) {
+			if (packets.size() == packet_count) {
+				packets.push_back(Packet());
+			} else {
+				packets[packet_count] = Packet();
+			}
+			Packet &packet = packets[packet_count];
+			for (int l = 0; l < LANES; l++) {
+				packet.inv_mass_sum[l] = 1.0;
+			}
+			packet_count++;
+		}
+
+		Packet &packet = packets[packet_count - 1];
+		int l = packet.pair_count++;
+		packet.pairs[l] = pair;
+		packet.contact_count = MAX(packet.contact_count, uint32_t(pair->contact_count));
+		packet.friction[l] = ABS(MIN(pair->A->get_friction(), pair->B->get_friction())); // Same as combine_friction().
+
+		real_t inv_mass_A = pair->collide_A ? pair->A->get_inv_mass() : 0.0;
+		real_t inv_mass_B = pair->collide_B ? pair->B->get_inv_mass() : 0.0;
+		packet.A.inv_mass[l] = inv_mass_A;
+		packet.B.inv_mass[l] = inv_mass_B;
+		packet.inv_mass_sum[l] = inv_mass_A + inv_mass_B;
+		if (pair->collide_A) {
+			packet.A.inv_inertia_tensor.set(l, pair->A->get_inv_inertia_tensor());
+		}
+		if (pair->collide_B) {
+			packet.B.inv_inertia_tensor.set(l, pair->B->get_inv_inertia_tensor());
+		}
+
+		for (int i = 0; i < pair->contact_count; i++) {
+			const GodotBodyPair3D::Contact &c = pair->contacts[i];
+			ContactLanes &contacts = packet.contacts[i];
+			contacts.active[l] = c.active ? UINT32_MAX : 0;
+			contacts.normal.set(l, c.normal);
+			contacts.rA.set(l, c.rA);
+			contacts.rB.set(l, c.rB);
+			contacts.acc_impulse.set(l, c.acc_impulse);
+			contacts.acc_tangent_impulse.set(l, c.acc_tangent_impulse);
+			contacts.acc_normal_impulse[l] = c.acc_normal_impulse;
+			contacts.acc_bias_impulse[l] = c.acc_bias_impulse;
+			contacts.acc_bias_impulse_center_of_mass[l] = c.acc_bias_impulse_center_of_mass;
+			contacts.mass_normal[l] = c.mass_normal;
+			contacts.bias[l] = c.bias;
+			contacts.bounce[l] = c.bounce;
+		}
+	}
+}
+
+void GodotContactSolver3D::finish() {
+	for (uint32_t packet_index = 0; packet_index < packet_count; packet_index++) {
+		const Packet &packet = packets[packet_index];
+		for (uint32_t l = 0; l < packet.pair_count; l++) {
+			GodotBodyPair3D *pair = packet.pairs[l];
+			for (int i = 0; i < pair->contact_count; i++) {
+				GodotBodyPair3D::Contact &c = pair->contacts[i];
+				const ContactLanes &contacts = packet.contacts[i];
+				c.active = contacts.active[l] != 0;
+				c.acc_impulse = contacts.acc_impulse.get(l);
+				c.acc_tangent_impulse = contacts.acc_tangent_impulse.get(l);
+				c.acc_normal_impulse = contacts.acc_normal_impulse[l];
+				c.acc_bias_impulse = contacts.acc_bias_impulse[l];
+				c.acc_bias_impulse_center_of_mass = contacts.acc_bias_impulse_center_of_mass[l];
+			}
+		}
+	}
+}
+
+void GodotContactSolver3D::_gather_velocities(Packet &p_packet) {
+	for (uint32_t l = 0; l < p_packet.pair_count; l++) {
+		const GodotBody3D *A = p_packet.pairs[l]->A;
+		const GodotBody3D *B = p_packet.pairs[l]->B;
+		p_packet.A.linear_velocity.set(l, A->get_linear_velocity());
+		p_packet.A.angular_velocity.set(l, A->get_angular_velocity());
+		p_packet.A.biased_linear_velocity.set(l, A->get_biased_linear_velocity());
+		p_packet.A.biased_angular_velocity.set(l, A->get_biased_angular_velocity());
+		p_packet.B.linear_velocity.set(l, B->get_linear_velocity());
+		p_packet.B.angular_velocity.set(l, B->get_angular_velocity());
+		p_packet.B.biased_linear_velocity.set(l, B->get_biased_linear_velocity());
+		p_packet.B.biased_angular_velocity.set(l, B->get_biased_angular_velocity());
+	}
+}
+
+void GodotContactSolver3D::_scatter_velocities(Packet &p_packet) {
+	// Only bodies affected by the pair are written, the others (e.g. static bodies) can be shared between lanes.
+	for (uint32_t l = 0; l < p_packet.pair_count; l++) {
+		GodotBodyPair3D *pair = p_packet.pairs[l];
+		if (pair->collide_A) {
+			pair->A->set_linear_velocity(p_packet.A.linear_velocity.get(l));
+			pair->A->set_angular_velocity(p_packet.A.angular_velocity.get(l));
+			pair->A->set_biased_linear_velocity(p_packet.A.biased_linear_velocity.get(l));
+			pair->A->set_biased_angular_velocity(p_packet.A.biased_angular_velocity.get(l));
+		}
+		if (pair->collide_B) {
+			pair->B->set_linear_velocity(p_packet.B.linear_velocity.get(l));
+			pair->B->set_angular_velocity(p_packet.B.angular_velocity.get(l));
+			pair->B->set_biased_linear_velocity(p_packet.B.biased_linear_velocity.get(l));
+			pair->B->set_biased_angular_velocity(p_packet.B.biased_angular_velocity.get(l));
+		}
+	}
+}
+
+// Lanes of real_t, with the operations needed by the solver. Masks have all the bits of a lane set when true.
+#if !defined(REAL_T_IS_DOUBLE) && defined(__AVX__)
+
+#include <immintrin.h>
+
+struct LaneReal {
+	__m256 v;
+};
+struct LaneMask {
+	__m256 v;
+};
+
+static_assert(GodotContactSolver3D::LANES == 8);
+
+static _FORCE_INLINE_ LaneReal lanes_load(const real_t *p_src) { return { _mm256_loadu_ps(p_src) }; }
+static _FORCE_INLINE_ void lanes_store(real_t *p_dst, const LaneReal &p_a) { _mm256_storeu_ps(p_dst, p_a.v); }
+static _FORCE_INLINE_ LaneReal lanes_set(real_t p_value) { return { _mm256_set1_ps(p_value) }; }
+static _FORCE_INLINE_ LaneMask lanes_load_mask(const uint32_t *p_src) { return { _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i *)p_src)) }; }
+static _FORCE_INLINE_ void lanes_store_mask(uint32_t *p_dst, const LaneMask &p_a) { _mm256_storeu_si256((__m256i *)p_dst, _mm256_castps_si256(p_a.v)); }
+static _FORCE_INLINE_ LaneReal operator+(const LaneReal &p_a, const LaneReal &p_b) { return { _mm256_add_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal operator-(const LaneReal &p_a, const LaneReal &p_b) { return { _mm256_sub_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal operator*(const LaneReal &p_a, const LaneReal &p_b) { return { _mm256_mul_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal operator/(const LaneReal &p_a, const LaneReal &p_b) { return { _mm256_div_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal operator-(const LaneReal &p_a) { return { _mm256_xor_ps(p_a.v, _mm256_set1_ps(-0.0f)) }; }
+static _FORCE_INLINE_ LaneReal lanes_max(const LaneReal &p_a, const LaneReal &p_b) { return { _mm256_max_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal lanes_sqrt(const LaneReal &p_a) { return { _mm256_sqrt_ps(p_a.v) }; }
+static _FORCE_INLINE_ LaneReal lanes_abs(const LaneReal &p_a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), p_a.v) }; }
+static _FORCE_INLINE_ LaneMask lanes_greater(const LaneReal &p_a, const LaneReal &p_b) { return { _mm256_cmp_ps(p_a.v, p_b.v, _CMP_GT_OQ) }; }
+static _FORCE_INLINE_ LaneMask operator&(const LaneMask &p_a, const LaneMask &p_b) { return { _mm256_and_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneMask operator|(const LaneMask &p_a, const LaneMask &p_b) { return { _mm256_or_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal lanes_select(const LaneMask &p_mask, const LaneReal &p_a, const LaneReal &p_b) { return { _mm256_blendv_ps(p_b.v, p_a.v, p_mask.v) }; }
+
+#elif !defined(REAL_T_IS_DOUBLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+
+#include <emmintrin.h>
+
+struct LaneReal {
+	__m128 v;
+};
+struct LaneMask {
+	__m128 v;
+};
+
+static _FORCE_INLINE_ LaneReal lanes_load(const real_t *p_src) { return { _mm_loadu_ps(p_src) }; }
+static _FORCE_INLINE_ void lanes_store(real_t *p_dst, const LaneReal &p_a) { _mm_storeu_ps(p_dst, p_a.v); }
+static _FORCE_INLINE_ LaneReal lanes_set(real_t p_value) { return { _mm_set1_ps(p_value) }; }
+static _FORCE_INLINE_ LaneMask lanes_load_mask(const uint32_t *p_src) { return { _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)p_src)) }; }
+static _FORCE_INLINE_ void lanes_store_mask(uint32_t *p_dst, const LaneMask &p_a) { _mm_storeu_si128((__m128i *)p_dst, _mm_castps_si128(p_a.v)); }
+static _FORCE_INLINE_ LaneReal operator+(const LaneReal &p_a, const LaneReal &p_b) { return { _mm_add_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal operator-(const LaneReal &p_a, const LaneReal &p_b) { return { _mm_sub_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal operator*(const LaneReal &p_a, const LaneReal &p_b) { return { _mm_mul_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal operator/(const LaneReal &p_a, const LaneReal &p_b) { return { _mm_div_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal operator-(const LaneReal &p_a) { return { _mm_xor_ps(p_a.v, _mm_set1_ps(-0.0f)) }; }
+static _FORCE_INLINE_ LaneReal lanes_max(const LaneReal &p_a, const LaneReal &p_b) { return { _mm_max_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal lanes_sqrt(const LaneReal &p_a) { return { _mm_sqrt_ps(p_a.v) }; }
+static _FORCE_INLINE_ LaneReal lanes_abs(const LaneReal &p_a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), p_a.v) }; }
+static _FORCE_INLINE_ LaneMask lanes_greater(const LaneReal &p_a, const LaneReal &p_b) { return { _mm_cmpgt_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneMask operator&(const LaneMask &p_a, const LaneMask &p_b) { return { _mm_and_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneMask operator|(const LaneMask &p_a, const LaneMask &p_b) { return { _mm_or_ps(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal lanes_select(const LaneMask &p_mask, const LaneReal &p_a, const LaneReal &p_b) { return { _mm_or_ps(_mm_and_ps(p_mask.v, p_a.v), _mm_andnot_ps(p_mask.v, p_b.v)) }; }
+
+#elif !defined(REAL_T_IS_DOUBLE) && defined(__ARM_NEON) && defined(__aarch64__)
+
+#include <arm_neon.h>
+
+struct LaneReal {
+	float32x4_t v;
+};
+struct LaneMask {
+	uint32x4_t v;
+};
+
+static _FORCE_INLINE_ LaneReal lanes_load(const real_t *p_src) { return { vld1q_f32(p_src) }; }
+static _FORCE_INLINE_ void lanes_store(real_t *p_dst, const LaneReal &p_a) { vst1q_f32(p_dst, p_a.v); }
+static _FORCE_INLINE_ LaneReal lanes_set(real_t p_value) { return { vdupq_n_f32(p_value) }; }
+static _FORCE_INLINE_ LaneMask lanes_load_mask(const uint32_t *p_src) { return { vld1q_u32(p_src) }; }
+static _FORCE_INLINE_ void lanes_store_mask(uint32_t *p_dst, const LaneMask &p_a) { vst1q_u32(p_dst, p_a.v); }
+static _FORCE_INLINE_ LaneReal operator+(const LaneReal &p_a, const LaneReal &p_b) { return { vaddq_f32(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal operator-(const LaneReal &p_a, const LaneReal &p_b) { return { vsubq_f32(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal operator*(const LaneReal &p_a, const LaneReal &p_b) { return { vmulq_f32(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal operator/(const LaneReal &p_a, const LaneReal &p_b) { return { vdivq_f32(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal operator-(const LaneReal &p_a) { return { vnegq_f32(p_a.v) }; }
+static _FORCE_INLINE_ LaneReal lanes_max(const LaneReal &p_a, const LaneReal &p_b) { return { vmaxq_f32(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal lanes_sqrt(const LaneReal &p_a) { return { vsqrtq_f32(p_a.v) }; }
+static _FORCE_INLINE_ LaneReal lanes_abs(const LaneReal &p_a) { return { vabsq_f32(p_a.v) }; }
+static _FORCE_INLINE_ LaneMask lanes_greater(const LaneReal &p_a, const LaneReal &p_b) { return { vcgtq_f32(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneMask operator&(const LaneMask &p_a, const LaneMask &p_b) { return { vandq_u32(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneMask operator|(const LaneMask &p_a, const LaneMask &p_b) { return { vorrq_u32(p_a.v, p_b.v) }; }
+static _FORCE_INLINE_ LaneReal lanes_select(const LaneMask &p_mask, const LaneReal &p_a, const LaneReal &p_b) { return { vbslq_f32(p_mask.v, p_a.v, p_b.v) }; }
+
+#else
+
+// Scalar fallback (double precision builds, or no known SIMD instruction set).
+
+#define LANES_FOR for (int l = 0; l < GodotContactSolver3D::LANES; l++)
+
+struct LaneReal {
+	real_t v[GodotContactSolver3D::LANES];
+};
+struct LaneMask {
+	bool v[GodotContactSolver3D::LANES];
+};
+
+static _FORCE_INLINE_ LaneReal lanes_load(const real_t *p_src) {
+	LaneReal r;
+	LANES_FOR { r.v[l] = p_src[l]; }
+	return r;
+}
+static _FORCE_INLINE_ void lanes_store(real_t *p_dst, const LaneReal &p_a) {
+	LANES_FOR { p_dst[l] = p_a.v[l]; }
+}
+static _FORCE_INLINE_ LaneReal lanes_set(real_t p_value) {
+	LaneReal r;
+	LANES_FOR { r.v[l] = p_value; }
+	return r;
+}
+static _FORCE_INLINE_ LaneMask lanes_load_mask(const uint32_t *p_src) {
+	LaneMask r;
+	LANES_FOR { r.v[l] = p_src[l] != 0; }
+	return r;
+}
+static _FORCE_INLINE_ void lanes_store_mask(uint32_t *p_dst, const LaneMask &p_a) {
+	LANES_FOR { p_dst[l] = p_a.v[l] ? UINT32_MAX : 0; }
+}
+
+#define LANES_BINARY_OP(m_type, m_op)                                    \
+	static _FORCE_INLINE_ m_type operator m_op(const m_type &p_a, const m_type &p_b) { \
+		m_type r;                                                        \
+		LANES_FOR { r.v[l] = p_a.v[l] m_op p_b.v[l]; }                   \
+		return r;                                                        \
+	}
+
+LANES_BINARY_OP(LaneReal, +)
+LANES_BINARY_OP(LaneReal, -)
+LANES_BINARY_OP(LaneReal, *)
+LANES_BINARY_OP(LaneReal, /)
+LANES_BINARY_OP(LaneMask, &)
+LANES_BINARY_OP(LaneMask, |)
+
+#undef LANES_BINARY_OP
+
+static _FORCE_INLINE_ LaneReal operator-(const LaneReal &p_a) {
+	LaneReal r;
+	LANES_FOR { r.v[l] = -p_a.v[l]; }
+	return r;
+}
+static _FORCE_INLINE_ LaneReal lanes_max(const LaneReal &p_a, const LaneReal &p_b) {
+	LaneReal r;
+	LANES_FOR { r.v[l] = MAX(p_a.v[l], p_b.v[l]); }
+	return r;
+}
+static _FORCE_INLINE_ LaneReal lanes_sqrt(const LaneReal &p_a) {
+	LaneReal r;
+	LANES_FOR { r.v[l] = Math::sqrt(p_a.v[l]); }
+	return r;
+}
+static _FORCE_INLINE_ LaneReal lanes_abs(const LaneReal &p_a) {
+	LaneReal r;
+	LANES_FOR { r.v[l] = Math::abs(p_a.v[l]); }
+	return r;
+}
+static _FORCE_INLINE_ LaneMask lanes_greater(const LaneReal &p_a, const LaneReal &p_b) {
+	LaneMask r;
+	LANES_FOR { r.v[l] = p_a.v[l] > p_b.v[l]; }
+	return r;
+}
+static _FORCE_INLINE_ LaneReal lanes_select(const LaneMask &p_mask, const LaneReal &p_a, const LaneReal &p_b) {
+	LaneReal r;
+	LANES_FOR { r.v[l] = p_mask.v[l] ? p_a.v[l] : p_b.v[l]; }
+	return r;
+}
+
+#undef LANES_FOR
+
+#endif
+
+// Vectors and bases of lanes, per component.
+struct LaneVector3 {
+	LaneReal x, y, z;
+};
+
+struct LaneBasis {
+	LaneReal rows[3][3];
+};
+
+// Templates, to accept the private lane structures of GodotContactSolver3D.
+template <typename T>
+static _FORCE_INLINE_ LaneVector3 lanes_load_vector3(const T &p_src) {
+	return { lanes_load(p_src.x), lanes_load(p_src.y), lanes_load(p_src.z) };
+}
+template <typename T>
+static _FORCE_INLINE_ void lanes_store_vector3(T &p_dst, const LaneVector3 &p_a) {
+	lanes_store(p_dst.x, p_a.x);
+	lanes_store(p_dst.y, p_a.y);
+	lanes_store(p_dst.z, p_a.z);
+}
+template <typename T>
+static _FORCE_INLINE_ LaneBasis lanes_load_basis(const T &p_src) {
+	LaneBasis r;
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			r.rows[i][j] = lanes_load(p_src.rows[i][j]);
+		}
+	}
+	return r;
+}
+static _FORCE_INLINE_ LaneVector3 operator+(const LaneVector3 &p_a, const LaneVector3 &p_b) { return { p_a.x + p_b.x, p_a.y + p_b.y, p_a.z + p_b.z }; }
+static _FORCE_INLINE_ LaneVector3 operator-(const LaneVector3 &p_a, const LaneVector3 &p_b) { return { p_a.x - p_b.x, p_a.y - p_b.y, p_a.z - p_b.z }; }
+static _FORCE_INLINE_ LaneVector3 operator*(const LaneVector3 &p_a, const LaneReal &p_b) { return { p_a.x * p_b, p_a.y * p_b, p_a.z * p_b }; }
+static _FORCE_INLINE_ LaneReal lanes_dot(const LaneVector3 &p_a, const LaneVector3 &p_b) { return p_a.x * p_b.x + p_a.y * p_b.y + p_a.z * p_b.z; }
+static _FORCE_INLINE_ LaneVector3 lanes_cross(const LaneVector3 &p_a, const LaneVector3 &p_b) {
+	return { p_a.y * p_b.z - p_a.z * p_b.y, p_a.z * p_b.x - p_a.x * p_b.z, p_a.x * p_b.y - p_a.y * p_b.x };
+}
+static _FORCE_INLINE_ LaneVector3 lanes_xform(const LaneBasis &p_basis, const LaneVector3 &p_v) {
+	return {
+		p_basis.rows[0][0] * p_v.x + p_basis.rows[0][1] * p_v.y + p_basis.rows[0][2] * p_v.z,
+		p_basis.rows[1][0] * p_v.x + p_basis.rows[1][1] * p_v.y + p_basis.rows[1][2] * p_v.z,
+		p_basis.rows[2][0] * p_v.x + p_basis.rows[2][1] * p_v.y + p_basis.rows[2][2] * p_v.z,
+	};
+}
+static _FORCE_INLINE_ LaneVector3 lanes_select(const LaneMask &p_mask, const LaneVector3 &p_a, const LaneVector3 &p_b) {
+	return { lanes_select(p_mask, p_a.x, p_b.x), lanes_select(p_mask, p_a.y, p_b.y), lanes_select(p_mask, p_a.z, p_b.z) };
+}
+
+void GodotContactSolver3D::_solve_contacts(Packet &p_packet, ContactLanes &p_contacts, real_t p_max_bias_av) {
+	BodyLanes &bA = p_packet.A;
+	BodyLanes &bB = p_packet.B;
+
+	// Same as GodotBodyPair3D::solve() for one contact, on all the lanes at once with the branches turned into selects:
+	// impulses are computed in all the lanes, and only accumulated where the scalar solver would apply them.
+	const LaneReal zero = lanes_set(0.0);
+	const LaneReal one = lanes_set(1.0);
+	const LaneReal min_velocity = lanes_set(MIN_VELOCITY);
+	const LaneReal max_bias_av = lanes_set(p_max_bias_av);
+
+	const LaneMask active = lanes_load_mask(p_contacts.active);
+	const LaneVector3 normal = lanes_load_vector3(p_contacts.normal);
+	const LaneVector3 rA = lanes_load_vector3(p_contacts.rA);
+	const LaneVector3 rB = lanes_load_vector3(p_contacts.rB);
+	const LaneBasis inv_inertia_tensor_A = lanes_load_basis(bA.inv_inertia_tensor);
+	const LaneBasis inv_inertia_tensor_B = lanes_load_basis(bB.inv_inertia_tensor);
+	const LaneReal inv_mass_A = lanes_load(bA.inv_mass);
+	const LaneReal inv_mass_B = lanes_load(bB.inv_mass);
+	const LaneReal inv_mass_sum = lanes_load(p_packet.inv_mass_sum);
+	const LaneReal bias = lanes_load(p_contacts.bias);
+	const LaneReal mass_normal = lanes_load(p_contacts.mass_normal);
+
+	// Angular velocity changes per unit of impulse along the normal.
+	const LaneVector3 normal_av_A = lanes_xform(inv_inertia_tensor_A, lanes_cross(rA, normal));
+	const LaneVector3 normal_av_B = lanes_xform(inv_inertia_tensor_B, lanes_cross(rB, normal));
+
+	// Bias impulse.
+
+	LaneVector3 blvA = lanes_load_vector3(bA.biased_linear_velocity);
+	LaneVector3 bavA = lanes_load_vector3(bA.biased_angular_velocity);
+	LaneVector3 blvB = lanes_load_vector3(bB.biased_linear_velocity);
+	LaneVector3 bavB = lanes_load_vector3(bB.biased_angular_velocity);
+
+	LaneReal vbn = lanes_dot(blvB + lanes_cross(bavB, rB) - blvA - lanes_cross(bavA, rA), normal);
+
+	const LaneMask bias_active = active & lanes_greater(lanes_abs(bias - vbn), min_velocity);
+	const LaneReal jbnOld = lanes_load(p_contacts.acc_bias_impulse);
+	const LaneReal jbn = lanes_select(bias_active, lanes_max(jbnOld + (bias - vbn) * mass_normal, zero), jbnOld);
+	lanes_store(p_contacts.acc_bias_impulse, jbn);
+
+	const LaneReal jb = jbn - jbnOld;
+	const LaneVector3 delta_av_A = normal_av_A * -jb;
+	const LaneVector3 delta_av_B = normal_av_B * jb;
+	const LaneReal delta_av_A_len = lanes_sqrt(lanes_dot(delta_av_A, delta_av_A));
+	const LaneReal delta_av_B_len = lanes_sqrt(lanes_dot(delta_av_B, delta_av_B));
+	blvA = blvA - normal * (jb * inv_mass_A);
+	bavA = bavA + delta_av_A * lanes_select(lanes_greater(delta_av_A_len, max_bias_av), max_bias_av / delta_av_A_len, one);
+	blvB = blvB + normal * (jb * inv_mass_B);
+	bavB = bavB + delta_av_B * lanes_select(lanes_greater(delta_av_B_len, max_bias_av), max_bias_av / delta_av_B_len, one);
+
+	vbn = lanes_dot(blvB + lanes_cross(bavB, rB) - blvA - lanes_cross(bavA, rA), normal);
+
+	const LaneMask bias_com_active = bias_active & lanes_greater(lanes_abs(bias - vbn), min_velocity);
+	const LaneReal jbnOld_com = lanes_load(p_contacts.acc_bias_impulse_center_of_mass);
+	const LaneReal jbn_com = lanes_select(bias_com_active, lanes_max(jbnOld_com + (bias - vbn) / inv_mass_sum, zero), jbnOld_com);
+	lanes_store(p_contacts.acc_bias_impulse_center_of_mass, jbn_com);
+
+	const LaneReal jb_com = jbn_com - jbnOld_com;
+	lanes_store_vector3(bA.biased_linear_velocity, blvA - normal * (jb_com * inv_mass_A));
+	lanes_store_vector3(bA.biased_angular_velocity, bavA);
+	lanes_store_vector3(bB.biased_linear_velocity, blvB + normal * (jb_com * inv_mass_B));
+	lanes_store_vector3(bB.biased_angular_velocity, bavB);
+
+	// Normal impulse.
+
+	LaneVector3 lvA = lanes_load_vector3(bA.linear_velocity);
+	LaneVector3 avA = lanes_load_vector3(bA.angular_velocity);
+	LaneVector3 lvB = lanes_load_vector3(bB.linear_velocity);
+	LaneVector3 avB = lanes_load_vector3(bB.angular_velocity);
+
+	const LaneReal vn = lanes_dot(lvB + lanes_cross(avB, rB) - lvA - lanes_cross(avA, rA), normal);
+
+	const LaneMask normal_active = active & lanes_greater(lanes_abs(vn), min_velocity);
+	const LaneReal jnOld = lanes_load(p_contacts.acc_normal_impulse);
+	const LaneReal jn = lanes_select(normal_active, lanes_max(jnOld - (lanes_load(p_contacts.bounce) + vn) * mass_normal, zero), jnOld);
+	lanes_store(p_contacts.acc_normal_impulse, jn);
+
+	const LaneReal j = jn - jnOld;
+	lvA = lvA - normal * (j * inv_mass_A);
+	avA = avA - normal_av_A * j;
+	lvB = lvB + normal * (j * inv_mass_B);
+	avB = avB + normal_av_B * j;
+
+	// Friction impulse.
+
+	const LaneVector3 dtv = lvB + lanes_cross(avB, rB) - lvA - lanes_cross(avA, rA);
+	LaneVector3 tv = dtv - normal * lanes_dot(normal, dtv);
+	const LaneReal tvl = lanes_sqrt(lanes_dot(tv, tv));
+
+	const LaneMask friction_active = active & lanes_greater(tvl, min_velocity);
+	const LaneReal tv_inv_len = one / lanes_select(friction_active, tvl, one);
+	tv = tv * tv_inv_len;
+
+	const LaneVector3 temp1 = lanes_xform(inv_inertia_tensor_A, lanes_cross(rA, tv));
+	const LaneVector3 temp2 = lanes_xform(inv_inertia_tensor_B, lanes_cross(rB, tv));
+	const LaneReal t = -tvl / (inv_mass_sum + lanes_dot(tv, lanes_cross(temp1, rA) + lanes_cross(temp2, rB)));
+
+	const LaneVector3 jtOld = lanes_load_vector3(p_contacts.acc_tangent_impulse);
+	LaneVector3 jt_acc = jtOld + tv * t;
+	const LaneReal fi_len = lanes_sqrt(lanes_dot(jt_acc, jt_acc));
+	const LaneReal jtMax = jn * lanes_load(p_packet.friction);
+	const LaneMask clamp_friction = lanes_greater(fi_len, lanes_set(CMP_EPSILON)) & lanes_greater(fi_len, jtMax);
+	jt_acc = lanes_select(friction_active, jt_acc * lanes_select(clamp_friction, jtMax / fi_len, one), jtOld);
+	lanes_store_vector3(p_contacts.acc_tangent_impulse, jt_acc);
+
+	const LaneVector3 jt = jt_acc - jtOld;
+	lanes_store_vector3(bA.linear_velocity, lvA - jt * inv_mass_A);
+	lanes_store_vector3(bA.angular_velocity, avA - lanes_xform(inv_inertia_tensor_A, lanes_cross(rA, jt)));
+	lanes_store_vector3(bB.linear_velocity, lvB + jt * inv_mass_B);
+	lanes_store_vector3(bB.angular_velocity, avB + lanes_xform(inv_inertia_tensor_B, lanes_cross(rB, jt)));
+
+	lanes_store_vector3(p_contacts.acc_impulse, lanes_load_vector3(p_contacts.acc_impulse) - normal * j - jt);
+	// Deactivates, until solved again, the contacts which didn't need any impulse.
+	lanes_store_mask(p_contacts.active, bias_active | normal_active | friction_active);
+}
+
+void GodotContactSolver3D::solve(uint32_t p_task_index, real_t p_step) {
+	if (p_task_index >= packet_count) {
+		constraints[p_task_index - packet_count]->solve(p_step);
+		return;
+	}
+
+	Packet &packet = packets[p_task_index];
+	const real_t max_bias_av = MAX_BIAS_ROTATION / p_step;
+
+	_gather_velocities(packet);
+	for (uint32_t i = 0; i < packet.contact_count; i++) {
+		_solve_contacts(packet, packet.contacts[i], max_bias_av);
+	}
+	_scatter_velocities(packet);
+}
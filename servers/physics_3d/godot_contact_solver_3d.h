@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  godot_contact_solver_3d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_CONTACT_SOLVER_3D_H
+#define GODOT_CONTACT_SOLVER_3D_H
+
+#include "godot_body_pair_3d.h"
+
+#include "core/templates/local_vector.h"
+
+#if !defined(REAL_T_IS_DOUBLE) && defined(__AVX__)
+#define CONTACT_SOLVER_LANES 8
+#else
+#define CONTACT_SOLVER_LANES 4 // SSE, NEON, or scalar.
+#endif
+
+// Solves a batch of constraints sharing no (non-static) body, as produced by the island coloring in GodotStep3D.
+// The contacts of GodotBodyPair3Ds are packed in structures of arrays of LANES pairs, and the sequential impulse
+// iterations run branchless on all the lanes at once, with SSE, AVX or NEON when available. Body velocities are
+// gathered in the packet before each iteration and scattered back after it. Other constraints are solved as usual.
+class GodotContactSolver3D {
+public:
+	enum {
+		LANES = CONTACT_SOLVER_LANES
+	};
+
+private:
+	struct Vector3Lanes {
+		real_t x[LANES] = {};
+		real_t y[LANES] = {};
+		real_t z[LANES] = {};
+
+		_FORCE_INLINE_ Vector3 get(int p_lane) const { return Vector3(x[p_lane], y[p_lane], z[p_lane]); }
+		_FORCE_INLINE_ void set(int p_lane, const Vector3 &p_value) {
+			x[p_lane] = p_value.x;
+			y[p_lane] = p_value.y;
+			z[p_lane] = p_value.z;
+		}
+	};
+
+	struct BasisLanes {
+		real_t rows[3][3][LANES] = {};
+
+		_FORCE_INLINE_ Basis get(int p_lane) const {
+			return Basis(rows[0][0][p_lane], rows[0][1][p_lane], rows[0][2][p_lane],
+					rows[1][0][p_lane], rows[1][1][p_lane], rows[1][2][p_lane],
+					rows[2][0][p_lane], rows[2][1][p_lane], rows[2][2][p_lane]);
+		}
+		_FORCE_INLINE_ void set(int p_lane, const Basis &p_value) {
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					rows[i][j][p_lane] = p_value.rows[i][j];
+				}
+			}
+		}
+	};
+
+	struct BodyLanes {
+		Vector3Lanes linear_velocity;
+		Vector3Lanes angular_velocity;
+		Vector3Lanes biased_linear_velocity;
+		Vector3Lanes biased_angular_velocity;
+		// Zero for bodies not affected by the pair, so impulses applied to them have no effect.
+		BasisLanes inv_inertia_tensor;
+		real_t inv_mass[LANES] = {};
+	};
+
+	struct ContactLanes {
+		uint32_t active[LANES] = {}; // All bits set when active, used as a mask.
+		Vector3Lanes normal;
+		Vector3Lanes rA, rB;
+		Vector3Lanes acc_impulse;
+		Vector3Lanes acc_tangent_impulse;
+		real_t acc_normal_impulse[LANES] = {};
+		real_t acc_bias_impulse[LANES] = {};
+		real_t acc_bias_impulse_center_of_mass[LANES] = {};
+		real_t mass_normal[LANES] = {};
+		real_t bias[LANES] = {};
+		real_t bounce[LANES] = {};
+	};
+
+	struct Packet {
+		GodotBodyPair3D *pairs[LANES] = {};
+		uint32_t pair_count = 0;
+		uint32_t contact_count = 0; // Largest contact count of the pairs.
+
+		real_t friction[LANES] = {};
+		real_t inv_mass_sum[LANES] = {}; // One in unused lanes, to keep divisions finite.
+
+		BodyLanes A, B;
+		ContactLanes contacts[GodotBodyPair3D::MAX_CONTACTS];
+	};
+
+	LocalVector<Packet> packets;
+	uint32_t packet_count = 0;
+	LocalVector<GodotConstraint3D *> constraints;
+
+	void _gather_velocities(Packet &p_packet);
+	void _scatter_velocities(Packet &p_packet);
+	void _solve_contacts(Packet &p_packet, ContactLanes &p_contacts, real_t p_max_bias_av);
+
+public:
+	// Packs the constraints after pre_solve(), must be called again if the batch changes.
+	void setup(const LocalVector<GodotConstraint3D *> &p_constraints);
+	// Writes the accumulated impulses back to the contacts.
+	void finish();
+
+	// Tasks can be run in parallel: each is a packet of pairs, or another constraint.
+	_FORCE_INLINE_ uint32_t get_task_count() const { return packet_count + constraints.size(); }
+	void solve(uint32_t p_task_index, real_t p_step);
+};
+
+#endif // GODOT_CONTACT_SOLVER_3D_H
@@ -39,6 +39,8 @@
 #include "joints/godot_slider_joint_3d.h"
 
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/frame_tracer.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -188,6 +190,22 @@ real_t GodotPhysicsServer3D::space_get_param(RID p_space, SpaceParameter p_param
 	return space->get_param(p_param);
 }
 
+Vector<uint8_t> GodotPhysicsServer3D::space_save_state(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(using_threads && !doing_sync, Vector<uint8_t>(), "Space state can't be saved while the space is being stepped, wait for iteration or physics process notification.");
+
+	return space->save_state();
+}
+
+bool GodotPhysicsServer3D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, false);
+	ERR_FAIL_COND_V_MSG(using_threads && !doing_sync, false, "Space state can't be restored while the space is being stepped, wait for iteration or physics process notification.");
+
+	return space->restore_state(p_state);
+}
+
 PhysicsDirectSpaceState3D *GodotPhysicsServer3D::space_get_direct_state(RID p_space) {
 	GodotSpace3D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_COND_V(!space, nullptr);
@@ -920,6 +938,71 @@ bool GodotPhysicsServer3D::body_test_motion(RID p_body, const MotionParameters &
 	return body->get_space()->test_body_motion(body, p_parameters, r_result);
 }
 
+bool GodotPhysicsServer3D::_slide_test_motion(void *p_userdata, RID p_body, const MotionParameters &p_parameters, MotionResult *r_result) {
+	SlideTestContext *context = static_cast<SlideTestContext *>(p_userdata);
+	return context->body->get_space()->test_body_motion(context->body, p_parameters, r_result, context->cull_results.ptr(), context->cull_subindex_results.ptr());
+}
+
+void GodotPhysicsServer3D::_body_move_and_slide_batch_task(uint32_t p_index, SlideBatch *p_batch) {
+	uint32_t begin = p_batch->count * p_index / p_batch->task_count;
+	uint32_t end = p_batch->count * (p_index + 1) / p_batch->task_count;
+
+	SlideTestContext context;
+	context.cull_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	context.cull_subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	for (uint32_t i = begin; i < end; i++) {
+		const SlideParameters &parameters = p_batch->parameters[i];
+		SlideResult &result = p_batch->results[i];
+
+		context.body = p_batch->bodies[i];
+		if (!context.body) {
+			result.transform = parameters.from;
+			result.velocity = parameters.velocity;
+			result.last_motion = Vector3();
+			result.motion_results.clear();
+			continue;
+		}
+
+		_body_move_and_slide(p_batch->rids[i], parameters, result, _slide_test_motion, &context);
+	}
+}
+
+void GodotPhysicsServer3D::body_move_and_slide_batch(const RID *p_bodies, const SlideParameters *p_parameters, int p_count, SlideResult *r_results) {
+	if (p_count <= 0) {
+		return;
+	}
+
+	SlideBatch batch;
+	batch.rids = p_bodies;
+	batch.parameters = p_parameters;
+	batch.results = r_results;
+	batch.count = p_count;
+	batch.bodies.resize(p_count);
+
+	for (int i = 0; i < p_count; i++) {
+		batch.bodies[i] = nullptr;
+
+		GodotBody3D *body = body_owner.get_or_null(p_bodies[i]);
+		ERR_CONTINUE(!body);
+		ERR_CONTINUE(!body->get_space());
+		ERR_CONTINUE(body->get_space()->is_locked());
+
+		batch.bodies[i] = body;
+	}
+
+	// The motions only read the spaces, once the shapes are up to date.
+	_update_shapes();
+
+	batch.task_count = CLAMP(uint32_t(WorkerThreadPool::get_singleton()->get_thread_count()), 1u, batch.count);
+	if (batch.task_count == 1) {
+		_body_move_and_slide_batch_task(0, &batch);
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer3D::_body_move_and_slide_batch_task, &batch, batch.task_count, -1, true, SNAME("Physics3DMoveAndSlideBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+}
+
 PhysicsDirectBodyState3D *GodotPhysicsServer3D::body_get_direct_state(RID p_body) {
 	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync), nullptr, "Body state is inaccessible right now, wait for iteration or physics process notification.");
 
@@ -1630,6 +1713,7 @@ void GodotPhysicsServer3D::init() {
 
 void GodotPhysicsServer3D::step(real_t p_step) {
 #ifndef _3D_DISABLED
+	TRACE_ZONE("PhysicsServer3D::step");
 
 	if (!active) {
 		return;
@@ -1640,11 +1724,17 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
+		elapsed_time[i] = 0;
+	}
 	for (const GodotSpace3D *E : active_spaces) {
 		stepper->step(const_cast<GodotSpace3D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
+			elapsed_time[i] += E->get_elapsed_time(GodotSpace3D::ElapsedTime(i));
+		}
 	}
 #endif
 }
@@ -1675,6 +1765,7 @@ void GodotPhysicsServer3D::flush_queries() {
 		uint64_t total_time[GodotSpace3D::ELAPSED_TIME_MAX];
 		static const char *time_name[GodotSpace3D::ELAPSED_TIME_MAX] = {
 			"integrate_forces",
+			"broadphase",
 			"generate_islands",
 			"setup_constraints",
 			"solve_constraints",
@@ -1725,6 +1816,24 @@ int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_INTEGRATE_FORCES_TIME: {
+			return elapsed_time[GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES];
+		} break;
+		case INFO_BROADPHASE_TIME: {
+			return elapsed_time[GodotSpace3D::ELAPSED_TIME_BROADPHASE];
+		} break;
+		case INFO_GENERATE_ISLANDS_TIME: {
+			return elapsed_time[GodotSpace3D::ELAPSED_TIME_GENERATE_ISLANDS];
+		} break;
+		case INFO_SETUP_CONSTRAINTS_TIME: {
+			return elapsed_time[GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS];
+		} break;
+		case INFO_SOLVE_CONSTRAINTS_TIME: {
+			return elapsed_time[GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS];
+		} break;
+		case INFO_INTEGRATE_VELOCITIES_TIME: {
+			return elapsed_time[GodotSpace3D::ELAPSED_TIME_INTEGRATE_VELOCITIES];
+		} break;
 	}
 
 	return 0;
@@ -43,11 +43,13 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	GDCLASS(GodotPhysicsServer3D, PhysicsServer3D);
 
 	friend class GodotPhysicsDirectSpaceState3D;
+	friend class GodotSpace3D;
 	bool active = true;
 
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	uint64_t elapsed_time[GodotSpace3D::ELAPSED_TIME_MAX] = {}; // Of all the active spaces, in microseconds.
 
 	bool using_threads = false;
 	bool doing_sync = false;
@@ -68,6 +70,24 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	SelfList<GodotCollisionObject3D>::List pending_shape_update_list;
 	void _update_shapes();
 
+	struct SlideBatch {
+		const RID *rids = nullptr;
+		const SlideParameters *parameters = nullptr;
+		SlideResult *results = nullptr;
+		LocalVector<GodotBody3D *> bodies; // Null if the body can't be moved.
+		uint32_t count = 0;
+		uint32_t task_count = 0;
+	};
+
+	struct SlideTestContext {
+		GodotBody3D *body = nullptr;
+		LocalVector<GodotCollisionObject3D *> cull_results;
+		LocalVector<int> cull_subindex_results;
+	};
+
+	static bool _slide_test_motion(void *p_userdata, RID p_body, const MotionParameters &p_parameters, MotionResult *r_result);
+	void _body_move_and_slide_batch_task(uint32_t p_index, SlideBatch *p_batch);
+
 	static GodotPhysicsServer3D *godot_singleton;
 
 public:
@@ -110,6 +130,9 @@ public:
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) override;
 	virtual real_t space_get_param(RID p_space, SpaceParameter p_param) const override;
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) const override;
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override;
+
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState3D *space_get_direct_state(RID p_space) override;
 
@@ -251,6 +274,7 @@ public:
 	virtual void body_set_ray_pickable(RID p_body, bool p_enable) override;
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) override;
+	virtual void body_move_and_slide_batch(const RID *p_bodies, const SlideParameters *p_parameters, int p_count, SlideResult *r_results) override;
 
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override;
@@ -33,6 +33,7 @@
 #include "core/io/image.h"
 #include "core/math/convex_hull.h"
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/sort_array.h"
 
 // GodotHeightMapShape3D is based on Bullet btHeightfieldTerrainShape.
@@ -68,9 +69,13 @@ const double cylinder_face_support_threshold = 0.999;
 void GodotShape3D::configure(const AABB &p_aabb) {
 	aabb = p_aabb;
 	configured = true;
+	notify_owners();
+}
+
+void GodotShape3D::notify_owners() {
 	for (const KeyValue<GodotShapeOwner3D *, int> &E : owners) {
 		GodotShapeOwner3D *co = const_cast<GodotShapeOwner3D *>(E.key);
-		co->_shape_changed();
+		co->_shape_data_changed(this);
 	}
 }
 
@@ -1285,18 +1290,7 @@ GodotFaceShape3D::GodotFaceShape3D() {
 }
 
 Vector<Vector3> GodotConcavePolygonShape3D::get_faces() const {
-	Vector<Vector3> rfaces;
-	rfaces.resize(faces.size() * 3);
-
-	for (int i = 0; i < faces.size(); i++) {
-		Face f = faces.get(i);
-
-		for (int j = 0; j < 3; j++) {
-			rfaces.set(i * 3 + j, vertices.get(f.indices[j]));
-		}
-	}
-
-	return rfaces;
+	return vertices; // Each face has its own vertices, in the order they were given.
 }
 
 void GodotConcavePolygonShape3D::project_range(const Vector3 &p_normal, const Transform3D &p_transform, real_t &r_min, real_t &r_max) const {
@@ -1345,40 +1339,31 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!params_bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
+void GodotConcavePolygonShape3D::_quantize_aabb(const AABB &p_aabb, uint16_t *r_min, uint16_t *r_max) const {
+	const AABB &shape_aabb = get_aabb();
+	Vector3 from = (p_aabb.position - shape_aabb.position) * bvh_quantize_scale;
+	Vector3 to = (p_aabb.position + p_aabb.size - shape_aabb.position) * bvh_quantize_scale;
+	for (int i = 0; i < 3; i++) {
+		// One extra unit on each side covers the rounding errors of converting back and forth.
+		r_min[i] = uint16_t(CLAMP(Math::floor(from[i]) - 1.0, 0.0, 65535.0));
+		r_max[i] = uint16_t(CLAMP(Math::ceil(to[i]) + 1.0, 0.0, 65535.0));
 	}
+}
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-
-		Vector3 res;
-		Vector3 normal;
-		if (face->intersect_segment(p_params->from, p_params->to, res, normal, true)) {
-			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
-			if ((d > 0) && (d < p_params->min_d)) {
-				p_params->min_d = d;
-				p_params->result = res;
-				p_params->normal = normal;
-				p_params->collisions++;
-			}
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			_cull_segment(params_bvh->left, p_params);
-		}
-		if (params_bvh->right >= 0) {
-			_cull_segment(params_bvh->right, p_params);
-		}
-	}
+AABB GodotConcavePolygonShape3D::_dequantize_aabb(const BVH &p_node) const {
+	const AABB &shape_aabb = get_aabb();
+	Vector3 from(p_node.min[0], p_node.min[1], p_node.min[2]);
+	Vector3 to(p_node.max[0], p_node.max[1], p_node.max[2]);
+	return AABB(shape_aabb.position + from * bvh_dequantize_scale, (to - from) * bvh_dequantize_scale);
+}
+
+void GodotConcavePolygonShape3D::_get_face(int p_index, GodotFaceShape3D *r_face) const {
+	const Face &f = faces[p_index];
+	const Vector3 *vr = vertices.ptr();
+	r_face->normal = f.normal;
+	r_face->vertex[0] = vr[f.indices[0]];
+	r_face->vertex[1] = vr[f.indices[1]];
+	r_face->vertex[2] = vr[f.indices[2]];
 }
 
 bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_result, Vector3 &r_normal, bool p_hit_back_faces) const {
@@ -1386,35 +1371,61 @@ bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const
 		return false;
 	}
 
-	// unlock data
-	const Face *fr = faces.ptr();
-	const Vector3 *vr = vertices.ptr();
 	const BVH *br = bvh.ptr();
 
 	GodotFaceShape3D face;
 	face.backface_collision = backface_collision && p_hit_back_faces;
 
-	_SegmentCullParams params;
-	params.from = p_begin;
-	params.to = p_end;
-	params.dir = (p_end - p_begin).normalized();
+	Vector3 dir = (p_end - p_begin).normalized();
+	// Shortened to the closest hit found so far, so farther nodes are skipped.
+	Vector3 to = p_end;
+	real_t min_d = 1e20;
+	bool collided = false;
 
-	params.faces = fr;
-	params.vertices = vr;
-	params.bvh = br;
+	uint32_t stack[BVH_MAX_DEPTH];
+	uint32_t stack_size = 0;
+	uint32_t idx = 0;
 
-	params.face = &face;
+	while (true) {
+		const BVH &node = br[idx];
+		if (_dequantize_aabb(node).intersects_segment(p_begin, to)) {
+			if (node.face_count == 0) {
+				// Visit the child closer to the origin first.
+				if (dir[node.split_axis] < 0) {
+					stack[stack_size++] = idx + 1;
+					idx = node.index;
+				} else {
+					stack[stack_size++] = node.index;
+					idx = idx + 1;
+				}
+				continue;
+			}
 
-	// cull
-	_cull_segment(0, &params);
+			for (uint32_t i = 0; i < node.face_count; i++) {
+				_get_face(node.index + i, &face);
+
+				Vector3 res;
+				Vector3 normal;
+				if (face.intersect_segment(p_begin, to, res, normal, true)) {
+					real_t d = dir.dot(res) - dir.dot(p_begin);
+					if ((d > 0) && (d < min_d)) {
+						min_d = d;
+						to = res;
+						r_result = res;
+						r_normal = normal;
+						collided = true;
+					}
+				}
+			}
+		}
 
-	if (params.collisions > 0) {
-		r_result = params.result;
-		r_normal = params.normal;
-		return true;
-	} else {
-		return false;
+		if (stack_size == 0) {
+			break;
+		}
+		idx = stack[--stack_size];
 	}
+
+	return collided;
 }
 
 bool GodotConcavePolygonShape3D::intersect_point(const Vector3 &p_point) const {
@@ -1425,68 +1436,53 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 	return Vector3();
 }
 
-bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
-		return false;
-	}
-
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-		if (p_params->callback(p_params->userdata, face)) {
-			return true;
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
-				return true;
-			}
-		}
-
-		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
-				return true;
-			}
-		}
-	}
-
-	return false;
-}
-
 void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata, bool p_invert_backface_collision) const {
 	// make matrix local to concave
-	if (faces.size() == 0) {
+	if (faces.size() == 0 || !p_local_aabb.intersects(get_aabb())) {
 		return;
 	}
 
-	AABB local_aabb = p_local_aabb;
+	// Compare in quantized space, bounds of both the query and the nodes are rounded outwards.
+	uint16_t query_min[3];
+	uint16_t query_max[3];
+	_quantize_aabb(p_local_aabb, query_min, query_max);
 
-	// unlock data
-	const Face *fr = faces.ptr();
-	const Vector3 *vr = vertices.ptr();
 	const BVH *br = bvh.ptr();
 
 	GodotFaceShape3D face; // use this to send in the callback
 	face.backface_collision = backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
-	_CullParams params;
-	params.aabb = local_aabb;
-	params.face = &face;
-	params.faces = fr;
-	params.vertices = vr;
-	params.bvh = br;
-	params.callback = p_callback;
-	params.userdata = p_userdata;
+	uint32_t stack[BVH_MAX_DEPTH];
+	uint32_t stack_size = 0;
+	uint32_t idx = 0;
 
-	// cull
-	_cull(0, &params);
+	while (true) {
+		const BVH &node = br[idx];
+		bool overlaps = node.min[0] <= query_max[0] && node.max[0] >= query_min[0] &&
+				node.min[1] <= query_max[1] && node.max[1] >= query_min[1] &&
+				node.min[2] <= query_max[2] && node.max[2] >= query_min[2];
+
+		if (overlaps) {
+			if (node.face_count == 0) {
+				stack[stack_size++] = node.index;
+				idx = idx + 1;
+				continue;
+			}
+
+			for (uint32_t i = 0; i < node.face_count; i++) {
+				_get_face(node.index + i, &face);
+				if (p_callback(p_userdata, &face)) {
+					return;
+				}
+			}
+		}
+
+		if (stack_size == 0) {
+			break;
+		}
+		idx = stack[--stack_size];
+	}
 }
 
 Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -1499,184 +1495,468 @@ Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
 			(p_mass / 3.0) * (extents.x * extents.x + extents.y * extents.y));
 }
 
-struct _Volume_BVH_Element {
-	AABB aabb;
-	Vector3 center;
-	int face_index = 0;
-};
+// Binned SAH builder. Large meshes build the top of the tree first, then the subtrees below it in parallel.
+struct _VolumeBVHBuilder {
+	enum {
+		BIN_COUNT = 16,
+		SAH_MAX_DEPTH = 64, // Deeper nodes are split at the median, which bounds the tree depth.
+		PARALLEL_MIN_FACES = 16384,
+		SUBTREE_MIN_FACES = 4096,
+	};
 
-struct _Volume_BVH_CompareX {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.x < b.center.x;
-	}
-};
+	struct Node {
+		AABB aabb;
+		uint32_t left = 0;
+		uint32_t right = 0;
+		uint32_t begin = 0;
+		uint32_t count = 0; // Only set for leaves.
+		uint32_t axis = 0;
+		int32_t subtree = -1; // Placeholder for a subtree built in parallel.
+	};
+
+	struct Subtree {
+		uint32_t begin = 0;
+		uint32_t end = 0;
+		uint32_t depth = 0;
+		LocalVector<Node> nodes;
+	};
+
+	struct CenterCompare {
+		const Vector3 *centers = nullptr;
+		int axis = 0;
+
+		_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+			return centers[p_a][axis] < centers[p_b][axis];
+		}
+	};
 
-struct _Volume_BVH_CompareY {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.y < b.center.y;
+	const AABB *face_aabbs = nullptr;
+	LocalVector<Vector3> centers;
+	uint32_t *order = nullptr;
+	uint32_t subtree_max_faces = 0; // Zero builds the whole tree on the calling thread.
+	LocalVector<Node> nodes;
+	LocalVector<Subtree> subtrees;
+
+	static _FORCE_INLINE_ real_t _get_cost_area(const AABB &p_aabb) {
+		return p_aabb.size.x * p_aabb.size.y + p_aabb.size.y * p_aabb.size.z + p_aabb.size.z * p_aabb.size.x;
 	}
-};
 
-struct _Volume_BVH_CompareZ {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.z < b.center.z;
+	_FORCE_INLINE_ uint32_t _get_bin(uint32_t p_face, int p_axis, real_t p_min, real_t p_scale) const {
+		return MIN(uint32_t((centers[p_face][p_axis] - p_min) * p_scale), uint32_t(BIN_COUNT - 1));
 	}
-};
 
-struct _Volume_BVH {
-	AABB aabb;
-	_Volume_BVH *left = nullptr;
-	_Volume_BVH *right = nullptr;
+	uint32_t _build(LocalVector<Node> &r_nodes, uint32_t p_begin, uint32_t p_end, uint32_t p_depth, bool p_defer) {
+		uint32_t count = p_end - p_begin;
+		uint32_t node_index = r_nodes.size();
+		r_nodes.push_back(Node());
 
-	int face_index = 0;
-};
+		AABB aabb = face_aabbs[order[p_begin]];
+		AABB centroid_aabb(centers[order[p_begin]], Vector3());
+		for (uint32_t i = p_begin + 1; i < p_end; i++) {
+			aabb.merge_with(face_aabbs[order[i]]);
+			centroid_aabb.expand_to(centers[order[i]]);
+		}
 
-_Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int &count) {
-	_Volume_BVH *bvh = memnew(_Volume_BVH);
-
-	if (p_size == 1) {
-		//leaf
-		bvh->aabb = p_elements[0].aabb;
-		bvh->left = nullptr;
-		bvh->right = nullptr;
-		bvh->face_index = p_elements->face_index;
-		count++;
-		return bvh;
-	} else {
-		bvh->face_index = -1;
+		r_nodes[node_index].aabb = aabb;
+		r_nodes[node_index].begin = p_begin;
+
+		if (p_defer && count <= subtree_max_faces) {
+			Subtree subtree;
+			subtree.begin = p_begin;
+			subtree.end = p_end;
+			subtree.depth = p_depth;
+			r_nodes[node_index].subtree = subtrees.size();
+			subtrees.push_back(subtree);
+			return node_index;
+		}
+
+		if (count == 1) {
+			r_nodes[node_index].count = 1;
+			return node_index;
+		}
+
+		int split_axis = centroid_aabb.get_longest_axis_index();
+		uint32_t split = p_begin + count / 2;
+		bool split_found = false;
+
+		if (p_depth < SAH_MAX_DEPTH && centroid_aabb.size[split_axis] > CMP_EPSILON) {
+			real_t best_cost = 1e20;
+			int best_axis = -1;
+			uint32_t best_bin = 0;
+
+			for (int axis = 0; axis < 3; axis++) {
+				real_t extent = centroid_aabb.size[axis];
+				if (extent <= CMP_EPSILON) {
+					continue;
+				}
+				real_t min = centroid_aabb.position[axis];
+				real_t scale = BIN_COUNT / extent;
+
+				AABB bin_aabbs[BIN_COUNT];
+				uint32_t bin_counts[BIN_COUNT] = {};
+				for (uint32_t i = p_begin; i < p_end; i++) {
+					uint32_t bin = _get_bin(order[i], axis, min, scale);
+					if (bin_counts[bin] == 0) {
+						bin_aabbs[bin] = face_aabbs[order[i]];
+					} else {
+						bin_aabbs[bin].merge_with(face_aabbs[order[i]]);
+					}
+					bin_counts[bin]++;
+				}
+
+				// Cost of everything right of each split.
+				real_t right_areas[BIN_COUNT];
+				uint32_t right_counts[BIN_COUNT];
+				AABB right_aabb;
+				uint32_t right_count = 0;
+				for (int i = BIN_COUNT - 1; i > 0; i--) {
+					if (bin_counts[i] > 0) {
+						if (right_count == 0) {
+							right_aabb = bin_aabbs[i];
+						} else {
+							right_aabb.merge_with(bin_aabbs[i]);
+						}
+						right_count += bin_counts[i];
+					}
+					right_areas[i] = right_count > 0 ? _get_cost_area(right_aabb) : 0;
+					right_counts[i] = right_count;
+				}
+
+				AABB left_aabb;
+				uint32_t left_count = 0;
+				for (int i = 1; i < BIN_COUNT; i++) {
+					if (bin_counts[i - 1] > 0) {
+						if (left_count == 0) {
+							left_aabb = bin_aabbs[i - 1];
+						} else {
+							left_aabb.merge_with(bin_aabbs[i - 1]);
+						}
+						left_count += bin_counts[i - 1];
+					}
+					if (left_count == 0 || right_counts[i] == 0) {
+						continue;
+					}
+					real_t cost = left_count * _get_cost_area(left_aabb) + right_counts[i] * right_areas[i];
+					if (cost < best_cost) {
+						best_cost = cost;
+						best_axis = axis;
+						best_bin = i;
+					}
+				}
+			}
+
+			if (best_axis >= 0) {
+				// Traversing a node costs about as much as testing a face.
+				real_t area = _get_cost_area(aabb);
+				if (count <= GodotConcavePolygonShape3D::BVH_MAX_LEAF_FACES && count * area <= area + best_cost) {
+					r_nodes[node_index].count = count;
+					return node_index;
+				}
+
+				real_t min = centroid_aabb.position[best_axis];
+				real_t scale = BIN_COUNT / centroid_aabb.size[best_axis];
+				uint32_t left_end = p_begin;
+				for (uint32_t i = p_begin; i < p_end; i++) {
+					if (_get_bin(order[i], best_axis, min, scale) < best_bin) {
+						SWAP(order[i], order[left_end]);
+						left_end++;
+					}
+				}
+
+				split_axis = best_axis;
+				split = left_end;
+				split_found = true;
+			}
+		}
+
+		if (!split_found) {
+			if (count <= GodotConcavePolygonShape3D::BVH_MAX_LEAF_FACES) {
+				r_nodes[node_index].count = count;
+				return node_index;
+			}
+			SortArray<uint32_t, CenterCompare> sorter;
+			sorter.compare.centers = centers.ptr();
+			sorter.compare.axis = split_axis;
+			sorter.nth_element(p_begin, p_end, split, order);
+		}
+
+		uint32_t left = _build(r_nodes, p_begin, split, p_depth + 1, p_defer);
+		uint32_t right = _build(r_nodes, split, p_end, p_depth + 1, p_defer);
+		r_nodes[node_index].left = left;
+		r_nodes[node_index].right = right;
+		r_nodes[node_index].axis = split_axis;
+		return node_index;
 	}
 
-	AABB aabb;
-	for (int i = 0; i < p_size; i++) {
-		if (i == 0) {
-			aabb = p_elements[i].aabb;
-		} else {
-			aabb.merge_with(p_elements[i].aabb);
+	void _build_subtree(uint32_t p_index, void *p_userdata) {
+		Subtree &subtree = subtrees[p_index];
+		_build(subtree.nodes, subtree.begin, subtree.end, subtree.depth, false);
+	}
+
+	// Writes the nodes depth first, with the subtrees in place of their placeholders.
+	void _flatten(const LocalVector<Node> &p_nodes, uint32_t p_index, LocalVector<Node> &r_nodes) {
+		const Node &node = p_nodes[p_index];
+		if (node.subtree >= 0) {
+			_flatten(subtrees[node.subtree].nodes, 0, r_nodes);
+			return;
+		}
+
+		uint32_t index = r_nodes.size();
+		r_nodes.push_back(node);
+		if (node.count == 0) {
+			_flatten(p_nodes, node.left, r_nodes);
+			r_nodes[index].right = r_nodes.size();
+			_flatten(p_nodes, node.right, r_nodes);
 		}
 	}
-	bvh->aabb = aabb;
-	switch (aabb.get_longest_axis_index()) {
-		case 0: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareX> sort_x;
-			sort_x.sort(p_elements, p_size);
 
-		} break;
-		case 1: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareY> sort_y;
-			sort_y.sort(p_elements, p_size);
-		} break;
-		case 2: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareZ> sort_z;
-			sort_z.sort(p_elements, p_size);
-		} break;
+	void build(const AABB *p_face_aabbs, uint32_t p_face_count, uint32_t *r_order, LocalVector<Node> &r_nodes) {
+		face_aabbs = p_face_aabbs;
+		order = r_order;
+		centers.resize(p_face_count);
+		for (uint32_t i = 0; i < p_face_count; i++) {
+			centers[i] = face_aabbs[i].get_center();
+			order[i] = i;
+		}
+
+		uint32_t thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+		bool parallel = p_face_count >= PARALLEL_MIN_FACES && thread_count > 1;
+		if (parallel) {
+			subtree_max_faces = MAX(p_face_count / (thread_count * 4), uint32_t(SUBTREE_MIN_FACES));
+		}
+
+		_build(nodes, 0, p_face_count, 0, parallel);
+
+		if (subtrees.size() > 0) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &_VolumeBVHBuilder::_build_subtree, nullptr, subtrees.size(), -1, true, SNAME("ConcavePolygonShape3DBuildBVH"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+
+		uint32_t node_count = nodes.size();
+		for (const Subtree &subtree : subtrees) {
+			node_count += subtree.nodes.size() - 1;
+		}
+		r_nodes.clear();
+		r_nodes.reserve(node_count);
+		_flatten(nodes, 0, r_nodes);
 	}
+};
+
+// Header of the BVH data saved along the faces, so loading them doesn't need to build it again.
+// It's followed by the nodes, and the source index of each face in leaf order.
+struct _VolumeBVHDataHeader {
+	uint32_t magic = 0;
+	uint32_t node_size = 0;
+	uint32_t face_count = 0;
+	uint32_t node_count = 0;
+	uint32_t faces_hash = 0;
+};
 
-	int split = p_size / 2;
-	bvh->left = _volume_build_bvh(p_elements, split, count);
-	bvh->right = _volume_build_bvh(&p_elements[split], p_size - split, count);
+static const uint32_t VOLUME_BVH_DATA_MAGIC = 0x31425643; // "CVB1".
 
-	//printf("branch at %p - %i: %i\n",bvh,count,bvh->face_index);
-	count++;
-	return bvh;
+uint32_t GodotConcavePolygonShape3D::_get_faces_hash() const {
+	return hash_murmur3_buffer(vertices.ptr(), vertices.size() * sizeof(Vector3));
 }
 
-void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
-	int idx = p_idx;
-
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
+void GodotConcavePolygonShape3D::_build_bvh(const Vector<AABB> &p_face_aabbs, Vector<uint32_t> &r_face_order) {
+	uint32_t face_count = p_face_aabbs.size();
+	r_face_order.resize(face_count);
 
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+	LocalVector<_VolumeBVHBuilder::Node> nodes;
+	_VolumeBVHBuilder builder;
+	builder.build(p_face_aabbs.ptr(), face_count, r_face_order.ptrw(), nodes);
 
-	} else {
-		p_bvh_array[p_idx].left = -1;
+	bvh.resize(nodes.size());
+	BVH *bvhw = bvh.ptrw();
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		const _VolumeBVHBuilder::Node &node = nodes[i];
+		BVH &b = bvhw[i];
+		_quantize_aabb(node.aabb, b.min, b.max);
+		if (node.count > 0) {
+			b.index = node.begin;
+			b.face_count = node.count;
+		} else {
+			b.index = node.right;
+			b.split_axis = node.axis;
+		}
 	}
+}
 
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
-		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
+bool GodotConcavePolygonShape3D::_load_bvh(const Vector<uint8_t> &p_data, Vector<uint32_t> &r_face_order) {
+	uint32_t face_count = vertices.size() / 3;
+
+	ERR_FAIL_COND_V(p_data.size() < (int)sizeof(_VolumeBVHDataHeader), false);
+	_VolumeBVHDataHeader header;
+	memcpy(&header, p_data.ptr(), sizeof(_VolumeBVHDataHeader));
+	if (header.magic != VOLUME_BVH_DATA_MAGIC || header.node_size != sizeof(BVH) || header.face_count != face_count || header.faces_hash != _get_faces_hash()) {
+		return false; // Saved by another version, or for other faces.
+	}
+	ERR_FAIL_COND_V(header.node_count == 0 || header.node_count > face_count * 2, false);
+	ERR_FAIL_COND_V((uint64_t)p_data.size() != sizeof(_VolumeBVHDataHeader) + uint64_t(header.node_count) * sizeof(BVH) + uint64_t(face_count) * sizeof(uint32_t), false);
+
+	const uint8_t *r = p_data.ptr() + sizeof(_VolumeBVHDataHeader);
+	Vector<BVH> nodes;
+	nodes.resize(header.node_count);
+	memcpy(nodes.ptrw(), r, header.node_count * sizeof(BVH));
+	r += header.node_count * sizeof(BVH);
+
+	r_face_order.resize(face_count);
+	memcpy(r_face_order.ptrw(), r, face_count * sizeof(uint32_t));
+
+	// Validate everything traversal relies on, so broken data can't crash the queries.
+	const BVH *nr = nodes.ptr();
+	uint32_t stack[BVH_MAX_DEPTH][2];
+	uint32_t stack_size = 1;
+	uint32_t visited = 0;
+	stack[0][0] = 0;
+	stack[0][1] = 0;
+	while (stack_size > 0) {
+		stack_size--;
+		uint32_t idx = stack[stack_size][0];
+		uint32_t depth = stack[stack_size][1];
+		visited++;
+		ERR_FAIL_COND_V(visited > header.node_count, false);
+
+		const BVH &node = nr[idx];
+		if (node.face_count > 0) {
+			ERR_FAIL_COND_V(uint64_t(node.index) + node.face_count > face_count, false);
+			continue;
+		}
+		ERR_FAIL_COND_V(node.split_axis > 2, false);
+		ERR_FAIL_COND_V(idx + 1 >= header.node_count || node.index <= idx + 1 || node.index >= header.node_count, false);
+		ERR_FAIL_COND_V(depth + 1 >= BVH_MAX_DEPTH || stack_size + 2 > BVH_MAX_DEPTH, false);
+		stack[stack_size][0] = node.index;
+		stack[stack_size][1] = depth + 1;
+		stack_size++;
+		stack[stack_size][0] = idx + 1;
+		stack[stack_size][1] = depth + 1;
+		stack_size++;
+	}
+	ERR_FAIL_COND_V(visited != header.node_count, false);
+
+	LocalVector<bool> used;
+	used.resize(face_count);
+	memset(used.ptr(), 0, face_count * sizeof(bool));
+	const uint32_t *fr = r_face_order.ptr();
+	for (uint32_t i = 0; i < face_count; i++) {
+		ERR_FAIL_COND_V(fr[i] >= face_count || used[fr[i]], false);
+		used[fr[i]] = true;
+	}
+
+	bvh = nodes;
+	return true;
+}
 
-	} else {
-		p_bvh_array[p_idx].right = -1;
+Vector<uint8_t> GodotConcavePolygonShape3D::_save_bvh() const {
+	_VolumeBVHDataHeader header;
+	header.magic = VOLUME_BVH_DATA_MAGIC;
+	header.node_size = sizeof(BVH);
+	header.face_count = faces.size();
+	header.node_count = bvh.size();
+	header.faces_hash = _get_faces_hash();
+
+	Vector<uint8_t> data;
+	data.resize(sizeof(_VolumeBVHDataHeader) + bvh.size() * sizeof(BVH) + faces.size() * sizeof(uint32_t));
+	uint8_t *w = data.ptrw();
+	memcpy(w, &header, sizeof(_VolumeBVHDataHeader));
+	w += sizeof(_VolumeBVHDataHeader);
+	memcpy(w, bvh.ptr(), bvh.size() * sizeof(BVH));
+	w += bvh.size() * sizeof(BVH);
+
+	uint32_t *face_order = (uint32_t *)w;
+	const Face *fr = faces.ptr();
+	for (int i = 0; i < faces.size(); i++) {
+		face_order[i] = fr[i].indices[0] / 3;
 	}
 
-	memdelete(p_bvh_tree);
+	return data;
 }
 
-void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_backface_collision) {
+void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_backface_collision, const Vector<uint8_t> &p_bvh_data) {
+	backface_collision = p_backface_collision;
+
+	if (!faces.is_empty() && p_faces == vertices) {
+		return; // Same faces (e.g. only backface collision changed), the BVH is still valid.
+	}
+
 	int src_face_count = p_faces.size();
 	if (src_face_count == 0) {
+		faces.clear();
+		vertices.clear();
+		bvh.clear();
 		configure(AABB());
 		return;
 	}
 	ERR_FAIL_COND(src_face_count % 3);
 	src_face_count /= 3;
 
-	const Vector3 *facesr = p_faces.ptr();
-
-	Vector<_Volume_BVH_Element> bvh_array;
-	bvh_array.resize(src_face_count);
-
-	_Volume_BVH_Element *bvh_arrayw = bvh_array.ptrw();
-
-	faces.resize(src_face_count);
-	Face *facesw = faces.ptrw();
-
-	vertices.resize(src_face_count * 3);
+	vertices = p_faces;
+	const Vector3 *vr = vertices.ptr();
 
-	Vector3 *verticesw = vertices.ptrw();
+	Vector<AABB> face_aabbs;
+	face_aabbs.resize(src_face_count);
+	AABB *face_aabbsw = face_aabbs.ptrw();
 
 	AABB _aabb;
 
 	for (int i = 0; i < src_face_count; i++) {
-		Face3 face(facesr[i * 3 + 0], facesr[i * 3 + 1], facesr[i * 3 + 2]);
-
-		bvh_arrayw[i].aabb = face.get_aabb();
-		bvh_arrayw[i].center = bvh_arrayw[i].aabb.get_center();
-		bvh_arrayw[i].face_index = i;
-		facesw[i].indices[0] = i * 3 + 0;
-		facesw[i].indices[1] = i * 3 + 1;
-		facesw[i].indices[2] = i * 3 + 2;
-		facesw[i].normal = face.get_plane().normal;
-		verticesw[i * 3 + 0] = face.vertex[0];
-		verticesw[i * 3 + 1] = face.vertex[1];
-		verticesw[i * 3 + 2] = face.vertex[2];
+		AABB &face_aabb = face_aabbsw[i];
+		face_aabb.position = vr[i * 3 + 0];
+		face_aabb.expand_to(vr[i * 3 + 1]);
+		face_aabb.expand_to(vr[i * 3 + 2]);
 		if (i == 0) {
-			_aabb = bvh_arrayw[i].aabb;
+			_aabb = face_aabb;
 		} else {
-			_aabb.merge_with(bvh_arrayw[i].aabb);
+			_aabb.merge_with(face_aabb);
 		}
 	}
 
-	int count = 0;
-	_Volume_BVH *bvh_tree = _volume_build_bvh(bvh_arrayw, src_face_count, count);
-
-	bvh.resize(count + 1);
+	// The shape AABB is needed to quantize the nodes.
+	configure(_aabb); // this type of shape has no margin
 
-	BVH *bvh_arrayw2 = bvh.ptrw();
+	for (int i = 0; i < 3; i++) {
+		bvh_quantize_scale[i] = _aabb.size[i] > 0 ? 65535.0 / _aabb.size[i] : 0.0;
+		bvh_dequantize_scale[i] = _aabb.size[i] / 65535.0;
+	}
 
-	int idx = 0;
-	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
+	Vector<uint32_t> face_order;
+	if (p_bvh_data.is_empty() || !_load_bvh(p_bvh_data, face_order)) {
+		_build_bvh(face_aabbs, face_order);
+	}
 
-	backface_collision = p_backface_collision;
+	faces.resize(src_face_count);
+	Face *facesw = faces.ptrw();
+	const uint32_t *face_orderr = face_order.ptr();
 
-	configure(_aabb); // this type of shape has no margin
+	for (int i = 0; i < src_face_count; i++) {
+		uint32_t src = face_orderr[i];
+		Face3 face(vr[src * 3 + 0], vr[src * 3 + 1], vr[src * 3 + 2]);
+		facesw[i].indices[0] = src * 3 + 0;
+		facesw[i].indices[1] = src * 3 + 1;
+		facesw[i].indices[2] = src * 3 + 2;
+		facesw[i].normal = face.get_plane().normal;
+	}
 }
 
 void GodotConcavePolygonShape3D::set_data(const Variant &p_data) {
 	Dictionary d = p_data;
 	ERR_FAIL_COND(!d.has("faces"));
 
-	_setup(d["faces"], d["backface_collision"]);
+	Vector<uint8_t> bvh_data;
+	if (d.has("bvh")) {
+		bvh_data = d["bvh"];
+	}
+
+	_setup(d["faces"], d["backface_collision"], bvh_data);
 }
 
 Variant GodotConcavePolygonShape3D::get_data() const {
 	Dictionary d;
 	d["faces"] = get_faces();
 	d["backface_collision"] = backface_collision;
+	if (!faces.is_empty()) {
+		d["bvh"] = _save_bvh();
+	}
 
 	return d;
 }
@@ -2082,6 +2362,47 @@ Vector3 GodotHeightMapShape3D::get_moment_of_inertia(real_t p_mass) const {
 			(p_mass / 3.0) * (extents.x * extents.x + extents.y * extents.y));
 }
 
+void GodotHeightMapShape3D::_update_bounds_chunk(int p_chunk_x, int p_chunk_z) {
+	int z0 = p_chunk_z * BOUNDS_CHUNK_SIZE;
+	int x0 = p_chunk_x * BOUNDS_CHUNK_SIZE;
+
+	Range r;
+
+	r.min = _get_height(x0, z0);
+	r.max = r.min;
+
+	// Compute min and max height for this chunk.
+	// We have to include one extra cell to account for neighbors.
+	// Here is why:
+	// Say we have a flat terrain, and a plateau that fits a chunk perfectly.
+	//
+	//   Left        Right
+	// 0---0---0---1---1---1
+	// |   |   |   |   |   |
+	// 0---0---0---1---1---1
+	// |   |   |   |   |   |
+	// 0---0---0---1---1---1
+	//           x
+	//
+	// If the AABB for the Left chunk did not share vertices with the Right,
+	// then we would fail collision tests at x due to a gap.
+	//
+	int z_max = MIN(z0 + BOUNDS_CHUNK_SIZE + 1, depth);
+	int x_max = MIN(x0 + BOUNDS_CHUNK_SIZE + 1, width);
+	for (int z = z0; z < z_max; ++z) {
+		for (int x = x0; x < x_max; ++x) {
+			real_t height = _get_height(x, z);
+			if (height < r.min) {
+				r.min = height;
+			} else if (height > r.max) {
+				r.max = height;
+			}
+		}
+	}
+
+	bounds_grid[p_chunk_x + p_chunk_z * bounds_grid_width] = r;
+}
+
 void GodotHeightMapShape3D::_build_accelerator() {
 	bounds_grid.clear();
 
@@ -2107,46 +2428,8 @@ void GodotHeightMapShape3D::_build_accelerator() {
 
 	// Compute min and max height for all chunks.
 	for (int cz = 0; cz < bounds_grid_depth; ++cz) {
-		int z0 = cz * BOUNDS_CHUNK_SIZE;
-
 		for (int cx = 0; cx < bounds_grid_width; ++cx) {
-			int x0 = cx * BOUNDS_CHUNK_SIZE;
-
-			Range r;
-
-			r.min = _get_height(x0, z0);
-			r.max = r.min;
-
-			// Compute min and max height for this chunk.
-			// We have to include one extra cell to account for neighbors.
-			// Here is why:
-			// Say we have a flat terrain, and a plateau that fits a chunk perfectly.
-			//
-			//   Left        Right
-			// 0---0---0---1---1---1
-			// |   |   |   |   |   |
-			// 0---0---0---1---1---1
-			// |   |   |   |   |   |
-			// 0---0---0---1---1---1
-			//           x
-			//
-			// If the AABB for the Left chunk did not share vertices with the Right,
-			// then we would fail collision tests at x due to a gap.
-			//
-			int z_max = MIN(z0 + BOUNDS_CHUNK_SIZE + 1, depth);
-			int x_max = MIN(x0 + BOUNDS_CHUNK_SIZE + 1, width);
-			for (int z = z0; z < z_max; ++z) {
-				for (int x = x0; x < x_max; ++x) {
-					real_t height = _get_height(x, z);
-					if (height < r.min) {
-						r.min = height;
-					} else if (height > r.max) {
-						r.max = height;
-					}
-				}
-			}
-
-			bounds_grid[cx + cz * bounds_grid_width] = r;
+			_update_bounds_chunk(cx, cz);
 		}
 	}
 }
@@ -2172,10 +2455,64 @@ void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width,
 	configure(aabb_new);
 }
 
+void GodotHeightMapShape3D::_update_region(const Rect2i &p_region, const Vector<real_t> &p_heights) {
+	ERR_FAIL_COND_MSG(!p_region.has_area() || !Rect2i(0, 0, width, depth).encloses(p_region), vformat("Region %s is outside of the heightmap.", p_region));
+	ERR_FAIL_COND(p_heights.size() != p_region.size.x * p_region.size.y);
+
+	const AABB &shape_aabb = get_aabb();
+	real_t min_height = shape_aabb.position.y;
+	real_t max_height = shape_aabb.position.y + shape_aabb.size.y;
+
+	// Written in place, the buffer is only copied if it's still shared with the caller.
+	real_t *w = heights.ptrw();
+	const real_t *r = p_heights.ptr();
+	for (int z = 0; z < p_region.size.y; z++) {
+		real_t *row = &w[(p_region.position.y + z) * width + p_region.position.x];
+		for (int x = 0; x < p_region.size.x; x++) {
+			real_t h = *r++;
+			row[x] = h;
+			if (h < min_height) {
+				min_height = h;
+			} else if (h > max_height) {
+				max_height = h;
+			}
+		}
+	}
+
+	if (!bounds_grid.is_empty()) {
+		// Chunks include the first row and column of the next ones, so the region can affect the chunks before it.
+		Point2i region_end = p_region.get_end() - Point2i(1, 1);
+		int chunk_x_end = MIN(region_end.x / BOUNDS_CHUNK_SIZE, bounds_grid_width - 1);
+		int chunk_z_end = MIN(region_end.y / BOUNDS_CHUNK_SIZE, bounds_grid_depth - 1);
+		for (int cz = MAX(p_region.position.y - 1, 0) / BOUNDS_CHUNK_SIZE; cz <= chunk_z_end; ++cz) {
+			for (int cx = MAX(p_region.position.x - 1, 0) / BOUNDS_CHUNK_SIZE; cx <= chunk_x_end; ++cx) {
+				_update_bounds_chunk(cx, cz);
+			}
+		}
+	}
+
+	// The AABB only grows, it's only reconfigured when the heights go beyond it.
+	if (min_height < shape_aabb.position.y || max_height > shape_aabb.position.y + shape_aabb.size.y) {
+		AABB aabb_new = shape_aabb;
+		aabb_new.position.y = min_height;
+		aabb_new.size.y = max_height - min_height;
+		configure(aabb_new);
+	} else {
+		// The owners still have to wake up the bodies resting on the changed heights.
+		notify_owners();
+	}
+}
+
 void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 	ERR_FAIL_COND(p_data.get_type() != Variant::DICTIONARY);
 
 	Dictionary d = p_data;
+	if (d.has("region")) {
+		// Partial update of the heights, with the same width and depth.
+		_update_region(d["region"], d.get("heights", Vector<real_t>()));
+		return;
+	}
+
 	ERR_FAIL_COND(!d.has("width"));
 	ERR_FAIL_COND(!d.has("depth"));
 	ERR_FAIL_COND(!d.has("heights"));
@@ -39,7 +39,7 @@ class GodotShape3D;
 
 class GodotShapeOwner3D {
 public:
-	virtual void _shape_changed() = 0;
+	virtual void _shape_data_changed(const GodotShape3D *p_shape) = 0;
 	virtual void remove_shape(GodotShape3D *p_shape) = 0;
 
 	virtual ~GodotShapeOwner3D() {}
@@ -55,6 +55,7 @@ class GodotShape3D {
 
 protected:
 	void configure(const AABB &p_aabb);
+	void notify_owners();
 
 public:
 	enum FeatureType {
@@ -302,7 +303,6 @@ public:
 	GodotConvexPolygonShape3D();
 };
 
-struct _Volume_BVH;
 struct GodotFaceShape3D;
 
 struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
@@ -313,52 +313,41 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 		int indices[3] = {};
 	};
 
+	// Faces are sorted in BVH leaf order, vertices keep the order they were given in.
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
 
-	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
-
-		int face_index = 0;
+	enum {
+		BVH_MAX_DEPTH = 128,
+		BVH_MAX_LEAF_FACES = 4,
 	};
 
-	Vector<BVH> bvh;
-
-	struct _CullParams {
-		AABB aabb;
-		QueryCallback callback = nullptr;
-		void *userdata = nullptr;
-		const Face *faces = nullptr;
-		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
-		GodotFaceShape3D *face = nullptr;
+	// Node bounds are quantized to 16 bits within the shape AABB, rounded outwards. Nodes are stored depth first,
+	// so the left child of an internal node always follows it.
+	struct BVH {
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
+		uint32_t index = 0; // Right child of internal nodes, first face of leaves.
+		uint16_t face_count = 0; // Zero for internal nodes.
+		uint16_t split_axis = 0;
 	};
 
-	struct _SegmentCullParams {
-		Vector3 from;
-		Vector3 to;
-		Vector3 dir;
-		const Face *faces = nullptr;
-		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
-		GodotFaceShape3D *face = nullptr;
-
-		Vector3 result;
-		Vector3 normal;
-		real_t min_d = 1e20;
-		int collisions = 0;
-	};
+	Vector<BVH> bvh;
+	Vector3 bvh_quantize_scale;
+	Vector3 bvh_dequantize_scale;
 
 	bool backface_collision = false;
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	bool _cull(int p_idx, _CullParams *p_params) const;
+	_FORCE_INLINE_ void _quantize_aabb(const AABB &p_aabb, uint16_t *r_min, uint16_t *r_max) const;
+	_FORCE_INLINE_ AABB _dequantize_aabb(const BVH &p_node) const;
+	_FORCE_INLINE_ void _get_face(int p_index, GodotFaceShape3D *r_face) const;
 
-	void _fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
+	uint32_t _get_faces_hash() const;
+	void _build_bvh(const Vector<AABB> &p_face_aabbs, Vector<uint32_t> &r_face_order);
+	bool _load_bvh(const Vector<uint8_t> &p_data, Vector<uint32_t> &r_face_order);
+	Vector<uint8_t> _save_bvh() const;
 
-	void _setup(const Vector<Vector3> &p_faces, bool p_backface_collision);
+	void _setup(const Vector<Vector3> &p_faces, bool p_backface_collision, const Vector<uint8_t> &p_bvh_data);
 
 public:
 	Vector<Vector3> get_faces() const;
@@ -415,12 +404,14 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 
 	void _get_cell(const Vector3 &p_point, int &r_x, int &r_y, int &r_z) const;
 
+	void _update_bounds_chunk(int p_chunk_x, int p_chunk_z);
 	void _build_accelerator();
 
 	template <typename ProcessFunction>
 	bool _intersect_grid_segment(ProcessFunction &p_process, const Vector3 &p_begin, const Vector3 &p_end, int p_width, int p_depth, const Vector3 &offset, Vector3 &r_point, Vector3 &r_normal) const;
 
 	void _setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height);
+	void _update_region(const Rect2i &p_region, const Vector<real_t> &p_heights);
 
 public:
 	Vector<real_t> get_heights() const;
@@ -33,6 +33,7 @@
 #include "godot_space_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/rb_map.h"
 #include "servers/rendering_server.h"
 
@@ -188,7 +189,7 @@ void GodotSoftBody3D::update_normals_and_centroids() {
 	}
 }
 
-void GodotSoftBody3D::update_bounds() {
+bool GodotSoftBody3D::_update_bounds_cache() {
 	AABB prev_bounds = bounds;
 	prev_bounds.grow_by(collision_margin);
 
@@ -196,8 +197,7 @@ void GodotSoftBody3D::update_bounds() {
 
 	const uint32_t nodes_count = nodes.size();
 	if (nodes_count == 0) {
-		deinitialize_shape();
-		return;
+		return false;
 	}
 
 	bool first = true;
@@ -215,7 +215,15 @@ void GodotSoftBody3D::update_bounds() {
 		}
 	}
 
-	if (get_space()) {
+	return moved;
+}
+
+void GodotSoftBody3D::update_bounds() {
+	bool moved = _update_bounds_cache();
+
+	if (nodes.is_empty()) {
+		deinitialize_shape();
+	} else if (get_space()) {
 		initialize_shape(moved);
 	}
 }
@@ -467,6 +475,17 @@ Vector3 GodotSoftBody3D::get_face_normal(uint32_t p_face_index) const {
 	return faces[p_face_index].normal;
 }
 
+uint32_t GodotSoftBody3D::get_link_count() const {
+	return links.size();
+}
+
+void GodotSoftBody3D::get_link_nodes(uint32_t p_link_index, uint32_t &r_node_1, uint32_t &r_node_2) const {
+	ERR_FAIL_UNSIGNED_INDEX(p_link_index, links.size());
+	const Link &link = links[p_link_index];
+	r_node_1 = link.n[0]->index;
+	r_node_2 = link.n[1]->index;
+}
+
 bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Vector<Vector3> &p_vertices) {
 	ERR_FAIL_COND_V(p_indices.is_empty(), false);
 	ERR_FAIL_COND_V(p_vertices.is_empty(), false);
@@ -578,7 +597,7 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 	}
 
 	generate_bending_constraints(2);
-	reoptimize_link_order();
+	color_links();
 
 	update_constants();
 	update_normals_and_centroids();
@@ -697,130 +716,66 @@ void GodotSoftBody3D::generate_bending_constraints(int p_distance) {
 //===================================================================
 
 // A small structure to track lists of dependent link calculations.
-class LinkDeps {
-public:
-	// A link calculation that is dependent on this one.
-	// Positive values = "input A" while negative values = "input B".
-	int value;
-	// Next dependence in the list.
-	LinkDeps *next;
-};
-typedef LinkDeps *LinkDepsPtr;
-
-void GodotSoftBody3D::reoptimize_link_order() {
-	const int reop_not_dependent = -1;
-	const int reop_node_complete = -2;
+void GodotSoftBody3D::color_links() {
+	link_color_offsets.clear();
 
 	uint32_t link_count = links.size();
-	uint32_t node_count = nodes.size();
-
-	if (link_count < 1 || node_count < 2) {
+	if (link_count == 0) {
 		return;
 	}
 
-	uint32_t i;
-	Link *lr;
-	int ar, br;
-	Node *node0 = &(nodes[0]);
-	Node *node1 = &(nodes[1]);
-	LinkDepsPtr link_dep;
-	int ready_list_head, ready_list_tail, link_num, link_dep_frees, dep_link;
-
-	// Allocate temporary buffers.
-	int *node_written_at = memnew_arr(int, node_count + 1); // What link calculation produced this node's current values?
-	int *link_dep_A = memnew_arr(int, link_count); // Link calculation input is dependent upon prior calculation #N
-	int *link_dep_B = memnew_arr(int, link_count);
-	int *ready_list = memnew_arr(int, link_count); // List of ready-to-process link calculations (# of links, maximum)
-	LinkDeps *link_dep_free_list = memnew_arr(LinkDeps, 2 * link_count); // Dependent-on-me list elements (2x# of links, maximum)
-	LinkDepsPtr *link_dep_list_starts = memnew_arr(LinkDepsPtr, link_count); // Start nodes of dependent-on-me lists, one for each link
-
-	// Copy the original, unsorted links to a side buffer.
-	Link *link_buffer = memnew_arr(Link, link_count);
-	memcpy(link_buffer, &(links[0]), sizeof(Link) * link_count);
-
-	// Clear out the node setup and ready list.
-	for (i = 0; i < node_count + 1; i++) {
-		node_written_at[i] = reop_not_dependent;
-	}
-	for (i = 0; i < link_count; i++) {
-		link_dep_list_starts[i] = nullptr;
-	}
-	ready_list_head = ready_list_tail = link_dep_frees = 0;
-
-	// Initial link analysis to set up data structures.
-	for (i = 0; i < link_count; i++) {
-		// Note which prior link calculations we are dependent upon & build up dependence lists.
-		lr = &(links[i]);
-		ar = (lr->n[0] - node0) / (node1 - node0);
-		br = (lr->n[1] - node0) / (node1 - node0);
-		if (node_written_at[ar] > reop_not_dependent) {
-			link_dep_A[i] = node_written_at[ar];
-			link_dep = &link_dep_free_list[link_dep_frees++];
-			link_dep->value = i;
-			link_dep->next = link_dep_list_starts[node_written_at[ar]];
-			link_dep_list_starts[node_written_at[ar]] = link_dep;
-		} else {
-			link_dep_A[i] = reop_not_dependent;
-		}
-		if (node_written_at[br] > reop_not_dependent) {
-			link_dep_B[i] = node_written_at[br];
-			link_dep = &link_dep_free_list[link_dep_frees++];
-			link_dep->value = -(int)(i + 1);
-			link_dep->next = link_dep_list_starts[node_written_at[br]];
-			link_dep_list_starts[node_written_at[br]] = link_dep;
-		} else {
-			link_dep_B[i] = reop_not_dependent;
-		}
+	const uint32_t max_colors = 64;
 
-		// Add this link to the initial ready list, if it is not dependent on any other links.
-		if ((link_dep_A[i] == reop_not_dependent) && (link_dep_B[i] == reop_not_dependent)) {
-			ready_list[ready_list_tail++] = i;
-			link_dep_A[i] = link_dep_B[i] = reop_node_complete; // Probably not needed now.
-		}
+	// Greedy coloring: each link gets the first color none of its nodes is used with yet.
+	LocalVector<uint64_t> node_colors;
+	node_colors.resize(nodes.size());
+	memset(node_colors.ptr(), 0, node_colors.size() * sizeof(uint64_t));
 
-		// Update the nodes to mark which ones are calculated by this link.
-		node_written_at[ar] = node_written_at[br] = i;
-	}
-
-	// Process the ready list and create the sorted list of links:
-	// -- By treating the ready list as a queue, we maximize the distance between any
-	//    inter-dependent node calculations.
-	// -- All other (non-related) nodes in the ready list will automatically be inserted
-	//    in between each set of inter-dependent link calculations by this loop.
-	i = 0;
-	while (ready_list_head != ready_list_tail) {
-		// Use ready list to select the next link to process.
-		link_num = ready_list[ready_list_head++];
-		// Copy the next-to-calculate link back into the original link array.
-		links[i++] = link_buffer[link_num];
-
-		// Free up any link inputs that are dependent on this one.
-		link_dep = link_dep_list_starts[link_num];
-		while (link_dep) {
-			dep_link = link_dep->value;
-			if (dep_link >= 0) {
-				link_dep_A[dep_link] = reop_not_dependent;
-			} else {
-				dep_link = -dep_link - 1;
-				link_dep_B[dep_link] = reop_not_dependent;
-			}
-			// Add this dependent link calculation to the ready list if *both* inputs are clear.
-			if ((link_dep_A[dep_link] == reop_not_dependent) && (link_dep_B[dep_link] == reop_not_dependent)) {
-				ready_list[ready_list_tail++] = dep_link;
-				link_dep_A[dep_link] = link_dep_B[dep_link] = reop_node_complete; // Probably not needed now.
+	LocalVector<uint8_t> link_colors;
+	link_colors.resize(link_count);
+	uint32_t color_sizes[max_colors + 1] = {};
+	uint32_t color_count = 0;
+
+	const Node *first_node = nodes.ptr();
+	for (uint32_t i = 0; i < link_count; i++) {
+		uint32_t node_a = links[i].n[0] - first_node;
+		uint32_t node_b = links[i].n[1] - first_node;
+
+		uint64_t used_colors = node_colors[node_a] | node_colors[node_b];
+		uint32_t color = max_colors; // Out of colors, solved serially.
+		if (used_colors != UINT64_MAX) {
+			color = 0;
+			while (used_colors & (uint64_t(1) << color)) {
+				color++;
 			}
-			link_dep = link_dep->next;
+			node_colors[node_a] |= uint64_t(1) << color;
+			node_colors[node_b] |= uint64_t(1) << color;
+			color_count = MAX(color_count, color + 1);
 		}
+
+		link_colors[i] = color;
+		color_sizes[color]++;
+	}
+
+	// Sort the links by color, keeping their order within each color.
+	uint32_t color_offsets[max_colors + 1];
+	uint32_t offset = 0;
+	for (uint32_t color = 0; color <= max_colors; color++) {
+		color_offsets[color] = offset;
+		offset += color_sizes[color];
 	}
 
-	// Delete the temporary buffers.
-	memdelete_arr(node_written_at);
-	memdelete_arr(link_dep_A);
-	memdelete_arr(link_dep_B);
-	memdelete_arr(ready_list);
-	memdelete_arr(link_dep_free_list);
-	memdelete_arr(link_dep_list_starts);
-	memdelete_arr(link_buffer);
+	link_color_offsets.resize(color_count + 1);
+	for (uint32_t color = 0; color <= color_count; color++) {
+		link_color_offsets[color] = color_offsets[color];
+	}
+
+	LocalVector<Link> sorted_links;
+	sorted_links.resize(link_count);
+	for (uint32_t i = 0; i < link_count; i++) {
+		sorted_links[color_offsets[link_colors[i]]++] = links[i];
+	}
+	links = sorted_links;
 }
 
 void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
@@ -1042,8 +997,8 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 		node.f = Vector3();
 	}
 
-	// Bounds and tree update.
-	update_bounds();
+	// Bounds update, the shape is updated in commit_motion().
+	bounds_moved = _update_bounds_cache();
 
 	// Node tree update.
 	for (const Node &node : nodes) {
@@ -1064,6 +1019,15 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	face_tree.optimize_incremental(1);
 }
 
+void GodotSoftBody3D::commit_motion() {
+	if (nodes.is_empty()) {
+		deinitialize_shape();
+	} else if (get_space()) {
+		initialize_shape(bounds_moved);
+	}
+	bounds_moved = false;
+}
+
 void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	const real_t inv_delta = 1.0 / p_delta;
 
@@ -1095,8 +1059,10 @@ void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	update_normals_and_centroids();
 }
 
-void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
-	for (Link &link : links) {
+void GodotSoftBody3D::_solve_link_range(uint32_t p_begin, uint32_t p_end, real_t kst) {
+	Link *links_ptr = links.ptr();
+	for (uint32_t i = p_begin; i < p_end; i++) {
+		Link &link = links_ptr[i];
 		if (link.c0 > 0) {
 			Node &node_a = *link.n[0];
 			Node &node_b = *link.n[1];
@@ -1111,6 +1077,35 @@ void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
 	}
 }
 
+void GodotSoftBody3D::_solve_link_batch(uint32_t p_batch_index, void *p_userdata) {
+	uint32_t begin = solving_link_begin + p_batch_index * SOLVER_THREADED_BATCH_SIZE;
+	_solve_link_range(begin, MIN(begin + SOLVER_THREADED_BATCH_SIZE, solving_link_end), solving_kst);
+}
+
+void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
+	if (!is_solver_threaded()) {
+		// Same order as the threaded solver, so both give the same results.
+		_solve_link_range(0, links.size(), kst);
+		return;
+	}
+
+	solving_kst = kst;
+	uint32_t color_count = link_color_offsets.size() - 1;
+	for (uint32_t color = 0; color < color_count; color++) {
+		solving_link_begin = link_color_offsets[color];
+		solving_link_end = link_color_offsets[color + 1];
+		uint32_t batch_count = (solving_link_end - solving_link_begin + SOLVER_THREADED_BATCH_SIZE - 1) / SOLVER_THREADED_BATCH_SIZE;
+		if (batch_count > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotSoftBody3D::_solve_link_batch, nullptr, batch_count, -1, true, SNAME("Physics3DSoftBodySolveLinks"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			_solve_link_range(solving_link_begin, solving_link_end, kst);
+		}
+	}
+
+	_solve_link_range(link_color_offsets[color_count], links.size(), kst);
+}
+
 struct AABBQueryResult {
 	const GodotSoftBody3D *soft_body = nullptr;
 	void *userdata = nullptr;
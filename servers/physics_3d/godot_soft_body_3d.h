@@ -78,16 +78,29 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 		uint32_t index = 0;
 	};
 
+	enum {
+		SOLVER_THREADED_MIN_LINKS = 4096, // Smaller soft bodies are solved on a single thread.
+		SOLVER_THREADED_BATCH_SIZE = 512, // Links per task.
+	};
+
 	LocalVector<Node> nodes;
 	LocalVector<Link> links;
 	LocalVector<Face> faces;
 
+	// Links are sorted by color, links of the same color share no node so they can be solved in parallel.
+	// The links that didn't get a color come last, and are solved serially.
+	LocalVector<uint32_t> link_color_offsets; // Start of each color, then the end of the last one.
+	uint32_t solving_link_begin = 0;
+	uint32_t solving_link_end = 0;
+	real_t solving_kst = 0.0;
+
 	DynamicBVH node_tree;
 	DynamicBVH face_tree;
 
 	LocalVector<uint32_t> map_visual_to_physics;
 
 	AABB bounds;
+	bool bounds_moved = false;
 
 	real_t collision_margin = 0.05;
 
@@ -156,6 +169,7 @@ public:
 	virtual void set_space(GodotSpace3D *p_space) override;
 
 	void set_mesh(RID p_mesh);
+	bool create_from_trimesh(const Vector<int> &p_indices, const Vector<Vector3> &p_vertices);
 
 	void update_rendering_server(PhysicsServer3DRenderingServerHandler *p_rendering_server_handler);
 
@@ -179,6 +193,10 @@ public:
 	void get_face_points(uint32_t p_face_index, Vector3 &r_point_1, Vector3 &r_point_2, Vector3 &r_point_3) const;
 	Vector3 get_face_normal(uint32_t p_face_index) const;
 
+	uint32_t get_link_count() const;
+	void get_link_nodes(uint32_t p_link_index, uint32_t &r_node_1, uint32_t &r_node_2) const;
+	_FORCE_INLINE_ const LocalVector<uint32_t> &get_link_color_offsets() const { return link_color_offsets; }
+
 	void set_iteration_count(int p_val);
 	_FORCE_INLINE_ real_t get_iteration_count() const { return iteration_count; }
 
@@ -201,7 +219,13 @@ public:
 	void set_drag_coefficient(real_t p_val);
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
+	// predict_motion() can run on several threads (for different soft bodies), as long as commit_motion() is called
+	// afterwards from a single thread, to update the broadphase.
 	void predict_motion(real_t p_delta);
+	void commit_motion();
+
+	// Large soft bodies solve their links with all the threads, they must be solved from the step thread.
+	_FORCE_INLINE_ bool is_solver_threaded() const { return links.size() >= SOLVER_THREADED_MIN_LINKS && !link_color_offsets.is_empty(); }
 	void solve_constraints(real_t p_delta);
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
@@ -219,6 +243,7 @@ protected:
 
 private:
 	void update_normals_and_centroids();
+	bool _update_bounds_cache();
 	void update_bounds();
 	void update_constants();
 	void update_area();
@@ -231,13 +256,14 @@ private:
 
 	void apply_forces(const LocalVector<GodotArea3D *> &p_wind_areas);
 
-	bool create_from_trimesh(const Vector<int> &p_indices, const Vector<Vector3> &p_vertices);
 	void generate_bending_constraints(int p_distance);
-	void reoptimize_link_order();
+	void color_links();
 	void append_link(uint32_t p_node1, uint32_t p_node2);
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
 	void solve_links(real_t kst, real_t ti);
+	void _solve_link_range(uint32_t p_begin, uint32_t p_end, real_t kst);
+	void _solve_link_batch(uint32_t p_batch_index, void *p_userdata = nullptr);
 
 	void initialize_face_tree();
 	void update_face_tree(real_t p_delta);
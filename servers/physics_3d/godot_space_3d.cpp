@@ -34,6 +34,7 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
@@ -108,38 +109,43 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
 	ERR_FAIL_COND_V(space->locked, false);
 
-	Vector3 begin, end;
-	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
-	normal = (end - begin).normalized();
+	Vector3 begin = p_parameters.from;
+	Vector3 end = p_parameters.to;
 
 	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
 
+	return _intersect_ray_results(p_parameters, begin, end, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
+
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray_results(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_results, const int *p_subindex_results, int p_amount, RayResult &r_result) {
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
+	const Vector3 &begin = p_from;
+	const Vector3 &end = p_to;
+	Vector3 normal = (end - begin).normalized();
+
 	bool collided = false;
 	Vector3 res_point, res_normal;
 	int res_shape = -1;
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -260,51 +266,55 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_COND_V(!shape, false);
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
+	return _cast_motion(shape, p_parameters, p_parameters.transform, p_parameters.motion, space->intersection_query_results, space->intersection_query_subindex_results, p_closest_safe, p_closest_unsafe, r_info);
+}
+
+bool GodotPhysicsDirectSpaceState3D::_cast_motion(GodotShape3D *p_shape, const ShapeParameters &p_parameters, const Transform3D &p_transform, const Vector3 &p_motion, GodotCollisionObject3D **r_results, int *r_subindex_results, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+	AABB aabb = p_transform.xform(p_shape->get_aabb());
+	aabb = aabb.merge(AABB(aabb.position + p_motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, r_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_subindex_results);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
-	Transform3D xform_inv = p_parameters.transform.affine_inverse();
+	Transform3D xform_inv = p_transform.affine_inverse();
 	GodotMotionShape3D mshape;
-	mshape.shape = shape;
-	mshape.motion = xform_inv.basis.xform(p_parameters.motion);
+	mshape.shape = p_shape;
+	mshape.motion = xform_inv.basis.xform(p_motion);
 
 	bool best_first = true;
 
-	Vector3 motion_normal = p_parameters.motion.normalized();
+	Vector3 motion_normal = p_motion.normalized();
 
 	Vector3 closest_A, closest_B;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = r_results[i];
+		int shape_idx = r_subindex_results[i];
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = motion_normal;
 
 		Transform3D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
 		sep_axis = motion_normal;
 
-		if (!GodotCollisionSolver3D::solve_distance(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (!GodotCollisionSolver3D::solve_distance(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
@@ -315,11 +325,11 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 		for (int j = 0; j < 8; j++) { //steps should be customizable..
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
-			mshape.motion = xform_inv.basis.xform(p_parameters.motion * fraction);
+			mshape.motion = xform_inv.basis.xform(p_motion * fraction);
 
 			Vector3 lA, lB;
 			Vector3 sep = motion_normal; //important optimization for this to work fast enough
-			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
+			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
 
 			if (collided) {
 				hi = fraction;
@@ -375,6 +385,104 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 	return true;
 }
 
+static uint32_t _get_batch_task_count(uint32_t p_packet_count) {
+	return CLAMP(uint32_t(WorkerThreadPool::get_singleton()->get_thread_count()), 1u, MAX(p_packet_count, 1u));
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_task(uint32_t p_index, RayBatch *p_batch) {
+	uint32_t begin = p_batch->count * p_index / p_batch->task_count;
+	uint32_t end = p_batch->count * (p_index + 1) / p_batch->task_count;
+
+	LocalVector<GodotCollisionObject3D *> results;
+	LocalVector<int> subindex_results;
+	results.resize(RAY_BATCH_PACKET_SIZE * GodotSpace3D::INTERSECTION_QUERY_MAX);
+	subindex_results.resize(RAY_BATCH_PACKET_SIZE * GodotSpace3D::INTERSECTION_QUERY_MAX);
+	int result_counts[RAY_BATCH_PACKET_SIZE];
+
+	uint32_t hit_count = 0;
+	for (uint32_t i = begin; i < end; i += RAY_BATCH_PACKET_SIZE) {
+		int packet_size = MIN(uint32_t(RAY_BATCH_PACKET_SIZE), end - i);
+		space->broadphase->cull_segments(p_batch->from + i, p_batch->to + i, packet_size, results.ptr(), result_counts, GodotSpace3D::INTERSECTION_QUERY_MAX, subindex_results.ptr());
+
+		for (int j = 0; j < packet_size; j++) {
+			int offset = j * GodotSpace3D::INTERSECTION_QUERY_MAX;
+			bool hit = _intersect_ray_results(*p_batch->parameters, p_batch->from[i + j], p_batch->to[i + j], results.ptr() + offset, subindex_results.ptr() + offset, result_counts[j], p_batch->results[i + j]);
+			p_batch->hits[i + j] = hit;
+			hit_count += hit ? 1 : 0;
+		}
+	}
+
+	p_batch->hit_count.add(hit_count);
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.count = p_count;
+	batch.task_count = _get_batch_task_count((p_count + RAY_BATCH_PACKET_SIZE - 1) / RAY_BATCH_PACKET_SIZE);
+
+	if (batch.task_count == 1) {
+		_intersect_ray_batch_task(0, &batch);
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_task, &batch, batch.task_count, -1, true, SNAME("Physics3DIntersectRayBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	return batch.hit_count.get();
+}
+
+void GodotPhysicsDirectSpaceState3D::_cast_motion_batch_task(uint32_t p_index, MotionBatch *p_batch) {
+	uint32_t begin = p_batch->count * p_index / p_batch->task_count;
+	uint32_t end = p_batch->count * (p_index + 1) / p_batch->task_count;
+
+	LocalVector<GodotCollisionObject3D *> results;
+	LocalVector<int> subindex_results;
+	results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	Transform3D transform = p_batch->parameters->transform;
+	for (uint32_t i = begin; i < end; i++) {
+		transform.origin = p_batch->origins[i];
+		_cast_motion(p_batch->shape, *p_batch->parameters, transform, p_batch->motions[i], results.ptr(), subindex_results.ptr(), p_batch->closest_safe[i], p_batch->closest_unsafe[i], nullptr);
+	}
+}
+
+bool GodotPhysicsDirectSpaceState3D::cast_motion_batch(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_COND_V(!shape, false);
+	if (p_count <= 0) {
+		return true;
+	}
+
+	MotionBatch batch;
+	batch.shape = shape;
+	batch.parameters = &p_parameters;
+	batch.origins = p_origins;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+	batch.count = p_count;
+	batch.task_count = _get_batch_task_count(p_count);
+
+	if (batch.task_count == 1) {
+		_cast_motion_batch_task(0, &batch);
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_cast_motion_batch_task, &batch, batch.task_count, -1, true, SNAME("Physics3DCastMotionBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	return true;
+}
+
 bool GodotPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
 	if (p_result_max <= 0) {
 		return false;
@@ -611,28 +719,28 @@ GodotPhysicsDirectSpaceState3D::GodotPhysicsDirectSpaceState3D() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
-	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb, GodotCollisionObject3D **r_results, int *r_subindex_results) {
+	int amount = broadphase->cull_aabb(p_aabb, r_results, INTERSECTION_QUERY_MAX, r_subindex_results);
 
 	for (int i = 0; i < amount; i++) {
 		bool keep = true;
 
-		if (intersection_query_results[i] == p_body) {
+		if (r_results[i] == p_body) {
 			keep = false;
-		} else if (intersection_query_results[i]->get_type() == GodotCollisionObject3D::TYPE_AREA) {
+		} else if (r_results[i]->get_type() == GodotCollisionObject3D::TYPE_AREA) {
 			keep = false;
-		} else if (intersection_query_results[i]->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
+		} else if (r_results[i]->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
 			keep = false;
-		} else if (!p_body->collides_with(static_cast<GodotBody3D *>(intersection_query_results[i]))) {
+		} else if (!p_body->collides_with(static_cast<GodotBody3D *>(r_results[i]))) {
 			keep = false;
-		} else if (static_cast<GodotBody3D *>(intersection_query_results[i])->has_exception(p_body->get_self()) || p_body->has_exception(intersection_query_results[i]->get_self())) {
+		} else if (static_cast<GodotBody3D *>(r_results[i])->has_exception(p_body->get_self()) || p_body->has_exception(r_results[i]->get_self())) {
 			keep = false;
 		}
 
 		if (!keep) {
 			if (i < amount - 1) {
-				SWAP(intersection_query_results[i], intersection_query_results[amount - 1]);
-				SWAP(intersection_query_subindex_results[i], intersection_query_subindex_results[amount - 1]);
+				SWAP(r_results[i], r_results[amount - 1]);
+				SWAP(r_subindex_results[i], r_subindex_results[amount - 1]);
 			}
 
 			amount--;
@@ -643,7 +751,7 @@ int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
 	return amount;
 }
 
-bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) {
+bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results) {
 	//give me back regular physics engine logic
 	//this is madness
 	//and most people using this function will think
@@ -716,7 +824,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 
 			bool collided = false;
 
-			int amount = _cull_aabb_for_body(p_body, body_aabb);
+			int amount = _cull_aabb_for_body(p_body, body_aabb, r_cull_results, r_cull_subindex_results);
 
 			for (int j = 0; j < p_body->get_shape_count(); j++) {
 				if (p_body->is_shape_disabled(j)) {
@@ -727,7 +835,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 				GodotShape3D *body_shape = p_body->get_shape(j);
 
 				for (int i = 0; i < amount; i++) {
-					const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+					const GodotCollisionObject3D *col_obj = r_cull_results[i];
 					if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 						continue;
 					}
@@ -735,7 +843,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 						continue;
 					}
 
-					int shape_idx = intersection_query_subindex_results[i];
+					int shape_idx = r_cull_subindex_results[i];
 
 					if (GodotCollisionSolver3D::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, nullptr, margin)) {
 						collided = cbk.amount > 0;
@@ -800,7 +908,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 		motion_aabb.position += p_parameters.motion;
 		motion_aabb = motion_aabb.merge(body_aabb);
 
-		int amount = _cull_aabb_for_body(p_body, motion_aabb);
+		int amount = _cull_aabb_for_body(p_body, motion_aabb, r_cull_results, r_cull_subindex_results);
 
 		for (int j = 0; j < p_body->get_shape_count(); j++) {
 			if (p_body->is_shape_disabled(j)) {
@@ -831,7 +939,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 			real_t best_unsafe = 1;
 
 			for (int i = 0; i < amount; i++) {
-				const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+				const GodotCollisionObject3D *col_obj = r_cull_results[i];
 				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 					continue;
 				}
@@ -839,7 +947,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 					continue;
 				}
 
-				int shape_idx = intersection_query_subindex_results[i];
+				int shape_idx = r_cull_subindex_results[i];
 
 				//test initial overlap, does it collide if going all the way?
 				Vector3 point_A, point_B;
@@ -940,7 +1048,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 		rcd.min_allowed_depth = MIN(motion_length, min_contact_depth);
 
 		body_aabb.position += p_parameters.motion * unsafe;
-		int amount = _cull_aabb_for_body(p_body, body_aabb);
+		int amount = _cull_aabb_for_body(p_body, body_aabb, r_cull_results, r_cull_subindex_results);
 
 		int from_shape = best_shape != -1 ? best_shape : 0;
 		int to_shape = best_shape != -1 ? best_shape + 1 : p_body->get_shape_count();
@@ -954,7 +1062,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 			GodotShape3D *body_shape = p_body->get_shape(j);
 
 			for (int i = 0; i < amount; i++) {
-				const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+				const GodotCollisionObject3D *col_obj = r_cull_results[i];
 				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 					continue;
 				}
@@ -962,7 +1070,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 					continue;
 				}
 
-				int shape_idx = intersection_query_subindex_results[i];
+				int shape_idx = r_cull_subindex_results[i];
 
 				rcd.object = col_obj;
 				rcd.shape = shape_idx;
@@ -1116,6 +1224,222 @@ const HashSet<GodotCollisionObject3D *> &GodotSpace3D::get_objects() const {
 	return objects;
 }
 
+#define SPACE_STATE_MAGIC 0x33535350 // "PSS3"
+
+struct SpaceStateHeader {
+	uint32_t magic = SPACE_STATE_MAGIC;
+	// Record sizes depend on the build (e.g. double precision), states can't be restored across builds.
+	uint32_t body_record_size = 0;
+	uint32_t pair_record_size = 0;
+	uint32_t constraint_record_size = 0;
+	uint32_t body_count = 0;
+	uint32_t pair_count = 0;
+	uint32_t constraint_count = 0;
+};
+
+struct SpaceStateBody {
+	RID self;
+	GodotBody3D::State state;
+};
+
+struct SpaceStatePair {
+	RID body_A;
+	RID body_B;
+	int shape_A = 0;
+	int shape_B = 0;
+	GodotBodyPair3D::State state;
+};
+
+// Constraints are solved in the order bodies got them, records of the same body follow each other in that order.
+struct SpaceStateConstraint {
+	RID body;
+	RID joint;
+	int32_t pair = -1; // Index of the pair record, when it's not a joint.
+};
+
+Vector<uint8_t> GodotSpace3D::save_state() const {
+	// Active bodies go first, in the order they are simulated, so restoring keeps that order.
+	LocalVector<GodotBody3D *> bodies;
+	for (const SelfList<GodotBody3D> *E = active_list.first(); E; E = E->next()) {
+		bodies.push_back(E->self());
+	}
+	for (GodotCollisionObject3D *object : objects) {
+		if (object->get_type() == GodotCollisionObject3D::TYPE_BODY && !static_cast<GodotBody3D *>(object)->is_active()) {
+			bodies.push_back(static_cast<GodotBody3D *>(object));
+		}
+	}
+
+	// Every pair is in the constraints of both its bodies, it's only stored from its first one.
+	LocalVector<GodotBodyPair3D *> pairs;
+	HashMap<GodotConstraint3D *, int32_t> pair_indices;
+	for (GodotBody3D *body : bodies) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			GodotBodyPair3D *pair = E.key->get_body_pair();
+			if (pair && E.value == 0) {
+				pair_indices.insert(E.key, pairs.size());
+				pairs.push_back(pair);
+			}
+		}
+	}
+
+	// Areas and soft bodies aren't saved, so only pairs and joints are kept in order.
+	LocalVector<SpaceStateConstraint> constraints;
+	for (GodotBody3D *body : bodies) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			SpaceStateConstraint record;
+			record.body = body->get_self();
+			if (E.key->get_body_pair()) {
+				record.pair = pair_indices[E.key];
+			} else if (E.key->get_self().is_valid()) {
+				record.joint = E.key->get_self();
+			} else {
+				continue;
+			}
+			constraints.push_back(record);
+		}
+	}
+
+	SpaceStateHeader header;
+	header.body_record_size = sizeof(SpaceStateBody);
+	header.pair_record_size = sizeof(SpaceStatePair);
+	header.constraint_record_size = sizeof(SpaceStateConstraint);
+	header.body_count = bodies.size();
+	header.pair_count = pairs.size();
+	header.constraint_count = constraints.size();
+
+	Vector<uint8_t> state;
+	state.resize(sizeof(SpaceStateHeader) + bodies.size() * sizeof(SpaceStateBody) + pairs.size() * sizeof(SpaceStatePair) + constraints.size() * sizeof(SpaceStateConstraint));
+	uint8_t *w = state.ptrw();
+
+	memcpy(w, &header, sizeof(SpaceStateHeader));
+	w += sizeof(SpaceStateHeader);
+
+	for (const GodotBody3D *body : bodies) {
+		SpaceStateBody record;
+		record.self = body->get_self();
+		body->save_state(record.state);
+		memcpy(w, &record, sizeof(SpaceStateBody));
+		w += sizeof(SpaceStateBody);
+	}
+
+	for (const GodotBodyPair3D *pair : pairs) {
+		SpaceStatePair record;
+		record.body_A = pair->get_body_a()->get_self();
+		record.body_B = pair->get_body_b()->get_self();
+		record.shape_A = pair->get_shape_a();
+		record.shape_B = pair->get_shape_b();
+		pair->save_state(record.state);
+		memcpy(w, &record, sizeof(SpaceStatePair));
+		w += sizeof(SpaceStatePair);
+	}
+
+	for (const SpaceStateConstraint &record : constraints) {
+		memcpy(w, &record, sizeof(SpaceStateConstraint));
+		w += sizeof(SpaceStateConstraint);
+	}
+
+	return state;
+}
+
+bool GodotSpace3D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, false, "Space state can't be restored while the space is being stepped.");
+	ERR_FAIL_COND_V(p_state.size() < int(sizeof(SpaceStateHeader)), false);
+
+	SpaceStateHeader header;
+	memcpy(&header, p_state.ptr(), sizeof(SpaceStateHeader));
+	ERR_FAIL_COND_V_MSG(header.magic != SPACE_STATE_MAGIC || header.body_record_size != sizeof(SpaceStateBody) || header.pair_record_size != sizeof(SpaceStatePair) || header.constraint_record_size != sizeof(SpaceStateConstraint), false, "Invalid space state, it must be created by space_save_state() with the same engine build.");
+	ERR_FAIL_COND_V(uint64_t(p_state.size()) != sizeof(SpaceStateHeader) + uint64_t(header.body_count) * sizeof(SpaceStateBody) + uint64_t(header.pair_count) * sizeof(SpaceStatePair) + uint64_t(header.constraint_count) * sizeof(SpaceStateConstraint), false);
+
+	// Bodies are activated again in the saved order.
+	while (active_list.first()) {
+		active_list.first()->self()->set_active(false);
+	}
+
+	// Contacts of pairs which didn't exist when the state was saved are dropped.
+	GodotBodyPair3D::State empty_pair_state;
+	for (GodotCollisionObject3D *object : objects) {
+		if (object->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		GodotBody3D *body = static_cast<GodotBody3D *>(object);
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			GodotBodyPair3D *pair = E.key->get_body_pair();
+			if (pair && E.value == 0) {
+				pair->restore_state(empty_pair_state);
+			}
+		}
+	}
+
+	const uint8_t *r = p_state.ptr() + sizeof(SpaceStateHeader);
+
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		SpaceStateBody record;
+		memcpy(&record, r, sizeof(SpaceStateBody));
+		r += sizeof(SpaceStateBody);
+
+		GodotBody3D *body = GodotPhysicsServer3D::godot_singleton->body_owner.get_or_null(record.self);
+		if (!body || body->get_space() != this) {
+			continue; // Freed or moved to another space since.
+		}
+		body->restore_state(record.state);
+	}
+
+	// Pairs only follow the bodies when the broadphase is updated, at the next step. Updates it now, so pairs which were
+	// dropped since the state was saved are created again before getting their contacts back.
+	update();
+
+	LocalVector<GodotConstraint3D *> restored_pairs;
+	restored_pairs.resize(header.pair_count);
+	for (uint32_t i = 0; i < header.pair_count; i++) {
+		restored_pairs[i] = nullptr;
+
+		SpaceStatePair record;
+		memcpy(&record, r, sizeof(SpaceStatePair));
+		r += sizeof(SpaceStatePair);
+
+		GodotBody3D *A = GodotPhysicsServer3D::godot_singleton->body_owner.get_or_null(record.body_A);
+		if (!A || A->get_space() != this) {
+			continue;
+		}
+
+		// Pairs are created by the broadphase, only the ones which still exist get their contacts back.
+		for (const KeyValue<GodotConstraint3D *, int> &E : A->get_constraint_map()) {
+			GodotBodyPair3D *pair = E.key->get_body_pair();
+			if (pair && E.value == 0 && pair->get_shape_a() == record.shape_A && pair->get_body_b()->get_self() == record.body_B && pair->get_shape_b() == record.shape_B) {
+				pair->restore_state(record.state);
+				restored_pairs[i] = E.key;
+				break;
+			}
+		}
+	}
+
+	// Pairs created again were added after the other constraints of their bodies, puts them back in the saved order.
+	LocalVector<SpaceStateConstraint> constraints;
+	constraints.resize(header.constraint_count);
+	memcpy(constraints.ptr(), r, header.constraint_count * sizeof(SpaceStateConstraint));
+
+	LocalVector<GodotConstraint3D *> order;
+	for (uint32_t i = 0; i < constraints.size(); i++) {
+		const SpaceStateConstraint &record = constraints[i];
+		if (record.pair >= 0 && uint32_t(record.pair) < restored_pairs.size()) {
+			order.push_back(restored_pairs[record.pair]);
+		} else if (record.joint.is_valid()) {
+			order.push_back(GodotPhysicsServer3D::godot_singleton->joint_owner.get_or_null(record.joint));
+		}
+		if (i + 1 < constraints.size() && constraints[i + 1].body == record.body) {
+			continue; // The next one belongs to the same body.
+		}
+
+		GodotBody3D *body = GodotPhysicsServer3D::godot_singleton->body_owner.get_or_null(record.body);
+		if (body && body->get_space() == this) {
+			body->set_constraint_order(order);
+		}
+		order.clear();
+	}
+
+	return true;
+}
+
 void GodotSpace3D::body_add_to_state_query_list(SelfList<GodotBody3D> *p_body) {
 	state_query_list.add(p_body);
 }
@@ -1258,6 +1582,7 @@ GodotSpace3D::GodotSpace3D() {
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/3d/solver/default_contact_bias");
+	wide_contact_solver = GLOBAL_GET("physics/3d/solver/use_wide_contact_solver");
 
 	broadphase = GodotBroadPhase3D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
@@ -40,6 +40,8 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define ISLAND_COLORING_MIN_CONSTRAINTS 256
+#define COLOR_THREADED_MIN_CONSTRAINTS 32
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,6 +114,35 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+void GodotStep3D::_gather_active_bodies(const SelfList<GodotBody3D>::List *p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody3D> *b = p_body_list->first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+}
+
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep3D::_predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->predict_motion(delta);
+}
+
+void GodotStep3D::_solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata) {
+	GodotSoftBody3D *soft_body = active_soft_bodies[p_soft_body_index];
+	if (soft_body->is_solver_threaded()) {
+		return; // Solved afterwards with all the threads.
+	}
+	soft_body->solve_constraints(delta);
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -132,6 +163,9 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
+	if (constraint_island.size() >= ISLAND_COLORING_MIN_CONSTRAINTS) {
+		return; // Solved afterwards by _solve_island_colored().
+	}
 
 	int current_priority = 1;
 
@@ -158,6 +192,129 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
+void GodotStep3D::_color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	for (uint32_t color = 0; color < color_count; color++) {
+		constraint_colors[color].clear();
+	}
+	color_count = 0;
+	uncolored_constraints.clear();
+
+	// Greedy coloring in island order, so the batches only depend on the constraints and not on the threads:
+	// each constraint gets the first color none of its non-static bodies is used with yet.
+	for (GodotConstraint3D *constraint : p_constraint_island) {
+		GodotBody3D **bodies = constraint->get_body_ptr();
+		int body_count = constraint->get_body_count();
+
+		uint64_t used_colors = 0;
+		for (int i = 0; i < body_count; i++) {
+			used_colors |= bodies[i]->get_solver_colors();
+		}
+
+		if (used_colors == UINT64_MAX || constraint->get_soft_body_count() > 0) {
+			// Out of colors, or modifying soft bodies (which aren't tracked), solved serially after all the colors.
+			uncolored_constraints.push_back(constraint);
+			continue;
+		}
+
+		uint32_t color = 0;
+		while (used_colors & (uint64_t(1) << color)) {
+			color++;
+		}
+
+		for (int i = 0; i < body_count; i++) {
+			// Static bodies are never modified by the solver, they can be shared between islands and colors.
+			if (bodies[i]->get_mode() != PhysicsServer3D::BODY_MODE_STATIC) {
+				bodies[i]->set_solver_colors(bodies[i]->get_solver_colors() | (uint64_t(1) << color));
+			}
+		}
+
+		if (color >= color_count) {
+			color_count = color + 1;
+			if (constraint_colors.size() < color_count) {
+				constraint_colors.resize(color_count);
+			}
+		}
+		constraint_colors[color].push_back(constraint);
+	}
+
+	for (const GodotConstraint3D *constraint : p_constraint_island) {
+		for (int i = 0; i < constraint->get_body_count(); i++) {
+			constraint->get_body_ptr()[i]->set_solver_colors(0);
+		}
+	}
+}
+
+void GodotStep3D::_solve_color_constraint(uint32_t p_task_index, void *p_userdata) {
+	if (wide_contact_solver) {
+		contact_solvers[solving_color].solve(p_task_index, delta);
+	} else {
+		constraint_colors[solving_color][p_task_index]->solve(delta);
+	}
+}
+
+static uint32_t _keep_constraints_with_priority(LocalVector<GodotConstraint3D *> &p_constraints, int p_priority) {
+	uint32_t kept_count = 0;
+	for (uint32_t constraint_index = 0; constraint_index < p_constraints.size(); ++constraint_index) {
+		GodotConstraint3D *constraint = p_constraints[constraint_index];
+		if (constraint->get_priority() >= p_priority) {
+			p_constraints[kept_count++] = constraint;
+		}
+	}
+	p_constraints.resize(kept_count);
+	return kept_count;
+}
+
+void GodotStep3D::_solve_island_colored(uint32_t p_island_index) {
+	_color_island(constraint_islands[p_island_index]);
+
+	int current_priority = 1;
+
+	uint32_t constraint_count = constraint_islands[p_island_index].size();
+	while (constraint_count > 0) {
+		if (wide_contact_solver) {
+			if (contact_solvers.size() < color_count) {
+				contact_solvers.resize(color_count);
+			}
+			for (uint32_t color = 0; color < color_count; color++) {
+				contact_solvers[color].setup(constraint_colors[color]);
+			}
+		}
+
+		for (int i = 0; i < iterations; i++) {
+			// Colors are solved one after the other, so each one sees the impulses applied by the previous ones.
+			for (uint32_t color = 0; color < color_count; color++) {
+				solving_color = color;
+				uint32_t task_count = wide_contact_solver ? contact_solvers[color].get_task_count() : constraint_colors[color].size();
+				if (task_count >= COLOR_THREADED_MIN_CONSTRAINTS) {
+					WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_color_constraint, nullptr, task_count, -1, true, SNAME("Physics3DConstraintSolveColor"));
+					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+				} else {
+					for (uint32_t task_index = 0; task_index < task_count; task_index++) {
+						_solve_color_constraint(task_index);
+					}
+				}
+			}
+
+			for (GodotConstraint3D *constraint : uncolored_constraints) {
+				constraint->solve(delta);
+			}
+		}
+
+		if (wide_contact_solver) {
+			for (uint32_t color = 0; color < color_count; color++) {
+				contact_solvers[color].finish();
+			}
+		}
+
+		// Check priority to keep only higher priority constraints.
+		++current_priority;
+		constraint_count = _keep_constraints_with_priority(uncolored_constraints, current_priority);
+		for (uint32_t color = 0; color < color_count; color++) {
+			constraint_count += _keep_constraints_with_priority(constraint_colors[color], current_priority);
+		}
+	}
+}
+
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
@@ -190,6 +347,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->set_last_step(p_delta);
 
 	iterations = p_space->get_solver_iterations();
+	wide_contact_solver = p_space->is_wide_contact_solver_enabled();
 	delta = p_delta;
 
 	const SelfList<GodotBody3D>::List *body_list = &p_space->get_active_body_list();
@@ -203,30 +361,52 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	int active_count = 0;
 
-	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	// Bodies are integrated in parallel, then the changes that can't be done from several threads
+	// (moving their shapes in the broadphase) are applied in order.
+	_gather_active_bodies(body_list);
+	active_count += active_bodies.size();
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (GodotBody3D *body : active_bodies) {
+		body->commit_integration();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
 
+	// Soft bodies are independent from each other here, they are processed in parallel like the rigid bodies.
+	active_soft_bodies.clear();
 	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
 	while (sb) {
-		sb->self()->predict_motion(p_delta);
+		active_soft_bodies.push_back(sb->self());
 		sb = sb->next();
-		active_count++;
+	}
+	active_count += active_soft_bodies.size();
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_predict_soft_body_motion, nullptr, active_soft_bodies.size(), -1, true, SNAME("Physics3DSoftBodyPredictMotion"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+		soft_body->commit_motion();
 	}
 
 	p_space->set_active_objects(active_count);
 
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
+	/* UPDATE BROADPHASE */
+
 	// Update the broadphase to register collision pairs.
 	p_space->update();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_BROADPHASE, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -260,7 +440,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	const SelfList<GodotBody3D> *b = body_list->first();
 
 	uint32_t body_island_count = 0;
 
@@ -344,7 +524,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -367,6 +547,13 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
+	// Islands too large to be solved by a single thread are skipped above, and solved with all the threads here.
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		if (constraint_islands[island_index].size() >= ISLAND_COLORING_MIN_CONSTRAINTS) {
+			_solve_island_colored(island_index);
+		}
+	}
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
@@ -375,11 +562,13 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	_gather_active_bodies(body_list);
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (GodotBody3D *body : active_bodies) {
+		body->commit_integration();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -390,10 +579,14 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
-	sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->solve_constraints(p_delta);
-		sb = sb->next();
+	// The soft body list can't change since the motion was predicted.
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_soft_body_constraints, nullptr, active_soft_bodies.size(), -1, true, SNAME("Physics3DSoftBodySolveConstraints"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+		if (soft_body->is_solver_threaded()) {
+			soft_body->solve_constraints(p_delta);
+		}
 	}
 
 	{ //profile
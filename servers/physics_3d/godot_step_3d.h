@@ -31,6 +31,7 @@
 #ifndef GODOT_STEP_3D_H
 #define GODOT_STEP_3D_H
 
+#include "godot_contact_solver_3d.h"
 #include "godot_space_3d.h"
 
 #include "core/templates/local_vector.h"
@@ -40,16 +41,34 @@ class GodotStep3D {
 
 	int iterations = 0;
 	real_t delta = 0.0;
+	bool wide_contact_solver = false;
 
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotBody3D *> active_bodies;
+	LocalVector<GodotSoftBody3D *> active_soft_bodies;
+
+	// Large islands are split into batches (colors) of constraints sharing no body, each solved in parallel.
+	LocalVector<LocalVector<GodotConstraint3D *>> constraint_colors;
+	uint32_t color_count = 0;
+	uint32_t solving_color = 0;
+	LocalVector<GodotConstraint3D *> uncolored_constraints;
+	LocalVector<GodotContactSolver3D> contact_solvers; // One per color, with the wide contact solver.
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _gather_active_bodies(const SelfList<GodotBody3D>::List *p_body_list);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata = nullptr);
+	void _solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _solve_color_constraint(uint32_t p_task_index, void *p_userdata = nullptr);
+	void _solve_island_colored(uint32_t p_island_index);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
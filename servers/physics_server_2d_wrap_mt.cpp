@@ -30,6 +30,7 @@
 
 #include "physics_server_2d_wrap_mt.h"
 
+#include "core/debugger/frame_tracer.h"
 #include "core/os/os.h"
 
 void PhysicsServer2DWrapMT::thread_exit() {
@@ -49,6 +50,7 @@ void PhysicsServer2DWrapMT::_thread_callback(void *_instance) {
 
 void PhysicsServer2DWrapMT::thread_loop() {
 	server_thread = Thread::get_caller_id();
+	FrameTracer::set_thread_name("Physics 2D Thread");
 
 	physics_server_2d->init();
 
@@ -430,6 +430,94 @@ Vector<real_t> PhysicsDirectSpaceState3D::_cast_motion(const Ref<PhysicsShapeQue
 	return ret;
 }
 
+int PhysicsDirectSpaceState3D::intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+		hit_count += r_hits[i] ? 1 : 0;
+	}
+	return hit_count;
+}
+
+bool PhysicsDirectSpaceState3D::cast_motion_batch(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform.origin = p_origins[i];
+		parameters.motion = p_motions[i];
+		if (!cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+Dictionary PhysicsDirectSpaceState3D::_intersect_ray_batch(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Dictionary());
+
+	int count = p_from.size();
+	Vector<RayResult> results;
+	results.resize(count);
+	Vector<bool> hits;
+	hits.resize(count);
+
+	intersect_ray_batch(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptrw(), hits.ptrw());
+
+	PackedByteArray hit;
+	PackedVector3Array position;
+	PackedVector3Array normal;
+	PackedInt64Array collider_id;
+	PackedInt32Array shape;
+	hit.resize(count);
+	position.resize(count);
+	normal.resize(count);
+	collider_id.resize(count);
+	shape.resize(count);
+
+	for (int i = 0; i < count; i++) {
+		const RayResult &result = results[i];
+		hit.write[i] = hits[i];
+		position.write[i] = hits[i] ? result.position : Vector3();
+		normal.write[i] = hits[i] ? result.normal : Vector3();
+		collider_id.write[i] = hits[i] ? int64_t(uint64_t(result.collider_id)) : 0;
+		shape.write[i] = hits[i] ? result.shape : -1;
+	}
+
+	Dictionary d;
+	d["hit"] = hit;
+	d["position"] = position;
+	d["normal"] = normal;
+	d["collider_id"] = collider_id;
+	d["shape"] = shape;
+
+	return d;
+}
+
+PackedVector2Array PhysicsDirectSpaceState3D::_cast_motion_batch(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions) {
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), PackedVector2Array());
+	ERR_FAIL_COND_V(p_origins.size() != p_motions.size(), PackedVector2Array());
+
+	int count = p_origins.size();
+	Vector<real_t> closest_safe;
+	Vector<real_t> closest_unsafe;
+	closest_safe.resize(count);
+	closest_unsafe.resize(count);
+
+	if (!cast_motion_batch(p_shape_query->get_parameters(), p_origins.ptr(), p_motions.ptr(), count, closest_safe.ptrw(), closest_unsafe.ptrw())) {
+		return PackedVector2Array();
+	}
+
+	PackedVector2Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
+		ret.write[i] = Vector2(closest_safe[i], closest_unsafe[i]);
+	}
+	return ret;
+}
+
 TypedArray<Vector3> PhysicsDirectSpaceState3D::_collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results) {
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), TypedArray<Vector3>());
 
@@ -477,6 +565,8 @@ void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
+	ClassDB::bind_method(D_METHOD("intersect_ray_batch", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_ray_batch);
+	ClassDB::bind_method(D_METHOD("cast_motion_batch", "parameters", "origins", "motions"), &PhysicsDirectSpaceState3D::_cast_motion_batch);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
 }
@@ -653,6 +743,650 @@ bool PhysicsServer3D::_body_test_motion(RID p_body, const Ref<PhysicsTestMotionP
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+//so, if you pass 45 as limit, avoid numerical precision errors when angle is 45.
+#define FLOOR_ANGLE_THRESHOLD 0.01
+
+static bool _slide_test_motion(void *p_userdata, RID p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) {
+	return static_cast<PhysicsServer3D *>(p_userdata)->body_test_motion(p_body, p_parameters, r_result);
+}
+
+struct _SlideCollisionState {
+	bool floor = false;
+	bool wall = false;
+	bool ceiling = false;
+
+	_SlideCollisionState() {}
+
+	_SlideCollisionState(bool p_floor, bool p_wall, bool p_ceiling) {
+		floor = p_floor;
+		wall = p_wall;
+		ceiling = p_ceiling;
+	}
+};
+
+// The body being slid, its state is kept in the result until the caller applies it.
+struct _SlideContext {
+	RID body;
+	const PhysicsServer3D::SlideParameters &parameters;
+	PhysicsServer3D::SlideResult &state;
+	PhysicsServer3D::TestMotionFunc test_motion = nullptr;
+	void *userdata = nullptr;
+	Vector3 platform_ceiling_velocity;
+
+	_SlideContext(RID p_body, const PhysicsServer3D::SlideParameters &p_parameters, PhysicsServer3D::SlideResult &r_state, PhysicsServer3D::TestMotionFunc p_test_motion, void *p_userdata) :
+			body(p_body),
+			parameters(p_parameters),
+			state(r_state),
+			test_motion(p_test_motion),
+			userdata(p_userdata) {}
+};
+
+static bool _slide_move_and_collide(_SlideContext &p_context, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult &r_result, bool p_test_only, bool p_cancel_sliding) {
+	bool colliding = p_context.test_motion(p_context.userdata, p_context.body, p_parameters, &r_result);
+
+	// Restore direction of motion to be along original motion,
+	// in order to avoid sliding due to recovery,
+	// but only if collision depth is low enough to avoid tunneling.
+	if (p_cancel_sliding) {
+		real_t motion_length = p_parameters.motion.length();
+		real_t precision = 0.001;
+
+		if (colliding) {
+			// Can't just use margin as a threshold because collision depth is calculated on unsafe motion,
+			// so even in normal resting cases the depth can be a bit more than the margin.
+			precision += motion_length * (r_result.collision_unsafe_fraction - r_result.collision_safe_fraction);
+
+			if (r_result.collisions[0].depth > p_parameters.margin + precision) {
+				p_cancel_sliding = false;
+			}
+		}
+
+		if (p_cancel_sliding) {
+			// When motion is null, recovery is the resulting motion.
+			Vector3 motion_normal;
+			if (motion_length > CMP_EPSILON) {
+				motion_normal = p_parameters.motion / motion_length;
+			}
+
+			// Check depth of recovery.
+			real_t projected_length = r_result.travel.dot(motion_normal);
+			Vector3 recovery = r_result.travel - motion_normal * projected_length;
+			real_t recovery_length = recovery.length();
+			// Fixes cases where canceling slide causes the motion to go too deep into the ground,
+			// because we're only taking rest information into account and not general recovery.
+			if (recovery_length < p_parameters.margin + precision) {
+				// Apply adjustment to motion.
+				r_result.travel = motion_normal * projected_length;
+				r_result.remainder = p_parameters.motion - r_result.travel;
+			}
+		}
+	}
+
+	for (int i = 0; i < 3; i++) {
+		if (p_context.parameters.locked_axes & (1 << i)) {
+			r_result.travel[i] = 0;
+		}
+	}
+
+	if (!p_test_only) {
+		p_context.state.transform = p_parameters.from;
+		p_context.state.transform.origin += r_result.travel;
+	}
+
+	return colliding;
+}
+
+static void _slide_set_platform_data(_SlideContext &p_context, const PhysicsServer3D::MotionCollision &p_collision) {
+	p_context.state.platform_rid = p_collision.collider;
+	p_context.state.platform_object_id = p_collision.collider_id;
+	p_context.state.platform_velocity = p_collision.collider_velocity;
+	p_context.state.platform_angular_velocity = p_collision.collider_angular_velocity;
+}
+
+static void _slide_set_collision_direction(_SlideContext &p_context, const PhysicsServer3D::MotionResult &p_result, _SlideCollisionState &r_state, _SlideCollisionState p_apply_state = _SlideCollisionState(true, true, true)) {
+	const PhysicsServer3D::SlideParameters &p = p_context.parameters;
+	PhysicsServer3D::SlideResult &state = p_context.state;
+	bool grounded = p.up_direction != Vector3();
+
+	r_state = _SlideCollisionState();
+
+	real_t wall_depth = -1.0;
+	real_t floor_depth = -1.0;
+
+	bool was_on_wall = state.on_wall;
+	Vector3 prev_wall_normal = state.wall_normal;
+	int wall_collision_count = 0;
+	Vector3 combined_wall_normal;
+	Vector3 tmp_wall_col; // Avoid duplicate on average calculation.
+
+	for (int i = p_result.collision_count - 1; i >= 0; i--) {
+		const PhysicsServer3D::MotionCollision &collision = p_result.collisions[i];
+
+		if (grounded) {
+			// Check if any collision is floor.
+			real_t floor_angle = collision.get_angle(p.up_direction);
+			if (floor_angle <= p.floor_max_angle + FLOOR_ANGLE_THRESHOLD) {
+				r_state.floor = true;
+				if (p_apply_state.floor && collision.depth > floor_depth) {
+					state.on_floor = true;
+					state.floor_normal = collision.normal;
+					floor_depth = collision.depth;
+					_slide_set_platform_data(p_context, collision);
+				}
+				continue;
+			}
+
+			// Check if any collision is ceiling.
+			real_t ceiling_angle = collision.get_angle(-p.up_direction);
+			if (ceiling_angle <= p.floor_max_angle + FLOOR_ANGLE_THRESHOLD) {
+				r_state.ceiling = true;
+				if (p_apply_state.ceiling) {
+					p_context.platform_ceiling_velocity = collision.collider_velocity;
+					state.ceiling_normal = collision.normal;
+					state.on_ceiling = true;
+				}
+				continue;
+			}
+		}
+
+		// Collision is wall by default.
+		r_state.wall = true;
+
+		if (p_apply_state.wall && collision.depth > wall_depth) {
+			state.on_wall = true;
+			wall_depth = collision.depth;
+			state.wall_normal = collision.normal;
+
+			if (!p.wall_platform_filter || p.wall_platform_filter(collision.collider_id)) {
+				_slide_set_platform_data(p_context, collision);
+			}
+		}
+
+		// Collect normal for calculating average.
+		if (!collision.normal.is_equal_approx(tmp_wall_col)) {
+			tmp_wall_col = collision.normal;
+			combined_wall_normal += collision.normal;
+			wall_collision_count++;
+		}
+	}
+
+	if (r_state.wall) {
+		if (wall_collision_count > 1 && !r_state.floor) {
+			// Check if wall normals cancel out to floor support.
+			if (!r_state.floor && grounded) {
+				combined_wall_normal.normalize();
+				real_t floor_angle = Math::acos(combined_wall_normal.dot(p.up_direction));
+				if (floor_angle <= p.floor_max_angle + FLOOR_ANGLE_THRESHOLD) {
+					r_state.floor = true;
+					r_state.wall = false;
+					if (p_apply_state.floor) {
+						state.on_floor = true;
+						state.floor_normal = combined_wall_normal;
+					}
+					if (p_apply_state.wall) {
+						state.on_wall = was_on_wall;
+						state.wall_normal = prev_wall_normal;
+					}
+					return;
+				}
+			}
+		}
+	}
+}
+
+static void _slide_apply_floor_snap(_SlideContext &p_context) {
+	const PhysicsServer3D::SlideParameters &p = p_context.parameters;
+	if (p_context.state.on_floor) {
+		return;
+	}
+
+	// Snap by at least collision margin to keep floor state consistent.
+	real_t length = MAX(p.floor_snap_length, p.margin);
+
+	PhysicsServer3D::MotionParameters parameters(p_context.state.transform, -p.up_direction * length, p.margin);
+	parameters.max_collisions = 4;
+	parameters.recovery_as_collision = true; // Also report collisions generated only from recovery.
+	parameters.collide_separation_ray = true;
+
+	PhysicsServer3D::MotionResult result;
+	if (_slide_move_and_collide(p_context, parameters, result, true, false)) {
+		_SlideCollisionState result_state;
+		// Apply direction for floor only.
+		_slide_set_collision_direction(p_context, result, result_state, _SlideCollisionState(true, false, false));
+
+		if (result_state.floor) {
+			if (p.floor_stop_on_slope) {
+				// move and collide may stray the object a bit because of pre un-stucking,
+				// so only ensure that motion happens on floor direction in this case.
+				if (result.travel.length() > p.margin) {
+					result.travel = p.up_direction * p.up_direction.dot(result.travel);
+				} else {
+					result.travel = Vector3();
+				}
+			}
+
+			parameters.from.origin += result.travel;
+			p_context.state.transform = parameters.from;
+		}
+	}
+}
+
+static void _slide_snap_on_floor(_SlideContext &p_context, bool p_was_on_floor, bool p_vel_dir_facing_up) {
+	if (p_context.state.on_floor || !p_was_on_floor || p_vel_dir_facing_up) {
+		return;
+	}
+
+	_slide_apply_floor_snap(p_context);
+}
+
+static bool _slide_on_floor_if_snapped(_SlideContext &p_context, bool p_was_on_floor, bool p_vel_dir_facing_up) {
+	const PhysicsServer3D::SlideParameters &p = p_context.parameters;
+	if (p.up_direction == Vector3() || p_context.state.on_floor || !p_was_on_floor || p_vel_dir_facing_up) {
+		return false;
+	}
+
+	// Snap by at least collision margin to keep floor state consistent.
+	real_t length = MAX(p.floor_snap_length, p.margin);
+
+	PhysicsServer3D::MotionParameters parameters(p_context.state.transform, -p.up_direction * length, p.margin);
+	parameters.max_collisions = 4;
+	parameters.recovery_as_collision = true; // Also report collisions generated only from recovery.
+	parameters.collide_separation_ray = true;
+
+	PhysicsServer3D::MotionResult result;
+	if (_slide_move_and_collide(p_context, parameters, result, true, false)) {
+		_SlideCollisionState result_state;
+		// Don't apply direction for any type.
+		_slide_set_collision_direction(p_context, result, result_state, _SlideCollisionState(false, false, false));
+
+		return result_state.floor;
+	}
+
+	return false;
+}
+
+static void _slide_grounded(_SlideContext &p_context, bool p_was_on_floor) {
+	const PhysicsServer3D::SlideParameters &p = p_context.parameters;
+	PhysicsServer3D::SlideResult &state = p_context.state;
+	const Vector3 &up_direction = p.up_direction;
+	Vector3 &velocity = state.velocity;
+
+	Vector3 motion = velocity * p.delta;
+	Vector3 motion_slide_up = motion.slide(up_direction);
+	Vector3 prev_floor_normal = state.floor_normal;
+
+	state.platform_rid = RID();
+	state.platform_object_id = ObjectID();
+	state.platform_velocity = Vector3();
+	state.platform_angular_velocity = Vector3();
+	p_context.platform_ceiling_velocity = Vector3();
+	state.floor_normal = Vector3();
+	state.wall_normal = Vector3();
+	state.ceiling_normal = Vector3();
+
+	// No sliding on first attempt to keep floor motion stable when possible,
+	// When stop on slope is enabled or when there is no up direction.
+	bool sliding_enabled = !p.floor_stop_on_slope;
+	// Constant speed can be applied only the first time sliding is enabled.
+	bool can_apply_constant_speed = sliding_enabled;
+	// If the platform's ceiling push down the body.
+	bool apply_ceiling_velocity = false;
+	bool first_slide = true;
+	bool vel_dir_facing_up = velocity.dot(up_direction) > 0;
+	Vector3 total_travel;
+
+	for (int iteration = 0; iteration < p.max_slides; ++iteration) {
+		PhysicsServer3D::MotionParameters parameters(state.transform, motion, p.margin);
+		parameters.max_collisions = 6; // There can be 4 collisions between 2 walls + 2 more for the floor.
+		parameters.recovery_as_collision = true; // Also report collisions generated only from recovery.
+
+		PhysicsServer3D::MotionResult result;
+		bool collided = _slide_move_and_collide(p_context, parameters, result, false, !sliding_enabled);
+
+		state.last_motion = result.travel;
+
+		if (collided) {
+			state.motion_results.push_back(result);
+
+			bool was_on_wall = state.on_wall;
+
+			_SlideCollisionState result_state;
+			_slide_set_collision_direction(p_context, result, result_state);
+
+			// If we hit a ceiling platform, we set the vertical velocity to at least the platform one.
+			if (state.on_ceiling && p_context.platform_ceiling_velocity != Vector3() && p_context.platform_ceiling_velocity.dot(up_direction) < 0) {
+				// If ceiling sliding is on, only apply when the ceiling is flat or when the motion is upward.
+				if (!p.slide_on_ceiling || motion.dot(up_direction) < 0 || (state.ceiling_normal + up_direction).length() < 0.01) {
+					apply_ceiling_velocity = true;
+					Vector3 ceiling_vertical_velocity = up_direction * up_direction.dot(p_context.platform_ceiling_velocity);
+					Vector3 motion_vertical_velocity = up_direction * up_direction.dot(velocity);
+					if (motion_vertical_velocity.dot(up_direction) > 0 || ceiling_vertical_velocity.length_squared() > motion_vertical_velocity.length_squared()) {
+						velocity = ceiling_vertical_velocity + velocity.slide(up_direction);
+					}
+				}
+			}
+
+			if (state.on_floor && p.floor_stop_on_slope && (velocity.normalized() + up_direction).length() < 0.01) {
+				if (result.travel.length() <= p.margin + CMP_EPSILON) {
+					state.transform.origin -= result.travel;
+				}
+				velocity = Vector3();
+				motion = Vector3();
+				state.last_motion = Vector3();
+				break;
+			}
+
+			if (result.remainder.is_zero_approx()) {
+				motion = Vector3();
+				break;
+			}
+
+			// Apply regular sliding by default.
+			bool apply_default_sliding = true;
+
+			// Wall collision checks.
+			if (result_state.wall && (motion_slide_up.dot(state.wall_normal) <= 0)) {
+				// Move on floor only checks.
+				if (p.floor_block_on_wall) {
+					// Needs horizontal motion from current motion instead of motion_slide_up
+					// to properly test the angle and avoid standing on slopes
+					Vector3 horizontal_motion = motion.slide(up_direction);
+					Vector3 horizontal_normal = state.wall_normal.slide(up_direction).normalized();
+					real_t motion_angle = Math::abs(Math::acos(-horizontal_normal.dot(horizontal_motion.normalized())));
+
+					// Avoid to move forward on a wall if floor_block_on_wall is true.
+					// Applies only when the motion angle is under 90 degrees,
+					// in order to avoid blocking lateral motion along a wall.
+					if (motion_angle < .5 * Math_PI) {
+						apply_default_sliding = false;
+						if (p_was_on_floor && !vel_dir_facing_up) {
+							// Cancel the motion.
+							real_t travel_total = result.travel.length();
+							real_t cancel_dist_max = MIN(0.1, p.margin * 20);
+							if (travel_total <= p.margin + CMP_EPSILON) {
+								state.transform.origin -= result.travel;
+								result.travel = Vector3(); // Cancel for constant speed computation.
+							} else if (travel_total < cancel_dist_max) { // If the movement is large the body can be prevented from reaching the walls.
+								state.transform.origin -= result.travel.slide(up_direction);
+								// Keep remaining motion in sync with amount canceled.
+								motion = motion.slide(up_direction);
+								result.travel = Vector3();
+							} else {
+								// Travel is too high to be safely canceled, we take it into account.
+								result.travel = result.travel.slide(up_direction);
+								motion = motion.normalized() * result.travel.length();
+							}
+							// Determines if you are on the ground, and limits the possibility of climbing on the walls because of the approximations.
+							_slide_snap_on_floor(p_context, true, false);
+						} else {
+							// If the movement is not canceled we only keep the remaining.
+							motion = result.remainder;
+						}
+
+						// Apply slide on forward in order to allow only lateral motion on next step.
+						Vector3 forward = state.wall_normal.slide(up_direction).normalized();
+						motion = motion.slide(forward);
+
+						// Scales the horizontal velocity according to the wall slope.
+						if (vel_dir_facing_up) {
+							Vector3 slide_motion = velocity.slide(result.collisions[0].normal);
+							// Keeps the vertical motion from velocity and add the horizontal motion of the projection.
+							velocity = up_direction * up_direction.dot(velocity) + slide_motion.slide(up_direction);
+						} else {
+							velocity = velocity.slide(forward);
+						}
+
+						// Allow only lateral motion along previous floor when already on floor.
+						// Fixes slowing down when moving in diagonal against an inclined wall.
+						if (p_was_on_floor && !vel_dir_facing_up && (motion.dot(up_direction) > 0.0)) {
+							// Slide along the corner between the wall and previous floor.
+							Vector3 floor_side = prev_floor_normal.cross(state.wall_normal);
+							if (floor_side != Vector3()) {
+								motion = floor_side * motion.dot(floor_side);
+							}
+						}
+
+						// Stop all motion when a second wall is hit (unless sliding down or jumping),
+						// in order to avoid jittering in corner cases.
+						bool stop_all_motion = was_on_wall && !vel_dir_facing_up;
+
+						// Allow sliding when the body falls.
+						if (!state.on_floor && motion.dot(up_direction) < 0) {
+							Vector3 slide_motion = motion.slide(state.wall_normal);
+							// Test again to allow sliding only if the result goes downwards.
+							// Fixes jittering issues at the bottom of inclined walls.
+							if (slide_motion.dot(up_direction) < 0) {
+								stop_all_motion = false;
+								motion = slide_motion;
+							}
+						}
+
+						if (stop_all_motion) {
+							motion = Vector3();
+							velocity = Vector3();
+						}
+					}
+				}
+
+				// Stop horizontal motion when under wall slide threshold.
+				if (p_was_on_floor && (p.wall_min_slide_angle > 0.0) && result_state.wall) {
+					Vector3 horizontal_normal = state.wall_normal.slide(up_direction).normalized();
+					real_t motion_angle = Math::abs(Math::acos(-horizontal_normal.dot(motion_slide_up.normalized())));
+					if (motion_angle < p.wall_min_slide_angle) {
+						motion = up_direction * motion.dot(up_direction);
+						velocity = up_direction * velocity.dot(up_direction);
+
+						apply_default_sliding = false;
+					}
+				}
+			}
+
+			if (apply_default_sliding) {
+				// Regular sliding, the last part of the test handle the case when you don't want to slide on the ceiling.
+				if ((sliding_enabled || !state.on_floor) && (!state.on_ceiling || p.slide_on_ceiling || !vel_dir_facing_up) && !apply_ceiling_velocity) {
+					const PhysicsServer3D::MotionCollision &collision = result.collisions[0];
+
+					Vector3 slide_motion = result.remainder.slide(collision.normal);
+					if (state.on_floor && !state.on_wall && !motion_slide_up.is_zero_approx()) {
+						// Slide using the intersection between the motion plane and the floor plane,
+						// in order to keep the direction intact.
+						real_t motion_length = slide_motion.length();
+						slide_motion = up_direction.cross(result.remainder).cross(state.floor_normal);
+
+						// Keep the length from default slide to change speed in slopes by default,
+						// when constant speed is not enabled.
+						slide_motion.normalize();
+						slide_motion *= motion_length;
+					}
+
+					if (slide_motion.dot(velocity) > 0.0) {
+						motion = slide_motion;
+					} else {
+						motion = Vector3();
+					}
+
+					if (p.slide_on_ceiling && result_state.ceiling) {
+						// Apply slide only in the direction of the input motion, otherwise just stop to avoid jittering when moving against a wall.
+						if (vel_dir_facing_up) {
+							velocity = velocity.slide(collision.normal);
+						} else {
+							// Avoid acceleration in slope when falling.
+							velocity = up_direction * up_direction.dot(velocity);
+						}
+					}
+				}
+				// No sliding on first attempt to keep floor motion stable when possible.
+				else {
+					motion = result.remainder;
+					if (result_state.ceiling && !p.slide_on_ceiling && vel_dir_facing_up) {
+						velocity = velocity.slide(up_direction);
+						motion = motion.slide(up_direction);
+					}
+				}
+			}
+
+			total_travel += result.travel;
+
+			// Apply Constant Speed.
+			if (p_was_on_floor && p.floor_constant_speed && can_apply_constant_speed && state.on_floor && !motion.is_zero_approx()) {
+				Vector3 travel_slide_up = total_travel.slide(up_direction);
+				motion = motion.normalized() * MAX(0, (motion_slide_up.length() - travel_slide_up.length()));
+			}
+		}
+		// When you move forward in a downward slope you don’t collide because you will be in the air.
+		// This test ensures that constant speed is applied, only if the player is still on the ground after the snap is applied.
+		else if (p.floor_constant_speed && first_slide && _slide_on_floor_if_snapped(p_context, p_was_on_floor, vel_dir_facing_up)) {
+			can_apply_constant_speed = false;
+			sliding_enabled = true;
+			state.transform.origin = state.transform.origin - result.travel;
+
+			// Slide using the intersection between the motion plane and the floor plane,
+			// in order to keep the direction intact.
+			Vector3 motion_slide_norm = up_direction.cross(motion).cross(prev_floor_normal);
+			motion_slide_norm.normalize();
+
+			motion = motion_slide_norm * (motion_slide_up.length());
+			collided = true;
+		}
+
+		if (!collided || motion.is_zero_approx()) {
+			break;
+		}
+
+		can_apply_constant_speed = !can_apply_constant_speed && !sliding_enabled;
+		sliding_enabled = true;
+		first_slide = false;
+	}
+
+	_slide_snap_on_floor(p_context, p_was_on_floor, vel_dir_facing_up);
+
+	// Reset the gravity accumulation when touching the ground.
+	if (state.on_floor && !vel_dir_facing_up) {
+		velocity = velocity.slide(up_direction);
+	}
+}
+
+static void _slide_floating(_SlideContext &p_context) {
+	const PhysicsServer3D::SlideParameters &p = p_context.parameters;
+	PhysicsServer3D::SlideResult &state = p_context.state;
+	const Vector3 &velocity = state.velocity;
+
+	Vector3 motion = velocity * p.delta;
+
+	state.platform_rid = RID();
+	state.platform_object_id = ObjectID();
+	state.floor_normal = Vector3();
+	state.platform_velocity = Vector3();
+	state.platform_angular_velocity = Vector3();
+
+	bool first_slide = true;
+	for (int iteration = 0; iteration < p.max_slides; ++iteration) {
+		PhysicsServer3D::MotionParameters parameters(state.transform, motion, p.margin);
+		parameters.recovery_as_collision = true; // Also report collisions generated only from recovery.
+
+		PhysicsServer3D::MotionResult result;
+		bool collided = _slide_move_and_collide(p_context, parameters, result, false, false);
+
+		state.last_motion = result.travel;
+
+		if (collided) {
+			state.motion_results.push_back(result);
+
+			_SlideCollisionState result_state;
+			_slide_set_collision_direction(p_context, result, result_state);
+
+			if (result.remainder.is_zero_approx()) {
+				motion = Vector3();
+				break;
+			}
+
+			if (p.wall_min_slide_angle != 0 && Math::acos(state.wall_normal.dot(-velocity.normalized())) < p.wall_min_slide_angle + FLOOR_ANGLE_THRESHOLD) {
+				motion = Vector3();
+				if (result.travel.length() < p.margin + CMP_EPSILON) {
+					state.transform.origin -= result.travel;
+				}
+			} else if (first_slide) {
+				Vector3 motion_slide_norm = result.remainder.slide(state.wall_normal).normalized();
+				motion = motion_slide_norm * (motion.length() - result.travel.length());
+			} else {
+				motion = result.remainder.slide(state.wall_normal);
+			}
+
+			if (motion.dot(velocity) <= 0.0) {
+				motion = Vector3();
+			}
+		}
+
+		if (!collided || motion.is_zero_approx()) {
+			break;
+		}
+
+		first_slide = false;
+	}
+}
+
+void PhysicsServer3D::_body_move_and_slide(RID p_body, const SlideParameters &p_parameters, SlideResult &r_result, TestMotionFunc p_test_motion, void *p_userdata) {
+	_SlideContext context(p_body, p_parameters, r_result, p_test_motion, p_userdata);
+
+	r_result.transform = p_parameters.from;
+	r_result.velocity = p_parameters.velocity;
+	for (int i = 0; i < 3; i++) {
+		if (p_parameters.locked_axes & (1 << i)) {
+			r_result.velocity[i] = 0.0;
+		}
+	}
+
+	r_result.motion_results.clear();
+
+	bool was_on_floor = r_result.on_floor;
+	r_result.on_floor = false;
+	r_result.on_wall = false;
+	r_result.on_ceiling = false;
+
+	r_result.last_motion = Vector3();
+
+	if (!p_parameters.platform_velocity.is_zero_approx()) {
+		MotionParameters parameters(r_result.transform, p_parameters.platform_velocity * p_parameters.delta, p_parameters.margin);
+		parameters.recovery_as_collision = true; // Also report collisions generated only from recovery.
+
+		parameters.exclude_bodies.insert(r_result.platform_rid);
+		if (r_result.platform_object_id.is_valid()) {
+			parameters.exclude_objects.insert(r_result.platform_object_id);
+		}
+
+		MotionResult floor_result;
+		if (_slide_move_and_collide(context, parameters, floor_result, false, false)) {
+			r_result.motion_results.push_back(floor_result);
+
+			_SlideCollisionState result_state;
+			_slide_set_collision_direction(context, floor_result, result_state);
+		}
+	}
+
+	if (p_parameters.up_direction != Vector3()) {
+		_slide_grounded(context, was_on_floor);
+	} else {
+		_slide_floating(context);
+	}
+}
+
+void PhysicsServer3D::body_move_and_slide(RID p_body, const SlideParameters &p_parameters, SlideResult &r_result) {
+	_body_move_and_slide(p_body, p_parameters, r_result, _slide_test_motion, this);
+}
+
+void PhysicsServer3D::body_apply_floor_snap(RID p_body, const SlideParameters &p_parameters, SlideResult &r_result) {
+	_SlideContext context(p_body, p_parameters, r_result, _slide_test_motion, this);
+
+	r_result.transform = p_parameters.from;
+	_slide_apply_floor_snap(context);
+}
+
+void PhysicsServer3D::body_move_and_slide_batch(const RID *p_bodies, const SlideParameters *p_parameters, int p_count, SlideResult *r_results) {
+	for (int i = 0; i < p_count; i++) {
+		_body_move_and_slide(p_bodies[i], p_parameters[i], r_results[i], _slide_test_motion, this);
+	}
+}
+
 RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	switch (p_shape) {
 		case SHAPE_WORLD_BOUNDARY:
@@ -704,6 +1438,8 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_is_active", "space"), &PhysicsServer3D::space_is_active);
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space"), &PhysicsServer3D::space_save_state);
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state"), &PhysicsServer3D::space_restore_state);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
@@ -1026,6 +1762,12 @@ void PhysicsServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_INTEGRATE_FORCES_TIME);
+	BIND_ENUM_CONSTANT(INFO_BROADPHASE_TIME);
+	BIND_ENUM_CONSTANT(INFO_GENERATE_ISLANDS_TIME);
+	BIND_ENUM_CONSTANT(INFO_SETUP_CONSTRAINTS_TIME);
+	BIND_ENUM_CONSTANT(INFO_SOLVE_CONSTRAINTS_TIME);
+	BIND_ENUM_CONSTANT(INFO_INTEGRATE_VELOCITIES_TIME);
 
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_RECYCLE_RADIUS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_MAX_SEPARATION);
@@ -1064,6 +1806,7 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
+	GLOBAL_DEF("physics/3d/solver/use_wide_contact_solver", false);
 }
 
 PhysicsServer3D::~PhysicsServer3D() {
@@ -126,6 +126,8 @@ private:
 	TypedArray<Dictionary> _intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
+	Dictionary _intersect_ray_batch(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
+	PackedVector2Array _cast_motion_batch(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions);
 	TypedArray<Vector3> _collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
 
@@ -200,6 +202,11 @@ public:
 
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) = 0;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) = 0;
+
+	// Same as intersect_ray() and cast_motion() for many queries sharing their parameters, except for the ray positions
+	// and the shape origins and motions. The default implementations run the queries one by one, servers can do better.
+	virtual int intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits);
+	virtual bool cast_motion_batch(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
 
@@ -299,6 +306,10 @@ public:
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) = 0;
 	virtual real_t space_get_param(RID p_space, SpaceParameter p_param) const = 0;
 
+	// Snapshot of the simulation state of the bodies in the space, to roll it back with space_restore_state().
+	virtual Vector<uint8_t> space_save_state(RID p_space) const = 0;
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) = 0;
+
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState3D *space_get_direct_state(RID p_space) = 0;
 
@@ -567,6 +578,60 @@ public:
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) = 0;
 
+	struct SlideParameters {
+		Transform3D from;
+		Vector3 velocity;
+		real_t delta = 0.0;
+		real_t margin = 0.001;
+		int max_slides = 6;
+		uint32_t locked_axes = 0; // BodyAxis flags, only the linear ones apply.
+		Vector3 up_direction = Vector3(0, 1, 0); // Zero for floating motion, where every collision is a wall.
+		real_t floor_max_angle = Math::deg_to_rad((real_t)45.0);
+		real_t floor_snap_length = 0.1;
+		real_t wall_min_slide_angle = Math::deg_to_rad((real_t)15.0);
+		bool floor_stop_on_slope = true;
+		bool floor_constant_speed = false;
+		bool floor_block_on_wall = true;
+		bool slide_on_ceiling = true;
+		Vector3 platform_velocity; // Velocity of the platform the body is on, the body follows it before sliding.
+		// Returns whether a wall collider becomes the platform of the body. Called from any thread, null accepts every collider.
+		bool (*wall_platform_filter)(ObjectID p_collider_id) = nullptr;
+	};
+
+	// Also the state of the previous slide on input: it tells whether the body was on the floor and which platform to exclude.
+	struct SlideResult {
+		Transform3D transform;
+		Vector3 velocity;
+		Vector3 last_motion;
+		Vector3 floor_normal;
+		Vector3 wall_normal;
+		Vector3 ceiling_normal;
+		bool on_floor = false;
+		bool on_wall = false;
+		bool on_ceiling = false;
+		RID platform_rid;
+		ObjectID platform_object_id;
+		Vector3 platform_velocity;
+		Vector3 platform_angular_velocity;
+		Vector<MotionResult> motion_results;
+	};
+
+	// Slides a body along its velocity with body_test_motion() and returns where it ends up without moving it.
+	// This is the slide logic of CharacterBody3D::move_and_slide() and apply_floor_snap().
+	void body_move_and_slide(RID p_body, const SlideParameters &p_parameters, SlideResult &r_result);
+	void body_apply_floor_snap(RID p_body, const SlideParameters &p_parameters, SlideResult &r_result);
+
+	// Slides many bodies like body_move_and_slide(). Every body is tested against the space as it was before the call.
+	// The default implementation slides them one by one, servers can slide them in parallel.
+	virtual void body_move_and_slide_batch(const RID *p_bodies, const SlideParameters *p_parameters, int p_count, SlideResult *r_results);
+
+	typedef bool (*TestMotionFunc)(void *p_userdata, RID p_body, const MotionParameters &p_parameters, MotionResult *r_result);
+
+protected:
+	// The slide logic shared by all the above, with the motion tests done by the caller.
+	static void _body_move_and_slide(RID p_body, const SlideParameters &p_parameters, SlideResult &r_result, TestMotionFunc p_test_motion, void *p_userdata);
+
+public:
 	/* SOFT BODY */
 
 	virtual RID soft_body_create() = 0;
@@ -805,7 +870,13 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_INTEGRATE_FORCES_TIME,
+		INFO_BROADPHASE_TIME,
+		INFO_GENERATE_ISLANDS_TIME,
+		INFO_SETUP_CONSTRAINTS_TIME,
+		INFO_SOLVE_CONSTRAINTS_TIME,
+		INFO_INTEGRATE_VELOCITIES_TIME,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
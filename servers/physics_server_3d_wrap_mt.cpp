@@ -30,6 +30,7 @@
 
 #include "physics_server_3d_wrap_mt.h"
 
+#include "core/debugger/frame_tracer.h"
 #include "core/os/os.h"
 
 void PhysicsServer3DWrapMT::thread_exit() {
@@ -49,6 +50,7 @@ void PhysicsServer3DWrapMT::_thread_callback(void *_instance) {
 
 void PhysicsServer3DWrapMT::thread_loop() {
 	server_thread = Thread::get_caller_id();
+	FrameTracer::set_thread_name("Physics 3D Thread");
 
 	physics_server_3d->init();
 
@@ -62,6 +62,8 @@ public:
 
 	bool owns_mesh(RID p_rid) { return mesh_owner.owns(p_rid); };
 
+	virtual bool can_create_resources_async() const override { return false; }
+
 	virtual RID mesh_allocate() override;
 	virtual void mesh_initialize(RID p_rid) override;
 	virtual void mesh_free(RID p_rid) override;
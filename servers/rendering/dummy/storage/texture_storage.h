@@ -120,6 +120,7 @@ public:
 	virtual void texture_set_detect_3d_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) override{};
 	virtual void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) override{};
 	virtual void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata) override{};
+	virtual void texture_set_streaming_callback(RID p_texture, RS::TextureStreamingCallback p_callback, void *p_userdata) override{};
 
 	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info) override{};
 
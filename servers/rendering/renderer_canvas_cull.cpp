@@ -30,6 +30,7 @@
 
 #include "renderer_canvas_cull.h"
 
+#include "core/config/engine.h"
 #include "core/math/geometry_2d.h"
 #include "renderer_viewport.h"
 #include "rendering_server_default.h"
@@ -514,9 +515,37 @@ void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
+	canvas_item->xform_curr = p_transform;
+
+	if (interpolation_data.enabled && canvas_item->interpolated) {
+		// Drawn in between the transforms of the last two physics ticks, see update_interpolation_frame().
+		if (!canvas_item->on_interpolate_list) {
+			canvas_item->on_interpolate_list = true;
+			interpolation_data.interpolate_list.push_back(p_item);
+		}
+		canvas_item->interpolation_moved = true;
+		return;
+	}
+
+	canvas_item->xform_prev = p_transform;
 	canvas_item->xform = p_transform;
 }
 
+void RendererCanvasCull::canvas_item_set_interpolated(RID p_item, bool p_interpolated) {
+	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
+	ERR_FAIL_COND(!canvas_item);
+
+	canvas_item->interpolated = p_interpolated;
+}
+
+void RendererCanvasCull::canvas_item_reset_physics_interpolation(RID p_item) {
+	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
+	ERR_FAIL_COND(!canvas_item);
+
+	canvas_item->xform_prev = canvas_item->xform_curr;
+	canvas_item->xform = canvas_item->xform_curr;
+}
+
 void RendererCanvasCull::canvas_item_set_visibility_layer(RID p_item, uint32_t p_visibility_layer) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
@@ -2030,6 +2059,62 @@ void RendererCanvasCull::update_visibility_notifiers() {
 	}
 }
 
+void RendererCanvasCull::set_physics_interpolation_enabled(bool p_enabled) {
+	if (interpolation_data.enabled == p_enabled) {
+		return;
+	}
+
+	interpolation_data.enabled = p_enabled;
+
+	if (!p_enabled) {
+		for (const RID &rid : interpolation_data.interpolate_list) {
+			Item *canvas_item = canvas_item_owner.get_or_null(rid);
+			if (canvas_item) {
+				canvas_item->xform_prev = canvas_item->xform_curr;
+				canvas_item->xform = canvas_item->xform_curr;
+				canvas_item->on_interpolate_list = false;
+				canvas_item->interpolation_moved = false;
+			}
+		}
+		interpolation_data.interpolate_list.clear();
+	}
+}
+
+void RendererCanvasCull::update_interpolation_tick() {
+	// Called before each physics tick, the transforms set during the last one become the previous ones.
+	// Items which weren't transformed during the last tick have reached their transform, and stop being interpolated.
+	for (uint32_t i = 0; i < interpolation_data.interpolate_list.size();) {
+		Item *canvas_item = canvas_item_owner.get_or_null(interpolation_data.interpolate_list[i]);
+		if (canvas_item && canvas_item->interpolation_moved) {
+			canvas_item->xform_prev = canvas_item->xform_curr;
+			canvas_item->interpolation_moved = false;
+			i++;
+			continue;
+		}
+
+		if (canvas_item) {
+			canvas_item->xform_prev = canvas_item->xform_curr;
+			canvas_item->xform = canvas_item->xform_curr;
+			canvas_item->on_interpolate_list = false;
+		}
+		interpolation_data.interpolate_list.remove_at_unordered(i);
+	}
+}
+
+void RendererCanvasCull::update_interpolation_frame() {
+	if (interpolation_data.interpolate_list.is_empty()) {
+		return;
+	}
+
+	real_t fraction = Engine::get_singleton()->get_physics_interpolation_fraction();
+	for (const RID &rid : interpolation_data.interpolate_list) {
+		Item *canvas_item = canvas_item_owner.get_or_null(rid);
+		if (canvas_item) {
+			canvas_item->xform = canvas_item->xform_prev.interpolate_with(canvas_item->xform_curr, fraction);
+		}
+	}
+}
+
 bool RendererCanvasCull::free(RID p_rid) {
 	if (canvas_owner.owns(p_rid)) {
 		Canvas *canvas = canvas_owner.get_or_null(p_rid);
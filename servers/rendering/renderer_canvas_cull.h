@@ -31,6 +31,7 @@
 #ifndef RENDERER_CANVAS_CULL_H
 #define RENDERER_CANVAS_CULL_H
 
+#include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
@@ -56,6 +57,13 @@ public:
 		int ysort_parent_abs_z_index; // Absolute Z index of parent. Only populated and used when y-sorting.
 		uint32_t visibility_layer = 0xffffffff;
 
+		// Physics interpolation, xform is interpolated between these each frame while on the interpolate list.
+		Transform2D xform_prev;
+		Transform2D xform_curr;
+		bool interpolated = false; // Opted in by the nodes.
+		bool on_interpolate_list = false;
+		bool interpolation_moved = false; // Transformed during the current physics tick.
+
 		Vector<Item *> child_items;
 
 		struct VisibilityNotifierData {
@@ -177,6 +185,11 @@ public:
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
 
+	struct InterpolationData {
+		bool enabled = false;
+		LocalVector<RID> interpolate_list;
+	} interpolation_data;
+
 	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &xform, const Rect2 &p_clip_rect, Rect2 global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *canvas_group_from, const Transform2D &p_xform);
 
 private:
@@ -213,6 +226,8 @@ public:
 	uint32_t canvas_item_get_visibility_layer(RID p_item);
 
 	void canvas_item_set_transform(RID p_item, const Transform2D &p_transform);
+	void canvas_item_set_interpolated(RID p_item, bool p_interpolated);
+	void canvas_item_reset_physics_interpolation(RID p_item);
 	void canvas_item_set_clip(RID p_item, bool p_clip);
 	void canvas_item_set_distance_field_mode(RID p_item, bool p_enable);
 	void canvas_item_set_custom_rect(RID p_item, bool p_custom_rect, const Rect2 &p_rect = Rect2());
@@ -319,6 +334,10 @@ public:
 
 	void update_visibility_notifiers();
 
+	void set_physics_interpolation_enabled(bool p_enabled);
+	void update_interpolation_tick();
+	void update_interpolation_frame();
+
 	bool free(RID p_rid);
 	RendererCanvasCull();
 	~RendererCanvasCull();
@@ -256,6 +256,11 @@ void ClusterBuilderRD::_clear() {
 	cluster_store_uniform_set = RID();
 }
 
+void ClusterBuilderRD::set_cluster_size(uint32_t p_size) {
+	ERR_FAIL_COND(next_power_of_2(p_size) != p_size || p_size < 8);
+	cluster_size = p_size;
+}
+
 void ClusterBuilderRD::setup(Size2i p_screen_size, uint32_t p_max_elements, RID p_depth_buffer, RID p_depth_buffer_sampler, RID p_color_buffer) {
 	ERR_FAIL_COND(p_max_elements == 0);
 	ERR_FAIL_COND(p_screen_size.x < 1);
@@ -223,6 +223,7 @@ private:
 	RID debug_uniform_set;
 
 public:
+	void set_cluster_size(uint32_t p_size); // Must be called before setup().
 	void setup(Size2i p_screen_size, uint32_t p_max_elements, RID p_depth_buffer, RID p_depth_buffer_sampler, RID p_color_buffer);
 
 	void begin(const Transform3D &p_view_transform, const Projection &p_cam_projection, bool p_flip_y);
@@ -48,9 +48,30 @@ SortEffects::SortEffects() {
 	for (int i = 0; i < SORT_MODE_MAX; i++) {
 		pipelines[i] = RD::get_singleton()->compute_pipeline_create(shader.version_get_shader(shader_version, i));
 	}
+
+	Vector<String> radix_sort_modes;
+	radix_sort_modes.push_back("\n#define MODE_COUNT\n");
+	radix_sort_modes.push_back("\n#define MODE_SCAN\n");
+	radix_sort_modes.push_back("\n#define MODE_SCATTER\n");
+
+	radix_shader.initialize(radix_sort_modes);
+
+	radix_shader_version = radix_shader.version_create();
+
+	for (int i = 0; i < RADIX_SORT_MODE_MAX; i++) {
+		radix_pipelines[i] = RD::get_singleton()->compute_pipeline_create(radix_shader.version_get_shader(radix_shader_version, i));
+	}
 }
 
 SortEffects::~SortEffects() {
+	if (radix_temp_buffer.is_valid()) {
+		RD::get_singleton()->free(radix_temp_buffer);
+	}
+	if (radix_histogram_buffer.is_valid()) {
+		RD::get_singleton()->free(radix_histogram_buffer);
+	}
+
+	radix_shader.version_free(radix_shader_version);
 	shader.version_free(shader_version);
 }
 
@@ -122,3 +143,79 @@ void SortEffects::sort_buffer(RID p_uniform_set, int p_size) {
 
 	RD::get_singleton()->compute_list_end();
 }
+
+void SortEffects::sort_buffer_radix(RID p_buffer, int p_size) {
+	ERR_FAIL_COND(p_size <= 0);
+
+	uint32_t block_count = (p_size + RADIX_SORT_BLOCK_SIZE - 1) / RADIX_SORT_BLOCK_SIZE;
+
+	uint32_t temp_size = p_size * sizeof(float) * 2;
+	if (temp_size > radix_temp_size) {
+		if (radix_temp_buffer.is_valid()) {
+			RD::get_singleton()->free(radix_temp_buffer);
+		}
+		radix_temp_size = temp_size;
+		radix_temp_buffer = RD::get_singleton()->storage_buffer_create(radix_temp_size);
+	}
+
+	uint32_t histogram_size = block_count * RADIX_SORT_RADIX_SIZE * sizeof(uint32_t);
+	if (histogram_size > radix_histogram_size) {
+		if (radix_histogram_buffer.is_valid()) {
+			RD::get_singleton()->free(radix_histogram_buffer);
+		}
+		radix_histogram_size = histogram_size;
+		radix_histogram_buffer = RD::get_singleton()->storage_buffer_create(radix_histogram_size);
+	}
+
+	UniformSetCacheRD *uniform_set_cache = UniformSetCacheRD::get_singleton();
+	ERR_FAIL_NULL(uniform_set_cache);
+
+	RID count_shader = radix_shader.version_get_shader(radix_shader_version, RADIX_SORT_MODE_COUNT);
+	RID scan_shader = radix_shader.version_get_shader(radix_shader_version, RADIX_SORT_MODE_SCAN);
+	RID scatter_shader = radix_shader.version_get_shader(radix_shader_version, RADIX_SORT_MODE_SCATTER);
+
+	RD::Uniform u_histograms(RD::UNIFORM_TYPE_STORAGE_BUFFER, 2, radix_histogram_buffer);
+
+	RadixSortPushConstant push_constant;
+	push_constant.total_elements = p_size;
+	push_constant.block_count = block_count;
+	push_constant.pad = 0;
+
+	RID src = p_buffer;
+	RID dst = radix_temp_buffer;
+
+	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
+
+	// Four passes of 8 bits, so the result ends back in p_buffer.
+	for (uint32_t shift = 0; shift < 32; shift += 8) {
+		push_constant.shift = shift;
+
+		RD::Uniform u_src(RD::UNIFORM_TYPE_STORAGE_BUFFER, 0, src);
+		RD::Uniform u_dst(RD::UNIFORM_TYPE_STORAGE_BUFFER, 1, dst);
+
+		RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, radix_pipelines[RADIX_SORT_MODE_COUNT]);
+		RD::get_singleton()->compute_list_bind_uniform_set(compute_list, uniform_set_cache->get_cache(count_shader, 0, u_src, u_histograms), 0);
+		RD::get_singleton()->compute_list_set_push_constant(compute_list, &push_constant, sizeof(RadixSortPushConstant));
+		RD::get_singleton()->compute_list_dispatch(compute_list, block_count, 1, 1);
+		RD::get_singleton()->compute_list_add_barrier(compute_list);
+
+		RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, radix_pipelines[RADIX_SORT_MODE_SCAN]);
+		RD::get_singleton()->compute_list_bind_uniform_set(compute_list, uniform_set_cache->get_cache(scan_shader, 0, u_histograms), 0);
+		RD::get_singleton()->compute_list_set_push_constant(compute_list, &push_constant, sizeof(RadixSortPushConstant));
+		RD::get_singleton()->compute_list_dispatch(compute_list, 1, 1, 1);
+		RD::get_singleton()->compute_list_add_barrier(compute_list);
+
+		RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, radix_pipelines[RADIX_SORT_MODE_SCATTER]);
+		RD::get_singleton()->compute_list_bind_uniform_set(compute_list, uniform_set_cache->get_cache(scatter_shader, 0, u_src, u_dst, u_histograms), 0);
+		RD::get_singleton()->compute_list_set_push_constant(compute_list, &push_constant, sizeof(RadixSortPushConstant));
+		RD::get_singleton()->compute_list_dispatch(compute_list, block_count, 1, 1);
+
+		if (shift + 8 < 32) {
+			RD::get_singleton()->compute_list_add_barrier(compute_list);
+		}
+
+		SWAP(src, dst);
+	}
+
+	RD::get_singleton()->compute_list_end();
+}
@@ -32,6 +32,7 @@
 #define SORT_EFFECTS_RD_H
 
 #include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
+#include "servers/rendering/renderer_rd/shaders/effects/radix_sort.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/effects/sort.glsl.gen.h"
 #include "servers/rendering/renderer_scene_render.h"
 
@@ -58,12 +59,47 @@ private:
 	RID shader_version;
 	RID pipelines[SORT_MODE_MAX];
 
+	enum RadixSortMode {
+		RADIX_SORT_MODE_COUNT,
+		RADIX_SORT_MODE_SCAN,
+		RADIX_SORT_MODE_SCATTER,
+		RADIX_SORT_MODE_MAX
+	};
+
+	enum {
+		RADIX_SORT_BLOCK_SIZE = 2048, // Elements processed per group, must match radix_sort.glsl.
+		RADIX_SORT_RADIX_SIZE = 256,
+	};
+
+	struct RadixSortPushConstant {
+		uint32_t total_elements;
+		uint32_t block_count;
+		uint32_t shift;
+		uint32_t pad;
+	};
+
+	RadixSortShaderRD radix_shader;
+	RID radix_shader_version;
+	RID radix_pipelines[RADIX_SORT_MODE_MAX];
+
+	// Scratch buffers, grown to fit the largest sort so far.
+	RID radix_temp_buffer;
+	RID radix_histogram_buffer;
+	uint32_t radix_temp_size = 0;
+	uint32_t radix_histogram_size = 0;
+
 protected:
 public:
+	// Below this amount of elements, the bitonic sort needs less dispatches than the radix sort.
+	static constexpr int RADIX_SORT_MIN_ELEMENTS = 16384;
+
 	SortEffects();
 	~SortEffects();
 
+	// Sorts the vec2 elements of the buffer bound at binding 0 of p_uniform_set by their x component (bitonic sort).
 	void sort_buffer(RID p_uniform_set, int p_size);
+	// Same as sort_buffer() with a radix sort, which scales better with large sizes and keeps equal keys in order.
+	void sort_buffer_radix(RID p_buffer, int p_size);
 };
 
 } // namespace RendererRD
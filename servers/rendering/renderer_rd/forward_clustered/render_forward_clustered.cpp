@@ -797,38 +797,25 @@ _FORCE_INLINE_ static uint32_t _indices_to_primitives(RS::PrimitiveType p_primit
 	static const uint32_t subtractor[RS::PRIMITIVE_MAX] = { 0, 0, 1, 0, 1 };
 	return (p_indices - subtractor[p_primitive]) / divisor[p_primitive];
 }
-void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, const RenderDataRD *p_render_data, PassMode p_pass_mode, uint32_t p_color_pass_flags = 0, bool p_using_sdfgi, bool p_using_opaque_gi, bool p_append) {
+void RenderForwardClustered::_fill_render_list_chunk(uint32_t p_chunk, RenderListFillData *p_data) {
 	RendererRD::MeshStorage *mesh_storage = RendererRD::MeshStorage::get_singleton();
 
-	if (p_render_list == RENDER_LIST_OPAQUE) {
-		scene_state.used_sss = false;
-		scene_state.used_screen_texture = false;
-		scene_state.used_normal_texture = false;
-		scene_state.used_depth_texture = false;
-	}
-	uint32_t lightmap_captures_used = 0;
-
-	Plane near_plane = Plane(-p_render_data->scene_data->cam_transform.basis.get_column(Vector3::AXIS_Z), p_render_data->scene_data->cam_transform.origin);
-	near_plane.d += p_render_data->scene_data->cam_projection.get_z_near();
-	float z_max = p_render_data->scene_data->cam_projection.get_z_far() - p_render_data->scene_data->cam_projection.get_z_near();
-
-	RenderList *rl = &render_list[p_render_list];
-	_update_dirty_geometry_instances();
+	const RenderDataRD *render_data = p_data->render_data;
+	const Plane &near_plane = p_data->near_plane;
+	float z_max = p_data->z_max;
+	float streaming_pixels_per_meter = p_data->streaming_pixels_per_meter;
 
-	if (!p_append) {
-		rl->clear();
-		if (p_render_list == RENDER_LIST_OPAQUE) {
-			render_list[RENDER_LIST_ALPHA].clear(); //opaque fills alpha too
-		}
-	}
+	RenderListFillChunk &chunk = render_list_fill_chunks[p_chunk];
+	chunk.clear();
 
-	//fill list
+	uint32_t from = p_chunk * RENDER_LIST_FILL_CHUNK_SIZE;
+	uint32_t to = MIN(from + RENDER_LIST_FILL_CHUNK_SIZE, render_data->instances->size());
 
-	for (int i = 0; i < (int)p_render_data->instances->size(); i++) {
-		GeometryInstanceForwardClustered *inst = static_cast<GeometryInstanceForwardClustered *>((*p_render_data->instances)[i]);
+	for (uint32_t i = from; i < to; i++) {
+		GeometryInstanceForwardClustered *inst = static_cast<GeometryInstanceForwardClustered *>((*render_data->instances)[i]);
 
 		Vector3 center = inst->transform.origin;
-		if (p_render_data->scene_data->cam_orthogonal) {
+		if (render_data->scene_data->cam_orthogonal) {
 			if (inst->use_aabb_center) {
 				center = inst->transformed_aabb.get_support(-near_plane.normal);
 			}
@@ -837,10 +824,21 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 			if (inst->use_aabb_center) {
 				center = inst->transformed_aabb.position + (inst->transformed_aabb.size * 0.5);
 			}
-			inst->depth = p_render_data->scene_data->cam_transform.origin.distance_to(center) - inst->sorting_offset;
+			inst->depth = render_data->scene_data->cam_transform.origin.distance_to(center) - inst->sorting_offset;
 		}
 		uint32_t depth_layer = CLAMP(int(inst->depth * 16 / z_max), 0, 15);
 
+		int streaming_size = 0;
+		if (streaming_pixels_per_meter > 0.0) {
+			// Assumes the texture covers the instance once, which is what most materials do.
+			float extent = inst->transformed_aabb.get_longest_axis_size();
+			float distance = 1.0;
+			if (!render_data->scene_data->cam_orthogonal) {
+				distance = MAX(float(render_data->scene_data->cam_transform.origin.distance_to(center)) - extent * 0.5f, float(render_data->scene_data->z_near));
+			}
+			streaming_size = int(streaming_pixels_per_meter * extent / distance);
+		}
+
 		uint32_t flags = inst->base_flags; //fill flags if appropriate
 
 		if (inst->non_uniform_scale) {
@@ -851,7 +849,7 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 		float fade_alpha = 1.0;
 
 		if (inst->fade_near || inst->fade_far) {
-			float fade_dist = inst->transform.origin.distance_to(p_render_data->scene_data->cam_transform.origin);
+			float fade_dist = inst->transform.origin.distance_to(render_data->scene_data->cam_transform.origin);
 			// Use `smoothstep()` to make opacity changes more gradual and less noticeable to the player.
 			if (inst->fade_far && fade_dist > inst->fade_far_begin) {
 				fade_alpha = Math::smoothstep(0.0f, 1.0f, 1.0f - (fade_dist - inst->fade_far_begin) / (inst->fade_far_end - inst->fade_far_begin));
@@ -864,7 +862,7 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 
 		flags = (flags & ~INSTANCE_DATA_FLAGS_FADE_MASK) | (uint32_t(fade_alpha * 255.0) << INSTANCE_DATA_FLAGS_FADE_SHIFT);
 
-		if (p_render_list == RENDER_LIST_OPAQUE) {
+		if (p_data->render_list == RENDER_LIST_OPAQUE) {
 			// Setup GI
 			if (inst->lightmap_instance.is_valid()) {
 				int32_t lightmap_cull_index = -1;
@@ -887,9 +885,10 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 				}
 
 			} else if (inst->lightmap_sh) {
-				if (lightmap_captures_used < scene_state.max_lightmap_captures) {
+				uint32_t capture_index = p_data->lightmap_captures_used.postincrement();
+				if (capture_index < scene_state.max_lightmap_captures) {
 					const Color *src_capture = inst->lightmap_sh->sh;
-					LightmapCaptureData &lcd = scene_state.lightmap_captures[lightmap_captures_used];
+					LightmapCaptureData &lcd = scene_state.lightmap_captures[capture_index];
 					for (int j = 0; j < 9; j++) {
 						lcd.sh[j * 4 + 0] = src_capture[j].r;
 						lcd.sh[j * 4 + 1] = src_capture[j].g;
@@ -897,13 +896,12 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 						lcd.sh[j * 4 + 3] = src_capture[j].a;
 					}
 					flags |= INSTANCE_DATA_FLAG_USE_LIGHTMAP_CAPTURE;
-					inst->gi_offset_cache = lightmap_captures_used;
-					lightmap_captures_used++;
+					inst->gi_offset_cache = capture_index;
 					uses_lightmap = true;
 				}
 
 			} else {
-				if (p_using_opaque_gi) {
+				if (p_data->using_opaque_gi) {
 					flags |= INSTANCE_DATA_FLAG_USE_GI_BUFFERS;
 				}
 
@@ -928,7 +926,7 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 					flags |= INSTANCE_DATA_FLAG_USE_VOXEL_GI;
 					uses_gi = true;
 				} else {
-					if (p_using_sdfgi && inst->can_sdfgi) {
+					if (p_data->using_sdfgi && inst->can_sdfgi) {
 						flags |= INSTANCE_DATA_FLAG_USE_SDFGI;
 						uses_gi = true;
 					}
@@ -944,16 +942,20 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 			surf->sort.uses_forward_gi = 0;
 			surf->sort.uses_lightmap = 0;
 
+			if (streaming_size > 0 && !surf->material->streamed_textures.is_empty()) {
+				chunk.streaming_requests.push_back(Pair<GeometryInstanceSurfaceDataCache *, int>(surf, streaming_size));
+			}
+
 			// LOD
 
-			if (p_render_data->scene_data->screen_mesh_lod_threshold > 0.0 && mesh_storage->mesh_surface_has_lod(surf->surface)) {
+			if (render_data->scene_data->screen_mesh_lod_threshold > 0.0 && mesh_storage->mesh_surface_has_lod(surf->surface)) {
 				// Get the LOD support points on the mesh AABB.
-				Vector3 lod_support_min = inst->transformed_aabb.get_support(p_render_data->scene_data->cam_transform.basis.get_column(Vector3::AXIS_Z));
-				Vector3 lod_support_max = inst->transformed_aabb.get_support(-p_render_data->scene_data->cam_transform.basis.get_column(Vector3::AXIS_Z));
+				Vector3 lod_support_min = inst->transformed_aabb.get_support(render_data->scene_data->cam_transform.basis.get_column(Vector3::AXIS_Z));
+				Vector3 lod_support_max = inst->transformed_aabb.get_support(-render_data->scene_data->cam_transform.basis.get_column(Vector3::AXIS_Z));
 
 				// Get the distances to those points on the AABB from the camera origin.
-				float distance_min = (float)p_render_data->scene_data->cam_transform.origin.distance_to(lod_support_min);
-				float distance_max = (float)p_render_data->scene_data->cam_transform.origin.distance_to(lod_support_max);
+				float distance_min = (float)render_data->scene_data->cam_transform.origin.distance_to(lod_support_min);
+				float distance_max = (float)render_data->scene_data->cam_transform.origin.distance_to(lod_support_max);
 
 				float distance = 0.0;
 
@@ -966,36 +968,28 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 					distance = -distance_max;
 				}
 
-				if (p_render_data->scene_data->cam_orthogonal) {
+				if (render_data->scene_data->cam_orthogonal) {
 					distance = 1.0;
 				}
 
 				uint32_t indices = 0;
-				surf->sort.lod_index = mesh_storage->mesh_surface_get_lod(surf->surface, inst->lod_model_scale * inst->lod_bias, distance * p_render_data->scene_data->lod_distance_multiplier, p_render_data->scene_data->screen_mesh_lod_threshold, indices);
-				if (p_render_data->render_info) {
+				surf->sort.lod_index = mesh_storage->mesh_surface_get_lod(surf->surface, inst->lod_model_scale * inst->lod_bias, distance * render_data->scene_data->lod_distance_multiplier, render_data->scene_data->screen_mesh_lod_threshold, indices);
+				if (render_data->render_info) {
 					indices = _indices_to_primitives(surf->primitive, indices);
-					if (p_render_list == RENDER_LIST_OPAQUE) { //opaque
-						p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += indices;
-					} else if (p_render_list == RENDER_LIST_SECONDARY) { //shadow
-						p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += indices;
-					}
+					chunk.primitive_count += indices;
 				}
 			} else {
 				surf->sort.lod_index = 0;
-				if (p_render_data->render_info) {
+				if (render_data->render_info) {
 					uint32_t to_draw = mesh_storage->mesh_surface_get_vertices_drawn_count(surf->surface);
 					to_draw = _indices_to_primitives(surf->primitive, to_draw);
 					to_draw *= inst->instance_count;
-					if (p_render_list == RENDER_LIST_OPAQUE) { //opaque
-						p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += to_draw;
-					} else if (p_render_list == RENDER_LIST_SECONDARY) { //shadow
-						p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += to_draw;
-					}
+					chunk.primitive_count += to_draw;
 				}
 			}
 
 			// ADD Element
-			if (p_pass_mode == PASS_MODE_COLOR) {
+			if (p_data->pass_mode == PASS_MODE_COLOR) {
 #ifdef DEBUG_ENABLED
 				bool force_alpha = unlikely(get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_OVERDRAW);
 #else
@@ -1007,10 +1001,10 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 				}
 
 				if (!force_alpha && (surf->flags & (GeometryInstanceSurfaceDataCache::FLAG_PASS_DEPTH | GeometryInstanceSurfaceDataCache::FLAG_PASS_OPAQUE))) {
-					rl->add_element(surf);
+					chunk.elements.push_back(surf);
 				}
 				if (force_alpha || (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_PASS_ALPHA)) {
-					render_list[RENDER_LIST_ALPHA].add_element(surf);
+					chunk.alpha_elements.push_back(surf);
 					if (uses_gi) {
 						surf->sort.uses_forward_gi = 1;
 					}
@@ -1021,24 +1015,24 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 				}
 
 				if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_USES_SUBSURFACE_SCATTERING) {
-					scene_state.used_sss = true;
+					chunk.used_sss = true;
 				}
 				if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_USES_SCREEN_TEXTURE) {
-					scene_state.used_screen_texture = true;
+					chunk.used_screen_texture = true;
 				}
 				if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_USES_NORMAL_TEXTURE) {
-					scene_state.used_normal_texture = true;
+					chunk.used_normal_texture = true;
 				}
 				if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_USES_DEPTH_TEXTURE) {
-					scene_state.used_depth_texture = true;
+					chunk.used_depth_texture = true;
 				}
-			} else if (p_pass_mode == PASS_MODE_SHADOW || p_pass_mode == PASS_MODE_SHADOW_DP) {
+			} else if (p_data->pass_mode == PASS_MODE_SHADOW || p_data->pass_mode == PASS_MODE_SHADOW_DP) {
 				if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_PASS_SHADOW) {
-					rl->add_element(surf);
+					chunk.elements.push_back(surf);
 				}
 			} else {
 				if (surf->flags & (GeometryInstanceSurfaceDataCache::FLAG_PASS_DEPTH | GeometryInstanceSurfaceDataCache::FLAG_PASS_OPAQUE)) {
-					rl->add_element(surf);
+					chunk.elements.push_back(surf);
 				}
 			}
 
@@ -1047,12 +1041,217 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 			surf = surf->next;
 		}
 	}
+}
+
+void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, const RenderDataRD *p_render_data, PassMode p_pass_mode, uint32_t p_color_pass_flags = 0, bool p_using_sdfgi, bool p_using_opaque_gi, bool p_append) {
+	RendererRD::TextureStorage *texture_storage = RendererRD::TextureStorage::get_singleton();
+
+	if (p_render_list == RENDER_LIST_OPAQUE) {
+		scene_state.used_sss = false;
+		scene_state.used_screen_texture = false;
+		scene_state.used_normal_texture = false;
+		scene_state.used_depth_texture = false;
+	}
+
+	RenderListFillData fill_data;
+	fill_data.render_list = p_render_list;
+	fill_data.render_data = p_render_data;
+	fill_data.pass_mode = p_pass_mode;
+	fill_data.using_sdfgi = p_using_sdfgi;
+	fill_data.using_opaque_gi = p_using_opaque_gi;
+
+	fill_data.near_plane = Plane(-p_render_data->scene_data->cam_transform.basis.get_column(Vector3::AXIS_Z), p_render_data->scene_data->cam_transform.origin);
+	fill_data.near_plane.d += p_render_data->scene_data->cam_projection.get_z_near();
+	fill_data.z_max = p_render_data->scene_data->cam_projection.get_z_far() - p_render_data->scene_data->cam_projection.get_z_near();
+
+	// Texture streaming feedback is estimated from the on-screen size of each instance in the main color pass.
+	if (p_render_list == RENDER_LIST_OPAQUE && p_pass_mode == PASS_MODE_COLOR && p_render_data->render_buffers.is_valid() && texture_storage->has_streaming_textures()) {
+		fill_data.streaming_pixels_per_meter = p_render_data->scene_data->cam_projection.get_pixels_per_meter(p_render_data->render_buffers->get_internal_size().width);
+	}
+
+	RenderList *rl = &render_list[p_render_list];
+	_update_dirty_geometry_instances();
+
+	if (!p_append) {
+		rl->clear();
+		if (p_render_list == RENDER_LIST_OPAQUE) {
+			render_list[RENDER_LIST_ALPHA].clear(); //opaque fills alpha too
+		}
+	}
+
+	//fill list
 
+	uint32_t chunk_count = (p_render_data->instances->size() + RENDER_LIST_FILL_CHUNK_SIZE - 1) / RENDER_LIST_FILL_CHUNK_SIZE;
+	if (render_list_fill_chunks.size() < chunk_count) {
+		render_list_fill_chunks.resize(chunk_count);
+	}
+
+	if (chunk_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RenderForwardClustered::_fill_render_list_chunk, &fill_data, chunk_count, -1, true, SNAME("ForwardClusteredFillRenderList"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (chunk_count == 1) {
+		_fill_render_list_chunk(0, &fill_data);
+	}
+
+	// Gather the chunks in order, so the lists are the same as when filled serially.
+	uint64_t primitive_count = 0;
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		const RenderListFillChunk &chunk = render_list_fill_chunks[i];
+
+		rl->add_elements(chunk.elements);
+		render_list[RENDER_LIST_ALPHA].add_elements(chunk.alpha_elements);
+
+		scene_state.used_sss = scene_state.used_sss || chunk.used_sss;
+		scene_state.used_screen_texture = scene_state.used_screen_texture || chunk.used_screen_texture;
+		scene_state.used_normal_texture = scene_state.used_normal_texture || chunk.used_normal_texture;
+		scene_state.used_depth_texture = scene_state.used_depth_texture || chunk.used_depth_texture;
+
+		primitive_count += chunk.primitive_count;
+
+		// Requests update per texture state, so they are sent from this thread.
+		for (const Pair<GeometryInstanceSurfaceDataCache *, int> &E : chunk.streaming_requests) {
+			for (const RID &texture : E.first->material->streamed_textures) {
+				texture_storage->texture_request_streaming_size(texture, E.second);
+			}
+		}
+	}
+
+	if (p_render_data->render_info) {
+		if (p_render_list == RENDER_LIST_OPAQUE) { //opaque
+			p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += primitive_count;
+		} else if (p_render_list == RENDER_LIST_SECONDARY) { //shadow
+			p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += primitive_count;
+		}
+	}
+
+	uint32_t lightmap_captures_used = MIN(fill_data.lightmap_captures_used.get(), scene_state.max_lightmap_captures);
 	if (p_render_list == RENDER_LIST_OPAQUE && lightmap_captures_used) {
 		RD::get_singleton()->buffer_update(scene_state.lightmap_capture_buffer, 0, sizeof(LightmapCaptureData) * lightmap_captures_used, scene_state.lightmap_captures, RD::BARRIER_MASK_RASTER);
 	}
 }
 
+void RenderForwardClustered::_sort_render_list_prepare(uint32_t p_chunk, RenderListSortData *p_data) {
+	uint32_t from = p_chunk * RENDER_LIST_SORT_CHUNK_SIZE;
+	uint32_t to = MIN(from + RENDER_LIST_SORT_CHUNK_SIZE, p_data->element_count);
+
+	uint64_t first_key1 = p_data->elements[0]->sort.sort_key1;
+	uint64_t first_key2 = p_data->elements[0]->sort.sort_key2;
+	uint64_t key1_bits = 0;
+	uint64_t key2_bits = 0;
+
+	for (uint32_t i = from; i < to; i++) {
+		GeometryInstanceSurfaceDataCache *surf = p_data->elements[i];
+		RenderListSortElement &e = p_data->src[i];
+		e.sort_key1 = surf->sort.sort_key1;
+		e.sort_key2 = surf->sort.sort_key2;
+		e.surface = surf;
+
+		key1_bits |= e.sort_key1 ^ first_key1;
+		key2_bits |= e.sort_key2 ^ first_key2;
+	}
+
+	p_data->key_bits[p_chunk * 2 + 0] = key1_bits;
+	p_data->key_bits[p_chunk * 2 + 1] = key2_bits;
+}
+
+void RenderForwardClustered::_sort_render_list_count(uint32_t p_chunk, RenderListSortData *p_data) {
+	uint32_t from = p_chunk * RENDER_LIST_SORT_CHUNK_SIZE;
+	uint32_t to = MIN(from + RENDER_LIST_SORT_CHUNK_SIZE, p_data->element_count);
+	uint32_t shift = (p_data->digit & 7) * 8;
+	bool use_key2 = p_data->digit >= 8;
+
+	uint32_t *histogram = p_data->histograms + p_chunk * 256;
+	memset(histogram, 0, sizeof(uint32_t) * 256);
+
+	for (uint32_t i = from; i < to; i++) {
+		const RenderListSortElement &e = p_data->src[i];
+		histogram[((use_key2 ? e.sort_key2 : e.sort_key1) >> shift) & 0xFF]++;
+	}
+}
+
+void RenderForwardClustered::_sort_render_list_scatter(uint32_t p_chunk, RenderListSortData *p_data) {
+	uint32_t from = p_chunk * RENDER_LIST_SORT_CHUNK_SIZE;
+	uint32_t to = MIN(from + RENDER_LIST_SORT_CHUNK_SIZE, p_data->element_count);
+	uint32_t shift = (p_data->digit & 7) * 8;
+	bool use_key2 = p_data->digit >= 8;
+
+	uint32_t *offsets = p_data->histograms + p_chunk * 256;
+
+	for (uint32_t i = from; i < to; i++) {
+		const RenderListSortElement &e = p_data->src[i];
+		p_data->dst[offsets[((use_key2 ? e.sort_key2 : e.sort_key1) >> shift) & 0xFF]++] = e;
+	}
+}
+
+void RenderForwardClustered::_sort_render_list_by_key(RenderListType p_render_list) {
+	RenderList &rl = render_list[p_render_list];
+
+	uint32_t element_count = rl.elements.size();
+	if (element_count < RENDER_LIST_RADIX_SORT_THRESHOLD) {
+		rl.sort_by_key();
+		return;
+	}
+
+	// Same order as RenderList::sort_by_key(), with sort_key2 as the most significant half of the key.
+
+	uint32_t chunk_count = (element_count + RENDER_LIST_SORT_CHUNK_SIZE - 1) / RENDER_LIST_SORT_CHUNK_SIZE;
+
+	render_list_sort_buffers[0].resize(element_count);
+	render_list_sort_buffers[1].resize(element_count);
+	render_list_sort_histograms.resize(chunk_count * 256);
+	render_list_sort_key_bits.resize(chunk_count * 2);
+
+	RenderListSortData sort_data;
+	sort_data.elements = rl.elements.ptr();
+	sort_data.element_count = element_count;
+	sort_data.src = render_list_sort_buffers[0].ptr();
+	sort_data.dst = render_list_sort_buffers[1].ptr();
+	sort_data.histograms = render_list_sort_histograms.ptr();
+	sort_data.key_bits = render_list_sort_key_bits.ptr();
+
+	WorkerThreadPool *thread_pool = WorkerThreadPool::get_singleton();
+
+	WorkerThreadPool::GroupID group_task = thread_pool->add_template_group_task(this, &RenderForwardClustered::_sort_render_list_prepare, &sort_data, chunk_count, -1, true, SNAME("ForwardClusteredSortRenderList"));
+	thread_pool->wait_for_group_task_completion(group_task);
+
+	uint64_t key_bits[2] = { 0, 0 };
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		key_bits[0] |= sort_data.key_bits[i * 2 + 0];
+		key_bits[1] |= sort_data.key_bits[i * 2 + 1];
+	}
+
+	for (uint32_t digit = 0; digit < 16; digit++) {
+		if (((key_bits[digit / 8] >> ((digit & 7) * 8)) & 0xFF) == 0) {
+			continue; // Same in all the keys, nothing to sort.
+		}
+
+		sort_data.digit = digit;
+
+		group_task = thread_pool->add_template_group_task(this, &RenderForwardClustered::_sort_render_list_count, &sort_data, chunk_count, -1, true, SNAME("ForwardClusteredSortRenderList"));
+		thread_pool->wait_for_group_task_completion(group_task);
+
+		// Offsets go by digit, then by chunk, which keeps the sort stable.
+		uint32_t offset = 0;
+		for (uint32_t i = 0; i < 256; i++) {
+			for (uint32_t j = 0; j < chunk_count; j++) {
+				uint32_t &histogram = sort_data.histograms[j * 256 + i];
+				uint32_t count = histogram;
+				histogram = offset;
+				offset += count;
+			}
+		}
+
+		group_task = thread_pool->add_template_group_task(this, &RenderForwardClustered::_sort_render_list_scatter, &sort_data, chunk_count, -1, true, SNAME("ForwardClusteredSortRenderList"));
+		thread_pool->wait_for_group_task_completion(group_task);
+
+		SWAP(sort_data.src, sort_data.dst);
+	}
+
+	for (uint32_t i = 0; i < element_count; i++) {
+		rl.elements[i] = sort_data.src[i].surface;
+	}
+}
+
 void RenderForwardClustered::_setup_voxelgis(const PagedArray<RID> &p_voxelgis) {
 	scene_state.voxelgis_used = MIN(p_voxelgis.size(), uint32_t(MAX_VOXEL_GI_INSTANCESS));
 	for (uint32_t i = 0; i < scene_state.voxelgis_used; i++) {
@@ -1681,7 +1880,7 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 	_update_render_base_uniform_set(); //may have changed due to the above (light buffer enlarged, as an example)
 
 	_fill_render_list(RENDER_LIST_OPAQUE, p_render_data, PASS_MODE_COLOR, color_pass_flags, using_sdfgi, using_sdfgi || using_voxelgi);
-	render_list[RENDER_LIST_OPAQUE].sort_by_key();
+	_sort_render_list_by_key(RENDER_LIST_OPAQUE);
 	render_list[RENDER_LIST_ALPHA].sort_by_reverse_depth_and_priority();
 	_fill_instance_data(RENDER_LIST_OPAQUE, p_render_data->render_info ? p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE] : (int *)nullptr);
 	_fill_instance_data(RENDER_LIST_ALPHA);
@@ -2462,7 +2661,7 @@ void RenderForwardClustered::_render_particle_collider_heightfield(RID p_fb, con
 	PassMode pass_mode = PASS_MODE_SHADOW;
 
 	_fill_render_list(RENDER_LIST_SECONDARY, &render_data, pass_mode);
-	render_list[RENDER_LIST_SECONDARY].sort_by_key();
+	_sort_render_list_by_key(RENDER_LIST_SECONDARY);
 	_fill_instance_data(RENDER_LIST_SECONDARY);
 
 	RID rp_uniform_set = _setup_render_pass_uniform_set(RENDER_LIST_SECONDARY, nullptr, RID());
@@ -2505,7 +2704,7 @@ void RenderForwardClustered::_render_material(const Transform3D &p_cam_transform
 
 	PassMode pass_mode = PASS_MODE_DEPTH_MATERIAL;
 	_fill_render_list(RENDER_LIST_SECONDARY, &render_data, pass_mode);
-	render_list[RENDER_LIST_SECONDARY].sort_by_key();
+	_sort_render_list_by_key(RENDER_LIST_SECONDARY);
 	_fill_instance_data(RENDER_LIST_SECONDARY);
 
 	RID rp_uniform_set = _setup_render_pass_uniform_set(RENDER_LIST_SECONDARY, nullptr, RID());
@@ -2554,7 +2753,7 @@ void RenderForwardClustered::_render_uv2(const PagedArray<RenderGeometryInstance
 
 	PassMode pass_mode = PASS_MODE_DEPTH_MATERIAL;
 	_fill_render_list(RENDER_LIST_SECONDARY, &render_data, pass_mode);
-	render_list[RENDER_LIST_SECONDARY].sort_by_key();
+	_sort_render_list_by_key(RENDER_LIST_SECONDARY);
 	_fill_instance_data(RENDER_LIST_SECONDARY);
 
 	RID rp_uniform_set = _setup_render_pass_uniform_set(RENDER_LIST_SECONDARY, nullptr, RID());
@@ -2621,7 +2820,7 @@ void RenderForwardClustered::_render_sdfgi(Ref<RenderSceneBuffersRD> p_render_bu
 
 	PassMode pass_mode = PASS_MODE_SDF;
 	_fill_render_list(RENDER_LIST_SECONDARY, &render_data, pass_mode);
-	render_list[RENDER_LIST_SECONDARY].sort_by_key();
+	_sort_render_list_by_key(RENDER_LIST_SECONDARY);
 	_fill_instance_data(RENDER_LIST_SECONDARY);
 
 	Vector3 half_size = p_bounds.size * 0.5;
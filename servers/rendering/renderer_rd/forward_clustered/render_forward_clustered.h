@@ -558,10 +558,90 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		_FORCE_INLINE_ void add_element(GeometryInstanceSurfaceDataCache *p_element) {
 			elements.push_back(p_element);
 		}
+
+		_FORCE_INLINE_ void add_elements(const LocalVector<GeometryInstanceSurfaceDataCache *> &p_elements) {
+			if (p_elements.is_empty()) {
+				return;
+			}
+			uint32_t from = elements.size();
+			elements.resize(from + p_elements.size());
+			memcpy(elements.ptr() + from, p_elements.ptr(), p_elements.size() * sizeof(GeometryInstanceSurfaceDataCache *));
+		}
 	};
 
 	RenderList render_list[RENDER_LIST_MAX];
 
+	// Instances are processed in chunks of this size on the WorkerThreadPool when filling render lists.
+	static constexpr uint32_t RENDER_LIST_FILL_CHUNK_SIZE = 256;
+
+	struct RenderListFillData {
+		RenderListType render_list = RENDER_LIST_OPAQUE;
+		const RenderDataRD *render_data = nullptr;
+		PassMode pass_mode = PASS_MODE_COLOR;
+		bool using_sdfgi = false;
+		bool using_opaque_gi = false;
+		Plane near_plane;
+		float z_max = 0.0;
+		float streaming_pixels_per_meter = 0.0;
+		SafeNumeric<uint32_t> lightmap_captures_used;
+	};
+
+	// Output of a chunk, gathered in chunk order once all of them are done.
+	struct RenderListFillChunk {
+		LocalVector<GeometryInstanceSurfaceDataCache *> elements;
+		LocalVector<GeometryInstanceSurfaceDataCache *> alpha_elements;
+		LocalVector<Pair<GeometryInstanceSurfaceDataCache *, int>> streaming_requests;
+		uint64_t primitive_count = 0;
+		bool used_sss = false;
+		bool used_screen_texture = false;
+		bool used_normal_texture = false;
+		bool used_depth_texture = false;
+
+		void clear() {
+			elements.clear();
+			alpha_elements.clear();
+			streaming_requests.clear();
+			primitive_count = 0;
+			used_sss = false;
+			used_screen_texture = false;
+			used_normal_texture = false;
+			used_depth_texture = false;
+		}
+	};
+
+	LocalVector<RenderListFillChunk> render_list_fill_chunks;
+
+	void _fill_render_list_chunk(uint32_t p_chunk, RenderListFillData *p_data);
+
+	// Render lists with at least this amount of elements are sorted by key with a radix sort on the WorkerThreadPool.
+	static constexpr uint32_t RENDER_LIST_RADIX_SORT_THRESHOLD = 8192;
+	static constexpr uint32_t RENDER_LIST_SORT_CHUNK_SIZE = 4096;
+
+	struct RenderListSortElement {
+		uint64_t sort_key1;
+		uint64_t sort_key2;
+		GeometryInstanceSurfaceDataCache *surface;
+	};
+
+	struct RenderListSortData {
+		GeometryInstanceSurfaceDataCache **elements = nullptr;
+		uint32_t element_count = 0;
+		RenderListSortElement *src = nullptr;
+		RenderListSortElement *dst = nullptr;
+		uint32_t *histograms = nullptr; // 256 per chunk, turned into offsets before scattering.
+		uint64_t *key_bits = nullptr; // Per chunk, the bits of sort_key1 and sort_key2 that differ from the first element.
+		uint32_t digit = 0; // Byte of the 128 bit key handled by the current pass, sort_key1 first.
+	};
+
+	LocalVector<RenderListSortElement> render_list_sort_buffers[2];
+	LocalVector<uint32_t> render_list_sort_histograms;
+	LocalVector<uint64_t> render_list_sort_key_bits;
+
+	void _sort_render_list_prepare(uint32_t p_chunk, RenderListSortData *p_data);
+	void _sort_render_list_count(uint32_t p_chunk, RenderListSortData *p_data);
+	void _sort_render_list_scatter(uint32_t p_chunk, RenderListSortData *p_data);
+	void _sort_render_list_by_key(RenderListType p_render_list);
+
 	virtual void _update_shader_quality_settings() override;
 
 	/* Effects */
@@ -360,6 +360,9 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 
 						RID shader_variant = shader_singleton->shader.version_get_shader(version, variant);
 						color_pipelines[i][j][l].setup(shader_variant, primitive_rd, raster_state, multisample_state, depth_stencil, blend_state, 0, singleton->default_specialization_constants);
+						// These features are checked at runtime as well, so enabling them gives a slower but generic variant.
+						// Forward GI is left as requested, since disabling it selects the GI buffers path instead.
+						color_pipelines[i][j][l].set_fallback_specializations(SHADER_SPECIALIZATION_PROJECTOR | SHADER_SPECIALIZATION_SOFT_SHADOWS | SHADER_SPECIALIZATION_DIRECTIONAL_SOFT_SHADOWS, 0);
 					}
 				} else {
 					RD::PipelineColorBlendState blend_state;
@@ -126,6 +126,11 @@ void RenderForwardMobile::RenderBufferDataForwardMobile::free_data() {
 	if (render_buffers) {
 		render_buffers->clear_context(RB_SCOPE_MOBILE);
 	}
+
+	if (cluster_builder) {
+		memdelete(cluster_builder);
+		cluster_builder = nullptr;
+	}
 }
 
 void RenderForwardMobile::RenderBufferDataForwardMobile::configure(RenderSceneBuffersRD *p_render_buffers) {
@@ -160,6 +165,16 @@ void RenderForwardMobile::RenderBufferDataForwardMobile::configure(RenderSceneBu
 
 		render_buffers->create_texture(RB_SCOPE_MOBILE, RB_TEX_DEPTH_MSAA, format, usage_bits, texture_samples);
 	}
+
+	RenderForwardMobile *forward_mobile = RenderForwardMobile::get_singleton();
+	if (forward_mobile->use_clustered_lighting && render_buffers->get_view_count() == 1) {
+		cluster_builder = memnew(ClusterBuilderRD);
+		cluster_builder->set_shared(forward_mobile->cluster_builder_shared);
+		cluster_builder->set_cluster_size(forward_mobile->cluster_size);
+
+		RID sampler = RendererRD::MaterialStorage::get_singleton()->sampler_rd_get_default(RS::CANVAS_ITEM_TEXTURE_FILTER_NEAREST, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED);
+		cluster_builder->setup(render_buffers->get_internal_size(), render_buffers->get_max_cluster_elements(), render_buffers->get_depth_texture(), sampler, render_buffers->get_internal_texture());
+	}
 }
 
 RID RenderForwardMobile::RenderBufferDataForwardMobile::get_color_fbs(FramebufferConfigType p_config_type) {
@@ -323,6 +338,26 @@ RID RenderForwardMobile::reflection_probe_create_framebuffer(RID p_color, RID p_
 	return RD::get_singleton()->framebuffer_create_multipass(fb, passes);
 }
 
+/* Lighting */
+
+void RenderForwardMobile::setup_added_reflection_probe(const Transform3D &p_transform, const Vector3 &p_half_size) {
+	if (current_cluster_builder != nullptr) {
+		current_cluster_builder->add_box(ClusterBuilderRD::BOX_TYPE_REFLECTION_PROBE, p_transform, p_half_size);
+	}
+}
+
+void RenderForwardMobile::setup_added_light(const RS::LightType p_type, const Transform3D &p_transform, float p_radius, float p_spot_aperture) {
+	if (current_cluster_builder != nullptr) {
+		current_cluster_builder->add_light(p_type == RS::LIGHT_SPOT ? ClusterBuilderRD::LIGHT_TYPE_SPOT : ClusterBuilderRD::LIGHT_TYPE_OMNI, p_transform, p_radius, p_spot_aperture);
+	}
+}
+
+void RenderForwardMobile::setup_added_decal(const Transform3D &p_transform, const Vector3 &p_half_size) {
+	if (current_cluster_builder != nullptr) {
+		current_cluster_builder->add_box(ClusterBuilderRD::BOX_TYPE_DECAL, p_transform, p_half_size);
+	}
+}
+
 void RenderForwardMobile::setup_render_buffer_data(Ref<RenderSceneBuffersRD> p_render_buffers) {
 	Ref<RenderBufferDataForwardMobile> data;
 	data.instantiate();
@@ -486,15 +521,16 @@ RID RenderForwardMobile::_setup_render_pass_uniform_set(RenderListType p_render_
 		uniforms.push_back(u);
 	}
 
+	*/
+
 	{
 		RD::Uniform u;
 		u.binding = 8;
 		u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
-		RID cb = p_cluster_buffer.is_valid() ? p_cluster_buffer : default_vec4_xform_buffer;
+		RID cb = (p_render_data && p_render_data->cluster_buffer.is_valid()) ? p_render_data->cluster_buffer : scene_shader.default_vec4_xform_buffer;
 		u.append_id(cb);
 		uniforms.push_back(u);
 	}
-	*/
 
 	{
 		RD::Uniform u;
@@ -526,6 +562,13 @@ RID RenderForwardMobile::_setup_render_pass_uniform_set(RenderListType p_render_
 		u.append_id(texture);
 		uniforms.push_back(u);
 	}
+	{
+		RD::Uniform u;
+		u.binding = 11;
+		u.uniform_type = RD::UNIFORM_TYPE_UNIFORM_BUFFER;
+		u.append_id(scene_state.cluster_data_buffer);
+		uniforms.push_back(u);
+	}
 
 	if (p_index >= (int)render_pass_uniform_sets.size()) {
 		render_pass_uniform_sets.resize(p_index + 1);
@@ -633,6 +676,10 @@ void RenderForwardMobile::_pre_opaque_render(RenderDataRD *p_render_data) {
 	//full barrier here, we need raster, transfer and compute and it depends from the previous work
 	RD::get_singleton()->barrier(RD::BARRIER_MASK_ALL_BARRIERS, RD::BARRIER_MASK_ALL_BARRIERS);
 
+	if (current_cluster_builder) {
+		current_cluster_builder->begin(p_render_data->scene_data->cam_transform, p_render_data->scene_data->cam_projection, true);
+	}
+
 	bool using_shadows = true;
 
 	if (p_render_data->reflection_probe.is_valid()) {
@@ -650,6 +697,10 @@ void RenderForwardMobile::_pre_opaque_render(RenderDataRD *p_render_data) {
 	texture_storage->update_decal_buffer(*p_render_data->decals, p_render_data->scene_data->cam_transform);
 
 	p_render_data->directional_light_count = directional_light_count;
+
+	if (current_cluster_builder) {
+		current_cluster_builder->bake_cluster();
+	}
 }
 
 void RenderForwardMobile::_render_scene(RenderDataRD *p_render_data, const Color &p_default_bg_color) {
@@ -670,6 +721,14 @@ void RenderForwardMobile::_render_scene(RenderDataRD *p_render_data, const Color
 
 	RENDER_TIMESTAMP("Prepare 3D Scene");
 
+	// Reflection probes don't have render buffer data, they keep using the per instance lists.
+	current_cluster_builder = rb_data.is_valid() ? rb_data->cluster_builder : nullptr;
+	if (current_cluster_builder != nullptr) {
+		p_render_data->cluster_buffer = current_cluster_builder->get_cluster_buffer();
+		p_render_data->cluster_size = current_cluster_builder->get_cluster_size();
+		p_render_data->cluster_max_elements = current_cluster_builder->get_max_cluster_elements();
+	}
+
 	_update_vrs(rb);
 
 	RENDER_TIMESTAMP("Setup 3D Scene");
@@ -900,6 +959,10 @@ void RenderForwardMobile::_render_scene(RenderDataRD *p_render_data, const Color
 		if (!is_environment(p_render_data->environment) || !environment_get_fog_enabled(p_render_data->environment)) {
 			spec_constant_base_flags |= 1 << SPEC_CONSTANT_DISABLE_FOG;
 		}
+
+		if (current_cluster_builder != nullptr) {
+			spec_constant_base_flags |= 1 << SPEC_CONSTANT_USE_CLUSTERED_LIGHTING;
+		}
 	}
 	{
 		if (rb_data.is_valid()) {
@@ -1743,6 +1806,7 @@ _FORCE_INLINE_ static uint32_t _indices_to_primitives(RS::PrimitiveType p_primit
 
 void RenderForwardMobile::_fill_render_list(RenderListType p_render_list, const RenderDataRD *p_render_data, PassMode p_pass_mode, bool p_append) {
 	RendererRD::MeshStorage *mesh_storage = RendererRD::MeshStorage::get_singleton();
+	RendererRD::TextureStorage *texture_storage = RendererRD::TextureStorage::get_singleton();
 
 	if (p_render_list == RENDER_LIST_OPAQUE) {
 		scene_state.used_sss = false;
@@ -1756,6 +1820,12 @@ void RenderForwardMobile::_fill_render_list(RenderListType p_render_list, const
 	near_plane.d += p_render_data->scene_data->cam_projection.get_z_near();
 	float z_max = p_render_data->scene_data->cam_projection.get_z_far() - p_render_data->scene_data->cam_projection.get_z_near();
 
+	// Texture streaming feedback is estimated from the on-screen size of each instance in the main color pass.
+	float streaming_pixels_per_meter = 0.0;
+	if (p_render_list == RENDER_LIST_OPAQUE && p_pass_mode == PASS_MODE_COLOR && p_render_data->render_buffers.is_valid() && texture_storage->has_streaming_textures()) {
+		streaming_pixels_per_meter = p_render_data->scene_data->cam_projection.get_pixels_per_meter(p_render_data->render_buffers->get_internal_size().width);
+	}
+
 	RenderList *rl = &render_list[p_render_list];
 
 	// Parse any updates on our geometry, updates surface caches and such
@@ -1787,6 +1857,17 @@ void RenderForwardMobile::_fill_render_list(RenderListType p_render_list, const
 		}
 		uint32_t depth_layer = CLAMP(int(inst->depth * 16 / z_max), 0, 15);
 
+		int streaming_size = 0;
+		if (streaming_pixels_per_meter > 0.0) {
+			// Assumes the texture covers the instance once, which is what most materials do.
+			float extent = inst->transformed_aabb.get_longest_axis_size();
+			float distance = 1.0;
+			if (!p_render_data->scene_data->cam_orthogonal) {
+				distance = MAX(float(p_render_data->scene_data->cam_transform.origin.distance_to(center)) - extent * 0.5f, float(p_render_data->scene_data->z_near));
+			}
+			streaming_size = int(streaming_pixels_per_meter * extent / distance);
+		}
+
 		uint32_t flags = inst->base_flags; //fill flags if appropriate
 
 		if (inst->non_uniform_scale) {
@@ -1841,6 +1922,12 @@ void RenderForwardMobile::_fill_render_list(RenderListType p_render_list, const
 		while (surf) {
 			surf->sort.uses_lightmap = 0;
 
+			if (streaming_size > 0) {
+				for (const RID &texture : surf->material->streamed_textures) {
+					texture_storage->texture_request_streaming_size(texture, streaming_size);
+				}
+			}
+
 			// LOD
 
 			if (p_render_data->scene_data->screen_mesh_lod_threshold > 0.0 && mesh_storage->mesh_surface_has_lod(surf->surface)) {
@@ -1953,6 +2040,17 @@ void RenderForwardMobile::_setup_environment(const RenderDataRD *p_render_data,
 	}
 
 	p_render_data->scene_data->update_ubo(scene_state.uniform_buffers[p_index], get_debug_draw_mode(), env, reflection_probe_instance, p_render_data->camera_attributes, p_flip_y, p_pancake_shadows, p_screen_size, p_default_bg_color, _render_buffers_get_luminance_multiplier(), p_opaque_render_buffers);
+
+	if (p_render_data->cluster_buffer.is_valid()) {
+		ClusterData cluster_data;
+		cluster_data.cluster_shift = get_shift_from_power_of_2(p_render_data->cluster_size);
+		cluster_data.max_cluster_element_count_div_32 = p_render_data->cluster_max_elements / 32;
+		uint32_t cluster_screen_width = (p_screen_size.width - 1) / p_render_data->cluster_size + 1;
+		uint32_t cluster_screen_height = (p_screen_size.height - 1) / p_render_data->cluster_size + 1;
+		cluster_data.cluster_type_size = cluster_screen_width * cluster_screen_height * (cluster_data.max_cluster_element_count_div_32 + 32);
+		cluster_data.cluster_width = cluster_screen_width;
+		RD::get_singleton()->buffer_update(scene_state.cluster_data_buffer, 0, sizeof(ClusterData), &cluster_data, RD::BARRIER_MASK_RASTER);
+	}
 }
 
 void RenderForwardMobile::_fill_element_info(RenderListType p_render_list, uint32_t p_offset, int32_t p_max_elements) {
@@ -2104,7 +2202,9 @@ void RenderForwardMobile::_render_list_template(RenderingDevice::DrawListID p_dr
 			if (inst->use_soft_shadow) {
 				base_spec_constants |= 1 << SPEC_CONSTANT_USING_SOFT_SHADOWS;
 			}
-			forward_id_storage_mobile->fill_push_constant_instance_indices(&push_constant, base_spec_constants, inst);
+			if (!(base_spec_constants & (1 << SPEC_CONSTANT_USE_CLUSTERED_LIGHTING))) {
+				forward_id_storage_mobile->fill_push_constant_instance_indices(&push_constant, base_spec_constants, inst);
+			}
 
 #ifdef DEBUG_ENABLED
 			if (unlikely(get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_LIGHTING)) {
@@ -2821,6 +2921,16 @@ RenderForwardMobile::RenderForwardMobile() {
 
 	scene_shader.init(defines);
 
+	{
+		// clustered lighting
+		use_clustered_lighting = GLOBAL_GET("rendering/lights_and_shadows/mobile/use_clustered_lighting");
+		cluster_size = GLOBAL_GET("rendering/lights_and_shadows/mobile/cluster_size");
+		if (use_clustered_lighting) {
+			cluster_builder_shared = memnew(ClusterBuilderSharedDataRD);
+		}
+		scene_state.cluster_data_buffer = RD::get_singleton()->uniform_buffer_create(sizeof(ClusterData));
+	}
+
 	// !BAS! maybe we need a mobile version of this setting?
 	render_list_thread_threshold = GLOBAL_GET("rendering/limits/forward_renderer/threaded_render_minimum_instances");
 
@@ -2843,6 +2953,11 @@ RenderForwardMobile::~RenderForwardMobile() {
 		}
 		RD::get_singleton()->free(scene_state.lightmap_buffer);
 		RD::get_singleton()->free(scene_state.lightmap_capture_buffer);
+		RD::get_singleton()->free(scene_state.cluster_data_buffer);
 		memdelete_arr(scene_state.lightmap_captures);
 	}
+
+	if (cluster_builder_shared) {
+		memdelete(cluster_builder_shared);
+	}
 }
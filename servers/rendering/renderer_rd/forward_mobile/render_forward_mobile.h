@@ -32,6 +32,7 @@
 #define RENDER_FORWARD_MOBILE_H
 
 #include "core/templates/paged_allocator.h"
+#include "servers/rendering/renderer_rd/cluster_builder_rd.h"
 #include "servers/rendering/renderer_rd/forward_mobile/scene_shader_forward_mobile.h"
 #include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
 #include "servers/rendering/renderer_rd/renderer_scene_render_rd.h"
@@ -81,6 +82,8 @@ private:
 		SPEC_CONSTANT_DISABLE_DECALS = 13,
 		SPEC_CONSTANT_DISABLE_FOG = 14,
 
+		SPEC_CONSTANT_USE_CLUSTERED_LIGHTING = 16,
+
 	};
 
 	enum {
@@ -128,6 +131,8 @@ private:
 		virtual void free_data() override;
 		virtual void configure(RenderSceneBuffersRD *p_render_buffers) override;
 
+		ClusterBuilderRD *cluster_builder = nullptr; // Only when using clustered lighting.
+
 	private:
 		RenderSceneBuffersRD *render_buffers = nullptr;
 		RD::TextureSamples texture_samples = RD::TEXTURE_SAMPLES_1;
@@ -135,6 +140,23 @@ private:
 
 	virtual void setup_render_buffer_data(Ref<RenderSceneBuffersRD> p_render_buffers) override;
 
+	/* Clustered lighting */
+
+	// Optionally, lights, reflection probes and decals are culled in screen space clusters instead of per instance,
+	// which lifts the MAX_RDL_CULL limit. The clusters are kept large, as mobile GPUs are bandwidth bound.
+	// Reflection probe and multiview renders still use the per instance lists.
+	struct ClusterData {
+		uint32_t cluster_shift;
+		uint32_t cluster_width;
+		uint32_t cluster_type_size;
+		uint32_t max_cluster_element_count_div_32;
+	};
+
+	bool use_clustered_lighting = false;
+	uint32_t cluster_size = 64;
+	ClusterBuilderSharedDataRD *cluster_builder_shared = nullptr;
+	ClusterBuilderRD *current_cluster_builder = nullptr;
+
 	/* Rendering */
 
 	enum PassMode {
@@ -269,6 +291,8 @@ private:
 		};
 
 		LocalVector<ShadowPass> shadow_passes;
+
+		RID cluster_data_buffer;
 	} scene_state;
 
 	/* Render List */
@@ -555,6 +579,11 @@ public:
 
 	virtual RID reflection_probe_create_framebuffer(RID p_color, RID p_depth) override;
 
+	/* callback from updating our lighting UBOs, used to populate cluster builder */
+	virtual void setup_added_reflection_probe(const Transform3D &p_transform, const Vector3 &p_half_size) override;
+	virtual void setup_added_light(const RS::LightType p_type, const Transform3D &p_transform, float p_radius, float p_spot_aperture) override;
+	virtual void setup_added_decal(const Transform3D &p_transform, const Vector3 &p_half_size) override;
+
 	/* SDFGI UPDATE */
 
 	virtual void sdfgi_update(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, const Vector3 &p_world_position) override {}
@@ -333,6 +333,13 @@ void SceneShaderForwardMobile::ShaderData::set_code(const String &p_code) {
 
 				RID shader_variant = shader_singleton->shader.version_get_shader(version, k);
 				pipelines[i][j][k].setup(shader_variant, primitive_rd, raster_state, multisample_state, depth_stencil, blend_state, 0, singleton->default_specialization_constants);
+
+				if (k == SHADER_VERSION_COLOR_PASS || k == SHADER_VERSION_COLOR_PASS_MULTIVIEW || k == SHADER_VERSION_LIGHTMAP_COLOR_PASS || k == SHADER_VERSION_LIGHTMAP_COLOR_PASS_MULTIVIEW) {
+					// All of these are also checked at runtime, so enabling every feature gives a slower but generic variant.
+					const uint32_t fallback_enable = (1 << RenderForwardMobile::SPEC_CONSTANT_USING_PROJECTOR) | (1 << RenderForwardMobile::SPEC_CONSTANT_USING_SOFT_SHADOWS) | (1 << RenderForwardMobile::SPEC_CONSTANT_USING_DIRECTIONAL_SOFT_SHADOWS);
+					const uint32_t fallback_disable = (1 << RenderForwardMobile::SPEC_CONSTANT_DISABLE_OMNI_LIGHTS) | (1 << RenderForwardMobile::SPEC_CONSTANT_DISABLE_SPOT_LIGHTS) | (1 << RenderForwardMobile::SPEC_CONSTANT_DISABLE_REFLECTION_PROBES) | (1 << RenderForwardMobile::SPEC_CONSTANT_DISABLE_DIRECTIONAL_LIGHTS) | (1 << RenderForwardMobile::SPEC_CONSTANT_DISABLE_DECALS) | (1 << RenderForwardMobile::SPEC_CONSTANT_DISABLE_FOG);
+					pipelines[i][j][k].set_fallback_specializations(fallback_enable, fallback_disable);
+				}
 			}
 		}
 	}
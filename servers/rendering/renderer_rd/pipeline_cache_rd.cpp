@@ -32,14 +32,16 @@
 
 #include "core/os/memory.h"
 
-RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+bool PipelineCacheRD::async_compilation_enabled = false;
+SafeNumeric<uint64_t> PipelineCacheRD::sync_compilations;
+SafeNumeric<uint64_t> PipelineCacheRD::async_compilations;
+
+RID PipelineCacheRD::_create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
 	RD::PipelineMultisampleState multisample_state_version = multisample_state;
 	multisample_state_version.sample_count = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, p_render_pass);
 
-	bool wireframe = p_wireframe;
-
 	RD::PipelineRasterizationState raster_state_version = rasterization_state;
-	raster_state_version.wireframe = wireframe;
+	raster_state_version.wireframe = p_wireframe;
 
 	Vector<RD::PipelineSpecializationConstant> specialization_constants = base_specialization_constants;
 
@@ -57,23 +59,123 @@ RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD
 		bool_index++;
 	}
 
-	RID pipeline = RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
-	ERR_FAIL_COND_V(pipeline.is_null(), RID());
+	return RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
+}
+
+uint32_t PipelineCacheRD::_add_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations, RID p_pipeline) {
 	versions = static_cast<Version *>(memrealloc(versions, sizeof(Version) * (version_count + 1)));
 	versions[version_count].framebuffer_id = p_framebuffer_format_id;
 	versions[version_count].vertex_id = p_vertex_format_id;
-	versions[version_count].wireframe = wireframe;
-	versions[version_count].pipeline = pipeline;
+	versions[version_count].wireframe = p_wireframe;
+	versions[version_count].pipeline = p_pipeline;
 	versions[version_count].render_pass = p_render_pass;
 	versions[version_count].bool_specializations = p_bool_specializations;
-	version_count++;
+	versions[version_count].compile_task = WorkerThreadPool::INVALID_TASK_ID;
+	return version_count++;
+}
+
+uint32_t PipelineCacheRD::_add_version_async(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	// Must be called with the spin lock held, the task will wait for it before storing the result.
+	uint32_t index = _add_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations, RID());
+	versions[index].compile_task = WorkerThreadPool::get_singleton()->add_template_task(this, &PipelineCacheRD::_compile_version_task, index, false, "PipelineCompile");
+	return index;
+}
+
+void PipelineCacheRD::_compile_version_task(uint32_t p_index) {
+	spin_lock.lock();
+	Version version = versions[p_index];
+	spin_lock.unlock();
+
+	// Shader and pipeline state can't change while this runs, _clear() waits for pending tasks.
+	RID pipeline = _create_pipeline(version.vertex_id, version.framebuffer_id, version.wireframe, version.render_pass, version.bool_specializations);
+	async_compilations.increment();
+
+	spin_lock.lock();
+	versions[p_index].pipeline = pipeline;
+	spin_lock.unlock();
+}
+
+RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	if (async_compilation_enabled) {
+		uint32_t fallback_specializations = (p_bool_specializations | fallback_specializations_enable) & ~fallback_specializations_disable;
+		if (fallback_specializations != p_bool_specializations) {
+			_add_version_async(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+			return _get_fallback_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, fallback_specializations);
+		}
+	}
+
+	RID pipeline = _create_pipeline(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+	ERR_FAIL_COND_V(pipeline.is_null(), RID());
+	sync_compilations.increment();
+	_add_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations, pipeline);
 	return pipeline;
 }
 
+RID PipelineCacheRD::_get_pending_version(uint32_t p_index) {
+	WorkerThreadPool::TaskID task = versions[p_index].compile_task;
+	if (WorkerThreadPool::get_singleton()->is_task_completed(task)) {
+		// Already done, so this returns right away.
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		versions[p_index].compile_task = WorkerThreadPool::INVALID_TASK_ID;
+		return versions[p_index].pipeline;
+	}
+
+	const Version &version = versions[p_index];
+	uint32_t fallback_specializations = (version.bool_specializations | fallback_specializations_enable) & ~fallback_specializations_disable;
+	if (fallback_specializations == version.bool_specializations) {
+		// This is the fallback itself (queued by a replay), nothing else to draw with.
+		// Take the task while locked, so no other thread waits on it or queries it after it's gone.
+		versions[p_index].compile_task = WorkerThreadPool::INVALID_TASK_ID;
+		spin_lock.unlock();
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		spin_lock.lock();
+		return versions[p_index].pipeline;
+	}
+
+	return _get_fallback_version(version.vertex_id, version.framebuffer_id, version.wireframe, version.render_pass, fallback_specializations);
+}
+
+RID PipelineCacheRD::_get_fallback_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	for (uint32_t i = 0; i < version_count; i++) {
+		if (versions[i].vertex_id == p_vertex_format_id && versions[i].framebuffer_id == p_framebuffer_format_id && versions[i].wireframe == p_wireframe && versions[i].render_pass == p_render_pass && versions[i].bool_specializations == p_bool_specializations) {
+			if (versions[i].compile_task != WorkerThreadPool::INVALID_TASK_ID) {
+				return _get_pending_version(i);
+			}
+			return versions[i].pipeline;
+		}
+	}
+
+	// The fallback maps to itself, so this compiles synchronously.
+	return _generate_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+}
+
+void PipelineCacheRD::_replay_versions() {
+	if (!async_compilation_enabled || shader.is_null()) {
+		replay_versions.clear();
+		return;
+	}
+
+	spin_lock.lock();
+	for (const Version &version : replay_versions) {
+		_add_version_async(version.vertex_id, version.framebuffer_id, version.wireframe, version.render_pass, version.bool_specializations);
+	}
+	spin_lock.unlock();
+	replay_versions.clear();
+}
+
 void PipelineCacheRD::_clear() {
-	// TODO: Clear should probably recompile all the variants already compiled instead to avoid stalls? Needs discussion.
 	if (versions) {
+		// Pending tasks write into the versions and use the current shader, so they must be done before either changes.
+		for (uint32_t i = 0; i < version_count; i++) {
+			if (versions[i].compile_task != WorkerThreadPool::INVALID_TASK_ID) {
+				WorkerThreadPool::get_singleton()->wait_for_task_completion(versions[i].compile_task);
+				versions[i].compile_task = WorkerThreadPool::INVALID_TASK_ID;
+			}
+		}
+
 		for (uint32_t i = 0; i < version_count; i++) {
+			// Recompiled in the background by _replay_versions(), instead of stalling when they are requested again.
+			replay_versions.push_back(versions[i]);
 			//shader may be gone, so this may not be valid
 			if (RD::get_singleton()->render_pipeline_is_valid(versions[i].pipeline)) {
 				RD::get_singleton()->free(versions[i].pipeline);
@@ -97,10 +199,12 @@ void PipelineCacheRD::setup(RID p_shader, RD::RenderPrimitive p_primitive, const
 	blend_state = p_blend_state;
 	dynamic_state_flags = p_dynamic_state_flags;
 	base_specialization_constants = p_base_specialization_constants;
+	_replay_versions();
 }
 void PipelineCacheRD::update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants) {
-	base_specialization_constants = p_base_specialization_constants;
 	_clear();
+	base_specialization_constants = p_base_specialization_constants;
+	_replay_versions();
 }
 
 void PipelineCacheRD::update_shader(RID p_shader) {
@@ -109,8 +213,18 @@ void PipelineCacheRD::update_shader(RID p_shader) {
 	setup(p_shader, render_primitive, rasterization_state, multisample_state, depth_stencil_state, blend_state, dynamic_state_flags);
 }
 
+void PipelineCacheRD::set_fallback_specializations(uint32_t p_enable_mask, uint32_t p_disable_mask) {
+	fallback_specializations_enable = p_enable_mask;
+	fallback_specializations_disable = p_disable_mask;
+}
+
+void PipelineCacheRD::set_async_compilation_enabled(bool p_enabled) {
+	async_compilation_enabled = p_enabled;
+}
+
 void PipelineCacheRD::clear() {
 	_clear();
+	replay_versions.clear(); // Nothing to replay them with.
 	shader = RID(); //clear shader
 	input_mask = 0;
 }
@@ -123,4 +237,5 @@ PipelineCacheRD::PipelineCacheRD() {
 
 PipelineCacheRD::~PipelineCacheRD() {
 	_clear();
+	replay_versions.clear();
 }
@@ -31,7 +31,10 @@
 #ifndef PIPELINE_CACHE_RD_H
 #define PIPELINE_CACHE_RD_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/spin_lock.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/rendering/rendering_device.h"
 
 class PipelineCacheRD {
@@ -55,13 +58,35 @@ class PipelineCacheRD {
 		bool wireframe;
 		uint32_t bool_specializations;
 		RID pipeline;
+		WorkerThreadPool::TaskID compile_task;
 	};
 
 	Version *versions = nullptr;
 	uint32_t version_count;
 
+	// Specializations toggled on/off to obtain the generic (ubershader) variant that is drawn
+	// while the requested one is compiled in the background. If the result equals the requested
+	// specializations, the version is compiled synchronously.
+	uint32_t fallback_specializations_enable = 0;
+	uint32_t fallback_specializations_disable = 0;
+
+	// Versions that were compiled before the last clear, recompiled in the background after setup.
+	LocalVector<Version> replay_versions;
+
+	static bool async_compilation_enabled;
+	static SafeNumeric<uint64_t> sync_compilations;
+	static SafeNumeric<uint64_t> async_compilations;
+
+	RID _create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+	uint32_t _add_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations, RID p_pipeline);
+	uint32_t _add_version_async(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+	void _compile_version_task(uint32_t p_index);
+
 	RID _generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations = 0);
+	RID _get_pending_version(uint32_t p_index);
+	RID _get_fallback_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
 
+	void _replay_versions();
 	void _clear();
 
 public:
@@ -69,6 +94,10 @@ public:
 	void update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants);
 	void update_shader(RID p_shader);
 
+	// Allows versions to be compiled on the WorkerThreadPool, drawing with the variant obtained by
+	// applying these masks to the requested specializations until they are ready.
+	void set_fallback_specializations(uint32_t p_enable_mask, uint32_t p_disable_mask);
+
 	_FORCE_INLINE_ RID get_render_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe = false, uint32_t p_render_pass = 0, uint32_t p_bool_specializations = 0) {
 #ifdef DEBUG_ENABLED
 		ERR_FAIL_COND_V_MSG(shader.is_null(), RID(),
@@ -81,7 +110,11 @@ public:
 		RID result;
 		for (uint32_t i = 0; i < version_count; i++) {
 			if (versions[i].vertex_id == p_vertex_format_id && versions[i].framebuffer_id == p_framebuffer_format_id && versions[i].wireframe == p_wireframe && versions[i].render_pass == p_render_pass && versions[i].bool_specializations == p_bool_specializations) {
-				result = versions[i].pipeline;
+				if (unlikely(versions[i].compile_task != WorkerThreadPool::INVALID_TASK_ID)) {
+					result = _get_pending_version(i);
+				} else {
+					result = versions[i].pipeline;
+				}
 				spin_lock.unlock();
 				return result;
 			}
@@ -95,6 +128,12 @@ public:
 		return input_mask;
 	}
 	void clear();
+
+	static void set_async_compilation_enabled(bool p_enabled);
+	static bool is_async_compilation_enabled() { return async_compilation_enabled; }
+	static uint64_t get_sync_compilation_count() { return sync_compilations.get(); }
+	static uint64_t get_async_compilation_count() { return async_compilations.get(); }
+
 	PipelineCacheRD();
 	~PipelineCacheRD();
 };
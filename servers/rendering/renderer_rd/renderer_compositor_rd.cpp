@@ -99,6 +99,10 @@ void RendererCompositorRD::begin_frame(double frame_step) {
 
 	canvas->set_time(time);
 	scene->set_time(time, frame_step);
+
+	mesh_storage->update_frame_info();
+	texture_storage->update_texture_streaming();
+	mesh_storage->update_mesh_streaming();
 }
 
 void RendererCompositorRD::end_frame(bool p_swap_buffers) {
@@ -290,8 +294,18 @@ RendererCompositorRD::RendererCompositorRD() {
 				}
 			}
 		}
+
+		if (!Engine::get_singleton()->is_editor_hint()) {
+			// Shaders compiled by the editor and packed with the project (see ShaderCacheExportPlugin).
+			const String exported_cache_dir = "res://.godot/shader_cache";
+			if (DirAccess::dir_exists_absolute(exported_cache_dir)) {
+				ShaderRD::set_shader_cache_readonly_dir(exported_cache_dir);
+			}
+		}
 	}
 
+	PipelineCacheRD::set_async_compilation_enabled(GLOBAL_GET("rendering/shader_compiler/pipeline_compilation/async"));
+
 	singleton = this;
 
 	utilities = memnew(RendererRD::Utilities);
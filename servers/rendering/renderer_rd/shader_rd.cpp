@@ -384,9 +384,9 @@ String ShaderRD::_version_get_sha1(Version *p_version) const {
 static const char *shader_file_header = "GDSC";
 static const uint32_t cache_file_version = 2;
 
-bool ShaderRD::_load_from_cache(Version *p_version) {
+bool ShaderRD::_load_from_cache(Version *p_version, const String &p_cache_dir) {
 	String sha1 = _version_get_sha1(p_version);
-	String path = shader_cache_dir.path_join(name).path_join(base_sha256).path_join(sha1) + ".cache";
+	String path = p_cache_dir.path_join(name).path_join(base_sha256).path_join(sha1) + ".cache";
 
 	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
 	if (f.is_null()) {
@@ -431,7 +431,10 @@ bool ShaderRD::_load_from_cache(Version *p_version) {
 		RID shader = RD::get_singleton()->shader_create_from_bytecode(p_version->variant_data[i]);
 		if (shader.is_null()) {
 			for (uint32_t j = 0; j < i; j++) {
-				RD::get_singleton()->free(p_version->variants[i]);
+				if (p_version->variants[j].is_valid()) {
+					RD::get_singleton()->free(p_version->variants[j]);
+					p_version->variants[j] = RID();
+				}
 			}
 			ERR_FAIL_COND_V(shader.is_null(), false);
 		}
@@ -474,10 +477,16 @@ void ShaderRD::_compile_version(Version *p_version) {
 	typedef Vector<uint8_t> ShaderStageData;
 	p_version->variant_data = memnew_arr(ShaderStageData, variant_defines.size());
 
-	if (shader_cache_dir_valid) {
-		if (_load_from_cache(p_version)) {
+	if (shader_cache_hash_valid) {
+		if (shader_cache_dir_valid && _load_from_cache(p_version, shader_cache_dir)) {
+			shader_cache_hits.increment();
 			return;
 		}
+		if (!shader_cache_readonly_dir.is_empty() && _load_from_cache(p_version, shader_cache_readonly_dir)) {
+			shader_cache_hits.increment();
+			return;
+		}
+		shader_cache_misses.increment();
 	}
 
 #if 1
@@ -644,20 +653,28 @@ void ShaderRD::initialize(const Vector<String> &p_variant_defines, const String
 		variants_enabled.push_back(true);
 	}
 
-	if (!shader_cache_dir.is_empty()) {
+	if (!shader_cache_dir.is_empty() || !shader_cache_readonly_dir.is_empty()) {
 		StringBuilder hash_build;
 
 		hash_build.append("[base_hash]");
 		hash_build.append(base_sha256);
 		hash_build.append("[general_defines]");
 		hash_build.append(general_defines.get_data());
+		if (is_compute) {
+			// Depends on the GPU vendor, which matters for caches shipped with an exported project.
+			hash_build.append("[base_compute_defines]");
+			hash_build.append(base_compute_defines.get_data());
+		}
 		for (int i = 0; i < variant_defines.size(); i++) {
 			hash_build.append("[variant_defines:" + itos(i) + "]");
 			hash_build.append(variant_defines[i].get_data());
 		}
 
 		base_sha256 = hash_build.as_string().sha256_text();
+		shader_cache_hash_valid = true;
+	}
 
+	if (!shader_cache_dir.is_empty()) {
 		Ref<DirAccess> d = DirAccess::open(shader_cache_dir);
 		ERR_FAIL_COND(d.is_null());
 		if (d->change_dir(name) != OK) {
@@ -684,6 +701,10 @@ void ShaderRD::set_shader_cache_dir(const String &p_dir) {
 	shader_cache_dir = p_dir;
 }
 
+void ShaderRD::set_shader_cache_readonly_dir(const String &p_dir) {
+	shader_cache_readonly_dir = p_dir;
+}
+
 void ShaderRD::set_shader_cache_save_compressed(bool p_enable) {
 	shader_cache_save_compressed = p_enable;
 }
@@ -697,6 +718,9 @@ void ShaderRD::set_shader_cache_save_debug(bool p_enable) {
 }
 
 String ShaderRD::shader_cache_dir;
+String ShaderRD::shader_cache_readonly_dir;
+SafeNumeric<uint64_t> ShaderRD::shader_cache_hits;
+SafeNumeric<uint64_t> ShaderRD::shader_cache_misses;
 bool ShaderRD::shader_cache_save_compressed = true;
 bool ShaderRD::shader_cache_save_compressed_zstd = true;
 bool ShaderRD::shader_cache_save_debug = true;
@@ -37,6 +37,7 @@
 #include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/rid_owner.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 #include "servers/rendering_server.h"
 
@@ -99,11 +100,16 @@ class ShaderRD {
 	String base_sha256;
 
 	static String shader_cache_dir;
+	// Cache shipped with an exported project (see ShaderCacheExportPlugin), only read from.
+	static String shader_cache_readonly_dir;
+	static SafeNumeric<uint64_t> shader_cache_hits;
+	static SafeNumeric<uint64_t> shader_cache_misses;
 	static bool shader_cache_cleanup_on_start;
 	static bool shader_cache_save_compressed;
 	static bool shader_cache_save_compressed_zstd;
 	static bool shader_cache_save_debug;
 	bool shader_cache_dir_valid = false;
+	bool shader_cache_hash_valid = false;
 
 	enum StageType {
 		STAGE_TYPE_VERTEX,
@@ -119,7 +125,7 @@ class ShaderRD {
 	void _add_stage(const char *p_code, StageType p_stage_type);
 
 	String _version_get_sha1(Version *p_version) const;
-	bool _load_from_cache(Version *p_version);
+	bool _load_from_cache(Version *p_version, const String &p_cache_dir);
 	void _save_to_cache(Version *p_version);
 
 protected:
@@ -158,6 +164,9 @@ public:
 	bool is_variant_enabled(int p_variant) const;
 
 	static void set_shader_cache_dir(const String &p_dir);
+	static void set_shader_cache_readonly_dir(const String &p_dir);
+	static uint64_t get_shader_cache_hits() { return shader_cache_hits.get(); }
+	static uint64_t get_shader_cache_misses() { return shader_cache_misses.get(); }
 	static void set_shader_cache_save_compressed(bool p_enable);
 	static void set_shader_cache_save_compressed_zstd(bool p_enable);
 	static void set_shader_cache_save_debug(bool p_enable);
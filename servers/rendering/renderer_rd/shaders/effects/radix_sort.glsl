@@ -0,0 +1,193 @@
+#[compute]
+
+#version 450
+
+#VERSION_DEFINES
+
+// Stable least significant digit radix sort of (key, value) pairs by key, 8 bits per pass.
+// Each pass counts the digits per block, scans the counts into global offsets,
+// and scatters the elements of each block to their offsets, keeping their order.
+
+#define RADIX_SIZE 256
+#define NUM_THREADS 256
+#define TILES_PER_BLOCK 8
+#define BLOCK_SIZE (NUM_THREADS * TILES_PER_BLOCK)
+#define MASK_WORDS (NUM_THREADS / 32)
+
+layout(local_size_x = NUM_THREADS, local_size_y = 1, local_size_z = 1) in;
+
+#ifndef MODE_SCAN
+
+layout(set = 0, binding = 0, std430) restrict readonly buffer SourceBuffer {
+	vec2 data[];
+}
+src_buffer;
+
+#endif
+
+#ifdef MODE_SCATTER
+
+layout(set = 0, binding = 1, std430) restrict writeonly buffer DestBuffer {
+	vec2 data[];
+}
+dst_buffer;
+
+#endif
+
+// Per block, RADIX_SIZE digit counts, then offsets after MODE_SCAN.
+layout(set = 0, binding = 2, std430) restrict buffer Histograms {
+	uint data[];
+}
+histograms;
+
+layout(push_constant, std430) uniform Params {
+	uint total_elements;
+	uint block_count;
+	uint shift;
+	uint pad;
+}
+params;
+
+#ifdef MODE_COUNT
+
+shared uint local_histogram[RADIX_SIZE];
+
+#endif
+
+#ifdef MODE_SCAN
+
+shared uint digit_offsets[RADIX_SIZE];
+
+#endif
+
+#ifdef MODE_SCATTER
+
+shared uint tile_masks[RADIX_SIZE * MASK_WORDS];
+shared uint digit_offsets[RADIX_SIZE];
+
+#endif
+
+#ifndef MODE_SCAN
+
+uint get_digit(float p_key) {
+	// Map the float to an uint with the same order: flip all the bits of negative numbers, and the sign bit of positive ones.
+	uint bits = floatBitsToUint(p_key);
+	bits ^= (bits & 0x80000000u) != 0 ? 0xFFFFFFFFu : 0x80000000u;
+	return (bits >> params.shift) & (RADIX_SIZE - 1);
+}
+
+#endif
+
+void main() {
+	uint lid = gl_LocalInvocationIndex;
+
+#ifdef MODE_COUNT
+
+	uint base = gl_WorkGroupID.x * BLOCK_SIZE;
+
+	local_histogram[lid] = 0;
+
+	groupMemoryBarrier();
+	barrier();
+
+	for (uint i = 0; i < TILES_PER_BLOCK; i++) {
+		uint index = base + i * NUM_THREADS + lid;
+		if (index < params.total_elements) {
+			atomicAdd(local_histogram[get_digit(src_buffer.data[index].x)], 1);
+		}
+	}
+
+	groupMemoryBarrier();
+	barrier();
+
+	histograms.data[gl_WorkGroupID.x * RADIX_SIZE + lid] = local_histogram[lid];
+
+#endif
+
+#ifdef MODE_SCAN
+
+	// Dispatched as a single group, each thread handles one digit.
+
+	uint digit_total = 0;
+	for (uint i = 0; i < params.block_count; i++) {
+		uint count = histograms.data[i * RADIX_SIZE + lid];
+		histograms.data[i * RADIX_SIZE + lid] = digit_total;
+		digit_total += count;
+	}
+
+	digit_offsets[lid] = digit_total;
+
+	groupMemoryBarrier();
+	barrier();
+
+	for (uint offset = 1; offset < RADIX_SIZE; offset <<= 1) {
+		uint value = lid >= offset ? digit_offsets[lid - offset] : 0;
+		groupMemoryBarrier();
+		barrier();
+		digit_offsets[lid] += value;
+		groupMemoryBarrier();
+		barrier();
+	}
+
+	uint digit_base = digit_offsets[lid] - digit_total; // Inclusive to exclusive.
+	for (uint i = 0; i < params.block_count; i++) {
+		histograms.data[i * RADIX_SIZE + lid] += digit_base;
+	}
+
+#endif
+
+#ifdef MODE_SCATTER
+
+	uint base = gl_WorkGroupID.x * BLOCK_SIZE;
+
+	digit_offsets[lid] = histograms.data[gl_WorkGroupID.x * RADIX_SIZE + lid];
+
+	for (uint tile = 0; tile < TILES_PER_BLOCK; tile++) {
+		for (uint i = 0; i < MASK_WORDS; i++) {
+			tile_masks[lid * MASK_WORDS + i] = 0;
+		}
+
+		groupMemoryBarrier();
+		barrier();
+
+		uint index = base + tile * NUM_THREADS + lid;
+		bool valid = index < params.total_elements;
+		vec2 element = vec2(0.0);
+		uint digit = 0;
+		uint word = lid / 32;
+
+		if (valid) {
+			element = src_buffer.data[index];
+			digit = get_digit(element.x);
+			atomicOr(tile_masks[digit * MASK_WORDS + word], 1u << (lid % 32));
+		}
+
+		groupMemoryBarrier();
+		barrier();
+
+		if (valid) {
+			// The rank within the tile is the amount of threads before this one with the same digit.
+			uint rank = 0;
+			for (uint i = 0; i < word; i++) {
+				rank += uint(bitCount(tile_masks[digit * MASK_WORDS + i]));
+			}
+			rank += uint(bitCount(tile_masks[digit * MASK_WORDS + word] & ((1u << (lid % 32)) - 1u)));
+
+			dst_buffer.data[digit_offsets[digit] + rank] = element;
+		}
+
+		groupMemoryBarrier();
+		barrier();
+
+		uint tile_count = 0;
+		for (uint i = 0; i < MASK_WORDS; i++) {
+			tile_count += uint(bitCount(tile_masks[lid * MASK_WORDS + i]));
+		}
+		digit_offsets[lid] += tile_count;
+
+		groupMemoryBarrier();
+		barrier();
+	}
+
+#endif
+}
@@ -485,6 +485,7 @@ layout(constant_id = 12) const bool sc_disable_directional_lights = false;
 layout(constant_id = 7) const bool sc_decal_use_mipmaps = true;
 layout(constant_id = 13) const bool sc_disable_decals = false;
 layout(constant_id = 14) const bool sc_disable_fog = false;
+layout(constant_id = 16) const bool sc_use_clustered_lighting = false;
 
 #endif //!MODE_RENDER_DEPTH
 
@@ -659,6 +660,73 @@ vec4 fog_process(vec3 vertex) {
 	return vec4(fog_color, fog_amount);
 }
 
+// Iterates over the decals, reflection probes or lights of one type affecting the fragment, either from the
+// per instance lists in the push constant, or from the clusters when using clustered lighting.
+struct ElementIterator {
+	uvec2 instance_indices;
+	uint cluster_offset;
+	uint item_min;
+	uint item_max;
+	uint word;
+	uint word_to;
+	uint mask;
+};
+
+uint cluster_get_range_clip_mask(uint i, uint z_min, uint z_max) {
+	int local_min = clamp(int(z_min) - int(i) * 32, 0, 31);
+	int mask_width = min(int(z_max) - int(z_min), 32 - local_min);
+	return bitfieldInsert(uint(0), uint(0xFFFFFFFF), local_min, mask_width);
+}
+
+ElementIterator element_iterator_create(uvec2 p_instance_indices, uint p_cluster_offset, uint p_cluster_z) {
+	ElementIterator it;
+	it.instance_indices = p_instance_indices;
+	it.cluster_offset = p_cluster_offset;
+	it.item_min = 0;
+	it.item_max = 0;
+	it.word = 0;
+	it.word_to = 0;
+	it.mask = 0;
+
+	if (sc_use_clustered_lighting) {
+		uint item_min_max = cluster_buffer.data[p_cluster_offset + cluster_data.max_cluster_element_count_div_32 + p_cluster_z];
+		it.item_min = item_min_max & 0xFFFFu;
+		it.item_max = item_min_max >> 16;
+		it.word = it.item_min >> 5;
+		it.word_to = (it.item_max == 0) ? 0 : ((it.item_max - 1) >> 5) + 1; //side effect of how it is stored, as item_max 0 means no elements
+		if (it.word < it.word_to) {
+			it.mask = cluster_buffer.data[p_cluster_offset + it.word] & cluster_get_range_clip_mask(it.word, it.item_min, it.item_max);
+		}
+	}
+
+	return it;
+}
+
+bool element_iterator_next(inout ElementIterator it, out uint r_index) {
+	if (sc_use_clustered_lighting) {
+		while (it.mask == 0) {
+			it.word++;
+			if (it.word >= it.word_to) {
+				return false;
+			}
+			it.mask = cluster_buffer.data[it.cluster_offset + it.word] & cluster_get_range_clip_mask(it.word, it.item_min, it.item_max);
+		}
+
+		uint bit = findMSB(it.mask);
+		it.mask &= ~(1u << bit);
+		r_index = 32 * it.word + bit;
+		return true;
+	}
+
+	// Up to 8 packed 8 bit indices, 0xFF ends the list.
+	if (it.word >= 8) {
+		return false;
+	}
+	r_index = ((it.word < 4 ? it.instance_indices.x : it.instance_indices.y) >> ((it.word & 0x3) << 3)) & 0xFF;
+	it.word++;
+	return r_index != 0xFF;
+}
+
 #endif //!MODE_RENDER DEPTH
 
 #define scene_data scene_data_block.data
@@ -879,20 +947,17 @@ void main() {
 	vec3 vertex_ddx = dFdx(vertex);
 	vec3 vertex_ddy = dFdy(vertex);
 
-	if (!sc_disable_decals) { //Decals
-		// must implement
-
-		uint decal_indices = draw_call.decals.x;
-		for (uint i = 0; i < 8; i++) {
-			uint decal_index = decal_indices & 0xFF;
-			if (i == 3) {
-				decal_indices = draw_call.decals.y;
-			} else {
-				decal_indices = decal_indices >> 8;
-			}
+	// Only used with clustered lighting.
+	uvec2 cluster_pos = uvec2(gl_FragCoord.xy) >> cluster_data.cluster_shift;
+	uint cluster_offset = (cluster_data.cluster_width * cluster_pos.y + cluster_pos.x) * (cluster_data.max_cluster_element_count_div_32 + 32);
+	uint cluster_z = uint(clamp((-vertex.z / scene_data.z_far) * 32.0, 0.0, 31.0));
 
-			if (decal_index == 0xFF) {
-				break;
+	if (!sc_disable_decals) { //Decals
+		ElementIterator decal_iterator = element_iterator_create(draw_call.decals, cluster_offset + cluster_data.cluster_type_size * 2, cluster_z);
+		uint decal_index;
+		while (element_iterator_next(decal_iterator, decal_index)) {
+			if (sc_use_clustered_lighting && !bool(decals.data[decal_index].mask & draw_call.layer_mask)) {
+				continue; //not masked
 			}
 
 			vec3 uv_local = (decals.data[decal_index].xform * vec4(vertex, 1.0)).xyz;
@@ -1151,8 +1216,6 @@ void main() {
 		vec4 reflection_accum = vec4(0.0, 0.0, 0.0, 0.0);
 		vec4 ambient_accum = vec4(0.0, 0.0, 0.0, 0.0);
 
-		uint reflection_indices = draw_call.reflection_probes.x;
-
 #ifdef LIGHT_ANISOTROPY_USED
 		// https://google.github.io/filament/Filament.html#lighting/imagebasedlights/anisotropy
 		vec3 anisotropic_direction = anisotropy >= 0.0 ? binormal : tangent;
@@ -1165,16 +1228,11 @@ void main() {
 		vec3 ref_vec = normalize(reflect(-view, bent_normal));
 		ref_vec = mix(ref_vec, bent_normal, roughness * roughness);
 
-		for (uint i = 0; i < 8; i++) {
-			uint reflection_index = reflection_indices & 0xFF;
-			if (i == 3) {
-				reflection_indices = draw_call.reflection_probes.y;
-			} else {
-				reflection_indices = reflection_indices >> 8;
-			}
-
-			if (reflection_index == 0xFF) {
-				break;
+		ElementIterator reflection_iterator = element_iterator_create(draw_call.reflection_probes, cluster_offset + cluster_data.cluster_type_size * 3, cluster_z);
+		uint reflection_index;
+		while (element_iterator_next(reflection_iterator, reflection_index)) {
+			if (sc_use_clustered_lighting && !bool(reflections.data[reflection_index].mask & draw_call.layer_mask)) {
+				continue; //not masked
 			}
 
 			reflection_process(reflection_index, vertex, ref_vec, bent_normal, roughness, ambient_light, specular_light, ambient_accum, reflection_accum);
@@ -1590,17 +1648,17 @@ void main() {
 	} //directional light
 
 	if (!sc_disable_omni_lights) { //omni lights
-		uint light_indices = draw_call.omni_lights.x;
-		for (uint i = 0; i < 8; i++) {
-			uint light_index = light_indices & 0xFF;
-			if (i == 3) {
-				light_indices = draw_call.omni_lights.y;
-			} else {
-				light_indices = light_indices >> 8;
-			}
+		ElementIterator light_iterator = element_iterator_create(draw_call.omni_lights, cluster_offset, cluster_z);
+		uint light_index;
+		while (element_iterator_next(light_iterator, light_index)) {
+			if (sc_use_clustered_lighting) {
+				if (!bool(omni_lights.data[light_index].mask & draw_call.layer_mask)) {
+					continue; //not masked
+				}
 
-			if (light_index == 0xFF) {
-				break;
+				if (omni_lights.data[light_index].bake_mode == LIGHT_BAKE_STATIC && bool(draw_call.flags & INSTANCE_FLAGS_USE_LIGHTMAP)) {
+					continue; // Statically baked light and object uses lightmap, skip
+				}
 			}
 
 			float shadow = light_process_omni_shadow(light_index, vertex, normal);
@@ -1635,17 +1693,17 @@ void main() {
 
 	if (!sc_disable_spot_lights) { //spot lights
 
-		uint light_indices = draw_call.spot_lights.x;
-		for (uint i = 0; i < 8; i++) {
-			uint light_index = light_indices & 0xFF;
-			if (i == 3) {
-				light_indices = draw_call.spot_lights.y;
-			} else {
-				light_indices = light_indices >> 8;
-			}
+		ElementIterator light_iterator = element_iterator_create(draw_call.spot_lights, cluster_offset + cluster_data.cluster_type_size, cluster_z);
+		uint light_index;
+		while (element_iterator_next(light_iterator, light_index)) {
+			if (sc_use_clustered_lighting) {
+				if (!bool(spot_lights.data[light_index].mask & draw_call.layer_mask)) {
+					continue; //not masked
+				}
 
-			if (light_index == 0xFF) {
-				break;
+				if (spot_lights.data[light_index].bake_mode == LIGHT_BAKE_STATIC && bool(draw_call.flags & INSTANCE_FLAGS_USE_LIGHTMAP)) {
+					continue; // Statically baked light and object uses lightmap, skip
+				}
 			}
 
 			float shadow = light_process_spot_shadow(light_index, vertex, normal);
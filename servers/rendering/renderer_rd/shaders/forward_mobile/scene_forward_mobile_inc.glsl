@@ -165,6 +165,20 @@ layout(set = 1, binding = 10) uniform mediump texture2D color_buffer;
 #define multiviewSampler sampler2D
 #endif // USE_MULTIVIEW
 
+// Only used with clustered lighting.
+layout(set = 1, binding = 8, std430) buffer restrict readonly ClusterBuffer {
+	uint data[];
+}
+cluster_buffer;
+
+layout(set = 1, binding = 11, std140) uniform ClusterDataBlock {
+	uint cluster_shift;
+	uint cluster_width;
+	uint cluster_type_size;
+	uint max_cluster_element_count_div_32;
+}
+cluster_data;
+
 /* Set 2 Skeleton & Instancing (can change per item) */
 
 layout(set = 2, binding = 0, std430) restrict readonly buffer Transforms {
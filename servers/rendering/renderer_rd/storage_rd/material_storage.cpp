@@ -764,6 +764,7 @@ void MaterialStorage::MaterialData::update_textures(const HashMap<StringName, Va
 
 	bool uses_global_textures = false;
 	global_textures_pass++;
+	streamed_textures.clear();
 
 	for (int i = 0, k = 0; i < p_texture_uniforms.size(); i++) {
 		const StringName &uniform_name = p_texture_uniforms[i].name;
@@ -917,6 +918,9 @@ void MaterialStorage::MaterialData::update_textures(const HashMap<StringName, Va
 
 				if (tex) {
 					rd_texture = (srgb && tex->rd_texture_srgb.is_valid()) ? tex->rd_texture_srgb : tex->rd_texture;
+					if (tex->streaming_callback) {
+						streamed_textures.push_back(textures[j]);
+					}
 #ifdef TOOLS_ENABLED
 					if (tex->detect_3d_callback && p_use_linear_color) {
 						tex->detect_3d_callback(tex->detect_3d_callback_ud);
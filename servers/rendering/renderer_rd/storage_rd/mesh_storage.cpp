@@ -30,6 +30,8 @@
 
 #include "mesh_storage.h"
 #include "../../rendering_server_globals.h"
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
 
 using namespace RendererRD;
 
@@ -42,6 +44,9 @@ MeshStorage *MeshStorage::get_singleton() {
 MeshStorage::MeshStorage() {
 	singleton = this;
 
+	mesh_streaming_enabled = !Engine::get_singleton()->is_editor_hint() && GLOBAL_GET("rendering/mesh_lod/streaming/enabled");
+	mesh_streaming_memory_budget = uint64_t(int(GLOBAL_GET("rendering/mesh_lod/streaming/memory_budget_mb"))) * 1024 * 1024;
+
 	default_rd_storage_buffer = RD::get_singleton()->storage_buffer_create(sizeof(uint32_t) * 4);
 
 	//default rd buffers
@@ -217,6 +222,10 @@ bool MeshStorage::free(RID p_rid) {
 
 /* MESH API */
 
+bool MeshStorage::can_create_resources_async() const {
+	return true;
+}
+
 RID MeshStorage::mesh_allocate() {
 	return mesh_owner.allocate_rid();
 }
@@ -368,21 +377,38 @@ void MeshStorage::mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_surface)
 	if (p_surface.index_count) {
 		bool is_index_16 = p_surface.vertex_count <= 65536 && p_surface.vertex_count > 0;
 
-		s->index_buffer = RD::get_singleton()->index_buffer_create(p_surface.index_count, is_index_16 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32, p_surface.index_data, false);
+		s->index_16 = is_index_16;
 		s->index_count = p_surface.index_count;
-		s->index_array = RD::get_singleton()->index_array_create(s->index_buffer, 0, s->index_count);
+		s->streaming = mesh_streaming_enabled && p_surface.lods.size();
+		if (s->streaming) {
+			// Uploaded on demand by update_mesh_streaming().
+			s->index_data = p_surface.index_data;
+		} else {
+			s->index_buffer = RD::get_singleton()->index_buffer_create(p_surface.index_count, is_index_16 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32, p_surface.index_data, false);
+			s->index_array = RD::get_singleton()->index_array_create(s->index_buffer, 0, s->index_count);
+		}
 		if (p_surface.lods.size()) {
 			s->lods = memnew_arr(Mesh::Surface::LOD, p_surface.lods.size());
 			s->lod_count = p_surface.lods.size();
 
 			for (int i = 0; i < p_surface.lods.size(); i++) {
 				uint32_t indices = p_surface.lods[i].index_data.size() / (is_index_16 ? 2 : 4);
-				s->lods[i].index_buffer = RD::get_singleton()->index_buffer_create(indices, is_index_16 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32, p_surface.lods[i].index_data);
-				s->lods[i].index_array = RD::get_singleton()->index_array_create(s->lods[i].index_buffer, 0, indices);
 				s->lods[i].edge_length = p_surface.lods[i].edge_length;
 				s->lods[i].index_count = indices;
+				if (s->streaming && uint32_t(i) + 1 < s->lod_count) {
+					s->lods[i].index_data = p_surface.lods[i].index_data;
+				} else {
+					s->lods[i].index_buffer = RD::get_singleton()->index_buffer_create(indices, is_index_16 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32, p_surface.lods[i].index_data);
+					s->lods[i].index_array = RD::get_singleton()->index_array_create(s->lods[i].index_buffer, 0, indices);
+				}
 			}
 		}
+
+		if (s->streaming) {
+			s->streaming_resident_lod = s->lod_count;
+			s->streaming_wanted_lod = s->lod_count;
+			mesh_streaming_surfaces.add(&s->streaming_list);
+		}
 	}
 
 	ERR_FAIL_COND_MSG(!p_surface.index_count && !p_surface.vertex_count, "Meshes must contain a vertex array, an index array, or both");
@@ -558,13 +584,21 @@ RS::SurfaceData MeshStorage::mesh_get_surface(RID p_mesh, int p_surface) const {
 	sd.primitive = s.primitive;
 
 	if (sd.index_count) {
-		sd.index_data = RD::get_singleton()->buffer_get_data(s.index_buffer);
+		if (s.streaming) {
+			sd.index_data = s.index_data;
+		} else {
+			sd.index_data = RD::get_singleton()->buffer_get_data(s.index_buffer);
+		}
 	}
 	sd.aabb = s.aabb;
 	for (uint32_t i = 0; i < s.lod_count; i++) {
 		RS::SurfaceData::LOD lod;
 		lod.edge_length = s.lods[i].edge_length;
-		lod.index_data = RD::get_singleton()->buffer_get_data(s.lods[i].index_buffer);
+		if (s.streaming && i + 1 < s.lod_count) {
+			lod.index_data = s.lods[i].index_data;
+		} else {
+			lod.index_data = RD::get_singleton()->buffer_get_data(s.lods[i].index_buffer);
+		}
 		sd.lods.push_back(lod);
 	}
 
@@ -752,9 +786,18 @@ void MeshStorage::mesh_clear(RID p_mesh) {
 			RD::get_singleton()->free(s.index_buffer);
 		}
 
+		if (s.streaming) {
+			for (uint32_t j = s.streaming_resident_lod; j < s.lod_count; j++) {
+				mesh_streaming_memory_used -= _mesh_surface_get_lod_index_count(&s, j) * (s.index_16 ? 2 : 4);
+			}
+			mesh_streaming_surfaces.remove(&s.streaming_list);
+		}
+
 		if (s.lod_count) {
 			for (uint32_t j = 0; j < s.lod_count; j++) {
-				RD::get_singleton()->free(s.lods[j].index_buffer);
+				if (s.lods[j].index_buffer.is_valid()) {
+					RD::get_singleton()->free(s.lods[j].index_buffer);
+				}
 			}
 			memdelete_arr(s.lods);
 		}
@@ -955,12 +998,24 @@ void MeshStorage::update_mesh_instances() {
 		return; //nothing to do
 	}
 
+	// Group the instances by mesh, so instances sharing a mesh (and often a skeleton) are dispatched back to back
+	// and only the per-instance state has to be rebound between them.
+	mesh_instance_update_list.clear();
+	while (dirty_mesh_instance_arrays.first()) {
+		MeshInstance *mi = dirty_mesh_instance_arrays.first()->self();
+		mesh_instance_update_list.push_back(mi);
+		dirty_mesh_instance_arrays.remove(&mi->array_update_list);
+	}
+	mesh_instance_update_list.sort_custom<MeshInstanceSort>();
+
 	//process skeletons and blend shapes
 	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
 
-	while (dirty_mesh_instance_arrays.first()) {
-		MeshInstance *mi = dirty_mesh_instance_arrays.first()->self();
+	RID bound_pipeline;
+	RID bound_surface_uniform_set;
+	RID bound_skeleton_uniform_set;
 
+	for (MeshInstance *mi : mesh_instance_update_list) {
 		Skeleton *sk = skeleton_owner.get_or_null(mi->skeleton);
 
 		for (uint32_t i = 0; i < mi->surfaces.size(); i++) {
@@ -970,14 +1025,24 @@ void MeshStorage::update_mesh_instances() {
 
 			bool array_is_2d = mi->mesh->surfaces[i]->format & RS::ARRAY_FLAG_USE_2D_VERTICES;
 
-			RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, skeleton_shader.pipeline[array_is_2d ? SkeletonShader::SHADER_MODE_2D : SkeletonShader::SHADER_MODE_3D]);
+			RID pipeline = skeleton_shader.pipeline[array_is_2d ? SkeletonShader::SHADER_MODE_2D : SkeletonShader::SHADER_MODE_3D];
+			if (pipeline != bound_pipeline) {
+				RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, pipeline);
+				bound_pipeline = pipeline;
+				// Binding a pipeline may invalidate the bound sets.
+				bound_surface_uniform_set = RID();
+				bound_skeleton_uniform_set = RID();
+			}
 
 			RD::get_singleton()->compute_list_bind_uniform_set(compute_list, mi->surfaces[i].uniform_set, SkeletonShader::UNIFORM_SET_INSTANCE);
-			RD::get_singleton()->compute_list_bind_uniform_set(compute_list, mi->mesh->surfaces[i]->uniform_set, SkeletonShader::UNIFORM_SET_SURFACE);
-			if (sk && sk->uniform_set_mi.is_valid()) {
-				RD::get_singleton()->compute_list_bind_uniform_set(compute_list, sk->uniform_set_mi, SkeletonShader::UNIFORM_SET_SKELETON);
-			} else {
-				RD::get_singleton()->compute_list_bind_uniform_set(compute_list, skeleton_shader.default_skeleton_uniform_set, SkeletonShader::UNIFORM_SET_SKELETON);
+			if (mi->mesh->surfaces[i]->uniform_set != bound_surface_uniform_set) {
+				RD::get_singleton()->compute_list_bind_uniform_set(compute_list, mi->mesh->surfaces[i]->uniform_set, SkeletonShader::UNIFORM_SET_SURFACE);
+				bound_surface_uniform_set = mi->mesh->surfaces[i]->uniform_set;
+			}
+			RID skeleton_uniform_set = (sk && sk->uniform_set_mi.is_valid()) ? sk->uniform_set_mi : skeleton_shader.default_skeleton_uniform_set;
+			if (skeleton_uniform_set != bound_skeleton_uniform_set) {
+				RD::get_singleton()->compute_list_bind_uniform_set(compute_list, skeleton_uniform_set, SkeletonShader::UNIFORM_SET_SKELETON);
+				bound_skeleton_uniform_set = skeleton_uniform_set;
 			}
 
 			SkeletonShader::PushConstant push_constant;
@@ -1020,18 +1085,124 @@ void MeshStorage::update_mesh_instances() {
 
 			//dispatch without barrier, so all is done at the same time
 			RD::get_singleton()->compute_list_dispatch_threads(compute_list, push_constant.vertex_count, 1, 1);
+			skinned_vertices += push_constant.vertex_count;
 		}
 
 		mi->dirty = false;
 		if (sk) {
 			mi->skeleton_version = sk->version;
 		}
-		dirty_mesh_instance_arrays.remove(&mi->array_update_list);
 	}
 
 	RD::get_singleton()->compute_list_end();
 }
 
+void MeshStorage::update_frame_info() {
+	skinned_vertices_in_frame = skinned_vertices;
+	skinned_vertices = 0;
+}
+
+void MeshStorage::_mesh_surface_streaming_upload_lod(Mesh::Surface *s, uint32_t p_lod) {
+	const Vector<uint8_t> &data = p_lod == 0 ? s->index_data : s->lods[p_lod - 1].index_data;
+	uint32_t indices = _mesh_surface_get_lod_index_count(s, p_lod);
+
+	RID index_buffer = RD::get_singleton()->index_buffer_create(indices, s->index_16 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32, data);
+	RID index_array = RD::get_singleton()->index_array_create(index_buffer, 0, indices);
+	if (p_lod == 0) {
+		s->index_buffer = index_buffer;
+		s->index_array = index_array;
+	} else {
+		s->lods[p_lod - 1].index_buffer = index_buffer;
+		s->lods[p_lod - 1].index_array = index_array;
+	}
+
+	s->streaming_resident_lod = p_lod;
+	mesh_streaming_memory_used += data.size();
+}
+
+void MeshStorage::_mesh_surface_streaming_drop_lod(Mesh::Surface *s) {
+	uint32_t lod = s->streaming_resident_lod;
+	ERR_FAIL_COND(lod >= s->lod_count);
+
+	RID &index_buffer = lod == 0 ? s->index_buffer : s->lods[lod - 1].index_buffer;
+	RID &index_array = lod == 0 ? s->index_array : s->lods[lod - 1].index_array;
+	RD::get_singleton()->free(index_buffer); // Frees the index array as a dependency.
+	index_buffer = RID();
+	index_array = RID();
+
+	s->streaming_resident_lod = lod + 1;
+	mesh_streaming_memory_used -= _mesh_surface_get_lod_index_count(s, lod) * (s->index_16 ? 2 : 4);
+}
+
+void MeshStorage::update_mesh_streaming() {
+	if (!mesh_streaming_enabled) {
+		return;
+	}
+
+	mesh_streaming_frame++;
+
+	LocalVector<Mesh::Surface *> pending; // Need finer LODs than the resident ones.
+	LocalVector<Mesh::Surface *> evictable; // Have finer LODs than needed, or were not rendered.
+
+	SelfList<Mesh::Surface> *E = mesh_streaming_surfaces.first();
+	while (E) {
+		Mesh::Surface *s = E->self();
+
+		uint32_t requested = s->streaming_requested_detail.get();
+		s->streaming_requested_detail.set(0);
+		if (requested) {
+			s->streaming_wanted_lod = s->lod_count + 1 - requested;
+			s->streaming_last_used_frame = mesh_streaming_frame;
+		} else {
+			s->streaming_wanted_lod = s->lod_count;
+		}
+
+		if (s->streaming_resident_lod > s->streaming_wanted_lod) {
+			pending.push_back(s);
+		} else if (s->streaming_resident_lod < s->streaming_wanted_lod) {
+			evictable.push_back(s);
+		}
+
+		E = E->next();
+	}
+
+	if (pending.is_empty()) {
+		return;
+	}
+
+	// LODs are only dropped to make room for the ones needed, least recently used first.
+	evictable.sort_custom<MeshStreamingLRUSort>();
+	uint32_t evict_from = 0;
+
+	uint64_t uploaded = 0;
+	for (Mesh::Surface *s : pending) {
+		while (s->streaming_resident_lod > s->streaming_wanted_lod) {
+			uint32_t lod = s->streaming_resident_lod - 1;
+			uint64_t size = _mesh_surface_get_lod_index_count(s, lod) * (s->index_16 ? 2 : 4);
+
+			if (uploaded > 0 && uploaded + size > MESH_STREAMING_UPLOAD_LIMIT) {
+				return; // Continue next frame.
+			}
+
+			if (mesh_streaming_memory_budget > 0) {
+				while (mesh_streaming_memory_used + size > mesh_streaming_memory_budget && evict_from < evictable.size()) {
+					Mesh::Surface *victim = evictable[evict_from];
+					_mesh_surface_streaming_drop_lod(victim);
+					if (victim->streaming_resident_lod >= victim->streaming_wanted_lod) {
+						evict_from++;
+					}
+				}
+				if (mesh_streaming_memory_used + size > mesh_streaming_memory_budget) {
+					return; // Budget is full, keep rendering with the resident LODs.
+				}
+			}
+
+			_mesh_surface_streaming_upload_lod(s, lod);
+			uploaded += size;
+		}
+	}
+}
+
 void MeshStorage::_mesh_surface_generate_version_for_input_mask(Mesh::Surface::Version &v, Mesh::Surface *s, uint32_t p_input_mask, MeshInstance::Surface *mis) {
 	Vector<RD::VertexAttribute> attributes;
 	Vector<RID> buffers;
@@ -1954,6 +2125,7 @@ void MeshStorage::skeleton_allocate_data(RID p_skeleton, int p_bones, bool p_2d_
 		RD::get_singleton()->free(skeleton->buffer);
 		skeleton->buffer = RID();
 		skeleton->data.clear();
+		skeleton->uploaded_data.clear();
 		skeleton->uniform_set_mi = RID();
 	}
 
@@ -2092,19 +2264,29 @@ void MeshStorage::skeleton_set_base_transform_2d(RID p_skeleton, const Transform
 void MeshStorage::_update_dirty_skeletons() {
 	while (skeleton_dirty_list) {
 		Skeleton *skeleton = skeleton_dirty_list;
+		skeleton_dirty_list = skeleton->dirty_list;
+		skeleton->dirty = false;
+		skeleton->dirty_list = nullptr;
+
+		// Animations commonly set every bone each frame, even when the pose doesn't change (e.g. paused or
+		// finished animations). Keep the version in that case, so the mesh instances using it are not skinned again.
+		// If no bone was written, both vectors still share the same memory.
+		bool pose_changed = skeleton->data.size() != skeleton->uploaded_data.size();
+		if (!pose_changed && skeleton->data.ptr() != skeleton->uploaded_data.ptr()) {
+			pose_changed = memcmp(skeleton->data.ptr(), skeleton->uploaded_data.ptr(), skeleton->data.size() * sizeof(float)) != 0;
+		}
+		if (!pose_changed) {
+			continue;
+		}
 
 		if (skeleton->size) {
 			RD::get_singleton()->buffer_update(skeleton->buffer, 0, skeleton->data.size() * sizeof(float), skeleton->data.ptr());
 		}
-
-		skeleton_dirty_list = skeleton->dirty_list;
+		skeleton->uploaded_data = skeleton->data;
 
 		skeleton->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_SKELETON_BONES);
 
 		skeleton->version++;
-
-		skeleton->dirty = false;
-		skeleton->dirty_list = nullptr;
 	}
 
 	skeleton_dirty_list = nullptr;
@@ -33,6 +33,7 @@
 
 #include "core/templates/local_vector.h"
 #include "core/templates/rid_owner.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "servers/rendering/renderer_rd/shaders/skeleton.glsl.gen.h"
 #include "servers/rendering/storage/mesh_storage.h"
@@ -107,11 +108,23 @@ private:
 				uint32_t index_count = 0;
 				RID index_buffer;
 				RID index_array;
+				Vector<uint8_t> index_data; // Only kept when streaming.
 			};
 
 			LOD *lods = nullptr;
 			uint32_t lod_count = 0;
 
+			// When streaming, only the coarsest LOD is uploaded at first, and the finer ones (including the full
+			// index array, LOD 0) are uploaded from the copies kept in system memory once the renderer needs them.
+			bool streaming = false;
+			bool index_16 = false;
+			Vector<uint8_t> index_data; // Only kept when streaming.
+			uint32_t streaming_resident_lod = 0; // Finest LOD in video memory, all the coarser ones are too.
+			SafeNumeric<uint32_t> streaming_requested_detail; // lod_count + 1 - finest LOD requested while rendering the frame, 0 if not rendered.
+			uint32_t streaming_wanted_lod = 0;
+			uint64_t streaming_last_used_frame = 0;
+			SelfList<Surface> streaming_list;
+
 			AABB aabb;
 
 			Vector<AABB> bone_aabbs;
@@ -130,6 +143,9 @@ private:
 			uint64_t particles_render_pass = 0;
 
 			RID uniform_set;
+
+			Surface() :
+					streaming_list(this) {}
 		};
 
 		uint32_t blend_shape_count = 0;
@@ -193,6 +209,39 @@ private:
 	SelfList<MeshInstance>::List dirty_mesh_instance_weights;
 	SelfList<MeshInstance>::List dirty_mesh_instance_arrays;
 
+	struct MeshInstanceSort {
+		_FORCE_INLINE_ bool operator()(const MeshInstance *p_a, const MeshInstance *p_b) const {
+			return p_a->mesh < p_b->mesh;
+		}
+	};
+	LocalVector<MeshInstance *> mesh_instance_update_list;
+
+	uint64_t skinned_vertices = 0;
+	uint64_t skinned_vertices_in_frame = 0;
+
+	/* Mesh streaming */
+
+	static constexpr uint64_t MESH_STREAMING_UPLOAD_LIMIT = 4 * 1024 * 1024; // Bytes uploaded per frame, at least one LOD is always uploaded.
+
+	bool mesh_streaming_enabled = false;
+	uint64_t mesh_streaming_memory_budget = 0;
+	uint64_t mesh_streaming_memory_used = 0; // Finer LODs of streamed surfaces only, the coarsest ones are always resident.
+	uint64_t mesh_streaming_frame = 0;
+	SelfList<Mesh::Surface>::List mesh_streaming_surfaces;
+
+	struct MeshStreamingLRUSort {
+		_FORCE_INLINE_ bool operator()(const Mesh::Surface *p_a, const Mesh::Surface *p_b) const {
+			return p_a->streaming_last_used_frame < p_b->streaming_last_used_frame;
+		}
+	};
+
+	_FORCE_INLINE_ static uint32_t _mesh_surface_get_lod_index_count(const Mesh::Surface *s, uint32_t p_lod) {
+		return p_lod == 0 ? s->index_count : s->lods[p_lod - 1].index_count;
+	}
+
+	void _mesh_surface_streaming_upload_lod(Mesh::Surface *s, uint32_t p_lod);
+	void _mesh_surface_streaming_drop_lod(Mesh::Surface *s);
+
 	/* MultiMesh */
 
 	struct MultiMesh {
@@ -291,6 +340,8 @@ private:
 		bool use_2d = false;
 		int size = 0;
 		Vector<float> data;
+		// Shares the data last uploaded to the buffer (copy on write), so unchanged poses can be detected.
+		Vector<float> uploaded_data;
 		RID buffer;
 
 		bool dirty = false;
@@ -325,6 +376,8 @@ public:
 
 	bool owns_mesh(RID p_rid) { return mesh_owner.owns(p_rid); };
 
+	virtual bool can_create_resources_async() const override;
+
 	virtual RID mesh_allocate() override;
 	virtual void mesh_initialize(RID p_mesh) override;
 	virtual void mesh_free(RID p_rid) override;
@@ -419,6 +472,16 @@ public:
 			}
 			current_lod = i;
 		}
+
+		if (unlikely(s->streaming)) {
+			// Request the LOD, but render with the finest one resident until it is uploaded.
+			uint32_t lod = current_lod + 1;
+			s->streaming_requested_detail.exchange_if_greater(s->lod_count + 1 - lod);
+			lod = MAX(lod, s->streaming_resident_lod);
+			r_index_count = _mesh_surface_get_lod_index_count(s, lod);
+			return lod;
+		}
+
 		if (current_lod == -1) {
 			return 0;
 		} else {
@@ -430,6 +493,12 @@ public:
 	_FORCE_INLINE_ RID mesh_surface_get_index_array(void *p_surface, uint32_t p_lod) const {
 		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
 
+		if (unlikely(s->streaming)) {
+			// Used without mesh_surface_get_lod() when automatic LOD is disabled, or to draw the mesh in 2D.
+			s->streaming_requested_detail.exchange_if_greater(s->lod_count + 1 - p_lod);
+			p_lod = MAX(p_lod, s->streaming_resident_lod);
+		}
+
 		if (p_lod == 0) {
 			return s->index_array;
 		} else {
@@ -561,6 +630,13 @@ public:
 	virtual void mesh_instance_set_canvas_item_transform(RID p_mesh_instance, const Transform2D &p_transform) override;
 	virtual void update_mesh_instances() override;
 
+	// Called once per frame, so get_skinned_vertices_in_frame() returns the count for the last full frame.
+	void update_frame_info();
+	uint64_t get_skinned_vertices_in_frame() const { return skinned_vertices_in_frame; }
+
+	// Called once per frame, uploads the mesh LODs requested while rendering the last frame.
+	void update_mesh_streaming();
+
 	/* MULTIMESH API */
 
 	bool owns_multimesh(RID p_rid) { return multimesh_owner.owns(p_rid); };
@@ -1251,7 +1251,11 @@ void ParticlesStorage::particles_set_view_axis(RID p_particles, const Vector3 &p
 		RD::get_singleton()->compute_list_dispatch_threads(compute_list, particles->amount, 1, 1);
 
 		RD::get_singleton()->compute_list_end();
-		sort_effects->sort_buffer(particles->particles_sort_uniform_set, particles->amount);
+		if (particles->amount >= SortEffects::RADIX_SORT_MIN_ELEMENTS) {
+			sort_effects->sort_buffer_radix(particles->particles_sort_buffer, particles->amount);
+		} else {
+			sort_effects->sort_buffer(particles->particles_sort_uniform_set, particles->amount);
+		}
 	}
 
 	if (particles->trails_enabled && particles->trail_bind_poses.size() > 1) {
@@ -660,6 +660,10 @@ bool TextureStorage::canvas_texture_get_uniform_set(RID p_texture, RS::CanvasIte
 		if (t->render_target) {
 			t->render_target->was_used = true;
 		}
+		if (t->streaming_callback) {
+			// There is no screen-space estimate for 2D, so request the full size.
+			texture_request_streaming_size(p_texture, MAX(t->width_2d, t->height_2d));
+		}
 	} else {
 		ct = canvas_texture_owner.get_or_null(p_texture);
 	}
@@ -776,6 +780,10 @@ void TextureStorage::texture_free(RID p_texture) {
 
 	decal_atlas_remove_texture(p_texture);
 
+	if (t->streaming_callback) {
+		streaming_textures.erase(p_texture);
+	}
+
 	for (int i = 0; i < t->proxies.size(); i++) {
 		Texture *p = texture_owner.get_or_null(t->proxies[i]);
 		ERR_CONTINUE(!p);
@@ -1352,9 +1360,21 @@ void TextureStorage::texture_replace(RID p_texture, RID p_by_texture) {
 	Vector<RID> proxies_to_update = tex->proxies;
 	Vector<RID> proxies_to_redirect = by_tex->proxies;
 
+	// Streamed textures are replaced whenever their mipmaps change, so keep the streaming state.
+	RS::TextureStreamingCallback streaming_callback = tex->streaming_callback;
+	void *streaming_callback_ud = tex->streaming_callback_ud;
+	int streaming_requested_size = tex->streaming_requested_size;
+	int streaming_reported_size = tex->streaming_reported_size;
+	uint32_t streaming_frames_below = tex->streaming_frames_below;
+
 	*tex = *by_tex;
 
 	tex->proxies = proxies_to_update; //restore proxies, so they can be updated
+	tex->streaming_callback = streaming_callback;
+	tex->streaming_callback_ud = streaming_callback_ud;
+	tex->streaming_requested_size = streaming_requested_size;
+	tex->streaming_reported_size = streaming_reported_size;
+	tex->streaming_frames_below = streaming_frames_below;
 
 	if (tex->canvas_texture) {
 		tex->canvas_texture->diffuse = p_texture; //update
@@ -1419,6 +1439,50 @@ void TextureStorage::texture_set_detect_roughness_callback(RID p_texture, RS::Te
 	tex->detect_roughness_callback = p_callback;
 }
 
+void TextureStorage::texture_set_streaming_callback(RID p_texture, RS::TextureStreamingCallback p_callback, void *p_userdata) {
+	Texture *tex = texture_owner.get_or_null(p_texture);
+	ERR_FAIL_COND(!tex);
+
+	tex->streaming_callback_ud = p_userdata;
+	tex->streaming_callback = p_callback;
+	tex->streaming_requested_size = 0;
+	tex->streaming_reported_size = 0;
+	tex->streaming_frames_below = 0;
+
+	if (p_callback) {
+		streaming_textures.insert(p_texture);
+	} else {
+		streaming_textures.erase(p_texture);
+	}
+}
+
+void TextureStorage::update_texture_streaming() {
+	for (const RID &E : streaming_textures) {
+		Texture *tex = texture_owner.get_or_null(E);
+		ERR_CONTINUE(!tex);
+
+		int requested = tex->streaming_requested_size;
+		tex->streaming_requested_size = 0;
+
+		if (requested > tex->streaming_reported_size) {
+			// Needed larger, report right away so the mipmaps can start loading.
+			tex->streaming_reported_size = requested;
+			tex->streaming_frames_below = 0;
+			tex->streaming_callback(tex->streaming_callback_ud, E, requested);
+		} else if (requested < tex->streaming_reported_size) {
+			// Needed smaller (or not at all), only report once it has been the case for a while to avoid reloading back and forth.
+			tex->streaming_frames_below++;
+			if (tex->streaming_frames_below >= TEXTURE_STREAMING_DOWNGRADE_FRAMES) {
+				tex->streaming_reported_size = requested;
+				tex->streaming_frames_below = 0;
+				tex->streaming_callback(tex->streaming_callback_ud, E, requested);
+			}
+		} else {
+			tex->streaming_frames_below = 0;
+		}
+	}
+}
+
 void TextureStorage::texture_debug_usage(List<RS::TextureInfo> *r_info) {
 }
 
@@ -167,6 +167,12 @@ private:
 		RS::TextureDetectRoughnessCallback detect_roughness_callback = nullptr;
 		void *detect_roughness_callback_ud = nullptr;
 
+		RS::TextureStreamingCallback streaming_callback = nullptr;
+		void *streaming_callback_ud = nullptr;
+		int streaming_requested_size = 0; // Largest size requested while rendering the current frame.
+		int streaming_reported_size = 0; // Last size sent to the streaming callback.
+		uint32_t streaming_frames_below = 0;
+
 		CanvasTexture *canvas_texture = nullptr;
 
 		void cleanup();
@@ -176,6 +182,10 @@ private:
 	mutable RID_Owner<Texture, true> texture_owner;
 	Texture *get_texture(RID p_rid) { return texture_owner.get_or_null(p_rid); };
 
+	// Frames a streamed texture must be needed at a smaller size before it is allowed to drop its larger mipmaps.
+	static const uint32_t TEXTURE_STREAMING_DOWNGRADE_FRAMES = 300;
+	HashSet<RID> streaming_textures;
+
 	struct TextureToRDFormat {
 		RD::DataFormat format;
 		RD::DataFormat format_srgb;
@@ -491,6 +501,17 @@ public:
 	virtual void texture_set_detect_3d_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) override;
 	virtual void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) override;
 	virtual void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata) override;
+	virtual void texture_set_streaming_callback(RID p_texture, RS::TextureStreamingCallback p_callback, void *p_userdata) override;
+
+	_FORCE_INLINE_ bool has_streaming_textures() const { return !streaming_textures.is_empty(); }
+	// Records the on-screen size (in pixels) a streamed texture is needed at, the largest request of the frame wins.
+	_FORCE_INLINE_ void texture_request_streaming_size(RID p_texture, int p_size) {
+		Texture *tex = texture_owner.get_or_null(p_texture);
+		if (tex && tex->streaming_callback && p_size > tex->streaming_requested_size) {
+			tex->streaming_requested_size = p_size;
+		}
+	}
+	void update_texture_streaming();
 
 	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info) override;
 
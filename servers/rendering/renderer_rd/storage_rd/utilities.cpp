@@ -31,6 +31,8 @@
 #include "utilities.h"
 #include "../environment/fog.h"
 #include "../environment/gi.h"
+#include "../pipeline_cache_rd.h"
+#include "../shader_rd.h"
 #include "light_storage.h"
 #include "mesh_storage.h"
 #include "particles_storage.h"
@@ -306,6 +308,16 @@ uint64_t Utilities::get_rendering_info(RS::RenderingInfo p_info) {
 		return buffer_mem_cache;
 	} else if (p_info == RS::RENDERING_INFO_VIDEO_MEM_USED) {
 		return total_mem_cache;
+	} else if (p_info == RS::RENDERING_INFO_PIPELINE_COMPILATIONS_SYNC) {
+		return PipelineCacheRD::get_sync_compilation_count();
+	} else if (p_info == RS::RENDERING_INFO_PIPELINE_COMPILATIONS_ASYNC) {
+		return PipelineCacheRD::get_async_compilation_count();
+	} else if (p_info == RS::RENDERING_INFO_SKINNED_VERTICES_IN_FRAME) {
+		return MeshStorage::get_singleton()->get_skinned_vertices_in_frame();
+	} else if (p_info == RS::RENDERING_INFO_SHADER_CACHE_HITS) {
+		return ShaderRD::get_shader_cache_hits();
+	} else if (p_info == RS::RENDERING_INFO_SHADER_CACHE_MISSES) {
+		return ShaderRD::get_shader_cache_misses();
 	}
 	return 0;
 }
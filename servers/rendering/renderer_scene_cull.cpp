@@ -30,9 +30,11 @@
 
 #include "renderer_scene_cull.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "renderer_scene_occlusion_cull_raster.h"
 #include "rendering_server_default.h"
 
 #include <new>
@@ -896,7 +898,7 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_COND(!instance);
 
-	if (instance->transform == p_transform) {
+	if (instance->transform_curr == p_transform) {
 		return; //must be checked to avoid worst evil
 	}
 
@@ -908,10 +910,41 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	}
 
 #endif
+	instance->transform_curr = p_transform;
+
+	if (interpolation_data.enabled && instance->interpolated) {
+		// Rendered in between the transforms of the last two physics ticks, see update_interpolation_frame().
+		if (!instance->on_interpolate_list) {
+			instance->on_interpolate_list = true;
+			interpolation_data.interpolate_list.push_back(p_instance);
+		}
+		instance->interpolation_moved = true;
+		return;
+	}
+
+	instance->transform_prev = p_transform;
 	instance->transform = p_transform;
 	_instance_queue_update(instance, true);
 }
 
+void RendererSceneCull::instance_set_interpolated(RID p_instance, bool p_interpolated) {
+	Instance *instance = instance_owner.get_or_null(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	instance->interpolated = p_interpolated;
+}
+
+void RendererSceneCull::instance_reset_physics_interpolation(RID p_instance) {
+	Instance *instance = instance_owner.get_or_null(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	instance->transform_prev = instance->transform_curr;
+	if (instance->transform != instance->transform_curr) {
+		instance->transform = instance->transform_curr;
+		_instance_queue_update(instance, true);
+	}
+}
+
 void RendererSceneCull::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_COND(!instance);
@@ -4100,6 +4133,65 @@ void RendererSceneCull::update_visibility_notifiers() {
 	}
 }
 
+void RendererSceneCull::set_physics_interpolation_enabled(bool p_enabled) {
+	if (interpolation_data.enabled == p_enabled) {
+		return;
+	}
+
+	interpolation_data.enabled = p_enabled;
+
+	if (!p_enabled) {
+		for (const RID &rid : interpolation_data.interpolate_list) {
+			Instance *instance = instance_owner.get_or_null(rid);
+			if (instance) {
+				instance->transform_prev = instance->transform_curr;
+				instance->transform = instance->transform_curr;
+				instance->on_interpolate_list = false;
+				instance->interpolation_moved = false;
+				_instance_queue_update(instance, true);
+			}
+		}
+		interpolation_data.interpolate_list.clear();
+	}
+}
+
+void RendererSceneCull::update_interpolation_tick() {
+	// Called before each physics tick, the transforms set during the last one become the previous ones.
+	// Instances which weren't transformed during the last tick have reached their transform, and stop being interpolated.
+	for (uint32_t i = 0; i < interpolation_data.interpolate_list.size();) {
+		Instance *instance = instance_owner.get_or_null(interpolation_data.interpolate_list[i]);
+		if (instance && instance->interpolation_moved) {
+			instance->transform_prev = instance->transform_curr;
+			instance->interpolation_moved = false;
+			i++;
+			continue;
+		}
+
+		if (instance) {
+			instance->transform_prev = instance->transform_curr;
+			instance->transform = instance->transform_curr;
+			instance->on_interpolate_list = false;
+			_instance_queue_update(instance, true);
+		}
+		interpolation_data.interpolate_list.remove_at_unordered(i);
+	}
+}
+
+void RendererSceneCull::update_interpolation_frame() {
+	if (interpolation_data.interpolate_list.is_empty()) {
+		return;
+	}
+
+	real_t fraction = Engine::get_singleton()->get_physics_interpolation_fraction();
+	for (const RID &rid : interpolation_data.interpolate_list) {
+		Instance *instance = instance_owner.get_or_null(rid);
+		if (instance) {
+			instance->transform = instance->transform_prev.interpolate_with(instance->transform_curr, fraction);
+			_instance_queue_update(instance, true);
+		}
+	}
+}
+
 /*******************************/
 /* Passthrough to Scene Render */
 /*******************************/
@@ -4154,7 +4246,8 @@ RendererSceneCull::RendererSceneCull() {
 		taa_jitter_array[i].y = get_halton_value(i, 3);
 	}
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// Replaced by the raycast module's culler when it's available and selected.
+	dummy_occlusion_culling = memnew(RendererSceneOcclusionCullRaster);
 }
 
 RendererSceneCull::~RendererSceneCull() {
@@ -392,6 +392,13 @@ public:
 
 		Transform3D transform;
 
+		// Physics interpolation, transform is interpolated between these each frame while on the interpolate list.
+		Transform3D transform_prev;
+		Transform3D transform_curr;
+		bool interpolated = false; // Opted in by the nodes.
+		bool on_interpolate_list = false;
+		bool interpolation_moved = false; // Transformed during the current physics tick.
+
 		float lod_bias;
 
 		bool ignore_occlusion_culling;
@@ -606,6 +613,11 @@ public:
 	SelfList<Instance>::List _instance_update_list;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies = false);
 
+	struct InterpolationData {
+		bool enabled = false;
+		LocalVector<RID> interpolate_list;
+	} interpolation_data;
+
 	struct InstanceGeometryData : public InstanceBaseData {
 		RenderGeometryInstance *geometry_instance = nullptr;
 		HashSet<Instance *> lights;
@@ -965,6 +977,8 @@ public:
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
 	virtual void instance_set_pivot_data(RID p_instance, float p_sorting_offset, bool p_use_aabb_center);
 	virtual void instance_set_transform(RID p_instance, const Transform3D &p_transform);
+	virtual void instance_set_interpolated(RID p_instance, bool p_interpolated);
+	virtual void instance_reset_physics_interpolation(RID p_instance);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id);
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight);
 	virtual void instance_set_surface_override_material(RID p_instance, int p_surface, RID p_material);
@@ -1301,6 +1315,10 @@ public:
 
 	virtual void update_visibility_notifiers();
 
+	virtual void set_physics_interpolation_enabled(bool p_enabled);
+	virtual void update_interpolation_tick();
+	virtual void update_interpolation_frame();
+
 	RendererSceneCull();
 	virtual ~RendererSceneCull();
 };
@@ -55,6 +55,7 @@ public:
 
 	public:
 		bool is_empty() const;
+		Size2i get_size() const { return sizes.is_empty() ? Size2i() : sizes[0]; }
 		virtual void clear();
 		virtual void resize(const Size2i &p_size);
 
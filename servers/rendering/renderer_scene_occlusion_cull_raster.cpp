@@ -0,0 +1,508 @@
+/**************************************************************************/
+/*  renderer_scene_occlusion_cull_raster.cpp                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "renderer_scene_occlusion_cull_raster.h"
+
+#include "core/object/worker_thread_pool.h"
+
+RendererSceneOcclusionCullRaster *RendererSceneOcclusionCullRaster::raster_singleton = nullptr;
+
+void RendererSceneOcclusionCullRaster::RasterHZBuffer::setup_triangles(const Vector3 *p_vertices, const uint32_t *p_indices, uint32_t p_index_count, const Transform3D &p_cam_inv_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, const Size2i &p_size, LocalVector<ScreenTriangle> &r_triangles) {
+	const float z_near = p_cam_projection.get_z_near();
+	const Vector2 size = Vector2(p_size);
+
+	for (uint32_t i = 0; i + 2 < p_index_count; i += 3) {
+		Vector3 view[3];
+		int inside_count = 0;
+		for (int j = 0; j < 3; j++) {
+			view[j] = p_cam_inv_transform.xform(p_vertices[p_indices[i + j]]);
+			if (view[j].z <= -z_near) {
+				inside_count++;
+			}
+		}
+
+		if (inside_count == 0) {
+			continue; // Fully behind the near plane.
+		}
+
+		// Clip against the near plane, which can turn the triangle into a quad.
+		Vector3 clipped[4];
+		int clipped_count = 0;
+		if (inside_count == 3) {
+			clipped[0] = view[0];
+			clipped[1] = view[1];
+			clipped[2] = view[2];
+			clipped_count = 3;
+		} else {
+			for (int j = 0; j < 3; j++) {
+				const Vector3 &a = view[j];
+				const Vector3 &b = view[(j + 1) % 3];
+				bool a_inside = a.z <= -z_near;
+				bool b_inside = b.z <= -z_near;
+				if (a_inside) {
+					clipped[clipped_count++] = a;
+				}
+				if (a_inside != b_inside) {
+					float t = (-z_near - a.z) / (b.z - a.z);
+					clipped[clipped_count++] = a.lerp(b, t);
+				}
+			}
+		}
+
+		Vector2 points[4];
+		float depths[4];
+		for (int j = 0; j < clipped_count; j++) {
+			Plane projected = p_cam_projection.xform4(Plane(clipped[j], 1.0));
+			float w = p_cam_orthogonal ? 1.0f : projected.d;
+			points[j] = Vector2(projected.normal.x / w * 0.5f + 0.5f, projected.normal.y / w * 0.5f + 0.5f) * size;
+			float depth = -clipped[j].z;
+			depths[j] = p_cam_orthogonal ? depth : 1.0f / depth;
+		}
+
+		for (int j = 1; j + 1 < clipped_count; j++) {
+			const int tri[3] = { 0, j, j + 1 };
+
+			Vector2 min_point = points[tri[0]];
+			Vector2 max_point = points[tri[0]];
+			for (int k = 1; k < 3; k++) {
+				min_point = min_point.min(points[tri[k]]);
+				max_point = max_point.max(points[tri[k]]);
+			}
+
+			if (max_point.x < 0.0f || max_point.y < 0.0f || min_point.x > size.x || min_point.y > size.y) {
+				continue; // Off-screen.
+			}
+
+			// Rows whose pixel centers may be covered.
+			int min_y = MAX(0, int(Math::ceil(min_point.y - 0.5f)));
+			int max_y = MIN(p_size.y - 1, int(Math::floor(max_point.y - 0.5f)));
+			if (min_y > max_y) {
+				continue;
+			}
+
+			ScreenTriangle st;
+			for (int k = 0; k < 3; k++) {
+				st.points[k] = points[tri[k]];
+				st.depths[k] = depths[tri[k]];
+			}
+			st.min_y = min_y;
+			st.max_y = max_y;
+			r_triangles.push_back(st);
+		}
+	}
+}
+
+void RendererSceneOcclusionCullRaster::RasterHZBuffer::_rasterize_band(uint32_t p_band, const RasterizeThreadData *p_data) {
+	const int width = sizes[0].x;
+	const int height = sizes[0].y;
+	const int band_from = p_band * height / p_data->band_count;
+	const int band_to = (p_band + 1) * height / p_data->band_count - 1;
+
+	float *depth_buffer = mips[0];
+	for (int i = band_from * width; i < (band_to + 1) * width; i++) {
+		depth_buffer[i] = FLT_MAX;
+	}
+
+	for (uint32_t list = 0; list < p_data->triangle_list_count; list++) {
+		const LocalVector<ScreenTriangle> &triangles = p_data->triangles[list];
+
+		for (const ScreenTriangle &st : triangles) {
+			int min_y = MAX(st.min_y, band_from);
+			int max_y = MIN(st.max_y, band_to);
+			if (min_y > max_y) {
+				continue;
+			}
+
+			const Vector2 &p0 = st.points[0];
+			const Vector2 &p1 = st.points[1];
+			const Vector2 &p2 = st.points[2];
+
+			float area = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+			if (Math::abs(area) < CMP_EPSILON) {
+				continue;
+			}
+			// Occluders are double sided, the sign of the area takes care of the winding.
+			float inv_area = 1.0f / area;
+
+			int min_x = MAX(0, int(Math::ceil(MIN(p0.x, MIN(p1.x, p2.x)) - 0.5f)));
+			int max_x = MIN(width - 1, int(Math::floor(MAX(p0.x, MAX(p1.x, p2.x)) - 0.5f)));
+			if (min_x > max_x) {
+				continue;
+			}
+
+			// Barycentric coordinates are linear in screen space, step them along each row.
+			const float step_b0 = (p1.y - p2.y) * inv_area;
+			const float step_b1 = (p2.y - p0.y) * inv_area;
+			const float step_b2 = (p0.y - p1.y) * inv_area;
+			const bool perspective = p_data->perspective;
+
+			for (int y = min_y; y <= max_y; y++) {
+				float px = min_x + 0.5f;
+				float py = y + 0.5f;
+				float b0 = ((p2.x - p1.x) * (py - p1.y) - (p2.y - p1.y) * (px - p1.x)) * inv_area;
+				float b1 = ((p0.x - p2.x) * (py - p2.y) - (p0.y - p2.y) * (px - p2.x)) * inv_area;
+				float b2 = ((p1.x - p0.x) * (py - p0.y) - (p1.y - p0.y) * (px - p0.x)) * inv_area;
+
+				float *row = &depth_buffer[y * width + min_x];
+				const int count = max_x - min_x + 1;
+
+				// Branchless so it compiles to masked SIMD (SSE/NEON) instructions.
+				for (int x = 0; x < count; x++) {
+					float w0 = b0 + step_b0 * x;
+					float w1 = b1 + step_b1 * x;
+					float w2 = b2 + step_b2 * x;
+					float z = w0 * st.depths[0] + w1 * st.depths[1] + w2 * st.depths[2];
+					float depth = perspective ? 1.0f / z : z;
+					bool covered = w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f && depth < row[x];
+					row[x] = covered ? depth : row[x];
+				}
+			}
+		}
+	}
+}
+
+void RendererSceneOcclusionCullRaster::RasterHZBuffer::rasterize(const LocalVector<ScreenTriangle> *p_triangle_lists, uint32_t p_list_count, bool p_cam_orthogonal, float p_z_far) {
+	ERR_FAIL_COND(is_empty());
+
+	RasterizeThreadData td;
+	td.band_count = MIN((uint32_t)sizes[0].y, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count() * 2);
+	td.perspective = !p_cam_orthogonal;
+	td.triangles = p_triangle_lists;
+	td.triangle_list_count = p_list_count;
+
+	debug_tex_range = p_z_far;
+
+	// Each band owns a range of rows, so threads never write to the same pixels.
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_band, &td, td.band_count, -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+////////////////////////////////////////////////////////
+
+bool RendererSceneOcclusionCullRaster::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RendererSceneOcclusionCullRaster::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RendererSceneOcclusionCullRaster::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RendererSceneOcclusionCullRaster::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_COND(!occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		RID scenario_rid = E.scenario;
+		RID instance_rid = E.instance;
+		ERR_CONTINUE(!scenarios.has(scenario_rid));
+		Scenario &scenario = scenarios[scenario_rid];
+		ERR_CONTINUE(!scenario.instances.has(instance_rid));
+
+		if (!scenario.dirty_instances.has(instance_rid)) {
+			scenario.dirty_instances.insert(instance_rid);
+			scenario.dirty_instances_array.push_back(instance_rid);
+		}
+	}
+}
+
+void RendererSceneOcclusionCullRaster::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_COND(!occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RendererSceneOcclusionCullRaster::add_scenario(RID p_scenario) {
+	if (scenarios.has(p_scenario)) {
+		scenarios[p_scenario].removed = false;
+	} else {
+		scenarios[p_scenario] = Scenario();
+	}
+}
+
+void RendererSceneOcclusionCullRaster::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+	scenario.removed = true;
+}
+
+void RendererSceneOcclusionCullRaster::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario.removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes.
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_COND(!occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	if (instance.enabled != p_enabled) {
+		instance.enabled = p_enabled;
+		scenario.dirty = true; // The active list needs a rebuild, but the instance doesn't need update.
+	}
+
+	if (changed && !scenario.dirty_instances.has(p_instance)) {
+		scenario.dirty_instances.insert(p_instance);
+		scenario.dirty_instances_array.push_back(p_instance);
+		scenario.dirty = true;
+	}
+}
+
+void RendererSceneOcclusionCullRaster::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.has(p_instance)) {
+		OccluderInstance &instance = scenario.instances[p_instance];
+
+		if (!instance.removed) {
+			Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+			if (occluder) {
+				occluder->users.erase(InstanceID(p_scenario, p_instance));
+			}
+
+			scenario.removed_instances.push_back(p_instance);
+			instance.removed = true;
+		}
+	}
+}
+
+void RendererSceneOcclusionCullRaster::Scenario::_update_dirty_instance(uint32_t p_idx, RID *p_instances) {
+	OccluderInstance *occ_inst = instances.getptr(p_instances[p_idx]);
+
+	if (!occ_inst) {
+		return;
+	}
+
+	Occluder *occ = raster_singleton->occluder_owner.get_or_null(occ_inst->occluder);
+
+	if (!occ) {
+		occ_inst->xformed_vertices.clear();
+		occ_inst->indices.clear();
+		return;
+	}
+
+	int vertices_size = occ->vertices.size();
+	occ_inst->xformed_vertices.resize(vertices_size);
+
+	const Vector3 *read_ptr = occ->vertices.ptr();
+	Vector3 *write_ptr = occ_inst->xformed_vertices.ptr();
+	for (int i = 0; i < vertices_size; i++) {
+		write_ptr[i] = occ_inst->xform.xform(read_ptr[i]);
+	}
+
+	// Drop invalid triangles here, so the rasterizer doesn't need to check them every frame.
+	const int32_t *indices = occ->indices.ptr();
+	int index_count = occ->indices.size() - occ->indices.size() % 3;
+	occ_inst->indices.clear();
+	occ_inst->indices.reserve(index_count);
+	for (int i = 0; i < index_count; i += 3) {
+		if (indices[i] < 0 || indices[i] >= vertices_size || indices[i + 1] < 0 || indices[i + 1] >= vertices_size || indices[i + 2] < 0 || indices[i + 2] >= vertices_size) {
+			continue;
+		}
+		occ_inst->indices.push_back(indices[i]);
+		occ_inst->indices.push_back(indices[i + 1]);
+		occ_inst->indices.push_back(indices[i + 2]);
+	}
+}
+
+bool RendererSceneOcclusionCullRaster::Scenario::update() {
+	if (removed) {
+		return true;
+	}
+
+	if (!dirty && removed_instances.is_empty() && dirty_instances_array.is_empty()) {
+		return false;
+	}
+
+	for (const RID &instance : removed_instances) {
+		instances.erase(instance);
+	}
+
+	if (dirty_instances_array.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance, dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, SNAME("RasterOcclusionCullUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (dirty_instances_array.size() == 1) {
+		_update_dirty_instance(0, dirty_instances_array.ptr());
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+	removed_instances.clear();
+
+	active_instances.clear();
+	for (const KeyValue<RID, OccluderInstance> &E : instances) {
+		if (E.value.enabled && !E.value.indices.is_empty()) {
+			active_instances.push_back(&E.value);
+		}
+	}
+
+	dirty = false;
+	return false;
+}
+
+////////////////////////////////////////////////////////
+
+void RendererSceneOcclusionCullRaster::_setup_triangles_threaded(uint32_t p_thread, const SetupThreadData *p_data) {
+	const LocalVector<const OccluderInstance *> &active_instances = p_data->scenario->active_instances;
+	uint32_t total_instances = active_instances.size();
+	uint32_t total_threads = p_data->thread_count;
+	uint32_t from = p_thread * total_instances / total_threads;
+	uint32_t to = (p_thread + 1 == total_threads) ? total_instances : ((p_thread + 1) * total_instances / total_threads);
+
+	LocalVector<RasterHZBuffer::ScreenTriangle> &triangles = thread_triangles[p_thread];
+	for (uint32_t i = from; i < to; i++) {
+		const OccluderInstance *occ_inst = active_instances[i];
+		RasterHZBuffer::setup_triangles(occ_inst->xformed_vertices.ptr(), occ_inst->indices.ptr(), occ_inst->indices.size(), p_data->cam_inv_transform, p_data->cam_projection, p_data->cam_orthogonal, p_data->size, triangles);
+	}
+}
+
+void RendererSceneOcclusionCullRaster::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RendererSceneOcclusionCullRaster::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RendererSceneOcclusionCullRaster::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RendererSceneOcclusionCullRaster::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RendererSceneOcclusionCullRaster::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+
+	bool removed = scenario.update();
+
+	if (removed) {
+		scenarios.erase(buffer.scenario_rid);
+		return;
+	}
+
+	uint32_t thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	thread_triangles.resize(thread_count);
+	for (LocalVector<RasterHZBuffer::ScreenTriangle> &triangles : thread_triangles) {
+		triangles.clear();
+	}
+
+	if (!scenario.active_instances.is_empty()) {
+		SetupThreadData td;
+		td.thread_count = thread_count;
+		td.scenario = &scenario;
+		td.cam_inv_transform = p_cam_transform.affine_inverse();
+		td.cam_projection = p_cam_projection;
+		td.cam_orthogonal = p_cam_orthogonal;
+		td.size = buffer.get_size();
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneOcclusionCullRaster::_setup_triangles_threaded, &td, thread_count, -1, true, SNAME("RasterOcclusionCullSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	buffer.rasterize(thread_triangles.ptr(), thread_triangles.size(), p_cam_orthogonal, p_cam_projection.get_z_far());
+	buffer.update_mips();
+}
+
+RendererSceneOcclusionCull::HZBuffer *RendererSceneOcclusionCullRaster::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RendererSceneOcclusionCullRaster::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+RendererSceneOcclusionCullRaster::RendererSceneOcclusionCullRaster() {
+	raster_singleton = this;
+}
+
+RendererSceneOcclusionCullRaster::~RendererSceneOcclusionCullRaster() {
+	raster_singleton = nullptr;
+}
@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  renderer_scene_occlusion_cull_raster.h                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RENDERER_SCENE_OCCLUSION_CULL_RASTER_H
+#define RENDERER_SCENE_OCCLUSION_CULL_RASTER_H
+
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Occlusion culling backend that rasterizes the occluders into the depth buffer on the CPU.
+// It has no dependencies, so it's used on platforms where Embree (and the raycast module) are not available.
+class RendererSceneOcclusionCullRaster : public RendererSceneOcclusionCull {
+public:
+	class RasterHZBuffer : public HZBuffer {
+	public:
+		struct ScreenTriangle {
+			Vector2 points[3];
+			// View depth, or its reciprocal when using a perspective projection, so it interpolates linearly in screen space.
+			float depths[3];
+			int min_y;
+			int max_y;
+		};
+
+	private:
+		struct RasterizeThreadData {
+			uint32_t band_count;
+			bool perspective;
+			const LocalVector<ScreenTriangle> *triangles;
+			uint32_t triangle_list_count;
+		};
+
+		void _rasterize_band(uint32_t p_band, const RasterizeThreadData *p_data);
+
+	public:
+		RID scenario_rid;
+
+		// Clips (against the near plane) and projects world space triangles, appending them to r_triangles.
+		static void setup_triangles(const Vector3 *p_vertices, const uint32_t *p_indices, uint32_t p_index_count, const Transform3D &p_cam_inv_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, const Size2i &p_size, LocalVector<ScreenTriangle> &r_triangles);
+
+		void rasterize(const LocalVector<ScreenTriangle> *p_triangle_lists, uint32_t p_list_count, bool p_cam_orthogonal, float p_z_far);
+	};
+
+private:
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		static uint32_t hash(const InstanceID &p_ins) {
+			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
+			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
+		}
+		bool operator==(const InstanceID &rhs) const {
+			return instance == rhs.instance && rhs.scenario == scenario;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		HashSet<InstanceID, InstanceID> users;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		LocalVector<uint32_t> indices;
+		LocalVector<Vector3> xformed_vertices;
+		Transform3D xform;
+		bool enabled = true;
+		bool removed = false;
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+		HashSet<RID> dirty_instances; // To avoid duplicates.
+		LocalVector<RID> dirty_instances_array; // To iterate and split into threads.
+		LocalVector<RID> removed_instances;
+
+		// Enabled instances with geometry, rebuilt when the scenario changes.
+		LocalVector<const OccluderInstance *> active_instances;
+		bool dirty = false;
+		bool removed = false;
+
+		void _update_dirty_instance(uint32_t p_idx, RID *p_instances);
+		bool update();
+	};
+
+	struct SetupThreadData {
+		uint32_t thread_count;
+		const Scenario *scenario;
+		Transform3D cam_inv_transform;
+		Projection cam_projection;
+		bool cam_orthogonal;
+		Size2i size;
+	};
+
+	static RendererSceneOcclusionCullRaster *raster_singleton;
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	// One list per thread, reused between frames to avoid allocations.
+	LocalVector<LocalVector<RasterHZBuffer::ScreenTriangle>> thread_triangles;
+
+	void _setup_triangles_threaded(uint32_t p_thread, const SetupThreadData *p_data);
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	RendererSceneOcclusionCullRaster();
+	~RendererSceneOcclusionCullRaster();
+};
+
+#endif // RENDERER_SCENE_OCCLUSION_CULL_RASTER_H
@@ -31,6 +31,7 @@
 #include "rendering_server_default.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/frame_tracer.h"
 #include "core/io/marshalls.h"
 #include "core/os/os.h"
 #include "core/templates/sort_array.h"
@@ -68,18 +69,68 @@ void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_call
 	frame_drawn_callbacks.push_back(p_callable);
 }
 
+void RenderingServerDefault::_update_capturing_timestamps() {
+	RSG::utilities->capturing_timestamps = frame_profiling || print_gpu_profile || trace_gpu_timestamps;
+}
+
+void RenderingServerDefault::_trace_gpu_timestamps() {
+	uint32_t count = RSG::utilities->get_captured_timestamps_count();
+	if (count < 2) {
+		return;
+	}
+
+	// There is no calibration between both clocks, so the GPU timeline is aligned
+	// to the CPU time at which its first timestamp was recorded.
+	uint64_t base_cpu = RSG::utilities->get_captured_timestamp_cpu_time(0);
+	uint64_t base_gpu = RSG::utilities->get_captured_timestamp_gpu_time(0);
+	LocalVector<uint64_t> times;
+	times.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		times[i] = base_cpu + (RSG::utilities->get_captured_timestamp_gpu_time(i) - base_gpu) / 1000;
+	}
+
+	FrameTracer::add_gpu_zone("GPU Frame", times[0], times[count - 1]);
+
+	// Timestamps starting with '>' and '<' open and close a nested scope, others last until the next timestamp.
+	LocalVector<Pair<String, uint64_t>> scopes;
+	for (uint32_t i = 0; i < count - 1; i++) {
+		String name = RSG::utilities->get_captured_timestamp_name(i);
+		if (name.begins_with(">")) {
+			scopes.push_back(Pair<String, uint64_t>(name.substr(1).strip_edges(), times[i]));
+		} else if (name.begins_with("<")) {
+			if (scopes.size()) {
+				FrameTracer::add_gpu_zone(scopes[scopes.size() - 1].first, scopes[scopes.size() - 1].second, times[i]);
+				scopes.resize(scopes.size() - 1);
+			}
+		} else {
+			FrameTracer::add_gpu_zone(name, times[i], times[i + 1]);
+		}
+	}
+}
+
 void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+	TRACE_ZONE("RenderingServer::draw");
+
 	//needs to be done before changes is reset to 0, to not force the editor to redraw
 	RS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
 
 	changes = 0;
 
+	if (FrameTracer::is_tracing() != trace_gpu_timestamps) {
+		trace_gpu_timestamps = FrameTracer::is_tracing();
+		_update_capturing_timestamps();
+	}
+
 	RSG::rasterizer->begin_frame(frame_step);
 
 	TIMESTAMP_BEGIN()
 
 	uint64_t time_usec = OS::get_singleton()->get_ticks_usec();
 
+	// Interpolated transforms must be set before updating instances.
+	RSG::scene->update_interpolation_frame();
+	RSG::canvas->update_interpolation_frame();
+
 	RSG::scene->update(); //update scenes stuff before updating instances
 
 	frame_setup_time = double(OS::get_singleton()->get_ticks_usec() - time_usec) / 1000.0;
@@ -145,6 +196,10 @@ void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
 		}
 
 		frame_profile = new_profile;
+
+		if (trace_gpu_timestamps) {
+			_trace_gpu_timestamps();
+		}
 	}
 
 	frame_profile_frame = RSG::utilities->get_captured_timestamps_frame();
@@ -205,6 +260,10 @@ bool RenderingServerDefault::has_changed() const {
 	return changes > 0;
 }
 
+bool RenderingServerDefault::is_draw_pipelined() const {
+	return pipelined;
+}
+
 void RenderingServerDefault::_init() {
 	RSG::rasterizer->initialize();
 }
@@ -248,7 +307,9 @@ void RenderingServerDefault::finish() {
 /* STATUS INFORMATION */
 
 uint64_t RenderingServerDefault::get_rendering_info(RenderingInfo p_info) {
-	if (p_info == RENDERING_INFO_TOTAL_OBJECTS_IN_FRAME) {
+	if (p_info == RENDERING_INFO_SYNC_POINTS_IN_FRAME) {
+		return sync_points_in_frame;
+	} else if (p_info == RENDERING_INFO_TOTAL_OBJECTS_IN_FRAME) {
 		return RSG::viewport->get_total_objects_drawn();
 	} else if (p_info == RENDERING_INFO_TOTAL_PRIMITIVES_IN_FRAME) {
 		return RSG::viewport->get_total_primitives_drawn();
@@ -263,7 +324,8 @@ RenderingDevice::DeviceType RenderingServerDefault::get_video_adapter_type() con
 }
 
 void RenderingServerDefault::set_frame_profiling_enabled(bool p_enable) {
-	RSG::utilities->capturing_timestamps = p_enable;
+	frame_profiling = p_enable;
+	_update_capturing_timestamps();
 }
 
 uint64_t RenderingServerDefault::get_frame_profile_frame() {
@@ -298,8 +360,8 @@ void RenderingServerDefault::sdfgi_set_debug_probe_select(const Vector3 &p_posit
 }
 
 void RenderingServerDefault::set_print_gpu_profile(bool p_enable) {
-	RSG::utilities->capturing_timestamps = p_enable;
 	print_gpu_profile = p_enable;
+	_update_capturing_timestamps();
 }
 
 RID RenderingServerDefault::get_test_cube() {
@@ -339,6 +401,12 @@ void RenderingServerDefault::_thread_exit() {
 
 void RenderingServerDefault::_thread_draw(bool p_swap_buffers, double frame_step) {
 	_draw(p_swap_buffers, frame_step);
+
+	if (pipelined) {
+		MutexLock lock(frame_mutex);
+		frames_drawn++;
+		frame_drawn_cond.notify_one();
+	}
 }
 
 void RenderingServerDefault::_thread_flush() {
@@ -352,6 +420,7 @@ void RenderingServerDefault::_thread_callback(void *_instance) {
 
 void RenderingServerDefault::_thread_loop() {
 	server_thread = Thread::get_caller_id();
+	FrameTracer::set_thread_name("Render Thread");
 
 	DisplayServer::get_singleton()->make_rendering_thread();
 
@@ -370,7 +439,19 @@ void RenderingServerDefault::_thread_loop() {
 
 /* EVENT QUEUING */
 
+void RenderingServerDefault::_set_physics_interpolation_enabled(bool p_enabled) {
+	RSG::scene->set_physics_interpolation_enabled(p_enabled);
+	RSG::canvas->set_physics_interpolation_enabled(p_enabled);
+}
+
+void RenderingServerDefault::_tick() {
+	RSG::scene->update_interpolation_tick();
+	RSG::canvas->update_interpolation_tick();
+}
+
 void RenderingServerDefault::sync() {
+	TRACE_ZONE("RenderingServer::sync");
+
 	if (create_thread) {
 		command_queue.push_and_sync(this, &RenderingServerDefault::_thread_flush);
 	} else {
@@ -379,18 +460,32 @@ void RenderingServerDefault::sync() {
 }
 
 void RenderingServerDefault::draw(bool p_swap_buffers, double frame_step) {
+	// Other threads may still be counting, subtract what was read instead of storing 0 so no sync point is lost.
+	sync_points_in_frame = sync_points.get();
+	sync_points.sub(sync_points_in_frame);
+
 	if (create_thread) {
+		if (pipelined) {
+			TRACE_ZONE("RenderingServer::wait_for_frame");
+			// Only wait for the frame before the previous one, the previous one can keep drawing while this one is queued.
+			MutexLock lock(frame_mutex);
+			while (frames_queued - frames_drawn >= 2) {
+				frame_drawn_cond.wait(lock);
+			}
+			frames_queued++;
+		}
 		command_queue.push(this, &RenderingServerDefault::_thread_draw, p_swap_buffers, frame_step);
 	} else {
 		_draw(p_swap_buffers, frame_step);
 	}
 }
 
-RenderingServerDefault::RenderingServerDefault(bool p_create_thread) :
+RenderingServerDefault::RenderingServerDefault(bool p_create_thread, bool p_pipelined) :
 		command_queue(p_create_thread) {
 	RenderingServer::init();
 
 	create_thread = p_create_thread;
+	pipelined = p_create_thread && p_pipelined;
 
 	if (!p_create_thread) {
 		server_thread = Thread::get_caller_id();
@@ -31,6 +31,7 @@
 #ifndef RENDERING_SERVER_DEFAULT_H
 #define RENDERING_SERVER_DEFAULT_H
 
+#include "core/os/condition_variable.h"
 #include "core/os/thread.h"
 #include "core/templates/command_queue_mt.h"
 #include "core/templates/hash_map.h"
@@ -67,6 +68,11 @@ class RenderingServerDefault : public RenderingServer {
 
 	double frame_setup_time = 0;
 
+	bool frame_profiling = false;
+	bool trace_gpu_timestamps = false;
+	void _update_capturing_timestamps();
+	void _trace_gpu_timestamps();
+
 	//for printing
 	bool print_gpu_profile = false;
 	HashMap<String, float> print_gpu_profile_task_time;
@@ -84,6 +90,18 @@ class RenderingServerDefault : public RenderingServer {
 	SafeFlag draw_thread_up;
 	bool create_thread;
 
+	// In pipelined mode the main thread doesn't sync with the render thread before each draw, so it can build the
+	// next frame while the previous one is still being drawn. At most two frames are queued at any time.
+	bool pipelined = false;
+	BinaryMutex frame_mutex;
+	ConditionVariable frame_drawn_cond;
+	uint64_t frames_queued = 0;
+	uint64_t frames_drawn = 0;
+
+	// Calls that had to wait for the render thread to return a value or flush its queue.
+	mutable SafeNumeric<uint64_t> sync_points;
+	uint64_t sync_points_in_frame = 0;
+
 	void _thread_draw(bool p_swap_buffers, double frame_step);
 	void _thread_flush();
 
@@ -92,6 +110,8 @@ class RenderingServerDefault : public RenderingServer {
 	Mutex alloc_mutex;
 
 	void _draw(bool p_swap_buffers, double frame_step);
+	void _set_physics_interpolation_enabled(bool p_enabled);
+	void _tick();
 	void _init();
 	void _finish();
 
@@ -120,9 +140,11 @@ public:
 #define WRITE_ACTION redraw_request();
 
 #ifdef DEBUG_SYNC
-#define SYNC_DEBUG print_line("sync on: " + String(__FUNCTION__));
+#define SYNC_DEBUG                                    \
+	print_line("sync on: " + String(__FUNCTION__)); \
+	sync_points.increment();
 #else
-#define SYNC_DEBUG
+#define SYNC_DEBUG sync_points.increment();
 #endif
 
 #include "servers/server_wrap_mt_common.h"
@@ -207,6 +229,7 @@ public:
 	FUNC3(texture_set_detect_3d_callback, RID, TextureDetectCallback, void *)
 	FUNC3(texture_set_detect_normal_callback, RID, TextureDetectCallback, void *)
 	FUNC3(texture_set_detect_roughness_callback, RID, TextureDetectRoughnessCallback, void *)
+	FUNC3(texture_set_streaming_callback, RID, TextureStreamingCallback, void *)
 
 	FUNC2(texture_set_path, RID, const String &)
 	FUNC1RC(String, texture_get_path, RID)
@@ -262,9 +285,7 @@ public:
 	virtual RID mesh_create_from_surfaces(const Vector<SurfaceData> &p_surfaces, int p_blend_shape_count = 0) override {
 		RID mesh = RSG::mesh_storage->mesh_allocate();
 
-		// TODO once we have RSG::mesh_storage, add can_create_resources_async and call here instead of texture_storage!!
-
-		if (Thread::get_caller_id() == server_thread || RSG::texture_storage->can_create_resources_async()) {
+		if (Thread::get_caller_id() == server_thread || RSG::mesh_storage->can_create_resources_async()) {
 			if (Thread::get_caller_id() == server_thread) {
 				command_queue.flush_if_pending();
 			}
@@ -767,6 +788,8 @@ public:
 	FUNC2(instance_set_layer_mask, RID, uint32_t)
 	FUNC3(instance_set_pivot_data, RID, float, bool)
 	FUNC2(instance_set_transform, RID, const Transform3D &)
+	FUNC2(instance_set_interpolated, RID, bool)
+	FUNC1(instance_reset_physics_interpolation, RID)
 	FUNC2(instance_attach_object_instance_id, RID, ObjectID)
 	FUNC3(instance_set_blend_shape_weight, RID, int, float)
 	FUNC3(instance_set_surface_override_material, RID, int, RID)
@@ -839,6 +862,8 @@ public:
 	FUNC2(canvas_item_set_update_when_visible, RID, bool)
 
 	FUNC2(canvas_item_set_transform, RID, const Transform2D &)
+	FUNC2(canvas_item_set_interpolated, RID, bool)
+	FUNC1(canvas_item_reset_physics_interpolation, RID)
 	FUNC2(canvas_item_set_clip, RID, bool)
 	FUNC2(canvas_item_set_distance_field_mode, RID, bool)
 	FUNC3(canvas_item_set_custom_rect, RID, bool, const Rect2 &)
@@ -983,7 +1008,26 @@ public:
 
 	virtual void draw(bool p_swap_buffers, double frame_step) override;
 	virtual void sync() override;
+
+	virtual void set_physics_interpolation_enabled(bool p_enabled) override {
+		if (Thread::get_caller_id() == server_thread) {
+			command_queue.flush_if_pending();
+			_set_physics_interpolation_enabled(p_enabled);
+		} else {
+			command_queue.push(this, &RenderingServerDefault::_set_physics_interpolation_enabled, p_enabled);
+		}
+	}
+
+	virtual void tick() override {
+		if (Thread::get_caller_id() == server_thread) {
+			command_queue.flush_if_pending();
+			_tick();
+		} else {
+			command_queue.push(this, &RenderingServerDefault::_tick);
+		}
+	}
 	virtual bool has_changed() const override;
+	virtual bool is_draw_pipelined() const override;
 	virtual void init() override;
 	virtual void finish() override;
 
@@ -1008,7 +1052,7 @@ public:
 
 	virtual Size2i get_maximum_viewport_size() const override;
 
-	RenderingServerDefault(bool p_create_thread = false);
+	RenderingServerDefault(bool p_create_thread = false, bool p_pipelined = false);
 	~RenderingServerDefault();
 };
 
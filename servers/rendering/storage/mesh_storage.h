@@ -40,6 +40,9 @@ public:
 
 	/* MESH API */
 
+	// If true, meshes can be initialized from any thread instead of being deferred to the render thread.
+	virtual bool can_create_resources_async() const = 0;
+
 	virtual RID mesh_allocate() = 0;
 	virtual void mesh_initialize(RID p_rid) = 0;
 	virtual void mesh_free(RID p_rid) = 0;
@@ -143,6 +143,10 @@ public:
 	typedef void (*TextureDetectRoughnessCallback)(void *, const String &, TextureDetectRoughnessChannel);
 	virtual void texture_set_detect_roughness_callback(RID p_texture, TextureDetectRoughnessCallback p_callback, void *p_userdata) = 0;
 
+	// Called (from the rendering thread) with the largest on-screen size at which the texture was needed recently, or 0 once it stopped being used.
+	typedef void (*TextureStreamingCallback)(void *, RID, int);
+	virtual void texture_set_streaming_callback(RID p_texture, TextureStreamingCallback p_callback, void *p_userdata) = 0;
+
 	struct TextureInfo {
 		RID texture;
 		uint32_t width;
@@ -1222,6 +1226,8 @@ public:
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask) = 0;
 	virtual void instance_set_pivot_data(RID p_instance, float p_sorting_offset, bool p_use_aabb_center) = 0;
 	virtual void instance_set_transform(RID p_instance, const Transform3D &p_transform) = 0;
+	virtual void instance_set_interpolated(RID p_instance, bool p_interpolated) = 0;
+	virtual void instance_reset_physics_interpolation(RID p_instance) = 0;
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id) = 0;
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight) = 0;
 	virtual void instance_set_surface_override_material(RID p_instance, int p_surface, RID p_material) = 0;
@@ -1329,6 +1335,8 @@ public:
 	virtual void canvas_item_set_update_when_visible(RID p_item, bool p_update) = 0;
 
 	virtual void canvas_item_set_transform(RID p_item, const Transform2D &p_transform) = 0;
+	virtual void canvas_item_set_interpolated(RID p_item, bool p_interpolated) = 0;
+	virtual void canvas_item_reset_physics_interpolation(RID p_item) = 0;
 	virtual void canvas_item_set_clip(RID p_item, bool p_clip) = 0;
 	virtual void canvas_item_set_distance_field_mode(RID p_item, bool p_enable) = 0;
 	virtual void canvas_item_set_custom_rect(RID p_item, bool p_custom_rect, const Rect2 &p_rect = Rect2()) = 0;
@@ -1520,7 +1528,14 @@ public:
 
 	virtual void draw(bool p_swap_buffers = true, double frame_step = 0.0) = 0;
 	virtual void sync() = 0;
+
+	// When enabled, the transforms of interpolated instances and canvas items set during physics ticks are
+	// rendered interpolated between the last two ticks. tick() must be called before each physics tick.
+	virtual void set_physics_interpolation_enabled(bool p_enabled) = 0;
+	virtual void tick() = 0;
 	virtual bool has_changed() const = 0;
+	// True if the main loop doesn't need to sync() before each draw(), as the server paces the frames itself.
+	virtual bool is_draw_pipelined() const = 0;
 	virtual void init();
 	virtual void finish() = 0;
 
@@ -1533,6 +1548,12 @@ public:
 		RENDERING_INFO_TEXTURE_MEM_USED,
 		RENDERING_INFO_BUFFER_MEM_USED,
 		RENDERING_INFO_VIDEO_MEM_USED,
+		RENDERING_INFO_PIPELINE_COMPILATIONS_SYNC,
+		RENDERING_INFO_PIPELINE_COMPILATIONS_ASYNC,
+		RENDERING_INFO_SYNC_POINTS_IN_FRAME,
+		RENDERING_INFO_SKINNED_VERTICES_IN_FRAME,
+		RENDERING_INFO_SHADER_CACHE_HITS,
+		RENDERING_INFO_SHADER_CACHE_MISSES,
 		RENDERING_INFO_MAX
 	};
 
@@ -31,11 +31,38 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/os/os.h"
+#include "scene/resources/navigation_mesh.h"
 #include "servers/navigation_server_3d.h"
 
 #include "tests/test_macros.h"
 
 namespace TestNavigationServer3D {
+// A grid of 1x1 quads covering the rectangle in the XZ plane.
+static Ref<NavigationMesh> create_grid_navigation_mesh(const Rect2i &p_rect) {
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_rect.size.y; z++) {
+		for (int x = 0; x <= p_rect.size.x; x++) {
+			vertices.push_back(Vector3(p_rect.position.x + x, 0, p_rect.position.y + z));
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+	for (int z = 0; z < p_rect.size.y; z++) {
+		for (int x = 0; x < p_rect.size.x; x++) {
+			int index = z * (p_rect.size.x + 1) + x;
+			Vector<int> polygon;
+			polygon.push_back(index);
+			polygon.push_back(index + p_rect.size.x + 1);
+			polygon.push_back(index + p_rect.size.x + 2);
+			polygon.push_back(index + 1);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -144,6 +171,119 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->process(0.0); // Give server some cycles to actually remove map.
 		CHECK_EQ(navigation_server->get_maps().size(), 0);
 	}
+
+	TEST_CASE("[NavigationServer3D] Map should find paths on a large grid") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A grid of 1x1 quads crossed by a wall row, that can only be passed at its end.
+		const int grid_size = 100;
+		const int wall_row = grid_size / 2;
+		const int wall_gap = grid_size - 10;
+
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(Rect2i(0, 0, grid_size, grid_size));
+		Vector<Vector<int>> polygons;
+		for (int i = 0; i < navigation_mesh->get_polygon_count(); i++) {
+			// The helper adds the quads row by row.
+			if (i / grid_size != wall_row || i % grid_size >= wall_gap) {
+				polygons.push_back(navigation_mesh->get_polygon(i));
+			}
+		}
+		navigation_mesh->clear_polygons();
+		for (const Vector<int> &polygon : polygons) {
+			navigation_mesh->add_polygon(polygon);
+		}
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		RID region = navigation_server->region_create();
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Paths should go straight when nothing is in the way") {
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(5.5, 0, 5.5), Vector3(95.5, 0, 5.5), true);
+			REQUIRE_EQ(path.size(), 2);
+			CHECK(path[0].is_equal_approx(Vector3(5.5, 0, 5.5)));
+			CHECK(path[1].is_equal_approx(Vector3(95.5, 0, 5.5)));
+		}
+
+		SUBCASE("Paths should go around the wall") {
+			const Vector3 origin(5.5, 0, 5.5);
+			const Vector3 destination(5.5, 0, 95.5);
+
+			const int iterations = 20;
+			Vector<Vector3> path;
+			uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < iterations; i++) {
+				path = navigation_server->map_get_path(map, origin, destination, true);
+			}
+			MESSAGE("Average path query time: ", (OS::get_singleton()->get_ticks_usec() - begin_usec) / iterations, " usec.");
+
+			REQUIRE_GT(path.size(), 2);
+			CHECK(path[0].is_equal_approx(origin));
+			CHECK(path[path.size() - 1].is_equal_approx(destination));
+
+			real_t length = 0.0;
+			for (int i = 1; i < path.size(); i++) {
+				length += path[i - 1].distance_to(path[i]);
+			}
+			CHECK_GT(length, 2.0 * (wall_gap - origin.x));
+		}
+
+		SUBCASE("Closest points should be on the closest polygons") {
+			CHECK(navigation_server->map_get_closest_point(map, Vector3(10.5, 3, 10.5)).is_equal_approx(Vector3(10.5, 0, 10.5)));
+			CHECK(navigation_server->map_get_closest_point(map, Vector3(-3, 0, 20.5)).is_equal_approx(Vector3(0, 0, 20.5)));
+			CHECK(navigation_server->map_get_closest_point(map, Vector3(10.5, 0, wall_row + 0.2)).is_equal_approx(Vector3(10.5, 0, wall_row)));
+			CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(20.5, 5, 20.5), Vector3(20.5, -5, 20.5)).is_equal_approx(Vector3(20.5, 0, 20.5)));
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to actually remove map.
+		CHECK_EQ(navigation_server->get_maps().size(), 0);
+	}
+
+	TEST_CASE("[NavigationServer3D] Map should find the cheapest path through several regions") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A corridor whose middle region is expensive to travel, along a cheap and longer detour region.
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		const Rect2i rects[4] = { Rect2i(0, 0, 2, 2), Rect2i(2, 0, 6, 2), Rect2i(8, 0, 2, 2), Rect2i(0, 2, 10, 2) };
+		RID regions[4];
+		for (int i = 0; i < 4; i++) {
+			regions[i] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[i], map);
+			navigation_server->region_set_navigation_mesh(regions[i], create_grid_navigation_mesh(rects[i]));
+		}
+		navigation_server->region_set_travel_cost(regions[1], 10.0);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 origin(0.5, 0, 0.5);
+		const Vector3 destination(9.5, 0, 0.5);
+		Vector<Vector3> path = navigation_server->map_get_path(map, origin, destination, true);
+		REQUIRE_GT(path.size(), 2);
+		CHECK(path[0].is_equal_approx(origin));
+		CHECK(path[path.size() - 1].is_equal_approx(destination));
+
+		// Going through the detour costs about 10, going straight through the middle region costs over 60.
+		real_t length = 0.0;
+		real_t detour_depth = 0.0;
+		for (int i = 1; i < path.size(); i++) {
+			length += path[i - 1].distance_to(path[i]);
+			detour_depth = MAX(detour_depth, path[i].z);
+		}
+		CHECK_GE(detour_depth, 2.0 - CMP_EPSILON);
+		CHECK_LT(length, 11.0);
+
+		for (int i = 0; i < 4; i++) {
+			navigation_server->free(regions[i]);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to actually remove map.
+		CHECK_EQ(navigation_server->get_maps().size(), 0);
+	}
 }
 } //namespace TestNavigationServer3D
 
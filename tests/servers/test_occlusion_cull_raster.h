@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*  test_occlusion_cull_raster.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_OCCLUSION_CULL_RASTER_H
+#define TEST_OCCLUSION_CULL_RASTER_H
+
+#include "servers/rendering/renderer_scene_occlusion_cull_raster.h"
+
+#include "tests/test_macros.h"
+
+namespace TestOcclusionCullRaster {
+
+typedef RendererSceneOcclusionCullRaster::RasterHZBuffer RasterHZBuffer;
+
+// Rasterizes a single quad of the given half size, facing the camera at the given distance.
+static void rasterize_quad(RasterHZBuffer &r_buffer, real_t p_half_size, real_t p_distance, const Projection &p_projection, bool p_orthogonal) {
+	const Vector3 vertices[4] = {
+		Vector3(-p_half_size, -p_half_size, -p_distance),
+		Vector3(p_half_size, -p_half_size, -p_distance),
+		Vector3(p_half_size, p_half_size, -p_distance),
+		Vector3(-p_half_size, p_half_size, -p_distance),
+	};
+	const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+	LocalVector<RasterHZBuffer::ScreenTriangle> triangles;
+	RasterHZBuffer::setup_triangles(vertices, indices, 6, Transform3D(), p_projection, p_orthogonal, r_buffer.get_size(), triangles);
+	r_buffer.rasterize(&triangles, 1, p_orthogonal, p_projection.get_z_far());
+	r_buffer.update_mips();
+}
+
+static bool is_box_occluded(const RasterHZBuffer &p_buffer, const AABB &p_aabb, const Projection &p_projection) {
+	const real_t bounds[6] = { p_aabb.position.x, p_aabb.position.y, p_aabb.position.z, p_aabb.position.x + p_aabb.size.x, p_aabb.position.y + p_aabb.size.y, p_aabb.position.z + p_aabb.size.z };
+	return p_buffer.is_occluded(bounds, Vector3(), Transform3D(), p_projection, p_projection.get_z_near());
+}
+
+TEST_CASE("[OcclusionCullRaster] Perspective occlusion") {
+	RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+	Projection projection = Projection::create_perspective(90.0, 1.0, 0.05, 100.0);
+
+	rasterize_quad(buffer, 2.0, 10.0, projection, false);
+
+	CHECK_MESSAGE(is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -30.0), Vector3(1.0, 1.0, 5.0)), projection),
+			"A box behind the occluder should be occluded.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -6.0), Vector3(1.0, 1.0, 1.0)), projection),
+			"A box in front of the occluder should be visible.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(buffer, AABB(Vector3(8.0, -0.5, -30.0), Vector3(1.0, 1.0, 5.0)), projection),
+			"A box behind the occluder, but outside of its silhouette, should be visible.");
+}
+
+TEST_CASE("[OcclusionCullRaster] Orthogonal occlusion") {
+	RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+	Projection projection;
+	projection.set_orthogonal(-10.0, 10.0, -10.0, 10.0, 0.05, 100.0);
+
+	rasterize_quad(buffer, 4.0, 10.0, projection, true);
+
+	CHECK(is_box_occluded(buffer, AABB(Vector3(-1.0, -1.0, -30.0), Vector3(2.0, 2.0, 5.0)), projection));
+	CHECK_FALSE(is_box_occluded(buffer, AABB(Vector3(-1.0, -1.0, -6.0), Vector3(2.0, 2.0, 1.0)), projection));
+	CHECK_FALSE(is_box_occluded(buffer, AABB(Vector3(6.0, -1.0, -30.0), Vector3(2.0, 2.0, 5.0)), projection));
+}
+
+TEST_CASE("[OcclusionCullRaster] Near plane clipping") {
+	RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+	Projection projection = Projection::create_perspective(90.0, 1.0, 0.05, 100.0);
+
+	// A floor-like triangle crossing the near plane must not cover the whole screen.
+	const Vector3 vertices[3] = { Vector3(-50.0, -1.0, -50.0), Vector3(50.0, -1.0, -50.0), Vector3(0.0, -1.0, 5.0) };
+	const uint32_t indices[3] = { 0, 1, 2 };
+	LocalVector<RasterHZBuffer::ScreenTriangle> triangles;
+	RasterHZBuffer::setup_triangles(vertices, indices, 3, Transform3D(), projection, false, buffer.get_size(), triangles);
+	CHECK(triangles.size() == 2);
+
+	buffer.rasterize(&triangles, 1, false, projection.get_z_far());
+	buffer.update_mips();
+
+	CHECK(is_box_occluded(buffer, AABB(Vector3(-0.5, -3.0, -20.0), Vector3(1.0, 1.0, 1.0)), projection));
+	CHECK_FALSE(is_box_occluded(buffer, AABB(Vector3(-0.5, 1.0, -20.0), Vector3(1.0, 1.0, 1.0)), projection));
+}
+
+} // namespace TestOcclusionCullRaster
+
+#endif // TEST_OCCLUSION_CULL_RASTER_H
@@ -0,0 +1,757 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/config/project_settings.h"
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/templates/hash_set.h"
+#include "servers/physics_3d/godot_physics_server_3d.h"
+#include "servers/physics_3d/godot_shape_3d.h"
+#include "servers/physics_3d/godot_soft_body_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+struct BodySnapshot {
+	Transform3D transform;
+	Vector3 linear_velocity;
+	Vector3 angular_velocity;
+
+	bool operator==(const BodySnapshot &p_other) const {
+		return transform == p_other.transform && linear_velocity == p_other.linear_velocity && angular_velocity == p_other.angular_velocity;
+	}
+};
+
+// A static floor with layers of unit boxes on it, slightly overlapping so every box touches its neighbors.
+// All the boxes end up in a single island, large enough to be solved by colors.
+class BoxStackScene {
+public:
+	GodotPhysicsServer3D *physics_server = nullptr;
+	RID space;
+	RID floor;
+	RID floor_shape;
+	RID box_shape;
+	LocalVector<RID> boxes;
+
+	BoxStackScene(const Vector3i &p_size) {
+		physics_server = memnew(GodotPhysicsServer3D);
+		physics_server->init();
+		physics_server->set_active(true);
+
+		space = physics_server->space_create();
+		physics_server->space_set_active(space, true);
+
+		floor_shape = physics_server->box_shape_create();
+		physics_server->shape_set_data(floor_shape, Vector3(p_size.x + 10.0, 0.5, p_size.z + 10.0));
+		floor = physics_server->body_create();
+		physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		physics_server->body_add_shape(floor, floor_shape);
+		physics_server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -0.5, 0)));
+		physics_server->body_set_space(floor, space);
+
+		box_shape = physics_server->box_shape_create();
+		physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		for (int y = 0; y < p_size.y; y++) {
+			for (int z = 0; z < p_size.z; z++) {
+				for (int x = 0; x < p_size.x; x++) {
+					RID box = physics_server->body_create();
+					physics_server->body_add_shape(box, box_shape);
+					physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 0.99, 0.5 + y * 0.99, z * 0.99)));
+					physics_server->body_set_space(box, space);
+					boxes.push_back(box);
+				}
+			}
+		}
+	}
+
+	void step(int p_steps) {
+		for (int i = 0; i < p_steps; i++) {
+			physics_server->step(1.0 / 60.0);
+		}
+	}
+
+	LocalVector<BodySnapshot> get_snapshot() const {
+		LocalVector<BodySnapshot> snapshot;
+		for (const RID &box : boxes) {
+			BodySnapshot body;
+			body.transform = physics_server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+			body.linear_velocity = physics_server->body_get_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+			body.angular_velocity = physics_server->body_get_state(box, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY);
+			snapshot.push_back(body);
+		}
+		return snapshot;
+	}
+
+	~BoxStackScene() {
+		for (const RID &box : boxes) {
+			physics_server->free(box);
+		}
+		physics_server->free(floor);
+		physics_server->free(box_shape);
+		physics_server->free(floor_shape);
+		physics_server->free(space);
+		physics_server->finish();
+		memdelete(physics_server);
+	}
+};
+
+static bool snapshots_equal(const LocalVector<BodySnapshot> &p_a, const LocalVector<BodySnapshot> &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < p_a.size(); i++) {
+		if (!(p_a[i] == p_b[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static LocalVector<BodySnapshot> simulate_box_stack(const Vector3i &p_size, int p_steps) {
+	BoxStackScene scene(p_size);
+	scene.step(p_steps);
+	return scene.get_snapshot();
+}
+
+// Sum of the impulses of the contacts reported by each box.
+static LocalVector<Vector3> simulate_box_stack_impulses(const Vector3i &p_size, int p_steps, bool p_wide_contact_solver) {
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/use_wide_contact_solver", p_wide_contact_solver);
+	BoxStackScene scene(p_size);
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/use_wide_contact_solver", false);
+
+	for (const RID &box : scene.boxes) {
+		scene.physics_server->body_set_max_contacts_reported(box, 16);
+	}
+	scene.step(p_steps);
+
+	LocalVector<Vector3> impulses;
+	for (const RID &box : scene.boxes) {
+		PhysicsDirectBodyState3D *state = scene.physics_server->body_get_direct_state(box);
+		Vector3 impulse;
+		for (int i = 0; i < state->get_contact_count(); i++) {
+			impulse += state->get_contact_impulse(i);
+		}
+		impulses.push_back(impulse);
+	}
+	return impulses;
+}
+
+static bool slide_results_equal(const PhysicsServer3D::SlideResult &p_a, const PhysicsServer3D::SlideResult &p_b) {
+	if (p_a.transform != p_b.transform || p_a.velocity != p_b.velocity || p_a.last_motion != p_b.last_motion) {
+		return false;
+	}
+	if (p_a.floor_normal != p_b.floor_normal || p_a.wall_normal != p_b.wall_normal || p_a.ceiling_normal != p_b.ceiling_normal) {
+		return false;
+	}
+	if (p_a.on_floor != p_b.on_floor || p_a.on_wall != p_b.on_wall || p_a.on_ceiling != p_b.on_ceiling) {
+		return false;
+	}
+	if (p_a.platform_rid != p_b.platform_rid || p_a.platform_velocity != p_b.platform_velocity || p_a.motion_results.size() != p_b.motion_results.size()) {
+		return false;
+	}
+	for (int i = 0; i < p_a.motion_results.size(); i++) {
+		if (p_a.motion_results[i].travel != p_b.motion_results[i].travel || p_a.motion_results[i].collision_count != p_b.motion_results[i].collision_count) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Wavy grid of triangles, with enough faces for the BVH to be built in parallel.
+static Vector<Vector3> create_concave_faces(int p_width, int p_depth) {
+	Vector<Vector3> faces;
+	for (int z = 0; z < p_depth; z++) {
+		for (int x = 0; x < p_width; x++) {
+			Vector3 v[4];
+			for (int i = 0; i < 4; i++) {
+				real_t vx = x + (i & 1);
+				real_t vz = z + (i >> 1);
+				v[i] = Vector3(vx, Math::sin(vx * 0.3) * Math::cos(vz * 0.2) * 2.0, vz);
+			}
+			faces.push_back(v[0]);
+			faces.push_back(v[1]);
+			faces.push_back(v[3]);
+			faces.push_back(v[3]);
+			faces.push_back(v[2]);
+			faces.push_back(v[0]);
+		}
+	}
+	return faces;
+}
+
+static void setup_concave_shape(GodotConcavePolygonShape3D &r_shape, const Vector<Vector3> &p_faces, const Vector<uint8_t> &p_bvh_data = Vector<uint8_t>()) {
+	Dictionary d;
+	d["faces"] = p_faces;
+	d["backface_collision"] = false;
+	if (!p_bvh_data.is_empty()) {
+		d["bvh"] = p_bvh_data;
+	}
+	r_shape.set_data(d);
+}
+
+static Vector3 get_face_center(const Vector3 *p_vertices) {
+	return (p_vertices[0] + p_vertices[1] + p_vertices[2]) / 3.0;
+}
+
+static bool concave_brute_force_segment(const Vector<Vector3> &p_faces, const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_result) {
+	Vector3 dir = (p_end - p_begin).normalized();
+	real_t min_d = 1e20;
+	bool collided = false;
+	for (int i = 0; i < p_faces.size(); i += 3) {
+		GodotFaceShape3D face;
+		face.vertex[0] = p_faces[i + 0];
+		face.vertex[1] = p_faces[i + 1];
+		face.vertex[2] = p_faces[i + 2];
+		face.normal = Face3(face.vertex[0], face.vertex[1], face.vertex[2]).get_plane().normal;
+
+		Vector3 res;
+		Vector3 normal;
+		if (face.intersect_segment(p_begin, p_end, res, normal, true)) {
+			real_t d = dir.dot(res) - dir.dot(p_begin);
+			if (d > 0 && d < min_d) {
+				min_d = d;
+				r_result = res;
+				collided = true;
+			}
+		}
+	}
+	return collided;
+}
+
+static bool concave_cull_callback(void *p_userdata, GodotShape3D *p_convex) {
+	GodotFaceShape3D *face = static_cast<GodotFaceShape3D *>(p_convex);
+	static_cast<HashSet<Vector3> *>(p_userdata)->insert(get_face_center(face->vertex));
+	return false;
+}
+
+// Segments and AABBs scattered over the grid, the same ones on each call.
+static void create_concave_queries(int p_width, int p_depth, LocalVector<Vector3> &r_segments, LocalVector<AABB> &r_aabbs) {
+	RandomPCG rng(42);
+	for (int i = 0; i < 200; i++) {
+		Vector3 begin(rng.random(-5.0f, p_width + 5.0f), rng.random(-5.0f, 5.0f), rng.random(-5.0f, p_depth + 5.0f));
+		Vector3 end(rng.random(-5.0f, p_width + 5.0f), rng.random(-5.0f, 5.0f), rng.random(-5.0f, p_depth + 5.0f));
+		r_segments.push_back(begin);
+		r_segments.push_back(end);
+
+		Vector3 position(rng.random(-5.0f, p_width + 5.0f), rng.random(-3.0f, 3.0f), rng.random(-5.0f, p_depth + 5.0f));
+		r_aabbs.push_back(AABB(position, Vector3(rng.random(0.0f, 4.0f), rng.random(0.0f, 2.0f), rng.random(0.0f, 4.0f))));
+	}
+}
+
+// Square cloth of p_size by p_size cells, two triangles each.
+static bool create_cloth(GodotSoftBody3D &r_soft_body, int p_size) {
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_size; z++) {
+		for (int x = 0; x <= p_size; x++) {
+			vertices.push_back(Vector3(x * 0.1, 0, z * 0.1));
+		}
+	}
+	Vector<int> indices;
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			int i = z * (p_size + 1) + x;
+			indices.push_back(i);
+			indices.push_back(i + 1);
+			indices.push_back(i + p_size + 2);
+			indices.push_back(i + p_size + 2);
+			indices.push_back(i + p_size + 1);
+			indices.push_back(i);
+		}
+	}
+	return r_soft_body.create_from_trimesh(indices, vertices);
+}
+
+// Shakes the cloth nodes, then lets the links pull them back.
+static void shake_cloth(GodotSoftBody3D &r_soft_body, int p_steps) {
+	RandomPCG rng(7);
+	for (uint32_t i = 0; i < r_soft_body.get_node_count(); i++) {
+		Vector3 velocity(rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f));
+		r_soft_body.apply_node_impulse(i, velocity / r_soft_body.get_node_inv_mass(i));
+	}
+	for (int i = 0; i < p_steps; i++) {
+		r_soft_body.solve_constraints(1.0 / 60.0);
+	}
+}
+
+static LocalVector<Vector3> simulate_cloth(int p_size, int p_steps) {
+	GodotSoftBody3D soft_body;
+	create_cloth(soft_body, p_size);
+	shake_cloth(soft_body, p_steps);
+
+	LocalVector<Vector3> positions;
+	for (uint32_t i = 0; i < soft_body.get_node_count(); i++) {
+		positions.push_back(soft_body.get_node_position(i));
+	}
+	return positions;
+}
+
+TEST_SUITE("[Physics]") {
+	TEST_CASE("[PhysicsServer3D] Colored island solving should not depend on threads") {
+		const Vector3i size(10, 3, 10);
+		const int steps = 20;
+
+		LocalVector<BodySnapshot> first = simulate_box_stack(size, steps);
+		LocalVector<BodySnapshot> second = simulate_box_stack(size, steps);
+		CHECK_MESSAGE(snapshots_equal(first, second), "Running the same simulation twice should give bit-identical results.");
+
+		// Same simulation with a single worker thread.
+		WorkerThreadPool::get_singleton()->finish();
+		WorkerThreadPool::get_singleton()->init(1);
+		LocalVector<BodySnapshot> single_thread = simulate_box_stack(size, steps);
+		WorkerThreadPool::get_singleton()->finish();
+		WorkerThreadPool::get_singleton()->init();
+		CHECK_MESSAGE(snapshots_equal(first, single_thread), "Results should be bit-identical with any amount of threads.");
+
+		// The boxes should still be resting on each other.
+		CHECK(first[0].transform.origin.y > 0.0);
+		CHECK(first[first.size() - 1].transform.origin.y > 1.0);
+	}
+
+	TEST_CASE("[PhysicsServer3D] Restoring a saved space state should give identical steps") {
+		const int steps = 20;
+
+		{
+			BoxStackScene scene(Vector3i(2, 2, 2));
+			scene.step(10); // Lets the boxes settle, so the state has contacts to restore.
+			Vector<uint8_t> state = scene.physics_server->space_save_state(scene.space);
+			scene.step(steps);
+			LocalVector<BodySnapshot> expected = scene.get_snapshot();
+
+			REQUIRE(scene.physics_server->space_restore_state(scene.space, state));
+			scene.step(steps);
+			CHECK_MESSAGE(snapshots_equal(expected, scene.get_snapshot()), "Steps after restoring should be bit-identical to the ones after saving.");
+		}
+
+		{
+			BoxStackScene scene(Vector3i(2, 2, 2));
+			scene.step(10);
+			Vector<uint8_t> state = scene.physics_server->space_save_state(scene.space);
+			scene.step(steps);
+			LocalVector<BodySnapshot> expected = scene.get_snapshot();
+
+			// Throws the stack away, so the pairs with the floor are dropped by the broadphase before restoring, and
+			// created again after the pairs between the boxes.
+			REQUIRE(scene.physics_server->space_restore_state(scene.space, state));
+			for (const RID &box : scene.boxes) {
+				scene.physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(0, 50, 0));
+			}
+			scene.step(steps);
+			CHECK(scene.get_snapshot()[0].transform.origin.y > 10.0);
+
+			REQUIRE(scene.physics_server->space_restore_state(scene.space, state));
+			scene.step(steps);
+			CHECK_MESSAGE(snapshots_equal(expected, scene.get_snapshot()), "Pairs dropped since the state was saved should get their contacts back.");
+		}
+	}
+
+	TEST_CASE("[PhysicsServer3D] Updating a height map region should wake up the bodies on it") {
+		GodotPhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D);
+		physics_server->init();
+		physics_server->set_active(true);
+
+		RID space = physics_server->space_create();
+		physics_server->space_set_active(space, true);
+
+		// A flat terrain with a single low corner, so digging in the middle stays within its AABB.
+		const int size = 10;
+		Vector<real_t> heights;
+		heights.resize(size * size);
+		heights.fill(0.0);
+		heights.write[0] = -5.0;
+
+		Dictionary data;
+		data["width"] = size;
+		data["depth"] = size;
+		data["heights"] = heights;
+		data["min_height"] = -5.0;
+		data["max_height"] = 0.0;
+
+		RID height_map_shape = physics_server->heightmap_shape_create();
+		physics_server->shape_set_data(height_map_shape, data);
+		RID terrain = physics_server->body_create();
+		physics_server->body_set_mode(terrain, PhysicsServer3D::BODY_MODE_STATIC);
+		physics_server->body_add_shape(terrain, height_map_shape);
+		physics_server->body_set_space(terrain, space);
+
+		RID box_shape = physics_server->box_shape_create();
+		physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		RID box = physics_server->body_create();
+		physics_server->body_add_shape(box, box_shape);
+		physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 0.5, 0)));
+		physics_server->body_set_space(box, space);
+
+		for (int i = 0; i < 180; i++) {
+			physics_server->step(1.0 / 60.0);
+		}
+		REQUIRE(bool(physics_server->body_get_state(box, PhysicsServer3D::BODY_STATE_SLEEPING)));
+		real_t resting_height = Transform3D(physics_server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin.y;
+
+		// Digs a pit under the box.
+		const Rect2i region(3, 3, 4, 4);
+		Vector<real_t> region_heights;
+		region_heights.resize(region.size.x * region.size.y);
+		region_heights.fill(-2.0);
+
+		Dictionary region_data;
+		region_data["region"] = region;
+		region_data["heights"] = region_heights;
+		physics_server->shape_set_data(height_map_shape, region_data);
+		Dictionary updated_data = physics_server->shape_get_data(height_map_shape);
+		CHECK_MESSAGE(real_t(updated_data["min_height"]) == -5.0, "The pit should be within the AABB, which is then not reconfigured.");
+
+		physics_server->step(1.0 / 60.0);
+		CHECK_FALSE(bool(physics_server->body_get_state(box, PhysicsServer3D::BODY_STATE_SLEEPING)));
+		for (int i = 0; i < 60; i++) {
+			physics_server->step(1.0 / 60.0);
+		}
+		CHECK(Transform3D(physics_server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin.y < resting_height - 1.0);
+
+		physics_server->free(box);
+		physics_server->free(terrain);
+		physics_server->free(box_shape);
+		physics_server->free(height_map_shape);
+		physics_server->free(space);
+		physics_server->finish();
+		memdelete(physics_server);
+	}
+
+	TEST_CASE("[PhysicsServer3D] Wide contact solver should match the scalar contact solver") {
+		const Vector3i size(10, 3, 10);
+		const int steps = 10;
+
+		LocalVector<Vector3> scalar = simulate_box_stack_impulses(size, steps, false);
+		LocalVector<Vector3> wide = simulate_box_stack_impulses(size, steps, true);
+		REQUIRE(scalar.size() == wide.size());
+
+		// Both solve the same contacts in the same order, only the rounding of the operations differs.
+		real_t max_difference = 0.0;
+		for (uint32_t i = 0; i < scalar.size(); i++) {
+			max_difference = MAX(max_difference, (scalar[i] - wide[i]).length());
+		}
+		CHECK_MESSAGE(max_difference < 1e-3, "Impulses of the wide contact solver should match GodotBodyPair3D::solve().");
+
+		// The boxes at the bottom carry the weight of the ones above them.
+		CHECK(scalar[0].length() > 0.0);
+	}
+
+	TEST_CASE("[PhysicsServer3D] Batched slides should match unbatched ones") {
+		// Kinematic boxes pushing into each other towards the center of the floor, so they hit the floor and walls.
+		BoxStackScene scene(Vector3i(4, 1, 4));
+		const Vector3 center(1.5 * 0.99, 0.5, 1.5 * 0.99);
+		const int steps = 20;
+
+		LocalVector<PhysicsServer3D::SlideResult> states;
+		for (const RID &box : scene.boxes) {
+			scene.physics_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_KINEMATIC);
+			PhysicsServer3D::SlideResult state;
+			state.on_floor = true;
+			state.floor_normal = Vector3(0, 1, 0);
+			state.platform_rid = scene.floor;
+			states.push_back(state);
+		}
+
+		int collisions = 0;
+		int constant_speed_on_floor = 0;
+		for (int step = 0; step < steps; step++) {
+			LocalVector<PhysicsServer3D::SlideParameters> parameters;
+			for (uint32_t i = 0; i < scene.boxes.size(); i++) {
+				PhysicsServer3D::SlideParameters body_parameters;
+				body_parameters.from = scene.physics_server->body_get_state(scene.boxes[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+				body_parameters.velocity = (center - body_parameters.from.origin).normalized() * 3.0 + Vector3(0, -2, 0);
+				body_parameters.delta = 1.0 / 60.0;
+				body_parameters.floor_constant_speed = i % 2 == 0;
+				body_parameters.floor_block_on_wall = i % 3 != 0;
+				if (i % 4 == 0) {
+					body_parameters.platform_velocity = Vector3(1, 0, 0);
+				}
+				parameters.push_back(body_parameters);
+			}
+
+			LocalVector<PhysicsServer3D::SlideResult> unbatched = states;
+			for (uint32_t i = 0; i < scene.boxes.size(); i++) {
+				scene.physics_server->body_move_and_slide(scene.boxes[i], parameters[i], unbatched[i]);
+			}
+
+			LocalVector<PhysicsServer3D::SlideResult> batched = states;
+			scene.physics_server->body_move_and_slide_batch(scene.boxes.ptr(), parameters.ptr(), scene.boxes.size(), batched.ptr());
+
+			for (uint32_t i = 0; i < scene.boxes.size(); i++) {
+				CHECK_MESSAGE(slide_results_equal(unbatched[i], batched[i]), "Step ", step, ", body ", i, " should slide the same in a batch.");
+				collisions += batched[i].motion_results.size();
+				if (parameters[i].floor_constant_speed && batched[i].on_floor) {
+					constant_speed_on_floor++;
+				}
+				scene.physics_server->body_set_state(scene.boxes[i], PhysicsServer3D::BODY_STATE_TRANSFORM, batched[i].transform);
+			}
+			states = batched;
+		}
+
+		// The boxes should have been sliding on the floor and against each other.
+		CHECK(collisions > 0);
+		CHECK(constant_speed_on_floor > 0);
+	}
+
+	TEST_CASE("[GodotConcavePolygonShape3D] BVH queries should match brute force") {
+		const int width = 130;
+		const int depth = 70;
+		Vector<Vector3> faces = create_concave_faces(width, depth);
+		GodotConcavePolygonShape3D shape;
+		setup_concave_shape(shape, faces);
+		REQUIRE(shape.get_faces() == faces);
+
+		LocalVector<Vector3> segments;
+		LocalVector<AABB> aabbs;
+		create_concave_queries(width, depth, segments, aabbs);
+
+		int hits = 0;
+		for (uint32_t i = 0; i < segments.size(); i += 2) {
+			Vector3 expected;
+			bool expected_hit = concave_brute_force_segment(faces, segments[i], segments[i + 1], expected);
+			Vector3 result;
+			Vector3 normal;
+			bool hit = shape.intersect_segment(segments[i], segments[i + 1], result, normal, true);
+			CHECK(hit == expected_hit);
+			if (hit && expected_hit) {
+				CHECK(result.is_equal_approx(expected));
+				hits++;
+			}
+		}
+		CHECK(hits > 0);
+
+		for (const AABB &aabb : aabbs) {
+			HashSet<Vector3> culled;
+			shape.cull(aabb, concave_cull_callback, &culled, false);
+			// Leaves and quantized bounds are conservative, extra faces are fine but none can be missing.
+			for (int i = 0; i < faces.size(); i += 3) {
+				AABB face_aabb(faces[i], Vector3());
+				face_aabb.expand_to(faces[i + 1]);
+				face_aabb.expand_to(faces[i + 2]);
+				if (face_aabb.intersects(aabb)) {
+					CHECK(culled.has(get_face_center(&faces[i])));
+				}
+			}
+		}
+
+		// Faces have no volume.
+		CHECK_FALSE(shape.intersect_point(Vector3(width * 0.5, 0, depth * 0.5)));
+	}
+
+	TEST_CASE("[GodotConcavePolygonShape3D] Saved BVH should load back with identical queries") {
+		const int width = 40;
+		const int depth = 30;
+		Vector<Vector3> faces = create_concave_faces(width, depth);
+		GodotConcavePolygonShape3D shape;
+		setup_concave_shape(shape, faces);
+
+		Dictionary data = shape.get_data();
+		REQUIRE(data.has("bvh"));
+		Vector<uint8_t> bvh_data = data["bvh"];
+
+		GodotConcavePolygonShape3D loaded;
+		setup_concave_shape(loaded, faces, bvh_data);
+		REQUIRE(loaded.bvh.size() == shape.bvh.size());
+		CHECK(memcmp(loaded.bvh.ptr(), shape.bvh.ptr(), shape.bvh.size() * sizeof(GodotConcavePolygonShape3D::BVH)) == 0);
+		Dictionary loaded_data = loaded.get_data();
+		CHECK(Vector<uint8_t>(loaded_data["bvh"]) == bvh_data);
+
+		LocalVector<Vector3> segments;
+		LocalVector<AABB> aabbs;
+		create_concave_queries(width, depth, segments, aabbs);
+		for (uint32_t i = 0; i < segments.size(); i += 2) {
+			Vector3 result;
+			Vector3 normal;
+			bool hit = shape.intersect_segment(segments[i], segments[i + 1], result, normal, true);
+			Vector3 loaded_result;
+			Vector3 loaded_normal;
+			bool loaded_hit = loaded.intersect_segment(segments[i], segments[i + 1], loaded_result, loaded_normal, true);
+			CHECK(hit == loaded_hit);
+			if (hit && loaded_hit) {
+				CHECK(result == loaded_result);
+				CHECK(normal == loaded_normal);
+			}
+		}
+		for (const AABB &aabb : aabbs) {
+			HashSet<Vector3> culled;
+			shape.cull(aabb, concave_cull_callback, &culled, false);
+			HashSet<Vector3> loaded_culled;
+			loaded.cull(aabb, concave_cull_callback, &loaded_culled, false);
+			CHECK(culled.size() == loaded_culled.size());
+			for (const Vector3 &center : culled) {
+				CHECK(loaded_culled.has(center));
+			}
+		}
+	}
+
+	TEST_CASE("[GodotConcavePolygonShape3D] Invalid BVH data should be rejected") {
+		Vector<Vector3> faces = create_concave_faces(20, 20);
+		GodotConcavePolygonShape3D shape;
+		setup_concave_shape(shape, faces);
+		Dictionary data = shape.get_data();
+		const Vector<uint8_t> bvh_data = data["bvh"];
+		const Vector<GodotConcavePolygonShape3D::BVH> bvh = shape.bvh;
+
+		Vector<uint32_t> face_order;
+		CHECK(shape._load_bvh(bvh_data, face_order));
+
+		// The header and the root node, then the source index of each face.
+		const int header_size = bvh_data.size() - bvh.size() * sizeof(GodotConcavePolygonShape3D::BVH) - faces.size() / 3 * sizeof(uint32_t);
+		const int root_index_offset = header_size + offsetof(GodotConcavePolygonShape3D::BVH, index);
+		REQUIRE(bvh[0].face_count == 0);
+
+		ERR_PRINT_OFF;
+
+		Vector<uint8_t> truncated = bvh_data;
+		truncated.resize(truncated.size() - 4);
+		CHECK_FALSE(shape._load_bvh(truncated, face_order));
+		truncated.resize(8);
+		CHECK_FALSE(shape._load_bvh(truncated, face_order));
+
+		Vector<uint8_t> bad_child = bvh_data;
+		uint32_t out_of_range = bvh.size();
+		memcpy(bad_child.ptrw() + root_index_offset, &out_of_range, sizeof(uint32_t));
+		CHECK_FALSE(shape._load_bvh(bad_child, face_order));
+
+		Vector<uint8_t> cycle = bvh_data;
+		uint32_t root = 0;
+		memcpy(cycle.ptrw() + root_index_offset, &root, sizeof(uint32_t));
+		CHECK_FALSE(shape._load_bvh(cycle, face_order));
+
+		Vector<uint8_t> duplicate_face = bvh_data;
+		memcpy(duplicate_face.ptrw() + duplicate_face.size() - sizeof(uint32_t), duplicate_face.ptr() + duplicate_face.size() - 2 * sizeof(uint32_t), sizeof(uint32_t));
+		CHECK_FALSE(shape._load_bvh(duplicate_face, face_order));
+
+		ERR_PRINT_ON;
+
+		// Saved for other faces.
+		Vector<Vector3> moved_faces = faces;
+		moved_faces.write[0].y += 1.0;
+		GodotConcavePolygonShape3D moved;
+		setup_concave_shape(moved, moved_faces);
+		CHECK_FALSE(moved._load_bvh(bvh_data, face_order));
+
+		// Rejected data is built again, and the shape still works.
+		GodotConcavePolygonShape3D rebuilt;
+		ERR_PRINT_OFF;
+		setup_concave_shape(rebuilt, faces, bad_child);
+		ERR_PRINT_ON;
+		REQUIRE(rebuilt.bvh.size() == bvh.size());
+		CHECK(memcmp(rebuilt.bvh.ptr(), bvh.ptr(), bvh.size() * sizeof(GodotConcavePolygonShape3D::BVH)) == 0);
+
+		// The BVH is kept when only backface collision changes.
+		const GodotConcavePolygonShape3D::BVH *bvh_ptr = rebuilt.bvh.ptr();
+		data["backface_collision"] = true;
+		data.erase("bvh");
+		rebuilt.set_data(data);
+		CHECK(rebuilt.backface_collision);
+		CHECK(rebuilt.bvh.ptr() == bvh_ptr);
+	}
+
+	TEST_CASE("[GodotSoftBody3D] Links of the same color should share no node") {
+		GodotSoftBody3D soft_body;
+		REQUIRE(create_cloth(soft_body, 45));
+		CHECK(soft_body.is_solver_threaded());
+
+		const LocalVector<uint32_t> &color_offsets = soft_body.get_link_color_offsets();
+		REQUIRE(color_offsets.size() > 1);
+		CHECK(color_offsets[0] == 0);
+		CHECK(color_offsets[color_offsets.size() - 1] <= soft_body.get_link_count());
+
+		// Color each node was last seen with.
+		LocalVector<uint32_t> node_colors;
+		node_colors.resize(soft_body.get_node_count());
+		memset(node_colors.ptr(), 0xff, node_colors.size() * sizeof(uint32_t));
+
+		int conflicts = 0;
+		for (uint32_t color = 0; color < color_offsets.size() - 1; color++) {
+			CHECK(color_offsets[color] <= color_offsets[color + 1]);
+			for (uint32_t link = color_offsets[color]; link < color_offsets[color + 1]; link++) {
+				uint32_t node_1 = 0;
+				uint32_t node_2 = 0;
+				soft_body.get_link_nodes(link, node_1, node_2);
+				conflicts += node_colors[node_1] == color;
+				conflicts += node_colors[node_2] == color;
+				node_colors[node_1] = color;
+				node_colors[node_2] = color;
+			}
+		}
+		CHECK(conflicts == 0);
+	}
+
+	TEST_CASE("[GodotSoftBody3D] Threaded link solving should not depend on threads") {
+		const int size = 45;
+		const int steps = 10;
+
+		LocalVector<Vector3> threaded = simulate_cloth(size, steps);
+
+		// Batches of each color are solved one after the other.
+		WorkerThreadPool::get_singleton()->finish();
+		WorkerThreadPool::get_singleton()->init(1);
+		LocalVector<Vector3> single_thread = simulate_cloth(size, steps);
+		WorkerThreadPool::get_singleton()->finish();
+		WorkerThreadPool::get_singleton()->init();
+
+		REQUIRE(threaded.size() == single_thread.size());
+		int differences = 0;
+		for (uint32_t i = 0; i < threaded.size(); i++) {
+			differences += threaded[i] != single_thread[i];
+		}
+		CHECK_MESSAGE(differences == 0, "Results should be bit-identical with any amount of threads.");
+	}
+
+	TEST_CASE("[GodotSoftBody3D] Cloth benchmark" * doctest::skip()) {
+		// 3,721 nodes, run with --no-skip. Bending constraints are generated with a node matrix, which limits the size.
+		GodotSoftBody3D soft_body;
+		REQUIRE(create_cloth(soft_body, 60));
+
+		const int steps = 60;
+		uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+		shake_cloth(soft_body, steps);
+		MESSAGE("Average step time for ", soft_body.get_link_count(), " links: ", (OS::get_singleton()->get_ticks_usec() - begin_usec) / steps, " usec.");
+	}
+
+	TEST_CASE("[PhysicsServer3D] Box stack benchmark" * doctest::skip()) {
+		// 5,000 boxes, run with --no-skip.
+		BoxStackScene scene(Vector3i(25, 8, 25));
+		scene.step(1); // Creates the pairs.
+
+		const int steps = 60;
+		uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+		scene.step(steps);
+		MESSAGE("Average step time for ", scene.boxes.size(), " boxes: ", (OS::get_singleton()->get_ticks_usec() - begin_usec) / steps, " usec.");
+	}
+}
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H